@@ -1,5 +1,9 @@
 #include "AppDelegate.h"
 #include "HelloWorldScene.h"
+#include "utils/CoreLog.h"
+#include "utils/DrawCallCounter.h"
+#include "utils/TraceProfiler.h"
+#include "configs/loaders/LevelConfigLoader.h"
 
 USING_NS_CC;
 
@@ -7,6 +11,14 @@ USING_NS_CC;
 static const int kDesignWidth = 1080;
 static const int kDesignHeight = 2080;
 
+const char* AppDelegate::kEventDidEnterBackground = "app_did_enter_background";
+
+#if POKER_TRACE
+// 当前帧（更新开始）和绘制阶段的开始时间
+static uint64_t s_frameStartNs = 0;
+static uint64_t s_drawStartNs = 0;
+#endif
+
 AppDelegate::AppDelegate()
 {
 }
@@ -24,6 +36,19 @@ void AppDelegate::initGLContextAttrs()
 
 bool AppDelegate::applicationDidFinishLaunching()
 {
+#if COCOS2D_DEBUG > 0
+    // 规则核心库的日志转发到引擎日志
+    CoreLog::setSink([](const char* message) {
+        cocos2d::log("%s", message);
+    });
+#endif
+
+    // 关卡配置通过引擎读取（支持资源搜索路径和安卓APK内资源）
+    LevelConfigLoader::setFileReader([](const std::string& filePath) -> std::string {
+        auto fileUtils = FileUtils::getInstance();
+        return fileUtils->getStringFromFile(fileUtils->fullPathForFilename(filePath));
+    });
+    
     // 初始化Director
     auto director = Director::getInstance();
     auto glview = director->getOpenGLView();
@@ -35,26 +60,52 @@ bool AppDelegate::applicationDidFinishLaunching()
                                            0.5f);
         director->setOpenGLView(glview);
     }
-
+    
     // 设置设计分辨率（固定宽度策略）
     glview->setDesignResolutionSize(kDesignWidth, kDesignHeight, ResolutionPolicy::FIXED_WIDTH);
-
+    
     // 显示FPS
     director->setDisplayStats(true);
 
+    // 统计每帧绘制调用数（卡牌全部来自同一图集，正常时整个牌桌只占一次）
+    DrawCallCounter::start();
+
+#if POKER_TRACE
+    // 每帧记录更新、绘制和整帧的区间，进入后台时导出
+    TraceProfiler::setThreadName("Main");
+    auto dispatcher = director->getEventDispatcher();
+    dispatcher->addCustomEventListener(Director::EVENT_BEFORE_UPDATE, [](EventCustom*) {
+        s_frameStartNs = TraceProfiler::now();
+    });
+    dispatcher->addCustomEventListener(Director::EVENT_AFTER_UPDATE, [](EventCustom*) {
+        s_drawStartNs = TraceProfiler::now();
+        TraceProfiler::recordZone("Director::update", s_frameStartNs, s_drawStartNs);
+    });
+    dispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW, [](EventCustom*) {
+        uint64_t endNs = TraceProfiler::now();
+        TraceProfiler::recordZone("Director::draw", s_drawStartNs, endNs);
+        TraceProfiler::recordZone("frame", s_frameStartNs, endNs);
+    });
+#endif
+
     // 设置FPS为60
     director->setAnimationInterval(1.0f / 60);
-
+    
     // 创建并运行第一个场景
     auto scene = HelloWorld::createScene();
     director->runWithScene(scene);
-
+    
     return true;
 }
 
 void AppDelegate::applicationDidEnterBackground()
 {
     Director::getInstance()->stopAnimation();
+    // 进入后台后进程可能被系统直接杀掉，通知控制器同步自动存档
+    Director::getInstance()->getEventDispatcher()->dispatchCustomEvent(kEventDidEnterBackground);
+#if POKER_TRACE
+    TraceProfiler::writeChromeTrace(FileUtils::getInstance()->getWritablePath() + "trace.json");
+#endif
     // 如果有音频，在这里暂停
 }
 
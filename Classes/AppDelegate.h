@@ -11,6 +11,11 @@
 class AppDelegate : private cocos2d::Application
 {
 public:
+    /**
+     * @brief 应用进入后台时派发的自定义事件名（控制器借此同步自动存档）
+     */
+    static const char* kEventDidEnterBackground;
+    
     /**
      * @brief 构造函数
      */
@@ -32,8 +32,8 @@ bool HelloWorld::init()
     _gameController = new GameController();
     _gameController->retain();
     
-    // 启动关卡1
-    if (!_gameController->startGame(1, this)) {
+    // 优先恢复上次未完成的关卡，没有存档时启动关卡1
+    if (!_gameController->resumeGame(this) && !_gameController->startGame(1, this)) {
         CCLOG("Failed to start game!");
     }
 
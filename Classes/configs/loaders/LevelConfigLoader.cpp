@@ -1,40 +1,404 @@
 #include "LevelConfigLoader.h"
-#include "cocos2d.h"
+#include "../../utils/CoreLog.h"
+#include "../../utils/TraceProfiler.h"
 #include "json/document.h"
-#include "json/stringbuffer.h"
+#include "json/reader.h"
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
 
-USING_NS_CC;
+LevelConfigLoader::FileReader LevelConfigLoader::s_fileReader = &LevelConfigLoader::readLocalFile;
+
+/**
+ * @class LevelConfigLoader::SaxHandler
+ * @brief 关卡JSON的SAX处理器
+ * @details 按记号流直接填充LevelConfig，与parseJsonDocument接受相同的格式：
+ *          根对象中的Playfield/Stack数组（不是数组时忽略），卡牌对象的CardFace/CardSuit（整数）
+ *          和Position（含数值x、y的对象，备用牌堆忽略）；同名成员只取第一个，其他成员忽略
+ *          DOM方式在格式不符时（例如卡牌不是对象、Position缺少x）会触发断言，这里改为解析失败
+ */
+class LevelConfigLoader::SaxHandler
+    : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, LevelConfigLoader::SaxHandler>
+{
+public:
+    explicit SaxHandler(LevelConfig* config)
+        : _config(config)
+        , _state(S_START)
+        , _target(T_SKIP)
+        , _skipDepth(0)
+        , _inPlayfield(false)
+        , _seenPlayfield(false)
+        , _seenStack(false)
+        , _seenFace(false)
+        , _seenSuit(false)
+        , _seenPosition(false)
+        , _seenX(false)
+        , _seenY(false)
+        , _schemaError(false)
+    {
+    }
+    
+    bool hasSchemaError() const { return _schemaError; }
+    
+    bool Null() { return scalar(false, 0, false, 0.0); }
+    bool Bool(bool) { return scalar(false, 0, false, 0.0); }
+    bool Int(int value) { return scalar(true, value, true, value); }
+    bool Uint(unsigned value) { return scalar(value <= INT_MAX, static_cast<int>(value), true, value); }
+    bool Int64(int64_t value) { return scalar(false, 0, true, static_cast<double>(value)); }
+    bool Uint64(uint64_t value) { return scalar(false, 0, true, static_cast<double>(value)); }
+    bool Double(double value) { return scalar(false, 0, true, value); }
+    bool String(const Ch*, rapidjson::SizeType, bool) { return scalar(false, 0, false, 0.0); }
+    
+    bool StartObject()
+    {
+        if (_skipDepth > 0) {
+            _skipDepth++;
+            return true;
+        }
+        
+        switch (_state) {
+            case S_START:
+                _state = S_ROOT;
+                return true;
+            case S_CARD_LIST:
+                // 新卡牌
+                _state = S_CARD;
+                _card = CardConfig();
+                _seenFace = _seenSuit = _seenPosition = false;
+                return true;
+            case S_CARD:
+                if (_target == T_POSITION) {
+                    _state = S_POSITION;
+                    _seenX = _seenY = false;
+                    return true;
+                }
+                return beginContainer();
+            default:
+                return beginContainer();
+        }
+    }
+    
+    bool Key(const Ch* str, rapidjson::SizeType length, bool)
+    {
+        if (_skipDepth > 0) {
+            return true;
+        }
+        
+        // 同名成员只取第一个（与HasMember/operator[]一致）
+        _target = T_SKIP;
+        switch (_state) {
+            case S_ROOT:
+                if (keyEquals(str, length, "Playfield") && !_seenPlayfield) {
+                    _seenPlayfield = true;
+                    _target = T_PLAYFIELD;
+                } else if (keyEquals(str, length, "Stack") && !_seenStack) {
+                    _seenStack = true;
+                    _target = T_STACK;
+                }
+                break;
+            case S_CARD:
+                if (keyEquals(str, length, "CardFace") && !_seenFace) {
+                    _seenFace = true;
+                    _target = T_FACE;
+                } else if (keyEquals(str, length, "CardSuit") && !_seenSuit) {
+                    _seenSuit = true;
+                    _target = T_SUIT;
+                } else if (keyEquals(str, length, "Position") && !_seenPosition && _inPlayfield) {
+                    // 备用牌堆的Position会统一放置，不读取
+                    _seenPosition = true;
+                    _target = T_POSITION;
+                }
+                break;
+            case S_POSITION:
+                if (keyEquals(str, length, "x") && !_seenX) {
+                    _seenX = true;
+                    _target = T_X;
+                } else if (keyEquals(str, length, "y") && !_seenY) {
+                    _seenY = true;
+                    _target = T_Y;
+                }
+                break;
+            default:
+                break;
+        }
+        return true;
+    }
+    
+    bool EndObject(rapidjson::SizeType)
+    {
+        if (_skipDepth > 0) {
+            _skipDepth--;
+            return true;
+        }
+        
+        switch (_state) {
+            case S_ROOT:
+                _state = S_DONE;
+                return true;
+            case S_CARD:
+                if (_inPlayfield) {
+                    _config->addPlayfieldCard(_card);
+                } else {
+                    _config->addStackCard(_card);
+                }
+                _state = S_CARD_LIST;
+                return true;
+            case S_POSITION:
+                _state = S_CARD;
+                return (_seenX && _seenY) || fail();
+            default:
+                return fail();
+        }
+    }
+    
+    bool StartArray()
+    {
+        if (_skipDepth > 0) {
+            _skipDepth++;
+            return true;
+        }
+        
+        if (_state == S_ROOT && (_target == T_PLAYFIELD || _target == T_STACK)) {
+            _state = S_CARD_LIST;
+            _inPlayfield = _target == T_PLAYFIELD;
+            return true;
+        }
+        return beginContainer();
+    }
+    
+    bool EndArray(rapidjson::SizeType)
+    {
+        if (_skipDepth > 0) {
+            _skipDepth--;
+            return true;
+        }
+        
+        if (_state == S_CARD_LIST) {
+            _state = S_ROOT;
+            return true;
+        }
+        return fail();
+    }
+    
+private:
+    enum State
+    {
+        S_START,        // 等待根对象
+        S_ROOT,         // 根对象内
+        S_CARD_LIST,    // Playfield/Stack数组内
+        S_CARD,         // 卡牌对象内
+        S_POSITION,     // Position对象内
+        S_DONE          // 根对象结束
+    };
+    
+    enum Target
+    {
+        T_SKIP,         // 忽略的成员
+        T_PLAYFIELD,
+        T_STACK,
+        T_FACE,
+        T_SUIT,
+        T_POSITION,
+        T_X,
+        T_Y
+    };
+    
+    static bool keyEquals(const Ch* str, rapidjson::SizeType length, const char* name)
+    {
+        return length == strlen(name) && memcmp(str, name, length) == 0;
+    }
+    
+    bool fail()
+    {
+        _schemaError = true;
+        return false;
+    }
+    
+    /**
+     * @brief 对象或数组值开始（卡牌数组、卡牌、Position之外的容器）
+     */
+    bool beginContainer()
+    {
+        switch (_state) {
+            case S_ROOT:
+                // 根对象中的其他成员，以及不是数组的Playfield/Stack
+                break;
+            case S_CARD:
+                if (_target != T_SKIP) {
+                    return fail();
+                }
+                break;
+            case S_POSITION:
+                if (_target != T_SKIP) {
+                    return fail();
+                }
+                break;
+            default:
+                // 根不是对象、卡牌不是对象
+                return fail();
+        }
+        _skipDepth = 1;
+        return true;
+    }
+    
+    /**
+     * @brief 标量值
+     * @param isInt 是否为int范围内的整数
+     * @param intValue 整数值
+     * @param isNumber 是否为数值
+     * @param number 数值
+     */
+    bool scalar(bool isInt, int intValue, bool isNumber, double number)
+    {
+        if (_skipDepth > 0) {
+            return true;
+        }
+        
+        switch (_state) {
+            case S_ROOT:
+                return true;
+            case S_CARD:
+                if (_target == T_FACE || _target == T_SUIT) {
+                    if (!isInt) {
+                        return fail();
+                    }
+                    if (_target == T_FACE) {
+                        _card.face = parseCardFace(intValue);
+                    } else {
+                        _card.suit = parseCardSuit(intValue);
+                    }
+                } else if (_target == T_POSITION) {
+                    return fail();
+                }
+                return true;
+            case S_POSITION:
+                if (_target == T_X || _target == T_Y) {
+                    if (!isNumber) {
+                        return fail();
+                    }
+                    float& coordinate = _target == T_X ? _card.position.x : _card.position.y;
+                    coordinate = static_cast<float>(number);
+                }
+                return true;
+            default:
+                return fail();
+        }
+    }
+    
+private:
+    LevelConfig* _config;       // 输出的关卡配置
+    State _state;               // 当前所在的容器
+    Target _target;             // 下一个值对应的成员
+    int _skipDepth;             // 正在跳过的容器嵌套深度
+    bool _inPlayfield;          // 当前卡牌数组是否为Playfield
+    bool _seenPlayfield;        // 根对象成员是否已出现
+    bool _seenStack;
+    bool _seenFace;             // 当前卡牌成员是否已出现
+    bool _seenSuit;
+    bool _seenPosition;
+    bool _seenX;                // 当前Position成员是否已出现
+    bool _seenY;
+    bool _schemaError;          // 是否因格式不符中止
+    CardConfig _card;           // 正在解析的卡牌
+};
 
 LevelConfig* LevelConfigLoader::loadLevelConfig(int levelId)
 {
     // 根据关卡ID构建文件路径
-    std::string filePath = StringUtils::format("level/level_%d.json", levelId);
-    return loadFromFile(filePath);
+    char filePath[64];
+    snprintf(filePath, sizeof(filePath), "level/level_%d.json", levelId);
+    
+    LevelConfig* config = loadFromFile(filePath);
+    if (config) {
+        config->setLevelId(levelId);
+    }
+    return config;
+}
+
+std::string LevelConfigLoader::readLevelFile(int levelId)
+{
+    char filePath[64];
+    snprintf(filePath, sizeof(filePath), "level/level_%d.json", levelId);
+    return s_fileReader(filePath);
 }
 
 LevelConfig* LevelConfigLoader::loadFromFile(const std::string& filePath)
 {
+    TRACE_ZONE("LevelConfigLoader::loadFromFile");
+    
     // 读取JSON文件内容
-    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
-    std::string jsonStr = FileUtils::getInstance()->getStringFromFile(fullPath);
+    std::string jsonStr = s_fileReader(filePath);
     
     if (jsonStr.empty()) {
-        CCLOG("LevelConfigLoader: Failed to load file: %s", filePath.c_str());
+        CORE_LOG("LevelConfigLoader: Failed to load file: %s", filePath.c_str());
         return nullptr;
     }
     
-    // 解析JSON
+    // 原地解析（直接修改读取的缓冲区）
+    LevelConfig* config = parseJsonInsitu(&jsonStr[0]);
+    if (!config) {
+        CORE_LOG("LevelConfigLoader: JSON parse error in file: %s", filePath.c_str());
+    }
+    return config;
+}
+
+LevelConfig* LevelConfigLoader::loadFromString(std::string jsonStr)
+{
+    if (jsonStr.empty()) {
+        return nullptr;
+    }
+    return parseJsonInsitu(&jsonStr[0]);
+}
+
+LevelConfig* LevelConfigLoader::loadFromStringDom(const std::string& jsonStr)
+{
     rapidjson::Document doc;
     doc.Parse(jsonStr.c_str());
     
-    if (doc.HasParseError()) {
-        CCLOG("LevelConfigLoader: JSON parse error in file: %s", filePath.c_str());
+    if (doc.HasParseError() || !doc.IsObject()) {
         return nullptr;
     }
-    
     return parseJsonDocument(doc);
 }
 
+LevelConfig* LevelConfigLoader::parseJsonInsitu(char* json)
+{
+    LevelConfig* config = new LevelConfig();
+    SaxHandler handler(config);
+    rapidjson::Reader reader;
+    rapidjson::InsituStringStream stream(json);
+    reader.Parse<rapidjson::kParseDefaultFlags | rapidjson::kParseInsituFlag>(stream, handler);
+    
+    if (reader.HasParseError()) {
+        if (handler.hasSchemaError()) {
+            CORE_LOG("LevelConfigLoader: Level JSON does not match schema at offset %u",
+                     static_cast<unsigned>(reader.GetErrorOffset()));
+        }
+        delete config;
+        return nullptr;
+    }
+    return config;
+}
+
+void LevelConfigLoader::setFileReader(FileReader reader)
+{
+    s_fileReader = reader ? reader : &LevelConfigLoader::readLocalFile;
+}
+
+std::string LevelConfigLoader::readLocalFile(const std::string& filePath)
+{
+    std::ifstream file(filePath.c_str(), std::ios::in | std::ios::binary);
+    if (!file) {
+        return std::string();
+    }
+    
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
 LevelConfig* LevelConfigLoader::parseJsonDocument(const rapidjson::Document& doc)
 {
     LevelConfig* config = new LevelConfig();
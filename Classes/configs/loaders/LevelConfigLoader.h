@@ -9,10 +9,19 @@
  * @class LevelConfigLoader
  * @brief 关卡配置加载器
  * @details 负责从JSON文件加载关卡配置数据
+ *          文件读取通过可替换的读取函数完成，默认使用标准库读取本地文件，
+ *          客户端替换为引擎的FileUtils（支持资源搜索路径和安卓APK内资源）
+ *          JSON使用SAX方式原地（in-situ）解析，边读取记号边填充LevelConfig，不构建DOM
  */
 class LevelConfigLoader
 {
 public:
+    /**
+     * @brief 文件读取函数类型
+     * @details 参数为文件路径，返回文件内容，读取失败返回空字符串
+     */
+    using FileReader = std::string (*)(const std::string& filePath);
+    
     /**
      * @brief 从JSON文件加载关卡配置
      * @param levelId 关卡ID
@@ -20,6 +29,15 @@ public:
      */
     static LevelConfig* loadLevelConfig(int levelId);
     
+    /**
+     * @brief 读取关卡JSON文件内容（不解析）
+     * @details 在调用线程上使用当前的读取函数；客户端的读取函数依赖引擎，只能在主线程调用，
+     *          读取的内容可交给工作线程用loadFromString解析
+     * @param levelId 关卡ID
+     * @return 文件内容，读取失败返回空字符串
+     */
+    static std::string readLevelFile(int levelId);
+    
     /**
      * @brief 从JSON文件路径加载关卡配置
      * @param filePath JSON文件路径
@@ -27,7 +45,39 @@ public:
      */
     static LevelConfig* loadFromFile(const std::string& filePath);
     
+    /**
+     * @brief 从JSON字符串加载关卡配置（SAX原地解析）
+     * @param jsonStr JSON内容（按值传入，解析时原地修改，调用方可std::move避免复制）
+     * @return 关卡配置指针，解析失败或不符合关卡格式时返回nullptr
+     */
+    static LevelConfig* loadFromString(std::string jsonStr);
+    
+    /**
+     * @brief 从JSON字符串加载关卡配置（构建DOM后遍历，仅用于对照测试和性能基准）
+     * @param jsonStr JSON内容
+     * @return 关卡配置指针，解析失败返回nullptr
+     */
+    static LevelConfig* loadFromStringDom(const std::string& jsonStr);
+    
+    /**
+     * @brief 设置文件读取函数
+     * @param reader 读取函数，传nullptr恢复默认的本地文件读取
+     */
+    static void setFileReader(FileReader reader);
+    
 private:
+    /**
+     * @brief SAX事件处理器（定义在实现文件中）
+     */
+    class SaxHandler;
+    
+    /**
+     * @brief 默认的文件读取函数（标准库读取本地文件）
+     * @param filePath 文件路径
+     * @return 文件内容，读取失败返回空字符串
+     */
+    static std::string readLocalFile(const std::string& filePath);
+    
     /**
      * @brief 解析JSON文档为关卡配置
      * @param doc JSON文档
@@ -35,6 +85,13 @@ private:
      */
     static LevelConfig* parseJsonDocument(const rapidjson::Document& doc);
     
+    /**
+     * @brief SAX原地解析JSON为关卡配置
+     * @param json 以'\0'结尾的可写JSON缓冲区（解析后内容被破坏）
+     * @return 关卡配置指针，语法错误或不符合关卡格式时返回nullptr
+     */
+    static LevelConfig* parseJsonInsitu(char* json);
+    
     /**
      * @brief 解析CardFaceType
      * @param faceValue 牌面值（0-12对应A-K）
@@ -48,6 +105,8 @@ private:
      * @return CardSuitType
      */
     static CardSuitType parseCardSuit(int suitValue);
+    
+    static FileReader s_fileReader;  // 文件读取函数
 };
 
-#endif // __LEVEL_CONFIG_LOADER_H__ 
\ No newline at end of file
+#endif // __LEVEL_CONFIG_LOADER_H__
@@ -0,0 +1,208 @@
+#include "LevelPackLoader.h"
+#include "../../utils/CoreLog.h"
+#include "../../utils/TraceProfiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+/**
+ * @brief 追加一个结构体的字节
+ */
+template <typename T>
+void appendBytes(std::vector<uint8_t>* outData, const T& value)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    outData->insert(outData->end(), bytes, bytes + sizeof(T));
+}
+
+LevelPackCard makePackCard(const CardConfig& cardConfig)
+{
+    LevelPackCard card;
+    card.x = cardConfig.position.x;
+    card.y = cardConfig.position.y;
+    card.face = static_cast<int8_t>(cardConfig.face);
+    card.suit = static_cast<int8_t>(cardConfig.suit);
+    card.reserved = 0;
+    return card;
+}
+
+bool compareLevelId(const LevelConfig* a, const LevelConfig* b)
+{
+    return a->getLevelId() < b->getLevelId();
+}
+
+} // namespace
+
+LevelPack* LevelPackLoader::loadFromFile(const std::string& filePath)
+{
+    TRACE_ZONE("LevelPackLoader::loadFromFile");
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        CORE_LOG("LevelPackLoader: Failed to open file: %s", filePath.c_str());
+        return nullptr;
+    }
+    
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    CloseHandle(file);
+    if (!mapping) {
+        CORE_LOG("LevelPackLoader: Failed to map file: %s", filePath.c_str());
+        return nullptr;
+    }
+    
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data) {
+        CORE_LOG("LevelPackLoader: Failed to map file: %s", filePath.c_str());
+        return nullptr;
+    }
+    
+    size_t size = static_cast<size_t>(fileSize.QuadPart);
+    LevelPack* pack = LevelPack::create(data, size, [data]() {
+        UnmapViewOfFile(data);
+    });
+#else
+    int fd = open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        CORE_LOG("LevelPackLoader: Failed to open file: %s", filePath.c_str());
+        return nullptr;
+    }
+    
+    struct stat fileStat;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
+        data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (data == MAP_FAILED) {
+        CORE_LOG("LevelPackLoader: Failed to map file: %s", filePath.c_str());
+        return nullptr;
+    }
+    
+    size_t size = static_cast<size_t>(fileStat.st_size);
+    LevelPack* pack = LevelPack::create(data, size, [data, size]() {
+        munmap(data, size);
+    });
+#endif
+
+    if (!pack) {
+        CORE_LOG("LevelPackLoader: Invalid level pack: %s", filePath.c_str());
+    }
+    return pack;
+}
+
+LevelPack* LevelPackLoader::loadFromBuffer(const std::string& data)
+{
+    // 以uint32_t为单位分配，保证结构体访问对齐
+    uint32_t* buffer = new uint32_t[(data.size() + sizeof(uint32_t) - 1) / sizeof(uint32_t) + 1];
+    memcpy(buffer, data.data(), data.size());
+    
+    LevelPack* pack = LevelPack::create(buffer, data.size(), [buffer]() {
+        delete[] buffer;
+    });
+    if (!pack) {
+        CORE_LOG("LevelPackLoader: Invalid level pack buffer");
+    }
+    return pack;
+}
+
+bool LevelPackLoader::saveToFile(const std::string& filePath, const std::vector<const LevelConfig*>& levels)
+{
+    std::vector<uint8_t> data;
+    if (!buildPackData(levels, &data)) {
+        return false;
+    }
+    
+    FILE* file = fopen(filePath.c_str(), "wb");
+    if (!file) {
+        CORE_LOG("LevelPackLoader: Failed to open file for writing: %s", filePath.c_str());
+        return false;
+    }
+    bool written = fwrite(data.data(), 1, data.size(), file) == data.size();
+    written = fclose(file) == 0 && written;
+    if (!written) {
+        CORE_LOG("LevelPackLoader: Failed to write file: %s", filePath.c_str());
+    }
+    return written;
+}
+
+bool LevelPackLoader::buildPackData(const std::vector<const LevelConfig*>& levels, std::vector<uint8_t>* outData)
+{
+    // 索引按关卡ID升序，便于二分查找
+    std::vector<const LevelConfig*> sortedLevels;
+    for (size_t i = 0; i < levels.size(); i++) {
+        if (levels[i]) {
+            sortedLevels.push_back(levels[i]);
+        }
+    }
+    std::stable_sort(sortedLevels.begin(), sortedLevels.end(), compareLevelId);
+    
+    const size_t maxCards = std::numeric_limits<uint16_t>::max();
+    uint64_t cardOffset = sizeof(LevelPackHeader) + sortedLevels.size() * sizeof(LevelPackEntry);
+    std::vector<LevelPackEntry> entries;
+    for (size_t i = 0; i < sortedLevels.size(); i++) {
+        const LevelConfig* level = sortedLevels[i];
+        if (i > 0 && level->getLevelId() == sortedLevels[i - 1]->getLevelId()) {
+            CORE_LOG("LevelPackLoader: Duplicate level id %d", level->getLevelId());
+            return false;
+        }
+        if (level->getPlayfieldCards().size() > maxCards || level->getStackCards().size() > maxCards) {
+            CORE_LOG("LevelPackLoader: Level %d has too many cards", level->getLevelId());
+            return false;
+        }
+        
+        LevelPackEntry entry;
+        entry.levelId = level->getLevelId();
+        entry.cardOffset = static_cast<uint32_t>(cardOffset);
+        entry.playfieldCount = static_cast<uint16_t>(level->getPlayfieldCards().size());
+        entry.stackCount = static_cast<uint16_t>(level->getStackCards().size());
+        entry.reserved = 0;
+        entries.push_back(entry);
+        
+        cardOffset += (static_cast<uint64_t>(entry.playfieldCount) + entry.stackCount) * sizeof(LevelPackCard);
+        if (cardOffset > std::numeric_limits<uint32_t>::max()) {
+            CORE_LOG("LevelPackLoader: Level pack exceeds 4GB");
+            return false;
+        }
+    }
+    
+    LevelPackHeader header;
+    memcpy(header.magic, LevelPack::kMagic, sizeof(header.magic));
+    header.version = LevelPack::kVersion;
+    header.levelCount = static_cast<uint32_t>(entries.size());
+    header.reserved = 0;
+    
+    outData->clear();
+    outData->reserve(static_cast<size_t>(cardOffset));
+    appendBytes(outData, header);
+    for (size_t i = 0; i < entries.size(); i++) {
+        appendBytes(outData, entries[i]);
+    }
+    for (size_t i = 0; i < sortedLevels.size(); i++) {
+        for (const CardConfig& cardConfig : sortedLevels[i]->getPlayfieldCards()) {
+            appendBytes(outData, makePackCard(cardConfig));
+        }
+        for (const CardConfig& cardConfig : sortedLevels[i]->getStackCards()) {
+            appendBytes(outData, makePackCard(cardConfig));
+        }
+    }
+    return true;
+}
@@ -0,0 +1,48 @@
+#ifndef __LEVEL_PACK_LOADER_H__
+#define __LEVEL_PACK_LOADER_H__
+
+#include "../models/LevelPack.h"
+#include <string>
+#include <vector>
+
+/**
+ * @class LevelPackLoader
+ * @brief 二进制关卡包加载器
+ * @details 本地文件通过内存映射打开（POSIX mmap / Windows MapViewOfFile），
+ *          关卡数据按需由操作系统换页读入，打开时间与关卡数量和大小基本无关；
+ *          无法映射的资源（例如安卓APK内的文件）由调用方读入内存后通过loadFromBuffer打开
+ *          关卡编辑仍使用JSON（LevelConfigLoader），发布前用LevelPackTool转换
+ */
+class LevelPackLoader
+{
+public:
+    /**
+     * @brief 内存映射打开关卡包文件
+     * @param filePath 文件路径
+     * @return 关卡包指针（由调用者释放），打开失败或格式错误返回nullptr
+     */
+    static LevelPack* loadFromFile(const std::string& filePath);
+    
+    /**
+     * @brief 从内存数据打开关卡包（复制一份对齐的数据）
+     * @param data 关卡包文件内容
+     * @return 关卡包指针（由调用者释放），格式错误返回nullptr
+     */
+    static LevelPack* loadFromBuffer(const std::string& data);
+    
+    /**
+     * @brief 把关卡写成关卡包文件
+     * @param filePath 输出文件路径
+     * @param levels 关卡配置（以getLevelId()作为关卡ID，ID不能重复）
+     * @return 写入失败、关卡ID重复或卡牌数量超出格式上限时返回false
+     */
+    static bool saveToFile(const std::string& filePath, const std::vector<const LevelConfig*>& levels);
+    
+private:
+    /**
+     * @brief 生成关卡包文件内容
+     */
+    static bool buildPackData(const std::vector<const LevelConfig*>& levels, std::vector<uint8_t>* outData);
+};
+
+#endif // __LEVEL_PACK_LOADER_H__
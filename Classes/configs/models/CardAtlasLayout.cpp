@@ -0,0 +1,62 @@
+#include "CardAtlasLayout.h"
+#include <algorithm>
+#include <cmath>
+
+CardAtlasLayout::CardAtlasLayout(int frameWidth, int frameHeight, int maxTextureSize)
+    : _frameWidth(frameWidth)
+    , _frameHeight(frameHeight)
+    , _columns(0)
+    , _rows(0)
+    , _framesPerPage(1)
+    , _pageCount(0)
+{
+    int cellWidth = frameWidth + 2 * kFramePadding;
+    int cellHeight = frameHeight + 2 * kFramePadding;
+    int maxColumns = frameWidth > 0 ? maxTextureSize / cellWidth : 0;
+    int maxRows = frameHeight > 0 ? maxTextureSize / cellHeight : 0;
+    if (maxColumns <= 0 || maxRows <= 0) {
+        return;
+    }
+    
+    // 每页尽量接近正方形：列数取帧数的平方根，行数超出上限时增加列数
+    int frameCount = kFrameCount;
+    int pageFrames = std::min(frameCount, maxColumns * maxRows);
+    int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(pageFrames))));
+    columns = std::max(columns, (pageFrames + maxRows - 1) / maxRows);
+    _columns = std::min(columns, maxColumns);
+    _rows = (pageFrames + _columns - 1) / _columns;
+    _framesPerPage = _columns * _rows;
+    _pageCount = (frameCount + _framesPerPage - 1) / _framesPerPage;
+}
+
+int CardAtlasLayout::getFrameIndex(CardFaceType face, CardSuitType suit, bool showFront)
+{
+    if (!showFront) {
+        return kBackFrameIndex;
+    }
+    if (face <= CFT_NONE || face >= CFT_NUM_CARD_FACE_TYPES || suit <= CST_NONE || suit >= CST_NUM_CARD_SUIT_TYPES) {
+        return -1;
+    }
+    return suit * CFT_NUM_CARD_FACE_TYPES + face;
+}
+
+void CardAtlasLayout::getFrameOrigin(int frameIndex, int* outX, int* outY) const
+{
+    int pageFrame = frameIndex % _framesPerPage;
+    *outX = (pageFrame % _columns) * (_frameWidth + 2 * kFramePadding) + kFramePadding;
+    *outY = (pageFrame / _columns) * (_frameHeight + 2 * kFramePadding) + kFramePadding;
+}
+
+int CardAtlasLayout::countDrawCalls(const std::vector<int>& frameIndices) const
+{
+    int drawCalls = 0;
+    int lastPage = -1;
+    for (int frameIndex : frameIndices) {
+        int page = frameIndex >= 0 ? getPageIndex(frameIndex) : -1;
+        if (page < 0 || page != lastPage) {
+            drawCalls++;
+        }
+        lastPage = page;
+    }
+    return drawCalls;
+}
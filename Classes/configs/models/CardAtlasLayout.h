@@ -0,0 +1,84 @@
+#ifndef __CARD_ATLAS_LAYOUT_H__
+#define __CARD_ATLAS_LAYOUT_H__
+
+#include "../../utils/CardDefines.h"
+#include <vector>
+
+/**
+ * @class CardAtlasLayout
+ * @brief 卡牌图集的排布
+ * @details 52张正面和1张背面按帧序号排成网格，每帧四周留kFramePadding像素（由帧边缘像素向外扩展，
+ *          缩放采样时不会混入相邻帧）；一页放不下时分成多页，每页边长不超过kMaxTextureSize
+ *          CardAtlasTool按此排布生成图集，客户端按页数加载，CoreBench按此统计卡牌的绘制调用数
+ */
+class CardAtlasLayout
+{
+public:
+    static const int kMaxTextureSize = 2048;    // 图集页最大边长（低端安卓设备普遍支持）
+    static const int kFramePadding = 2;         // 每帧四周的扩展像素
+    static const int kBackFrameIndex = CST_NUM_CARD_SUIT_TYPES * CFT_NUM_CARD_FACE_TYPES;  // 背面的帧序号
+    static const int kFrameCount = kBackFrameIndex + 1;                                      // 帧数量
+    
+    /**
+     * @brief 构造函数
+     * @param frameWidth 帧宽度（像素）
+     * @param frameHeight 帧高度（像素）
+     * @param maxTextureSize 图集页最大边长
+     */
+    CardAtlasLayout(int frameWidth, int frameHeight, int maxTextureSize = kMaxTextureSize);
+    
+    /**
+     * @brief 获取卡牌显示的帧序号
+     * @param face 牌面类型
+     * @param suit 花色类型
+     * @param showFront 是否显示正面（false时为背面）
+     * @return 帧序号，正面的牌面或花色无效时返回-1
+     */
+    static int getFrameIndex(CardFaceType face, CardSuitType suit, bool showFront);
+    
+    /**
+     * @brief 帧尺寸超过最大边长时无法排布
+     */
+    bool isValid() const { return _pageCount > 0; }
+    
+    /**
+     * @brief 获取帧尺寸（像素）
+     */
+    int getFrameWidth() const { return _frameWidth; }
+    int getFrameHeight() const { return _frameHeight; }
+    
+    /**
+     * @brief 获取页数和每页的尺寸（像素，所有页相同）
+     */
+    int getPageCount() const { return _pageCount; }
+    int getPageWidth() const { return _columns * (_frameWidth + 2 * kFramePadding); }
+    int getPageHeight() const { return _rows * (_frameHeight + 2 * kFramePadding); }
+    
+    /**
+     * @brief 获取帧所在的页
+     */
+    int getPageIndex(int frameIndex) const { return frameIndex / _framesPerPage; }
+    
+    /**
+     * @brief 获取帧在所在页中的左上角像素坐标（不含扩展像素）
+     */
+    void getFrameOrigin(int frameIndex, int* outX, int* outY) const;
+    
+    /**
+     * @brief 统计按顺序绘制这些帧需要的绘制调用数
+     * @details 相邻两帧在同一页时渲染器可以合批；无效帧（-1）按单独的一次绘制计算
+     * @param frameIndices 按绘制顺序的帧序号
+     * @return 绘制调用数
+     */
+    int countDrawCalls(const std::vector<int>& frameIndices) const;
+    
+private:
+    int _frameWidth;        // 帧宽度
+    int _frameHeight;       // 帧高度
+    int _columns;           // 每页列数
+    int _rows;              // 每页行数
+    int _framesPerPage;     // 每页帧数
+    int _pageCount;         // 页数（无法排布时为0）
+};
+
+#endif // __CARD_ATLAS_LAYOUT_H__
@@ -1,13 +1,28 @@
 #include "CardResConfig.h"
-#include "cocos2d.h"
+#include <cstdio>
+
+namespace {
+
+/**
+ * @brief 图集页的路径（不含扩展名），第0页为images/cards，之后为images/cards_1、images/cards_2……
+ */
+std::string getCardAtlasBasePath(int page)
+{
+    if (page <= 0) {
+        return "images/cards";
+    }
+    char path[32];
+    snprintf(path, sizeof(path), "images/cards_%d", page);
+    return path;
+}
+
+} // namespace
 
 std::string CardResConfig::getCardFrontTexture(CardFaceType face, CardSuitType suit)
 {
     // 格式: images/cards/[suit]_[face].png
     // 例如: images/cards/hearts_A.png
-    std::string suitName = getSuitName(suit);
-    std::string faceName = getFaceName(face);
-    return cocos2d::StringUtils::format("images/cards/%s_%s.png", suitName.c_str(), faceName.c_str());
+    return "images/cards/" + getSuitName(suit) + "_" + getFaceName(face) + ".png";
 }
 
 std::string CardResConfig::getCardBackTexture()
@@ -15,6 +30,16 @@ std::string CardResConfig::getCardBackTexture()
     return "images/cards/card_back.png";
 }
 
+std::string CardResConfig::getCardAtlasPlist(int page)
+{
+    return getCardAtlasBasePath(page) + ".plist";
+}
+
+std::string CardResConfig::getCardAtlasTexture(int page)
+{
+    return getCardAtlasBasePath(page) + ".png";
+}
+
 std::string CardResConfig::getFaceName(CardFaceType face)
 {
     switch (face) {
@@ -7,7 +7,8 @@
 /**
  * @class CardResConfig
  * @brief 卡牌UI资源配置类
- * @details 提供卡牌纹理资源路径的映射
+ * @details 提供卡牌纹理资源路径的映射，不依赖引擎（CardAtlasTool和客户端共用）
+ *          卡牌纹理路径同时是卡牌图集中的帧名称
  */
 class CardResConfig
 {
@@ -26,6 +27,20 @@ public:
      */
     static std::string getCardBackTexture();
     
+    /**
+     * @brief 获取卡牌图集页的plist路径（帧布局见CardAtlasLayout）
+     * @param page 页序号
+     * @return plist路径（纹理与plist同名，扩展名为.png）
+     */
+    static std::string getCardAtlasPlist(int page);
+    
+    /**
+     * @brief 获取卡牌图集页的纹理路径
+     * @param page 页序号
+     * @return 纹理文件路径
+     */
+    static std::string getCardAtlasTexture(int page);
+    
     /**
      * @brief 获取牌面名称字符串（用于文件名）
      * @param face 牌面类型
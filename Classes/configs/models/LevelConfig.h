@@ -1,8 +1,8 @@
 #ifndef __LEVEL_CONFIG_H__
 #define __LEVEL_CONFIG_H__
 
-#include "cocos2d.h"
 #include "../../utils/CardDefines.h"
+#include "../../utils/CardPosition.h"
 #include <vector>
 
 /**
@@ -13,16 +13,16 @@ struct CardConfig
 {
     CardFaceType face;      // 牌面类型
     CardSuitType suit;      // 花色类型
-    cocos2d::Vec2 position; // 位置坐标
+    CardPosition position;  // 位置坐标
     
     CardConfig()
         : face(CFT_NONE)
         , suit(CST_NONE)
-        , position(cocos2d::Vec2::ZERO)
+        , position()
     {
     }
     
-    CardConfig(CardFaceType f, CardSuitType s, const cocos2d::Vec2& pos)
+    CardConfig(CardFaceType f, CardSuitType s, const CardPosition& pos)
         : face(f)
         , suit(s)
         , position(pos)
@@ -0,0 +1,108 @@
+#include "LevelLayoutTemplate.h"
+#include "../../models/CardCoverGraph.h"
+#include "../../utils/CardGeometry.h"
+
+// 金字塔布局的参数（设计分辨率坐标，与手工关卡的主牌区范围一致）
+static const float kPeaksCenterX = 540.0f;     // 布局水平中心
+static const float kPeaksTopY = 1000.0f;       // 第一行卡牌的中心高度
+
+LevelLayoutTemplate::LevelLayoutTemplate()
+    : _stackCount(0)
+{
+}
+
+bool LevelLayoutTemplate::init(const std::vector<CardPosition>& playfieldPositions, int stackCount)
+{
+    _playfieldPositions.clear();
+    _stackCount = 0;
+    _coveredOffsets.clear();
+    _coveredIndices.clear();
+    _coveringOffsets.clear();
+    _coveringIndices.clear();
+    if (stackCount < 1) {
+        return false;
+    }
+    
+    _playfieldPositions = playfieldPositions;
+    _stackCount = stackCount;
+    
+    // 以模板下标作为卡牌ID构建遮挡关系，与生成后的GameModel中的遮挡关系一致
+    int cardCount = static_cast<int>(playfieldPositions.size());
+    std::vector<int> cardIds(cardCount);
+    for (int i = 0; i < cardCount; i++) {
+        cardIds[i] = i;
+    }
+    CardCoverGraph coverGraph;
+    coverGraph.build(cardIds, playfieldPositions);
+    _coveredOffsets = coverGraph.getCoveredOffsets();
+    _coveredIndices = coverGraph.getCoveredIds();
+    if (_coveredOffsets.empty()) {
+        _coveredOffsets.assign(1, 0);
+    }
+    
+    // 反转边得到压住每张卡牌的卡牌
+    _coveringOffsets.assign(cardCount + 1, 0);
+    for (int covered : _coveredIndices) {
+        _coveringOffsets[covered + 1]++;
+    }
+    for (int i = 0; i < cardCount; i++) {
+        _coveringOffsets[i + 1] += _coveringOffsets[i];
+    }
+    _coveringIndices.resize(_coveredIndices.size());
+    std::vector<int> fillOffsets(_coveringOffsets.begin(), _coveringOffsets.end() - 1);
+    for (int index = 0; index < cardCount; index++) {
+        for (int i = _coveredOffsets[index]; i < _coveredOffsets[index + 1]; i++) {
+            _coveringIndices[fillOffsets[_coveredIndices[i]]++] = index;
+        }
+    }
+    return true;
+}
+
+bool LevelLayoutTemplate::initFromLevel(const LevelConfig& levelConfig)
+{
+    const std::vector<CardConfig>& playfieldCards = levelConfig.getPlayfieldCards();
+    std::vector<CardPosition> positions;
+    positions.reserve(playfieldCards.size());
+    for (const CardConfig& card : playfieldCards) {
+        positions.push_back(card.position);
+    }
+    return init(positions, static_cast<int>(levelConfig.getStackCards().size()));
+}
+
+bool LevelLayoutTemplate::initPeaks(int peakCount, int rowCount, int stackCount)
+{
+    if (peakCount < 1 || rowCount < 1) {
+        init(std::vector<CardPosition>(), 0);
+        return false;
+    }
+    
+    // 同一行相邻卡牌恰好接触（不算重叠），下一行错开半张卡牌并压住上一行
+    float peakWidth = rowCount * kCardWidth;
+    float rowStep = kCardHeight * 0.5f;
+    std::vector<CardPosition> positions;
+    positions.reserve(peakCount * rowCount * (rowCount + 1) / 2);
+    for (int row = 0; row < rowCount; row++) {
+        for (int peak = 0; peak < peakCount; peak++) {
+            float peakCenterX = kPeaksCenterX + (peak - (peakCount - 1) * 0.5f) * peakWidth;
+            for (int i = 0; i <= row; i++) {
+                positions.push_back(CardPosition(peakCenterX + (i - row * 0.5f) * kCardWidth,
+                                                 kPeaksTopY - row * rowStep));
+            }
+        }
+    }
+    return init(positions, stackCount);
+}
+
+void LevelLayoutTemplate::getCoveredCards(int index, const int** outBegin, const int** outEnd) const
+{
+    const int* data = _coveredIndices.data();
+    *outBegin = data + _coveredOffsets[index];
+    *outEnd = data + _coveredOffsets[index + 1];
+}
+
+void LevelLayoutTemplate::getCoveringCards(int index, const int** outBegin, const int** outEnd) const
+{
+    const int* data = _coveringIndices.data();
+    *outBegin = data + _coveringOffsets[index];
+    *outEnd = data + _coveringOffsets[index + 1];
+}
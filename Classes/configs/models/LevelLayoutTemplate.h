@@ -0,0 +1,82 @@
+#ifndef __LEVEL_LAYOUT_TEMPLATE_H__
+#define __LEVEL_LAYOUT_TEMPLATE_H__
+
+#include "LevelConfig.h"
+#include "../../utils/CardPosition.h"
+#include <vector>
+
+/**
+ * @class LevelLayoutTemplate
+ * @brief 关卡布局模板
+ * @details 只描述主牌区卡牌位置（按绘制顺序）和备用牌堆卡牌数量，不含牌面，
+ *          由ProceduralLevelGenerator填入牌面生成关卡配置
+ *          初始化时用CardCoverGraph计算一次遮挡关系并保存双向邻接表（CSR，按卡牌在模板中的下标），
+ *          之后只读，可在多个线程中共享，同一模板生成大量关卡时不再重复检测重叠
+ */
+class LevelLayoutTemplate
+{
+public:
+    /**
+     * @brief 构造函数（空模板）
+     */
+    LevelLayoutTemplate();
+    
+    /**
+     * @brief 从卡牌位置初始化
+     * @param playfieldPositions 主牌区卡牌中心坐标，按绘制顺序排列（后面的卡牌绘制在上层）
+     * @param stackCount 备用牌堆卡牌数量（包括开局时翻到底牌堆的一张，至少为1）
+     * @return stackCount无效时返回false
+     */
+    bool init(const std::vector<CardPosition>& playfieldPositions, int stackCount);
+    
+    /**
+     * @brief 使用已有关卡的布局（忽略其中的牌面）
+     * @param levelConfig 关卡配置
+     * @return 关卡没有备用牌堆卡牌时返回false
+     */
+    bool initFromLevel(const LevelConfig& levelConfig);
+    
+    /**
+     * @brief 生成若干座并排的金字塔布局
+     * @param peakCount 金字塔数量
+     * @param rowCount 每座金字塔的行数（第r行有r+1张卡牌，下一行压住上一行相邻的两张）
+     * @param stackCount 备用牌堆卡牌数量
+     * @return 参数无效时返回false
+     */
+    bool initPeaks(int peakCount, int rowCount, int stackCount);
+    
+    /**
+     * @brief 获取主牌区卡牌数量
+     */
+    int getPlayfieldCount() const { return static_cast<int>(_playfieldPositions.size()); }
+    
+    /**
+     * @brief 获取主牌区卡牌位置（按绘制顺序）
+     */
+    const std::vector<CardPosition>& getPlayfieldPositions() const { return _playfieldPositions; }
+    
+    /**
+     * @brief 获取备用牌堆卡牌数量
+     */
+    int getStackCount() const { return _stackCount; }
+    
+    /**
+     * @brief 获取被index处卡牌直接压住的卡牌下标
+     */
+    void getCoveredCards(int index, const int** outBegin, const int** outEnd) const;
+    
+    /**
+     * @brief 获取直接压住index处卡牌的卡牌下标
+     */
+    void getCoveringCards(int index, const int** outBegin, const int** outEnd) const;
+    
+private:
+    std::vector<CardPosition> _playfieldPositions;  // 主牌区卡牌位置（按绘制顺序）
+    int _stackCount;                                // 备用牌堆卡牌数量
+    std::vector<int> _coveredOffsets;               // 按下标的被压住卡牌起始位置（长度为卡牌数+1）
+    std::vector<int> _coveredIndices;               // 被压住的卡牌下标
+    std::vector<int> _coveringOffsets;              // 按下标的压住它的卡牌起始位置（长度为卡牌数+1）
+    std::vector<int> _coveringIndices;              // 压住它的卡牌下标
+};
+
+#endif // __LEVEL_LAYOUT_TEMPLATE_H__
@@ -0,0 +1,34 @@
+#ifndef __LEVEL_LOAD_INPUT_H__
+#define __LEVEL_LOAD_INPUT_H__
+
+#include "LevelLayoutTemplate.h"
+#include "LevelPack.h"
+#include <cstdint>
+#include <string>
+
+/**
+ * @struct LevelLoadInput
+ * @brief 生成一个关卡所需的全部输入
+ * @details 由主线程准备（查找关卡包、通过引擎读取JSON文件），之后只包含内存数据，
+ *          工作线程只做解析和生成，不访问文件系统和引擎
+ *          按关卡包、JSON、按种子生成的顺序尝试，前一种不可用或失败时使用下一种
+ */
+struct LevelLoadInput
+{
+    int levelId;                        // 关卡ID
+    LevelView packLevel;                // 关卡包中的关卡（所属LevelPack需在生成完成前保持有效）
+    std::string json;                   // 关卡JSON文件内容（没有时为空）
+    const LevelLayoutTemplate* layout;  // 按种子生成时使用的布局模板（不生成时为nullptr）
+    uint64_t seed;                      // 按种子生成时的种子
+    float difficulty;                   // 按种子生成时的难度（0~1）
+    
+    LevelLoadInput()
+        : levelId(0)
+        , layout(nullptr)
+        , seed(0)
+        , difficulty(0.0f)
+    {
+    }
+};
+
+#endif // __LEVEL_LOAD_INPUT_H__
@@ -0,0 +1,132 @@
+#include "LevelPack.h"
+#include <cstring>
+
+const char LevelPack::kMagic[4] = { 'L', 'P', 'A', 'K' };
+
+static_assert(sizeof(LevelPackHeader) == 16, "LevelPackHeader layout");
+static_assert(sizeof(LevelPackEntry) == 16, "LevelPackEntry layout");
+static_assert(sizeof(LevelPackCard) == 12, "LevelPackCard layout");
+
+namespace {
+
+bool isLittleEndianHost()
+{
+    const uint16_t probe = 1;
+    return *reinterpret_cast<const uint8_t*>(&probe) == 1;
+}
+
+} // namespace
+
+LevelConfig* LevelView::createLevelConfig() const
+{
+    if (!isValid()) {
+        return nullptr;
+    }
+    
+    LevelConfig* config = new LevelConfig();
+    config->setLevelId(getLevelId());
+    for (int i = 0; i < getPlayfieldCount(); i++) {
+        config->addPlayfieldCard(getPlayfieldCard(i));
+    }
+    for (int i = 0; i < getStackCount(); i++) {
+        config->addStackCard(getStackCard(i));
+    }
+    return config;
+}
+
+CardConfig LevelView::toCardConfig(const LevelPackCard& card)
+{
+    CardFaceType face = (card.face >= 0 && card.face < CFT_NUM_CARD_FACE_TYPES)
+        ? static_cast<CardFaceType>(card.face) : CFT_NONE;
+    CardSuitType suit = (card.suit >= 0 && card.suit < CST_NUM_CARD_SUIT_TYPES)
+        ? static_cast<CardSuitType>(card.suit) : CST_NONE;
+    return CardConfig(face, suit, CardPosition(card.x, card.y));
+}
+
+LevelPack* LevelPack::create(const void* data, size_t size, const ReleaseFunc& release)
+{
+    LevelPack* pack = new LevelPack(data, size, release);
+    if (!pack->validate()) {
+        delete pack;
+        return nullptr;
+    }
+    return pack;
+}
+
+LevelPack::LevelPack(const void* data, size_t size, const ReleaseFunc& release)
+    : _data(static_cast<const uint8_t*>(data))
+    , _size(size)
+    , _header(nullptr)
+    , _entries(nullptr)
+    , _release(release)
+{
+    if (_data && _size >= sizeof(LevelPackHeader)) {
+        _header = reinterpret_cast<const LevelPackHeader*>(_data);
+        _entries = reinterpret_cast<const LevelPackEntry*>(_data + sizeof(LevelPackHeader));
+    }
+}
+
+LevelPack::~LevelPack()
+{
+    if (_release) {
+        _release();
+    }
+}
+
+LevelView LevelPack::getLevel(int index) const
+{
+    if (index < 0 || index >= getLevelCount()) {
+        return LevelView();
+    }
+    
+    const LevelPackEntry* entry = &_entries[index];
+    return LevelView(entry, reinterpret_cast<const LevelPackCard*>(_data + entry->cardOffset));
+}
+
+LevelView LevelPack::findLevel(int levelId) const
+{
+    int low = 0;
+    int high = getLevelCount() - 1;
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        int midId = _entries[mid].levelId;
+        if (midId == levelId) {
+            return getLevel(mid);
+        }
+        if (midId < levelId) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return LevelView();
+}
+
+bool LevelPack::validate() const
+{
+    // 格式按小端存储，直接映射到结构体使用
+    if (!_header || !isLittleEndianHost() || (reinterpret_cast<uintptr_t>(_data) & 3) != 0) {
+        return false;
+    }
+    if (memcmp(_header->magic, kMagic, sizeof(kMagic)) != 0 || _header->version != kVersion) {
+        return false;
+    }
+    
+    uint64_t indexEnd = sizeof(LevelPackHeader) + static_cast<uint64_t>(_header->levelCount) * sizeof(LevelPackEntry);
+    if (indexEnd > _size) {
+        return false;
+    }
+    
+    for (uint32_t i = 0; i < _header->levelCount; i++) {
+        const LevelPackEntry& entry = _entries[i];
+        uint64_t cardsEnd = static_cast<uint64_t>(entry.cardOffset)
+            + (static_cast<uint64_t>(entry.playfieldCount) + entry.stackCount) * sizeof(LevelPackCard);
+        if (entry.cardOffset < indexEnd || (entry.cardOffset & 3) != 0 || cardsEnd > _size) {
+            return false;
+        }
+        if (i > 0 && _entries[i - 1].levelId >= entry.levelId) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,174 @@
+#ifndef __LEVEL_PACK_H__
+#define __LEVEL_PACK_H__
+
+#include "LevelConfig.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+/**
+ * @file LevelPack.h
+ * @brief 二进制关卡包格式与只读视图
+ * @details 一个关卡包文件包含多个关卡，所有字段为小端、4字节对齐：
+ *          [LevelPackHeader][LevelPackEntry x levelCount（按关卡ID升序）][LevelPackCard ...]
+ *          每个关卡的卡牌连续存放，先主牌区后备用牌堆
+ *          文件内容直接映射到内存使用，读取关卡时不解析、不复制
+ */
+
+/**
+ * @struct LevelPackHeader
+ * @brief 关卡包文件头（16字节）
+ */
+struct LevelPackHeader
+{
+    char magic[4];          // 文件标识"LPAK"
+    uint32_t version;       // 格式版本
+    uint32_t levelCount;    // 关卡数量
+    uint32_t reserved;      // 保留，写0
+};
+
+/**
+ * @struct LevelPackEntry
+ * @brief 关卡索引项（16字节）
+ */
+struct LevelPackEntry
+{
+    int32_t levelId;            // 关卡ID
+    uint32_t cardOffset;        // 第一张卡牌相对文件开头的字节偏移
+    uint16_t playfieldCount;    // 主牌区卡牌数量
+    uint16_t stackCount;        // 备用牌堆卡牌数量
+    uint32_t reserved;          // 保留，写0
+};
+
+/**
+ * @struct LevelPackCard
+ * @brief 卡牌记录（12字节）
+ */
+struct LevelPackCard
+{
+    float x;            // 位置X坐标
+    float y;            // 位置Y坐标
+    int8_t face;        // 牌面（CardFaceType）
+    int8_t suit;        // 花色（CardSuitType）
+    uint16_t reserved;  // 保留，写0
+};
+
+/**
+ * @class LevelView
+ * @brief 关卡包中单个关卡的只读视图
+ * @details 只持有指向关卡包内存的指针，可按值传递；所属LevelPack释放后失效
+ */
+class LevelView
+{
+public:
+    LevelView()
+        : _entry(nullptr)
+        , _cards(nullptr)
+    {
+    }
+    
+    LevelView(const LevelPackEntry* entry, const LevelPackCard* cards)
+        : _entry(entry)
+        , _cards(cards)
+    {
+    }
+    
+    bool isValid() const { return _entry != nullptr; }
+    int getLevelId() const { return _entry->levelId; }
+    int getPlayfieldCount() const { return _entry->playfieldCount; }
+    int getStackCount() const { return _entry->stackCount; }
+    
+    /**
+     * @brief 获取主牌区第index张卡牌配置
+     */
+    CardConfig getPlayfieldCard(int index) const { return toCardConfig(_cards[index]); }
+    
+    /**
+     * @brief 获取备用牌堆第index张卡牌配置
+     */
+    CardConfig getStackCard(int index) const { return toCardConfig(_cards[_entry->playfieldCount + index]); }
+    
+    /**
+     * @brief 复制为关卡配置（编辑或需要长期持有时使用）
+     * @return 关卡配置指针（由调用者释放）
+     */
+    LevelConfig* createLevelConfig() const;
+    
+private:
+    static CardConfig toCardConfig(const LevelPackCard& card);
+    
+private:
+    const LevelPackEntry* _entry;   // 索引项
+    const LevelPackCard* _cards;    // 该关卡的第一张卡牌
+};
+
+/**
+ * @class LevelPack
+ * @brief 已加载的关卡包
+ * @details 由LevelPackLoader创建，打开时只校验文件头和索引范围，
+ *          关卡数据在使用时直接从内存读取
+ */
+class LevelPack
+{
+public:
+    /**
+     * @brief 文件标识与当前格式版本
+     */
+    static const char kMagic[4];
+    static const uint32_t kVersion = 1;
+    
+    /**
+     * @brief 内存释放函数类型（关卡包析构时调用）
+     */
+    using ReleaseFunc = std::function<void()>;
+    
+    /**
+     * @brief 在一块内存上创建关卡包
+     * @param data 关卡包内容（至少4字节对齐，在关卡包析构前保持有效）
+     * @param size 字节数
+     * @param release 析构时调用的释放函数（创建失败时立即调用），可为空
+     * @return 关卡包指针（由调用者释放），格式错误时返回nullptr
+     */
+    static LevelPack* create(const void* data, size_t size, const ReleaseFunc& release);
+    
+    /**
+     * @brief 析构函数（调用释放函数）
+     */
+    ~LevelPack();
+    
+    /**
+     * @brief 获取关卡数量
+     */
+    int getLevelCount() const { return static_cast<int>(_header->levelCount); }
+    
+    /**
+     * @brief 按序号获取关卡（序号按关卡ID升序）
+     */
+    LevelView getLevel(int index) const;
+    
+    /**
+     * @brief 按关卡ID查找关卡（二分查找）
+     * @return 不存在时返回无效视图
+     */
+    LevelView findLevel(int levelId) const;
+    
+private:
+    LevelPack(const void* data, size_t size, const ReleaseFunc& release);
+    
+    LevelPack(const LevelPack&) = delete;
+    LevelPack& operator=(const LevelPack&) = delete;
+    
+    /**
+     * @brief 校验文件头、索引和每个关卡的卡牌范围
+     */
+    bool validate() const;
+    
+private:
+    const uint8_t* _data;                   // 关卡包内容
+    size_t _size;                           // 字节数
+    const LevelPackHeader* _header;         // 文件头
+    const LevelPackEntry* _entries;         // 索引
+    ReleaseFunc _release;                   // 释放函数
+};
+
+#endif // __LEVEL_PACK_H__
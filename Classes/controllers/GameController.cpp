@@ -1,82 +1,293 @@
 #include "GameController.h"
 #include "../configs/loaders/LevelConfigLoader.h"
-#include "../services/GameModelFromLevelGenerator.h"
+#include "../configs/loaders/LevelPackLoader.h"
+#include "../services/GameRulesService.h"
+#include "../services/LevelBuildService.h"
+#include "../utils/CardPositionConvert.h"
+#include "../utils/CoreLog.h"
+#include "../utils/DrawCallCounter.h"
+#include "../utils/TraceProfiler.h"
+#include "../AppDelegate.h"
+#include <algorithm>
 
 USING_NS_CC;
 
+// 发布版本使用的二进制关卡包（由LevelPackTool从JSON关卡转换）
+static const char* kLevelPackPath = "level/levels.pack";
+
+// 开始关卡后在后台预加载的后续关卡数量
+static const int kPrefetchLevelCount = 2;
+
+// 按种子生成的关卡：布局（金字塔数、行数、备用牌数）、种子基数和难度曲线
+static const int kProceduralPeakCount = 3;
+static const int kProceduralRowCount = 3;
+static const int kProceduralStackCount = 16;
+static const uint64_t kProceduralSeedBase = 0x5EED000000000000ULL;
+static const float kProceduralBaseDifficulty = 0.3f;
+static const float kProceduralDifficultyStep = 0.02f;
+static const float kProceduralMaxDifficulty = 0.9f;
+
+// 自动存档日志文件名（位于可写目录）
+static const char* kSaveJournalFileName = "autosave.journal";
+
+// 最近一局的回放文件名（位于可写目录，用于重现玩家反馈的问题）
+static const char* kReplayFileName = "last_replay.rpl";
+
 GameController::GameController()
     : _gameModel(nullptr)
     , _undoModel(nullptr)
     , _gameView(nullptr)
+    , _cardViewPool(nullptr)
     , _undoManager(nullptr)
+    , _levelPack(nullptr)
+    , _prefetchManager(nullptr)
+    , _saveJournalManager(nullptr)
+    , _replayRecorderManager(nullptr)
+    , _backgroundListener(nullptr)
 {
 }
 
 GameController::~GameController()
 {
+    // 先停止预加载线程，它可能正在读取关卡包
+    CC_SAFE_DELETE(_prefetchManager);
+    CC_SAFE_DELETE(_levelPack);
+    if (_backgroundListener) {
+        Director::getInstance()->getEventDispatcher()->removeEventListener(_backgroundListener);
+    }
+    CC_SAFE_DELETE(_saveJournalManager);
+    CC_SAFE_DELETE(_replayRecorderManager);
     CC_SAFE_DELETE(_gameModel);
     CC_SAFE_DELETE(_undoModel);
     CC_SAFE_DELETE(_undoManager);
-    // _gameView由Cocos2d-x自动管理，不需要手动delete
+    // _gameView由Cocos2d-x自动管理，不需要手动delete；池中只有已从场景移除的空闲视图
+    CC_SAFE_DELETE(_cardViewPool);
 }
 
 bool GameController::startGame(int levelId, Node* parentNode)
 {
+    TRACE_ZONE("GameController::startGame");
+    
     if (!parentNode) {
         CCLOG("GameController: parentNode is null");
         return false;
     }
     
-    // 加载关卡配置
-    LevelConfig* levelConfig = LevelConfigLoader::loadLevelConfig(levelId);
-    if (!levelConfig) {
-        CCLOG("GameController: Failed to load level config for level %d", levelId);
+    if (!_prefetchManager) {
+        initLevelLoading();
+        initSaveJournal();
+        initCardViewPool();
+    }
+    releaseGame();
+    
+    // 输出预加载线程暂存的核心库日志
+    CoreLog::flush();
+    
+    // 已预加载好的关卡直接使用，否则在主线程加载
+    GameModel* gameModel = _prefetchManager->takeGameModel(levelId);
+    if (!gameModel) {
+        gameModel = loadGameModel(levelId);
+    }
+    
+    // 切换预加载窗口，跳关时未完成的旧请求被取消
+    _prefetchManager->prefetchLevels(levelId + 1, kPrefetchLevelCount);
+    
+    if (!initGame(gameModel, new UndoModel(), parentNode)) {
+        return false;
+    }
+    
+    // 新关卡的初始状态作为自动存档的基础快照和回放的起始状态
+    _saveJournalManager->startJournal(levelId, _gameModel, _undoModel);
+    _replayRecorderManager->startRecording(levelId, _gameModel, _undoModel,
+                                           toCardPosition(_gameView->getTrayPosition()));
+    return true;
+}
+
+bool GameController::resumeGame(Node* parentNode)
+{
+    TRACE_ZONE("GameController::resumeGame");
+    
+    if (!parentNode) {
+        CCLOG("GameController: parentNode is null");
         return false;
     }
     
-    bool success = initGame(levelConfig, parentNode);
+    if (!_prefetchManager) {
+        initLevelLoading();
+        initSaveJournal();
+        initCardViewPool();
+    }
+    releaseGame();
+    
+    CoreLog::flush();
+    
+    // 读取基础快照并重放之后的操作记录，日志继续用于之后的自动存档
+    GameModel* gameModel = new GameModel();
+    UndoModel* undoModel = new UndoModel();
+    int levelId = 0;
+    if (!_saveJournalManager->restoreJournal(gameModel, undoModel, &levelId)) {
+        delete gameModel;
+        delete undoModel;
+        return false;
+    }
+    CCLOG("GameController: Resumed level %d with %d undo actions", levelId, undoModel->getActionCount());
+    
+    _prefetchManager->prefetchLevels(levelId + 1, kPrefetchLevelCount);
+    
+    if (!initGame(gameModel, undoModel, parentNode)) {
+        return false;
+    }
+    
+    // 回放从恢复后的状态开始录制
+    _replayRecorderManager->startRecording(levelId, _gameModel, _undoModel,
+                                           toCardPosition(_gameView->getTrayPosition()));
+    return true;
+}
+
+void GameController::releaseGame()
+{
+    // 切换关卡前保存未完成的一局（已胜利的一局在胜利时已保存）
+    if (_gameModel && !_gameModel->isGameWon()) {
+        saveReplay();
+    }
+    if (_gameView) {
+        // 卡牌视图放回对象池，随GameView一起销毁的只有各区域和按钮
+        _gameView->recycleCardViews();
+        _gameView->removeFromParent();
+        _gameView = nullptr;
+    }
+    CC_SAFE_DELETE(_gameModel);
+    CC_SAFE_DELETE(_undoModel);
+    CC_SAFE_DELETE(_undoManager);
+}
+
+void GameController::initLevelLoading()
+{
+    FileUtils* fileUtils = FileUtils::getInstance();
+    std::string packPath = fileUtils->fullPathForFilename(kLevelPackPath);
+    if (!packPath.empty()) {
+        // 本地文件直接映射；APK内的资源无法映射，读入内存后打开
+        _levelPack = LevelPackLoader::loadFromFile(packPath);
+        if (!_levelPack) {
+            _levelPack = LevelPackLoader::loadFromBuffer(fileUtils->getStringFromFile(packPath));
+        }
+    }
+    
+    _proceduralLayout.initPeaks(kProceduralPeakCount, kProceduralRowCount, kProceduralStackCount);
+    
+    _prefetchManager = new LevelPrefetchManager();
+    _prefetchManager->init([this](int levelId, LevelLoadInput* input) {
+        return prepareLevelInput(levelId, input);
+    });
+}
+
+void GameController::initSaveJournal()
+{
+    _saveJournalManager = new SaveJournalManager();
+    _saveJournalManager->init(FileUtils::getInstance()->getWritablePath() + kSaveJournalFileName);
+    _replayRecorderManager = new ReplayRecorderManager();
+    
+    // 操作记录只在每kSyncInterval条时fsync，进入后台前把剩余记录写入存储设备；
+    // 应用可能在后台被结束，同时保存回放
+    _backgroundListener = Director::getInstance()->getEventDispatcher()->addCustomEventListener(
+        AppDelegate::kEventDidEnterBackground, [this](EventCustom*) {
+            _saveJournalManager->sync();
+            saveReplay();
+        });
+}
+
+void GameController::initCardViewPool()
+{
+    // 按种子生成的关卡卡牌最多（底牌取自备用牌堆），预热后手工关卡和生成关卡都不需要在关卡开始时创建视图
+    _cardViewPool = new CardViewPool();
+    _cardViewPool->prewarm(_proceduralLayout.getPlayfieldCount() + _proceduralLayout.getStackCount());
+}
+
+void GameController::saveReplay()
+{
+    if (!_replayRecorderManager || !_replayRecorderManager->isRecording() || !_gameModel) {
+        return;
+    }
+    
+    std::string filePath = FileUtils::getInstance()->getWritablePath() + kReplayFileName;
+    if (!_replayRecorderManager->saveReplay(filePath, _gameModel, _undoModel)) {
+        CCLOG("GameController: Failed to save replay");
+    }
+}
+
+bool GameController::prepareLevelInput(int levelId, LevelLoadInput* input) const
+{
+    input->levelId = levelId;
+    if (_levelPack) {
+        input->packLevel = _levelPack->findLevel(levelId);
+    }
+    if (!input->packLevel.isValid()) {
+        input->json = LevelConfigLoader::readLevelFile(levelId);
+    }
     
-    delete levelConfig;
-    return success;
+    // 没有手工关卡时按种子生成，同一关卡ID在所有设备上得到相同的牌局
+    input->layout = &_proceduralLayout;
+    input->seed = kProceduralSeedBase + static_cast<uint64_t>(levelId);
+    input->difficulty = std::min(kProceduralMaxDifficulty,
+                                 kProceduralBaseDifficulty + kProceduralDifficultyStep * levelId);
+    return true;
 }
 
-bool GameController::initGame(const LevelConfig* levelConfig, Node* parentNode)
+GameModel* GameController::loadGameModel(int levelId) const
 {
+    TRACE_ZONE("GameController::loadGameModel");
+    
+    LevelLoadInput input;
+    prepareLevelInput(levelId, &input);
+    GameModel* gameModel = LevelBuildService::buildGameModel(input);
+    if (!gameModel) {
+        CCLOG("GameController: Failed to load level config for level %d", levelId);
+    }
+    return gameModel;
+}
+
+bool GameController::initGame(GameModel* gameModel, UndoModel* undoModel, Node* parentNode)
+{
+    TRACE_ZONE("GameController::initGame");
+    
     // 生成游戏数据模型
-    _gameModel = GameModelFromLevelGenerator::generateGameModel(levelConfig);
+    _gameModel = gameModel;
+    _undoModel = undoModel;
     if (!_gameModel) {
         CCLOG("GameController: Failed to generate game model");
         return false;
     }
     
-    // 创建撤销数据模型
-    _undoModel = new UndoModel();
-    
     // 创建撤销管理器
     _undoManager = new UndoManager();
     _undoManager->init(_undoModel);
     
     // 设置撤销动画回调
     _undoManager->setUndoAnimationCallback([this](const UndoAction& action) {
-        // 根据撤销类型播放相应的动画
-        Vec2 fromPos = action.fromPosition;
-        Vec2 toPos = action.toPosition;
+        // 根据撤销类型播放相应的动画（撤销记录不保存位置，模型已恢复到操作前的位置）
+        const CardModel* fromCard = _gameModel->getCardById(action.fromCardId);
+        const CardModel* toCard = _gameModel->getCardById(action.toCardId);
+        if (!fromCard || !toCard) {
+            return;
+        }
+        Vec2 fromPos = toVec2(fromCard->getPosition());
+        Vec2 toPos = toVec2(toCard->getPosition());
         
         switch (action.type) {
             case UAT_REPLACE_TRAY_FROM_STACK:
                 // 动画：fromCard从tray位置移回stack位置
-                _gameView->playCardMoveAnimation(action.fromCardId, fromPos, 0.3f);
+                _gameView->playCardMoveAnimation(action.fromCardId, _gameView->getStackPosition(), 0.3f);
                 // 动画：toCard从不可见移回tray位置
                 _gameView->playCardMoveAnimation(action.toCardId, toPos, 0.3f);
                 break;
-                
+            
             case UAT_REPLACE_TRAY_FROM_PLAYFIELD:
                 // 动画：fromCard从tray位置移回playfield位置
                 _gameView->playCardMoveAnimation(action.fromCardId, fromPos, 0.3f);
                 // 动画：toCard从不可见移回tray位置
                 _gameView->playCardMoveAnimation(action.toCardId, toPos, 0.3f);
                 break;
-                
+            
             default:
                 break;
         }
@@ -85,7 +296,7 @@ bool GameController::initGame(const LevelConfig* levelConfig, Node* parentNode)
     });
     
     // 创建游戏视图
-    _gameView = GameView::create();
+    _gameView = GameView::create(_cardViewPool);
     if (!_gameView) {
         CCLOG("GameController: Failed to create game view");
         return false;
@@ -95,6 +306,9 @@ bool GameController::initGame(const LevelConfig* levelConfig, Node* parentNode)
     
     // 初始化游戏视图
     _gameView->initGameView(_gameModel);
+    CCLOG("GameController: Card view pool hits %d, misses %d, created %d",
+          _cardViewPool->getHitCount(), _cardViewPool->getMissCount(), _cardViewPool->getCreatedCount());
+    _cardViewPool->resetStats();
     
     // 设置视图回调
     _gameView->setCardClickCallback([this](int cardId) {
@@ -109,9 +323,17 @@ bool GameController::initGame(const LevelConfig* levelConfig, Node* parentNode)
         handleUndoClick();
     });
     
+    _gameView->setRedoButtonClickCallback([this]() {
+        handleRedoClick();
+    });
+    
     // 初始化撤销按钮状态
     updateUndoButtonState();
     
+    // 每关重新统计单帧最大绘制调用数
+    CCLOG("GameController: Max draw calls in previous level: %d", DrawCallCounter::getMaxDrawCalls());
+    DrawCallCounter::resetMaxDrawCalls();
+    
     CCLOG("GameController: Game started successfully");
     return true;
 }
@@ -122,6 +344,9 @@ void GameController::handleCardClick(int cardId)
         return;
     }
     
+    // 被规则拒绝的点击同样记录，回放时按相同规则忽略
+    _replayRecorderManager->recordInput(RIT_CARD_CLICK, cardId, _gameModel, _undoModel);
+    
     CardModel* card = _gameModel->getCardById(cardId);
     if (!card) {
         CCLOG("GameController: Card %d not found", cardId);
@@ -133,15 +358,15 @@ void GameController::handleCardClick(int cardId)
         case CL_PLAYFIELD:
             handlePlayfieldCardClick(cardId);
             break;
-            
+        
         case CL_TRAY:
             // 底牌本身不可点击，忽略
             break;
-            
+        
         case CL_STACK:
             // 备用牌堆的牌不可直接点击，通过handleStackClick处理
             break;
-            
+        
         default:
             break;
     }
@@ -159,6 +384,9 @@ void GameController::handlePlayfieldCardClick(int cardId)
     // 检查是否胜利
     if (checkGameWin()) {
         CCLOG("GameController: You Win!");
+        // 关卡已完成，不再需要恢复
+        _saveJournalManager->discard();
+        saveReplay();
         // TODO: 显示胜利界面
     }
 }
@@ -169,6 +397,8 @@ void GameController::handleStackClick()
         return;
     }
     
+    _replayRecorderManager->recordInput(RIT_STACK_CLICK, -1, _gameModel, _undoModel);
+    
     // 检查备用牌堆是否还有牌
     if (_gameModel->getStackCardIds().empty()) {
         CCLOG("GameController: Stack is empty");
@@ -180,47 +410,46 @@ void GameController::handleStackClick()
 
 void GameController::handleUndoClick()
 {
+    if (_gameModel) {
+        _replayRecorderManager->recordInput(RIT_UNDO_CLICK, -1, _gameModel, _undoModel);
+    }
     performUndo();
 }
 
-void GameController::replaceTrayFromStack()
+void GameController::handleRedoClick()
 {
-    if (!_gameModel || !_undoManager) {
-        return;
+    if (_gameModel) {
+        _replayRecorderManager->recordInput(RIT_REDO_CLICK, -1, _gameModel, _undoModel);
     }
-    
-    // 获取当前底牌和备用牌堆顶牌
-    int oldTrayCardId = _gameModel->getTrayCardId();
-    int newTrayCardId = _gameModel->popFromStack();
-    
-    if (newTrayCardId == -1) {
-        CCLOG("GameController: No cards in stack");
+    if (!performRedo()) {
         return;
     }
     
-    CardModel* oldTrayCard = _gameModel->getCardById(oldTrayCardId);
-    CardModel* newTrayCard = _gameModel->getCardById(newTrayCardId);
-    
-    if (!oldTrayCard || !newTrayCard) {
+    // 重做的可能正是最后一次匹配
+    if (checkGameWin()) {
+        CCLOG("GameController: You Win!");
+        _saveJournalManager->discard();
+        saveReplay();
+    }
+}
+
+void GameController::replaceTrayFromStack()
+{
+    if (!_gameModel || !_undoManager) {
         return;
     }
     
-    // 记录撤销操作（在修改数据前）
+    // 更新数据模型（规则由核心库实现，撤销记录在修改数据前生成）
+    Vec2 trayPos = _gameView->getTrayPosition();
     UndoAction undoAction;
-    undoAction.type = UAT_REPLACE_TRAY_FROM_STACK;
-    undoAction.fromCardId = newTrayCardId;
-    undoAction.toCardId = oldTrayCardId;
-    undoAction.fromPosition = _gameView->getStackPosition();  // 备用牌堆位置
-    undoAction.toPosition = oldTrayCard->getPosition();       // 当前底牌位置
+    if (!GameRulesService::replaceTrayFromStack(_gameModel, toCardPosition(trayPos), &undoAction)) {
+        CCLOG("GameController: No cards in stack");
+        return;
+    }
     _undoManager->recordAction(undoAction);
+    _saveJournalManager->appendMove(undoAction, toCardPosition(trayPos), _gameModel, _undoModel);
     
-    // 更新数据模型
-    Vec2 trayPos = _gameView->getTrayPosition();
-    
-    newTrayCard->setLocation(CL_TRAY);
-    newTrayCard->setFlipped(true);
-    newTrayCard->setPosition(trayPos);
-    _gameModel->setTrayCardId(newTrayCardId);
+    int newTrayCardId = undoAction.fromCardId;
     
     // 播放动画
     _gameView->playCardMoveAnimation(newTrayCardId, trayPos, 0.3f);
@@ -237,36 +466,20 @@ void GameController::replaceTrayFromPlayfield(int playfieldCardId)
         return;
     }
     
-    CardModel* playfieldCard = _gameModel->getCardById(playfieldCardId);
-    int oldTrayCardId = _gameModel->getTrayCardId();
-    CardModel* oldTrayCard = _gameModel->getCardById(oldTrayCardId);
-    
-    if (!playfieldCard || !oldTrayCard) {
+    // 更新数据模型（规则由核心库实现，撤销记录在修改数据前生成）
+    CardPosition trayPos = toCardPosition(_gameView->getTrayPosition());
+    UndoAction undoAction;
+    if (!GameRulesService::replaceTrayFromPlayfield(_gameModel, playfieldCardId, trayPos, &undoAction)) {
         return;
     }
-    
-    // 记录撤销操作（在修改数据前）
-    UndoAction undoAction;
-    undoAction.type = UAT_REPLACE_TRAY_FROM_PLAYFIELD;
-    undoAction.fromCardId = playfieldCardId;
-    undoAction.toCardId = oldTrayCardId;
-    undoAction.fromPosition = playfieldCard->getPosition();
-    undoAction.toPosition = oldTrayCard->getPosition();
     _undoManager->recordAction(undoAction);
-    
-    // 更新数据模型
-    Vec2 trayPos = _gameView->getTrayPosition();
-    
-    // 从主牌区移除
-    _gameModel->removeFromPlayfield(playfieldCardId);
-    
-    // 将主牌区卡牌移动到底牌堆
-    playfieldCard->setLocation(CL_TRAY);
-    playfieldCard->setPosition(trayPos);
-    _gameModel->setTrayCardId(playfieldCardId);
+    _saveJournalManager->appendMove(undoAction, trayPos, _gameModel, _undoModel);
     
     // 播放动画
-    _gameView->playMatchAnimation(playfieldCardId, oldTrayCardId);
+    _gameView->playMatchAnimation(playfieldCardId, undoAction.toCardId);
+    
+    // 被压住的卡牌可能因此露出
+    updateClickableCards();
     
     // 更新撤销按钮状态
     updateUndoButtonState();
@@ -276,6 +489,8 @@ void GameController::replaceTrayFromPlayfield(int playfieldCardId)
 
 void GameController::performUndo()
 {
+    TRACE_ZONE("GameController::performUndo");
+    
     if (!_undoManager || !_gameModel) {
         return;
     }
@@ -285,7 +500,52 @@ void GameController::performUndo()
         return;
     }
     
-    _undoManager->performUndo(_gameModel);
+    if (_undoManager->performUndo(_gameModel)) {
+        _saveJournalManager->appendUndo(_gameModel, _undoModel);
+    }
+    
+    // 放回主牌区的卡牌重新压住下层卡牌
+    updateClickableCards();
+}
+
+bool GameController::performRedo()
+{
+    TRACE_ZONE("GameController::performRedo");
+    
+    if (!_undoManager || !_gameModel) {
+        return false;
+    }
+    
+    if (!_undoManager->canRedo()) {
+        CCLOG("GameController: No action to redo");
+        return false;
+    }
+    
+    // 与正常操作相同：通过规则服务修改模型；自动存档记为重做，恢复后之后的可重做记录仍然保留
+    Vec2 trayPos = _gameView->getTrayPosition();
+    UndoAction action;
+    if (!_undoManager->performRedo(_gameModel, toCardPosition(trayPos), &action)) {
+        return false;
+    }
+    _saveJournalManager->appendRedo(action, toCardPosition(trayPos), _gameModel, _undoModel);
+    
+    // 播放动画
+    switch (action.type) {
+        case UAT_REPLACE_TRAY_FROM_STACK:
+            _gameView->playCardMoveAnimation(action.fromCardId, trayPos, 0.3f);
+            break;
+        
+        case UAT_REPLACE_TRAY_FROM_PLAYFIELD:
+            _gameView->playMatchAnimation(action.fromCardId, action.toCardId);
+            break;
+        
+        default:
+            break;
+    }
+    
+    updateClickableCards();
+    updateUndoButtonState();
+    return true;
 }
 
 void GameController::updateUndoButtonState()
@@ -293,25 +553,29 @@ void GameController::updateUndoButtonState()
     if (_gameView && _undoManager) {
         bool canUndo = _undoManager->canUndo();
         _gameView->updateUndoButton(canUndo);
+        _gameView->updateRedoButton(_undoManager->canRedo());
     }
 }
 
-bool GameController::canMatchWithTray(int cardId) const
+void GameController::updateClickableCards()
 {
-    if (!_gameModel) {
-        return false;
+    if (!_gameModel || !_gameView) {
+        return;
     }
     
-    CardModel* card = _gameModel->getCardById(cardId);
-    int trayCardId = _gameModel->getTrayCardId();
-    CardModel* trayCard = _gameModel->getCardById(trayCardId);
-    
-    if (!card || !trayCard) {
-        return false;
+    std::vector<int> changedIds;
+    _gameModel->takeClickableChanges(&changedIds);
+    for (int cardId : changedIds) {
+        const CardModel* card = _gameModel->getCardById(cardId);
+        if (card) {
+            _gameView->setCardClickable(cardId, card->isClickable());
+        }
     }
-    
-    // 检查是否可以匹配（牌面数值差1）
-    return card->canMatchWith(trayCard);
+}
+
+bool GameController::canMatchWithTray(int cardId) const
+{
+    return GameRulesService::canMatchWithTray(_gameModel, cardId);
 }
 
 bool GameController::checkGameWin()
@@ -5,8 +5,15 @@
 #include "../models/GameModel.h"
 #include "../models/UndoModel.h"
 #include "../views/GameView.h"
+#include "../views/CardViewPool.h"
 #include "../managers/UndoManager.h"
+#include "../managers/LevelPrefetchManager.h"
+#include "../managers/SaveJournalManager.h"
+#include "../managers/ReplayRecorderManager.h"
 #include "../configs/models/LevelConfig.h"
+#include "../configs/models/LevelLayoutTemplate.h"
+#include "../configs/models/LevelLoadInput.h"
+#include "../configs/models/LevelPack.h"
 
 /**
  * @class GameController
@@ -32,9 +39,18 @@ public:
      * @param levelId 关卡ID
      * @param parentNode 父节点，用于添加GameView
      * @return 是否成功开始游戏
+     * @details 可重复调用切换关卡；优先使用后台预加载好的关卡，
+     *          开始后在后台预加载之后的kPrefetchLevelCount个关卡
      */
     bool startGame(int levelId, cocos2d::Node* parentNode);
     
+    /**
+     * @brief 从自动存档日志恢复上次未完成的关卡
+     * @param parentNode 父节点，用于添加GameView
+     * @return 没有可恢复的存档时返回false，调用方应改为startGame
+     */
+    bool resumeGame(cocos2d::Node* parentNode);
+    
     /**
      * @brief 处理卡牌点击事件
      * @param cardId 卡牌ID
@@ -51,6 +67,11 @@ public:
      */
     void handleUndoClick();
     
+    /**
+     * @brief 处理重做按钮点击事件
+     */
+    void handleRedoClick();
+    
     /**
      * @brief 检查游戏是否胜利
      * @return 如果胜利返回true
@@ -60,11 +81,55 @@ public:
 private:
     /**
      * @brief 初始化游戏数据和视图
-     * @param levelConfig 关卡配置
+     * @param gameModel 生成的游戏数据模型（由控制器接管）
+     * @param undoModel 撤销数据模型（由控制器接管）
      * @param parentNode 父节点
      * @return 是否成功初始化
      */
-    bool initGame(const LevelConfig* levelConfig, cocos2d::Node* parentNode);
+    bool initGame(GameModel* gameModel, UndoModel* undoModel, cocos2d::Node* parentNode);
+    
+    /**
+     * @brief 释放当前关卡的数据和视图
+     */
+    void releaseGame();
+    
+    /**
+     * @brief 打开二进制关卡包并启动关卡预加载（首次开始游戏时调用）
+     */
+    void initLevelLoading();
+    
+    /**
+     * @brief 打开自动存档日志和回放录制，应用进入后台时同步日志并保存回放（首次开始游戏时调用）
+     */
+    void initSaveJournal();
+    
+    /**
+     * @brief 创建卡牌视图对象池并按关卡的卡牌数预热（首次开始游戏时调用）
+     */
+    void initCardViewPool();
+    
+    /**
+     * @brief 把当前录制的回放保存到可写目录（覆盖上一次的回放）
+     */
+    void saveReplay();
+    
+    /**
+     * @brief 准备关卡输入（只在主线程调用）
+     * @param levelId 关卡ID
+     * @param input 要填写的关卡输入
+     * @return 是否准备成功
+     * @details 优先使用关卡包，关卡包中没有该关卡时读取JSON关卡（编辑阶段），
+     *          同时填写按种子在_proceduralLayout上生成的参数（没有手工关卡时的无限关卡）
+     *          JSON文件通过引擎的FileUtils读取，因此不能在预加载线程中调用
+     */
+    bool prepareLevelInput(int levelId, LevelLoadInput* input) const;
+    
+    /**
+     * @brief 在主线程加载关卡并生成游戏数据模型（预加载未完成时使用）
+     * @param levelId 关卡ID
+     * @return 游戏数据模型（由调用者释放），加载失败返回nullptr
+     */
+    GameModel* loadGameModel(int levelId) const;
     
     /**
      * @brief 处理主牌区卡牌点击（匹配逻辑）
@@ -89,10 +154,21 @@ private:
     void performUndo();
     
     /**
-     * @brief 更新撤销按钮状态
+     * @brief 执行重做操作
+     * @return 没有可重做的操作或重做失败时返回false（模型不变）
+     */
+    bool performRedo();
+    
+    /**
+     * @brief 更新撤销和重做按钮状态
      */
     void updateUndoButtonState();
     
+    /**
+     * @brief 把模型中遮挡状态变化的卡牌同步到卡牌视图
+     */
+    void updateClickableCards();
+    
     /**
      * @brief 检查主牌区卡牌是否可以与底牌匹配
      * @param cardId 主牌区卡牌ID
@@ -104,7 +180,14 @@ private:
     GameModel* _gameModel;          // 游戏数据模型
     UndoModel* _undoModel;          // 撤销数据模型
     GameView* _gameView;            // 游戏视图
+    CardViewPool* _cardViewPool;    // 卡牌视图对象池（跨关卡复用卡牌视图）
     UndoManager* _undoManager;      // 撤销管理器
+    LevelPack* _levelPack;          // 二进制关卡包（没有时为nullptr）
+    LevelLayoutTemplate _proceduralLayout;  // 按种子生成关卡使用的布局模板
+    LevelPrefetchManager* _prefetchManager; // 关卡预加载管理器
+    SaveJournalManager* _saveJournalManager; // 自动存档日志管理器
+    ReplayRecorderManager* _replayRecorderManager; // 回放录制管理器
+    cocos2d::EventListenerCustom* _backgroundListener; // 应用进入后台事件监听
 };
 
 #endif // __GAME_CONTROLLER_H__ 
\ No newline at end of file
@@ -0,0 +1,447 @@
+#include "BatchSolverManager.h"
+#include "../services/LevelSolverSearch.h"
+#include "../utils/WorkStealingPool.h"
+#include <atomic>
+#include <chrono>
+
+namespace {
+
+int popCount(uint64_t bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(bits);
+#else
+    int count = 0;
+    while (bits) {
+        bits &= bits - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+} // namespace
+
+/**
+ * @class ConcurrentSolverTable
+ * @brief 多线程共享的无锁置换表
+ * @details 固定大小，每个桶两个条目：一个按剩余卡牌数优先保留，一个总是覆盖。每个条目由三个原子字组成：
+ *          lines、mask^mix(lines)、(关卡标记|最少翻牌|备用牌堆与底牌)^mix(第二个字)，
+ *          每个字都用前一个字的混合值编码（mix(0)不为0，lines为0时同样参与校验）。
+ *          并发写入造成的撕裂读（各字来自不同的写入）解码出的mask或aux是随机值，
+ *          与查询键不一致而按未命中处理；只有三个字属于同一次写入时才能解码出一致的条目（无锁哈希）
+ */
+class ConcurrentSolverTable
+{
+public:
+    explicit ConcurrentSolverTable(int sizeBits)
+        : _sizeBits(sizeBits)
+        , _entries(new Entry[(static_cast<size_t>(1) << sizeBits) * kBucketSize])
+    {
+    }
+    
+    ~ConcurrentSolverTable()
+    {
+        delete[] _entries;
+    }
+    
+    bool find(unsigned int levelTag, const SolverStateKey& key, SolverSubtreeResult* outResult) const
+    {
+        const Entry* bucket = bucketOf(levelTag, key);
+        for (int i = 0; i < kBucketSize; i++) {
+            uint64_t mask = 0;
+            uint64_t aux = 0;
+            uint64_t lines = 0;
+            if (bucket[i].read(&mask, &aux, &lines)
+                && mask == key.playfieldMask
+                && (aux >> 32) == levelTag
+                && (aux & 0xFFFF) == key.stackAndTray) {
+                outResult->winningLines = lines;
+                outResult->minStackDraws = static_cast<int>((aux >> 16) & 0xFFFF) - 1;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void store(unsigned int levelTag, const SolverStateKey& key, const SolverSubtreeResult& result)
+    {
+        uint64_t aux = (static_cast<uint64_t>(levelTag) << 32)
+            | (static_cast<uint64_t>(result.minStackDraws + 1) << 16)
+            | static_cast<uint64_t>(key.stackAndTray);
+        
+        // 第一个条目保留剩余卡牌最多（子树最大）的状态，第二个条目总是覆盖
+        Entry* bucket = bucketOf(levelTag, key);
+        uint64_t oldMask = 0;
+        uint64_t oldAux = 0;
+        uint64_t oldLines = 0;
+        Entry* target = &bucket[1];
+        if (!bucket[0].read(&oldMask, &oldAux, &oldLines)
+            || (oldAux >> 32) != levelTag
+            || remainingCards(oldMask, oldAux) <= remainingCards(key.playfieldMask, aux)) {
+            target = &bucket[0];
+        }
+        target->write(key.playfieldMask, aux, result.winningLines);
+    }
+    
+private:
+    struct Entry
+    {
+        std::atomic<uint64_t> lines;        // 获胜路线数量
+        std::atomic<uint64_t> maskCheck;    // 主牌区位掩码 ^ mix(lines)
+        std::atomic<uint64_t> auxCheck;     // 其余键与最少翻牌次数 ^ mix(maskCheck)
+        
+        Entry()
+        {
+            // 空条目同样编码（解码出的aux为0），全0的字不会被当作有效条目
+            write(0, 0, 0);
+        }
+        
+        /**
+         * @brief 读取条目，空条目返回false
+         */
+        bool read(uint64_t* outMask, uint64_t* outAux, uint64_t* outLines) const
+        {
+            uint64_t value = lines.load(std::memory_order_relaxed);
+            uint64_t maskWord = maskCheck.load(std::memory_order_relaxed);
+            uint64_t aux = auxCheck.load(std::memory_order_relaxed) ^ mix(maskWord);
+            if ((aux >> 32) == 0) {
+                return false;
+            }
+            *outMask = maskWord ^ mix(value);
+            *outAux = aux;
+            *outLines = value;
+            return true;
+        }
+        
+        void write(uint64_t mask, uint64_t aux, uint64_t value)
+        {
+            uint64_t maskWord = mask ^ mix(value);
+            lines.store(value, std::memory_order_relaxed);
+            maskCheck.store(maskWord, std::memory_order_relaxed);
+            auxCheck.store(aux ^ mix(maskWord), std::memory_order_relaxed);
+        }
+    };
+    
+    static const int kBucketSize = 2;
+    
+    /**
+     * @brief 校验用的混合函数（splitmix64终结函数，先异或非零常量使mix(0)不为0）
+     */
+    static uint64_t mix(uint64_t value)
+    {
+        uint64_t z = value ^ 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    
+    static int remainingCards(uint64_t mask, uint64_t aux)
+    {
+        return popCount(mask) + static_cast<int>((aux & 0xFFFF) >> 4);
+    }
+    
+    Entry* bucketOf(unsigned int levelTag, const SolverStateKey& key) const
+    {
+        uint64_t h = SolverStateKeyHash().hash64(key) ^ mix(levelTag);
+        return &_entries[static_cast<size_t>(h >> (64 - _sizeBits)) * kBucketSize];
+    }
+    
+private:
+    int _sizeBits;      // 桶数量的位数
+    Entry* _entries;    // 条目数组
+};
+
+namespace {
+
+// 搜索树拆分参数：只在浅层、剩余卡牌较多时拆分，避免任务过碎
+const int kMaxSplitDepth = 10;
+const int kMinSplitRemainingCards = 14;
+
+/**
+ * @class TaggedSolverTable
+ * @brief 绑定关卡标记的置换表视图（供SolverSearch使用）
+ */
+class TaggedSolverTable
+{
+public:
+    TaggedSolverTable(ConcurrentSolverTable* table, unsigned int levelTag)
+        : _table(table)
+        , _levelTag(levelTag)
+    {
+    }
+    
+    bool find(const SolverStateKey& key, SolverSubtreeResult* outResult) const
+    {
+        return _table->find(_levelTag, key, outResult);
+    }
+    
+    void store(const SolverStateKey& key, const SolverSubtreeResult& result)
+    {
+        _table->store(_levelTag, key, result);
+    }
+    
+private:
+    ConcurrentSolverTable* _table;
+    unsigned int _levelTag;
+};
+
+/**
+ * @struct LevelJob
+ * @brief 单个关卡的求解任务
+ */
+struct LevelJob
+{
+    WorkStealingPool* pool;                             // 线程池
+    TaggedSolverTable table;                            // 置换表视图
+    SolverDeal deal;                                    // 牌局数据
+    std::atomic<unsigned long long> nodesExpanded;      // 展开状态数
+    std::chrono::steady_clock::time_point startTime;    // 开始求解的时间
+    BatchSolveEntry* entry;                             // 输出结果
+    
+    LevelJob(WorkStealingPool* workerPool, ConcurrentSolverTable* sharedTable, unsigned int levelTag, BatchSolveEntry* output)
+        : pool(workerPool)
+        , table(sharedTable, levelTag)
+        , nodesExpanded(0)
+        , entry(output)
+    {
+    }
+};
+
+/**
+ * @struct SplitNode
+ * @brief 拆分出的搜索树节点，子节点全部完成后由最后一个子任务合并结果
+ */
+struct SplitNode
+{
+    LevelJob* job;                                      // 所属关卡
+    SplitNode* parent;                                  // 父节点（根节点为nullptr）
+    int slot;                                           // 在父节点结果数组中的下标
+    SolverStateKey key;                                 // 搜索状态
+    std::vector<SolverSubtreeResult> childResults;      // 子节点结果
+    std::vector<int> childCosts;                        // 到达子节点的翻牌消耗
+    std::atomic<int> pending;                           // 未完成的子节点数
+    
+    SplitNode(LevelJob* levelJob, SplitNode* parentNode, int slotIndex, const SolverStateKey& stateKey)
+        : job(levelJob)
+        , parent(parentNode)
+        , slot(slotIndex)
+        , key(stateKey)
+        , pending(0)
+    {
+    }
+};
+
+void finishJob(LevelJob* job, const SolverSubtreeResult& root)
+{
+    LevelSolveResult& result = job->entry->result;
+    result.supported = true;
+    result.winnable = root.winningLines > 0;
+    result.minStackDraws = root.minStackDraws;
+    result.minMoveCount = result.winnable ? job->deal.getPlayfieldCount() + root.minStackDraws : -1;
+    result.winningLineCount = root.winningLines;
+    result.nodesExpanded = job->nodesExpanded.load();
+    
+    job->entry->wallTimeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - job->startTime).count();
+}
+
+/**
+ * @brief 节点完成：把结果交给父节点，父节点的子节点全部完成时继续向上合并
+ */
+void completeNode(SplitNode* node, SolverSubtreeResult result)
+{
+    while (true) {
+        SplitNode* parent = node->parent;
+        if (!parent) {
+            finishJob(node->job, result);
+            delete node;
+            return;
+        }
+        
+        parent->childResults[node->slot] = result;
+        delete node;
+        if (parent->pending.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        
+        // 最后一个完成的子节点负责合并父节点
+        result = SolverSubtreeResult::lost();
+        for (size_t i = 0; i < parent->childResults.size(); i++) {
+            result.merge(parent->childResults[i], parent->childCosts[i]);
+        }
+        parent->job->table.store(parent->key, result);
+        node = parent;
+    }
+}
+
+void processNode(SplitNode* node, int depth)
+{
+    LevelJob* job = node->job;
+    const SolverStateKey key = node->key;
+    
+    if (key.playfieldMask == 0) {
+        completeNode(node, SolverSubtreeResult::won());
+        return;
+    }
+    
+    SolverSubtreeResult cached;
+    if (job->table.find(key, &cached)) {
+        completeNode(node, cached);
+        return;
+    }
+    
+    int remainingCards = popCount(key.playfieldMask) + key.getStackCount();
+    if (depth >= kMaxSplitDepth || remainingCards < kMinSplitRemainingCards) {
+        // 子树足够小，在当前线程内顺序搜索
+        SolverSearch<TaggedSolverTable> search(job->deal, job->table);
+        SolverSubtreeResult result = search.search(key);
+        job->nodesExpanded.fetch_add(search.getNodesExpanded(), std::memory_order_relaxed);
+        completeNode(node, result);
+        return;
+    }
+    
+    job->nodesExpanded.fetch_add(1, std::memory_order_relaxed);
+    
+    // 展开子节点
+    std::vector<SolverStateKey> childKeys;
+    if (!job->deal.isDeadEnd(key)) {
+        int stackCount = key.getStackCount();
+        uint64_t candidates = job->deal.getMatchCandidates(key);
+        while (candidates) {
+            int index = SolverDeal::lowestBitIndex(candidates);
+            candidates &= candidates - 1;
+            childKeys.push_back(SolverStateKey::make(key.playfieldMask & ~(1ULL << index),
+                                                     stackCount, job->deal.getPlayfieldValue(index)));
+            node->childCosts.push_back(0);
+        }
+        if (stackCount > 0) {
+            childKeys.push_back(SolverStateKey::make(key.playfieldMask, stackCount - 1,
+                                                     job->deal.getStackValue(stackCount - 1)));
+            node->childCosts.push_back(1);
+        }
+    }
+    
+    if (childKeys.empty()) {
+        job->table.store(key, SolverSubtreeResult::lost());
+        completeNode(node, SolverSubtreeResult::lost());
+        return;
+    }
+    
+    // 先创建全部子节点再提交：提交后父节点可能随时被其他线程合并并释放
+    int childCount = static_cast<int>(childKeys.size());
+    node->childResults.resize(childCount);
+    node->pending.store(childCount, std::memory_order_relaxed);
+    
+    std::vector<SplitNode*> children;
+    for (int i = 0; i < childCount; i++) {
+        children.push_back(new SplitNode(job, node, i, childKeys[i]));
+    }
+    
+    WorkStealingPool* pool = job->pool;
+    for (int i = 0; i < childCount; i++) {
+        SplitNode* child = children[i];
+        pool->submit([child, depth]() {
+            processNode(child, depth + 1);
+        });
+    }
+}
+
+/**
+ * @brief 开始求解一个关卡（在工作线程中调用）
+ */
+void startJob(LevelJob* job, const GameModel* gameModel)
+{
+    job->entry->loaded = true;
+    if (!job->deal.init(gameModel)) {
+        return;
+    }
+    
+    job->startTime = std::chrono::steady_clock::now();
+    processNode(new SplitNode(job, nullptr, 0, job->deal.getRootKey()), 0);
+}
+
+} // namespace
+
+BatchSolverManager::BatchSolverManager()
+    : _pool(nullptr)
+    , _table(nullptr)
+    , _nextLevelTag(1)
+{
+}
+
+BatchSolverManager::~BatchSolverManager()
+{
+    delete _pool;
+    delete _table;
+}
+
+bool BatchSolverManager::init(int threadCount, int tableSizeBits)
+{
+    if (_pool || tableSizeBits < 1 || tableSizeBits > 32) {
+        return false;
+    }
+    
+    _pool = new WorkStealingPool(threadCount);
+    _table = new ConcurrentSolverTable(tableSizeBits);
+    return true;
+}
+
+std::vector<BatchSolveEntry> BatchSolverManager::solveBatch(int levelCount, const LevelModelFactory& factory)
+{
+    std::vector<BatchSolveEntry> entries(levelCount > 0 ? levelCount : 0);
+    if (!_pool || entries.empty()) {
+        return entries;
+    }
+    
+    std::vector<LevelJob*> jobs;
+    for (int i = 0; i < levelCount; i++) {
+        jobs.push_back(new LevelJob(_pool, _table, allocateLevelTag(), &entries[i]));
+    }
+    
+    for (int i = 0; i < levelCount; i++) {
+        LevelJob* job = jobs[i];
+        _pool->submit([job, i, &factory]() {
+            GameModel* gameModel = factory(i);
+            if (gameModel) {
+                startJob(job, gameModel);
+                delete gameModel;
+            }
+        });
+    }
+    
+    _pool->waitIdle();
+    
+    for (size_t i = 0; i < jobs.size(); i++) {
+        delete jobs[i];
+    }
+    return entries;
+}
+
+LevelSolveResult BatchSolverManager::solve(const GameModel* gameModel)
+{
+    if (!_pool || !gameModel) {
+        return LevelSolveResult();
+    }
+    
+    BatchSolveEntry entry;
+    LevelJob job(_pool, _table, allocateLevelTag(), &entry);
+    _pool->submit([&job, gameModel]() {
+        startJob(&job, gameModel);
+    });
+    _pool->waitIdle();
+    return entry.result;
+}
+
+unsigned int BatchSolverManager::allocateLevelTag()
+{
+    if (_nextLevelTag == 0) {
+        _nextLevelTag = 1;
+    }
+    return _nextLevelTag++;
+}
+
+int BatchSolverManager::getThreadCount() const
+{
+    return _pool ? _pool->getThreadCount() : 0;
+}
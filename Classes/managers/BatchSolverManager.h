@@ -0,0 +1,105 @@
+#ifndef __BATCH_SOLVER_MANAGER_H__
+#define __BATCH_SOLVER_MANAGER_H__
+
+#include "../models/GameModel.h"
+#include "../services/LevelSolver.h"
+#include <functional>
+#include <vector>
+
+class WorkStealingPool;
+class ConcurrentSolverTable;
+
+/**
+ * @struct BatchSolveEntry
+ * @brief 批量求解中单个关卡的结果
+ */
+struct BatchSolveEntry
+{
+    bool loaded;                // 关卡是否加载成功
+    LevelSolveResult result;    // 求解结果
+    double wallTimeMs;          // 求解耗时（毫秒，不含加载）
+    
+    BatchSolveEntry()
+        : loaded(false)
+        , wallTimeMs(0.0)
+    {
+    }
+};
+
+/**
+ * @class BatchSolverManager
+ * @brief 多线程批量关卡求解管理器
+ * @details 持有工作窃取线程池和所有线程共享的无锁置换表
+ *          每个关卡作为一个任务加载和求解；较大的关卡在搜索树浅层拆分成子树任务，
+ *          子树完成后由最后完成的子任务合并结果（不阻塞等待），空闲线程窃取子树任务
+ *          置换表是有损的（冲突时覆盖），只影响命中率，不影响结果的正确性
+ */
+class BatchSolverManager
+{
+public:
+    /**
+     * @brief 关卡加载函数类型
+     * @details 参数为关卡序号，返回新建的GameModel（由管理器释放），失败返回nullptr
+     *          在工作线程中调用，需保证线程安全
+     */
+    using LevelModelFactory = std::function<GameModel*(int levelIndex)>;
+    
+    /**
+     * @brief 默认置换表大小（2^20个桶，每桶两个条目，约48MB）
+     */
+    static const int kDefaultTableSizeBits = 20;
+    
+    /**
+     * @brief 构造函数
+     */
+    BatchSolverManager();
+    
+    /**
+     * @brief 析构函数
+     */
+    ~BatchSolverManager();
+    
+    /**
+     * @brief 初始化
+     * @param threadCount 工作线程数量，<=0时使用硬件并发数
+     * @param tableSizeBits 置换表大小（2^tableSizeBits个桶）
+     * @return 是否初始化成功
+     */
+    bool init(int threadCount, int tableSizeBits = kDefaultTableSizeBits);
+    
+    /**
+     * @brief 批量求解
+     * @param levelCount 关卡数量
+     * @param factory 关卡加载函数
+     * @return 每个关卡的结果（与关卡序号一一对应）
+     */
+    std::vector<BatchSolveEntry> solveBatch(int levelCount, const LevelModelFactory& factory);
+    
+    /**
+     * @brief 使用所有线程求解单个关卡
+     * @param gameModel 游戏数据模型（从其当前状态开始求解）
+     * @return 求解结果
+     */
+    LevelSolveResult solve(const GameModel* gameModel);
+    
+    /**
+     * @brief 获取工作线程数量
+     */
+    int getThreadCount() const;
+    
+private:
+    /**
+     * @brief 分配新的关卡标记（0保留给空条目）
+     */
+    unsigned int allocateLevelTag();
+    
+    BatchSolverManager(const BatchSolverManager&) = delete;
+    BatchSolverManager& operator=(const BatchSolverManager&) = delete;
+    
+private:
+    WorkStealingPool* _pool;            // 工作窃取线程池
+    ConcurrentSolverTable* _table;      // 共享置换表
+    unsigned int _nextLevelTag;         // 置换表中区分不同关卡的标记
+};
+
+#endif // __BATCH_SOLVER_MANAGER_H__
@@ -0,0 +1,267 @@
+#include "DifficultyEstimatorManager.h"
+#include "../services/GameModelFromLevelGenerator.h"
+#include "../services/LevelSolverSearch.h"
+#include "../utils/SeededRandom.h"
+#include "../utils/WorkStealingPool.h"
+#include <chrono>
+
+namespace {
+
+int popCount(uint64_t bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(bits);
+#else
+    int count = 0;
+    while (bits) {
+        bits &= bits - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief 取位掩码中第n个（从0开始）置位的下标
+ */
+int nthBitIndex(uint64_t bits, int n)
+{
+    for (int i = 0; i < n; i++) {
+        bits &= bits - 1;
+    }
+    return SolverDeal::lowestBitIndex(bits);
+}
+
+/**
+ * @brief 随机策略：在所有匹配和翻牌中均匀选择
+ * @return 匹配的主牌区下标，-1表示翻牌
+ */
+int pickRandomMove(uint64_t candidates, bool canDraw, SeededRandom* random)
+{
+    int matchCount = popCount(candidates);
+    int choice = random->nextBelow(matchCount + (canDraw ? 1 : 0));
+    return choice < matchCount ? nthBitIndex(candidates, choice) : -1;
+}
+
+/**
+ * @brief 贪心策略：优先匹配，选择匹配后可继续匹配的卡牌最多的一张（并列时随机）
+ * @return 匹配的主牌区下标，-1表示翻牌
+ */
+int pickGreedyMove(const SolverDeal& deal, const SolverStateKey& key, uint64_t candidates, SeededRandom* random)
+{
+    int bestIndex = -1;
+    int bestFollowCount = -1;
+    int tieCount = 0;
+    int stackCount = key.getStackCount();
+    while (candidates) {
+        int index = SolverDeal::lowestBitIndex(candidates);
+        candidates &= candidates - 1;
+        SolverStateKey next = SolverStateKey::make(key.playfieldMask & ~(1ULL << index), stackCount,
+                                                   deal.getPlayfieldValue(index));
+        int followCount = popCount(deal.getMatchCandidates(next));
+        if (followCount > bestFollowCount) {
+            bestIndex = index;
+            bestFollowCount = followCount;
+            tieCount = 1;
+        } else if (followCount == bestFollowCount && random->nextBelow(++tieCount) == 0) {
+            bestIndex = index;
+        }
+    }
+    return bestIndex;
+}
+
+} // namespace
+
+int DifficultyEstimate::getQuantile(const std::vector<long long>& histogram, double quantile)
+{
+    long long total = 0;
+    for (long long count : histogram) {
+        total += count;
+    }
+    if (total == 0) {
+        return -1;
+    }
+    
+    long long seen = 0;
+    for (size_t i = 0; i < histogram.size(); i++) {
+        seen += histogram[i];
+        if (seen >= quantile * total) {
+            return static_cast<int>(i);
+        }
+    }
+    return static_cast<int>(histogram.size()) - 1;
+}
+
+DifficultyEstimatorManager::DifficultyEstimatorManager()
+    : _pool(nullptr)
+{
+}
+
+DifficultyEstimatorManager::~DifficultyEstimatorManager()
+{
+    delete _pool;
+}
+
+bool DifficultyEstimatorManager::init(int threadCount)
+{
+    if (_pool) {
+        return false;
+    }
+    
+    _pool = new WorkStealingPool(threadCount);
+    return true;
+}
+
+DifficultyEstimate DifficultyEstimatorManager::estimate(const LevelConfig* levelConfig,
+                                                        const DifficultyEstimateOptions& options)
+{
+    if (!levelConfig) {
+        return DifficultyEstimate();
+    }
+    std::vector<DifficultyEstimate> results = estimateBatch(1, [levelConfig](int) {
+        return GameModelFromLevelGenerator::generateGameModel(levelConfig);
+    }, options);
+    return results[0];
+}
+
+std::vector<DifficultyEstimate> DifficultyEstimatorManager::estimateBatch(int levelCount, const LevelModelFactory& factory,
+                                                                          const DifficultyEstimateOptions& options)
+{
+    std::vector<DifficultyEstimate> results(levelCount > 0 ? levelCount : 0);
+    if (!_pool || results.empty() || options.playoutCount <= 0) {
+        return results;
+    }
+    
+    auto startTime = std::chrono::steady_clock::now();
+    
+    // 提取所有关卡的牌局数据，划分任务并为每个任务分配翻牌分布的分段
+    std::vector<SolverDeal> deals(levelCount);
+    int taskCountPerLevel = (options.playoutCount + kPlayoutsPerTask - 1) / kPlayoutsPerTask;
+    size_t histogramSize = 0;
+    _tasks.clear();
+    for (int i = 0; i < levelCount; i++) {
+        GameModel* gameModel = factory(i);
+        bool loaded = gameModel && deals[i].init(gameModel);
+        delete gameModel;
+        if (!loaded) {
+            continue;
+        }
+        
+        results[i].supported = true;
+        int bucketCount = deals[i].getRootKey().getStackCount() + 1;
+        for (int taskIndex = 0; taskIndex < taskCountPerLevel; taskIndex++) {
+            PlayoutTask task = {};
+            task.levelIndex = i;
+            task.taskIndex = taskIndex;
+            int remaining = options.playoutCount - taskIndex * kPlayoutsPerTask;
+            task.playoutCount = remaining < kPlayoutsPerTask ? remaining : kPlayoutsPerTask;
+            task.histogramOffset = histogramSize;
+            histogramSize += bucketCount * 2;
+            _tasks.push_back(task);
+        }
+    }
+    _histogramArena.assign(histogramSize, 0);
+    
+    for (size_t i = 0; i < _tasks.size(); i++) {
+        PlayoutTask* task = &_tasks[i];
+        const SolverDeal* deal = &deals[task->levelIndex];
+        long long* drawHistogram = _histogramArena.data() + task->histogramOffset;
+        _pool->submit([deal, &options, task, drawHistogram]() {
+            runTask(*deal, options, task, drawHistogram);
+        });
+    }
+    _pool->waitIdle();
+    
+    // 按任务顺序合并（整数累加，结果与调度顺序无关）
+    double elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+    for (const PlayoutTask& task : _tasks) {
+        DifficultyEstimate& result = results[task.levelIndex];
+        int bucketCount = deals[task.levelIndex].getRootKey().getStackCount() + 1;
+        if (result.drawHistogram.empty()) {
+            result.drawHistogram.assign(bucketCount, 0);
+            result.winDrawHistogram.assign(bucketCount, 0);
+        }
+        const long long* drawHistogram = _histogramArena.data() + task.histogramOffset;
+        for (int draws = 0; draws < bucketCount; draws++) {
+            result.drawHistogram[draws] += drawHistogram[draws];
+            result.winDrawHistogram[draws] += drawHistogram[bucketCount + draws];
+        }
+        result.playoutCount += task.playoutCount;
+        result.winCount += task.winCount;
+        result.greedyPlayoutCount += task.greedyPlayoutCount;
+        result.greedyWinCount += task.greedyWinCount;
+        result.stuckMoveSum += task.stuckMoveSum;
+        result.stuckCardSum += task.stuckCardSum;
+    }
+    for (DifficultyEstimate& result : results) {
+        result.wallTimeMs = elapsedMs;
+    }
+    return results;
+}
+
+int DifficultyEstimatorManager::getThreadCount() const
+{
+    return _pool ? _pool->getThreadCount() : 0;
+}
+
+void DifficultyEstimatorManager::runTask(const SolverDeal& deal, const DifficultyEstimateOptions& options,
+                                         PlayoutTask* task, long long* drawHistogram)
+{
+    // 随机序列只由种子、关卡和任务序号决定
+    SeededRandom random(options.seed ^ (static_cast<uint64_t>(task->levelIndex) << 32)
+                        ^ static_cast<uint64_t>(task->taskIndex));
+    const SolverStateKey rootKey = deal.getRootKey();
+    long long* winDrawHistogram = drawHistogram + rootKey.getStackCount() + 1;
+    long long winCount = 0;
+    long long greedyPlayoutCount = 0;
+    long long greedyWinCount = 0;
+    long long stuckMoveSum = 0;
+    long long stuckCardSum = 0;
+    
+    for (int playout = 0; playout < task->playoutCount; playout++) {
+        bool greedy = random.nextFloat() < options.greedyRatio;
+        SolverStateKey key = rootKey;
+        int moveCount = 0;
+        int drawCount = 0;
+        while (key.playfieldMask != 0) {
+            int stackCount = key.getStackCount();
+            uint64_t candidates = deal.getMatchCandidates(key);
+            if (!candidates && stackCount == 0) {
+                break;
+            }
+            
+            int index = -1;
+            if (candidates) {
+                index = greedy ? pickGreedyMove(deal, key, candidates, &random)
+                               : pickRandomMove(candidates, stackCount > 0, &random);
+            }
+            if (index >= 0) {
+                key = SolverStateKey::make(key.playfieldMask & ~(1ULL << index), stackCount,
+                                           deal.getPlayfieldValue(index));
+            } else {
+                key = SolverStateKey::make(key.playfieldMask, stackCount - 1, deal.getStackValue(stackCount - 1));
+                drawCount++;
+            }
+            moveCount++;
+        }
+        
+        bool won = key.playfieldMask == 0;
+        drawHistogram[drawCount]++;
+        greedyPlayoutCount += greedy ? 1 : 0;
+        if (won) {
+            winDrawHistogram[drawCount]++;
+            winCount++;
+            greedyWinCount += greedy ? 1 : 0;
+        } else {
+            stuckMoveSum += moveCount;
+            stuckCardSum += popCount(key.playfieldMask);
+        }
+    }
+    
+    task->winCount = winCount;
+    task->greedyPlayoutCount = greedyPlayoutCount;
+    task->greedyWinCount = greedyWinCount;
+    task->stuckMoveSum = stuckMoveSum;
+    task->stuckCardSum = stuckCardSum;
+}
@@ -0,0 +1,203 @@
+#ifndef __DIFFICULTY_ESTIMATOR_MANAGER_H__
+#define __DIFFICULTY_ESTIMATOR_MANAGER_H__
+
+#include "../configs/models/LevelConfig.h"
+#include "../models/GameModel.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class WorkStealingPool;
+class SolverDeal;
+
+/**
+ * @struct DifficultyEstimateOptions
+ * @brief 难度评估参数
+ */
+struct DifficultyEstimateOptions
+{
+    int playoutCount;       // 每个关卡的模拟对局数
+    float greedyRatio;      // 贪心策略对局的比例（其余为随机策略）
+    uint64_t seed;          // 随机种子（同一种子的结果与线程数无关）
+    
+    DifficultyEstimateOptions()
+        : playoutCount(100000)
+        , greedyRatio(0.5f)
+        , seed(1)
+    {
+    }
+};
+
+/**
+ * @struct DifficultyEstimate
+ * @brief 单个关卡的难度评估结果
+ * @details 卡住指主牌区没有可匹配的卡牌且备用牌堆已空；翻牌压力为一局中从备用牌堆翻牌的次数
+ */
+struct DifficultyEstimate
+{
+    bool supported;                         // 是否支持评估（关卡加载失败或超出求解上限时为false）
+    long long playoutCount;                 // 模拟对局数
+    long long winCount;                     // 获胜对局数
+    long long greedyPlayoutCount;           // 贪心策略对局数
+    long long greedyWinCount;               // 贪心策略获胜对局数
+    long long stuckMoveSum;                 // 未获胜对局卡住前的操作数（匹配+翻牌）之和
+    long long stuckCardSum;                 // 未获胜对局卡住时主牌区剩余卡牌数之和
+    std::vector<long long> drawHistogram;   // 按翻牌次数统计的对局数（下标为翻牌次数，长度为备用牌数+1）
+    std::vector<long long> winDrawHistogram; // 获胜对局按翻牌次数的统计
+    double wallTimeMs;                      // 评估耗时（毫秒，批量评估时为整批耗时）
+    
+    DifficultyEstimate()
+        : supported(false)
+        , playoutCount(0)
+        , winCount(0)
+        , greedyPlayoutCount(0)
+        , greedyWinCount(0)
+        , stuckMoveSum(0)
+        , stuckCardSum(0)
+        , wallTimeMs(0.0)
+    {
+    }
+    
+    /**
+     * @brief 全部对局的胜率
+     */
+    double getWinRate() const { return ratio(winCount, playoutCount); }
+    
+    /**
+     * @brief 贪心策略的胜率
+     */
+    double getGreedyWinRate() const { return ratio(greedyWinCount, greedyPlayoutCount); }
+    
+    /**
+     * @brief 随机策略的胜率
+     */
+    double getRandomWinRate() const { return ratio(winCount - greedyWinCount, playoutCount - greedyPlayoutCount); }
+    
+    /**
+     * @brief 未获胜对局卡住前的平均操作数
+     */
+    double getMeanMovesToStuck() const { return ratio(stuckMoveSum, playoutCount - winCount); }
+    
+    /**
+     * @brief 难度分数（0~1）：两种策略失败率的平均值，不受策略比例影响
+     */
+    double getDifficultyScore() const { return 1.0 - (getRandomWinRate() + getGreedyWinRate()) * 0.5; }
+    
+    /**
+     * @brief 翻牌次数分布的分位数
+     * @param histogram drawHistogram或winDrawHistogram
+     * @param quantile 分位（0~1）
+     * @return 至少quantile比例的对局翻牌次数不超过该值，没有对局时返回-1
+     */
+    static int getQuantile(const std::vector<long long>& histogram, double quantile);
+    
+private:
+    static double ratio(long long numerator, long long denominator)
+    {
+        return denominator > 0 ? static_cast<double>(numerator) / denominator : 0.0;
+    }
+};
+
+/**
+ * @class DifficultyEstimatorManager
+ * @brief 多线程蒙特卡洛难度评估管理器
+ * @details 在求解器的牌局数据（SolverDeal）上批量模拟对局：随机策略在所有合法操作中均匀选择，
+ *          贪心策略总是优先匹配（选择匹配后可继续匹配的卡牌最多的一张），无法匹配时才翻牌
+ *          对局按kPlayoutsPerTask拆成任务交给工作窃取线程池，每个任务用由种子、关卡和任务序号
+ *          确定的SeededRandom，结果与线程数和调度顺序无关
+ *          对局状态只有16字节的SolverStateKey，在栈上推进；任务结果和翻牌分布写入一次性分配的
+ *          连续内存（按任务分段，多次评估复用容量），模拟过程中不分配内存也不共享可写数据
+ */
+class DifficultyEstimatorManager
+{
+public:
+    /**
+     * @brief 关卡加载函数类型
+     * @details 参数为关卡序号，返回新建的GameModel（由管理器释放），失败返回nullptr
+     *          在调用estimateBatch的线程中依次调用
+     */
+    using LevelModelFactory = std::function<GameModel*(int levelIndex)>;
+    
+    /**
+     * @brief 每个任务模拟的对局数
+     */
+    static const int kPlayoutsPerTask = 4096;
+    
+    /**
+     * @brief 构造函数
+     */
+    DifficultyEstimatorManager();
+    
+    /**
+     * @brief 析构函数
+     */
+    ~DifficultyEstimatorManager();
+    
+    /**
+     * @brief 初始化
+     * @param threadCount 工作线程数量，<=0时使用硬件并发数
+     * @return 是否初始化成功
+     */
+    bool init(int threadCount);
+    
+    /**
+     * @brief 评估单个关卡
+     * @param levelConfig 关卡配置
+     * @param options 评估参数
+     * @return 评估结果
+     */
+    DifficultyEstimate estimate(const LevelConfig* levelConfig, const DifficultyEstimateOptions& options);
+    
+    /**
+     * @brief 批量评估（所有关卡的对局一起调度，适合评估整个关卡目录）
+     * @param levelCount 关卡数量
+     * @param factory 关卡加载函数
+     * @param options 评估参数
+     * @return 每个关卡的结果（与关卡序号一一对应）
+     */
+    std::vector<DifficultyEstimate> estimateBatch(int levelCount, const LevelModelFactory& factory,
+                                                  const DifficultyEstimateOptions& options);
+    
+    /**
+     * @brief 获取工作线程数量
+     */
+    int getThreadCount() const;
+    
+private:
+    /**
+     * @struct PlayoutTask
+     * @brief 一个任务的对局范围与计数（计数只由该任务在结束时写入一次）
+     */
+    struct PlayoutTask
+    {
+        int levelIndex;             // 关卡序号
+        int taskIndex;              // 在关卡内的任务序号（决定随机种子）
+        int playoutCount;           // 模拟对局数
+        size_t histogramOffset;     // 翻牌分布在_histogramArena中的起始位置
+        long long winCount;         // 获胜对局数
+        long long greedyPlayoutCount; // 贪心策略对局数
+        long long greedyWinCount;   // 贪心策略获胜对局数
+        long long stuckMoveSum;     // 未获胜对局卡住前的操作数之和
+        long long stuckCardSum;     // 未获胜对局卡住时主牌区剩余卡牌数之和
+    };
+    
+    /**
+     * @brief 执行一个任务的全部对局
+     * @param deal 牌局数据
+     * @param options 评估参数
+     * @param task 任务
+     * @param drawHistogram 该任务的翻牌分布（全部对局与获胜对局各占备用牌数+1个计数）
+     */
+    static void runTask(const SolverDeal& deal, const DifficultyEstimateOptions& options, PlayoutTask* task,
+                        long long* drawHistogram);
+    
+    DifficultyEstimatorManager(const DifficultyEstimatorManager&) = delete;
+    DifficultyEstimatorManager& operator=(const DifficultyEstimatorManager&) = delete;
+    
+private:
+    WorkStealingPool* _pool;                    // 工作窃取线程池
+    std::vector<PlayoutTask> _tasks;            // 本次评估的全部任务（复用容量）
+    std::vector<long long> _histogramArena;     // 所有任务的翻牌分布（按任务分段，复用容量）
+};
+
+#endif // __DIFFICULTY_ESTIMATOR_MANAGER_H__
@@ -0,0 +1,203 @@
+#include "LevelPrefetchManager.h"
+#include "../services/LevelBuildService.h"
+#include "../utils/TraceProfiler.h"
+#include <utility>
+#include <vector>
+
+LevelPrefetchManager::LevelPrefetchManager()
+    : _cacheCapacity(0)
+    , _generation(0)
+    , _windowFirstLevelId(0)
+    , _windowCount(0)
+    , _loadingLevelId(-1)
+    , _stopping(false)
+{
+}
+
+LevelPrefetchManager::~LevelPrefetchManager()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+        _requests.clear();
+    }
+    _condition.notify_all();
+    if (_worker.joinable()) {
+        _worker.join();
+    }
+    
+    for (const CacheEntry& entry : _cache) {
+        delete entry.gameModel;
+    }
+}
+
+bool LevelPrefetchManager::init(const LevelInputProvider& provider, int cacheCapacity)
+{
+    if (_worker.joinable() || !provider || cacheCapacity <= 0) {
+        return false;
+    }
+    
+    _provider = provider;
+    _cacheCapacity = cacheCapacity;
+    _worker = std::thread(&LevelPrefetchManager::workerLoop, this);
+    return true;
+}
+
+void LevelPrefetchManager::prefetchLevels(int firstLevelId, int count)
+{
+    if (count > _cacheCapacity) {
+        count = _cacheCapacity;
+    }
+    if (count < 0) {
+        count = 0;
+    }
+    
+    // 先找出需要生成的关卡，输入在不持有锁时准备（读取文件期间工作线程可以继续生成）
+    std::vector<int> missingLevelIds;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (int i = 0; i < count; i++) {
+            int levelId = firstLevelId + i;
+            if (_cacheIndex.find(levelId) == _cacheIndex.end() && levelId != _loadingLevelId) {
+                missingLevelIds.push_back(levelId);
+            }
+        }
+    }
+    
+    std::vector<Request> requests;
+    for (int levelId : missingLevelIds) {
+        Request request;
+        request.generation = 0;
+        request.input.levelId = levelId;
+        if (_provider(levelId, &request.input)) {
+            requests.push_back(std::move(request));
+        }
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _generation++;
+        _requests.clear();
+        _windowFirstLevelId = firstLevelId;
+        _windowCount = count;
+        
+        // 已缓存的关卡提到最前，避免被本窗口的新模型淘汰
+        for (int i = 0; i < count; i++) {
+            std::unordered_map<int, std::list<CacheEntry>::iterator>::iterator found = _cacheIndex.find(firstLevelId + i);
+            if (found != _cacheIndex.end()) {
+                _cache.splice(_cache.begin(), _cache, found->second);
+            }
+        }
+        
+        // 准备输入期间工作线程可能已生成了其中的关卡
+        for (Request& request : requests) {
+            int levelId = request.input.levelId;
+            if (_cacheIndex.find(levelId) != _cacheIndex.end() || levelId == _loadingLevelId) {
+                continue;
+            }
+            request.generation = _generation;
+            _requests.push_back(std::move(request));
+        }
+    }
+    _condition.notify_one();
+}
+
+void LevelPrefetchManager::cancelAll()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _generation++;
+    _requests.clear();
+    _windowCount = 0;
+}
+
+GameModel* LevelPrefetchManager::takeGameModel(int levelId)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::unordered_map<int, std::list<CacheEntry>::iterator>::iterator found = _cacheIndex.find(levelId);
+    if (found == _cacheIndex.end()) {
+        return nullptr;
+    }
+    
+    GameModel* gameModel = found->second->gameModel;
+    _cache.erase(found->second);
+    _cacheIndex.erase(found);
+    return gameModel;
+}
+
+bool LevelPrefetchManager::isReady(int levelId) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _cacheIndex.find(levelId) != _cacheIndex.end();
+}
+
+int LevelPrefetchManager::getCachedCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return static_cast<int>(_cache.size());
+}
+
+void LevelPrefetchManager::workerLoop()
+{
+    TRACE_THREAD_NAME("LevelPrefetch");
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _condition.wait(lock, [this]() {
+            return _stopping || !_requests.empty();
+        });
+        if (_stopping) {
+            return;
+        }
+        
+        Request request = std::move(_requests.front());
+        _requests.pop_front();
+        int levelId = request.input.levelId;
+        _loadingLevelId = levelId;
+        
+        // 解析和生成不持有锁，主线程可以继续取模型或发出新请求
+        lock.unlock();
+        GameModel* gameModel = nullptr;
+        {
+            TRACE_ZONE("LevelPrefetchManager::buildLevel");
+            gameModel = LevelBuildService::buildGameModel(request.input);
+        }
+        lock.lock();
+        
+        _loadingLevelId = -1;
+        
+        // 请求已被取消且不在新窗口内时丢弃结果
+        bool wanted = request.generation == _generation || isInWindow(levelId);
+        if (gameModel && wanted && !_stopping) {
+            insertCache(levelId, gameModel);
+        } else {
+            delete gameModel;
+        }
+    }
+}
+
+bool LevelPrefetchManager::isInWindow(int levelId) const
+{
+    return levelId >= _windowFirstLevelId && levelId - _windowFirstLevelId < _windowCount;
+}
+
+void LevelPrefetchManager::insertCache(int levelId, GameModel* gameModel)
+{
+    std::unordered_map<int, std::list<CacheEntry>::iterator>::iterator found = _cacheIndex.find(levelId);
+    if (found != _cacheIndex.end()) {
+        delete found->second->gameModel;
+        _cache.erase(found->second);
+        _cacheIndex.erase(found);
+    }
+    
+    CacheEntry entry;
+    entry.levelId = levelId;
+    entry.gameModel = gameModel;
+    _cache.push_front(entry);
+    _cacheIndex[levelId] = _cache.begin();
+    
+    while (static_cast<int>(_cache.size()) > _cacheCapacity) {
+        const CacheEntry& oldest = _cache.back();
+        delete oldest.gameModel;
+        _cacheIndex.erase(oldest.levelId);
+        _cache.pop_back();
+    }
+}
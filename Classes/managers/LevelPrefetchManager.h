@@ -0,0 +1,143 @@
+#ifndef __LEVEL_PREFETCH_MANAGER_H__
+#define __LEVEL_PREFETCH_MANAGER_H__
+
+#include "../configs/models/LevelLoadInput.h"
+#include "../models/GameModel.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+/**
+ * @class LevelPrefetchManager
+ * @brief 关卡预加载管理器
+ * @details 在一个后台工作线程中生成GameModel，结果放入有容量上限的LRU缓存，
+ *          主线程通过takeGameModel非阻塞地取走已生成的模型
+ *          关卡输入（关卡包视图、JSON文件内容）由调用prefetchLevels的线程准备，
+ *          工作线程只通过LevelBuildService解析和生成，不访问文件系统和引擎
+ *          prefetchLevels设置新的预加载窗口：尚未开始的旧请求直接丢弃，
+ *          正在生成的关卡若不在新窗口内，完成后结果被丢弃（通过请求代数判断）
+ *          作为Controller的成员变量，不实现为单例
+ */
+class LevelPrefetchManager
+{
+public:
+    /**
+     * @brief 关卡输入准备函数类型
+     * @details 参数为关卡ID和要填写的输入，返回是否准备成功
+     *          在调用prefetchLevels的线程中调用，可以使用引擎读取文件
+     */
+    using LevelInputProvider = std::function<bool(int levelId, LevelLoadInput* input)>;
+    
+    /**
+     * @brief 默认缓存的关卡数量
+     */
+    static const int kDefaultCacheCapacity = 4;
+    
+    /**
+     * @brief 构造函数
+     */
+    LevelPrefetchManager();
+    
+    /**
+     * @brief 析构函数（丢弃未开始的请求，等待正在生成的关卡完成后退出工作线程）
+     */
+    ~LevelPrefetchManager();
+    
+    /**
+     * @brief 初始化并启动工作线程
+     * @param provider 关卡输入准备函数
+     * @param cacheCapacity 缓存的关卡数量上限
+     * @return 是否初始化成功
+     */
+    bool init(const LevelInputProvider& provider, int cacheCapacity = kDefaultCacheCapacity);
+    
+    /**
+     * @brief 设置预加载窗口（取消上一个窗口中尚未完成的请求）
+     * @details 在当前线程为窗口内尚未缓存的关卡调用输入准备函数，再交给工作线程生成
+     * @param firstLevelId 第一个预加载的关卡ID
+     * @param count 预加载的关卡数量（超过缓存容量时按容量截断）
+     */
+    void prefetchLevels(int firstLevelId, int count);
+    
+    /**
+     * @brief 取消所有尚未完成的请求（已缓存的模型保留）
+     */
+    void cancelAll();
+    
+    /**
+     * @brief 取走已生成的关卡模型（不阻塞）
+     * @param levelId 关卡ID
+     * @return 游戏数据模型（由调用者释放），尚未生成或生成失败时返回nullptr
+     */
+    GameModel* takeGameModel(int levelId);
+    
+    /**
+     * @brief 关卡模型是否已生成
+     */
+    bool isReady(int levelId) const;
+    
+    /**
+     * @brief 获取缓存中的关卡数量
+     */
+    int getCachedCount() const;
+    
+private:
+    /**
+     * @struct CacheEntry
+     * @brief 缓存项
+     */
+    struct CacheEntry
+    {
+        int levelId;            // 关卡ID
+        GameModel* gameModel;   // 生成的游戏数据模型
+    };
+    
+    /**
+     * @struct Request
+     * @brief 预加载请求
+     */
+    struct Request
+    {
+        unsigned int generation; // 发出请求时的代数
+        LevelLoadInput input;   // 关卡输入（包含关卡ID）
+    };
+    
+    /**
+     * @brief 工作线程主循环
+     */
+    void workerLoop();
+    
+    /**
+     * @brief 关卡是否在当前预加载窗口内（调用时需持有锁）
+     */
+    bool isInWindow(int levelId) const;
+    
+    /**
+     * @brief 放入缓存，超出容量时淘汰最久未使用的模型（调用时需持有锁）
+     */
+    void insertCache(int levelId, GameModel* gameModel);
+    
+    LevelPrefetchManager(const LevelPrefetchManager&) = delete;
+    LevelPrefetchManager& operator=(const LevelPrefetchManager&) = delete;
+    
+private:
+    LevelInputProvider _provider;               // 关卡输入准备函数
+    int _cacheCapacity;                         // 缓存容量
+    std::list<CacheEntry> _cache;               // 缓存（最近使用的在前）
+    std::unordered_map<int, std::list<CacheEntry>::iterator> _cacheIndex;  // 关卡ID到缓存项
+    std::deque<Request> _requests;              // 等待处理的请求
+    unsigned int _generation;                   // 请求代数（每次取消加一）
+    int _windowFirstLevelId;                    // 当前预加载窗口
+    int _windowCount;
+    int _loadingLevelId;                        // 正在生成的关卡ID（没有时为-1）
+    bool _stopping;                             // 是否正在退出
+    mutable std::mutex _mutex;                  // 保护以上成员
+    std::condition_variable _condition;         // 通知工作线程有新请求或需要退出
+    std::thread _worker;                        // 工作线程
+};
+
+#endif // __LEVEL_PREFETCH_MANAGER_H__
@@ -0,0 +1,139 @@
+#include "ReplayRecorderManager.h"
+#include "../utils/CoreLog.h"
+#include "../utils/Crc32.h"
+#include <cstdio>
+#include <cstring>
+
+ReplayRecorderManager::ReplayRecorderManager()
+    : _recording(false)
+    , _levelId(0)
+    , _inputCount(0)
+{
+}
+
+bool ReplayRecorderManager::startRecording(int levelId, const GameModel* gameModel, const UndoModel* undoModel,
+                                           const CardPosition& trayPosition)
+{
+    _recording = false;
+    _stream.clear();
+    _inputCount = 0;
+    if (!gameModel || !undoModel) {
+        return false;
+    }
+    
+    // 起始快照补齐到4字节，回放时可以在文件缓冲区中直接读取
+    size_t snapshotSize = GameSnapshotService::getSnapshotSize(gameModel, undoModel);
+    _snapshot.assign((snapshotSize + sizeof(uint32_t) - 1) / sizeof(uint32_t), 0);
+    if (GameSnapshotService::writeSnapshot(gameModel, undoModel, _snapshot.data(),
+                                           _snapshot.size() * sizeof(uint32_t)) != snapshotSize) {
+        CORE_LOG("ReplayRecorderManager: Failed to write snapshot for level %d", levelId);
+        return false;
+    }
+    
+    _levelId = levelId;
+    _trayPosition = trayPosition;
+    _lastInputTime = std::chrono::steady_clock::now();
+    _recording = true;
+    return true;
+}
+
+void ReplayRecorderManager::recordInput(ReplayInputType type, int cardId, const GameModel* gameModel,
+                                        const UndoModel* undoModel)
+{
+    if (!_recording) {
+        return;
+    }
+    
+    if (_inputCount > 0 && _inputCount % kCheckpointInterval == 0) {
+        appendCheckpoint(&_stream, gameModel, undoModel);
+    }
+    
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    long long deltaMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - _lastInputTime).count();
+    _lastInputTime = now;
+    _stream.push_back(static_cast<uint8_t>(type));
+    appendVarint(static_cast<uint32_t>(deltaMs > 0 ? deltaMs : 0));
+    if (type == RIT_CARD_CLICK) {
+        appendVarint(static_cast<uint32_t>(cardId + 1));
+    }
+    _inputCount++;
+}
+
+bool ReplayRecorderManager::getReplayData(const GameModel* gameModel, const UndoModel* undoModel,
+                                          std::vector<uint32_t>* outData) const
+{
+    if (!_recording || !gameModel || !outData) {
+        return false;
+    }
+    
+    // 结尾检查点只加在输出的副本上，录制可以继续
+    std::vector<uint8_t> stream(_stream);
+    appendCheckpoint(&stream, gameModel, undoModel);
+    
+    size_t snapshotSize = _snapshot.size() * sizeof(uint32_t);
+    size_t dataSize = snapshotSize + stream.size();
+    outData->assign((sizeof(ReplayFileHeader) + dataSize + sizeof(uint32_t) - 1) / sizeof(uint32_t), 0);
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(outData->data());
+    uint8_t* data = bytes + sizeof(ReplayFileHeader);
+    memcpy(data, _snapshot.data(), snapshotSize);
+    memcpy(data + snapshotSize, stream.data(), stream.size());
+    
+    ReplayFileHeader header;
+    memcpy(header.magic, ReplayPlayerService::kMagic, sizeof(header.magic));
+    header.version = ReplayPlayerService::kVersion;
+    header.levelId = _levelId;
+    header.trayX = _trayPosition.x;
+    header.trayY = _trayPosition.y;
+    header.snapshotSize = static_cast<uint32_t>(snapshotSize);
+    header.streamSize = static_cast<uint32_t>(stream.size());
+    header.inputCount = _inputCount;
+    header.dataCrc = Crc32::compute(data, dataSize);
+    memcpy(bytes, &header, sizeof(header));
+    return true;
+}
+
+bool ReplayRecorderManager::saveReplay(const std::string& filePath, const GameModel* gameModel,
+                                       const UndoModel* undoModel) const
+{
+    std::vector<uint32_t> data;
+    if (!getReplayData(gameModel, undoModel, &data)) {
+        return false;
+    }
+    
+    // 先完整写入临时文件再替换，写到一半时旧的回放仍然有效
+    std::string tempPath = filePath + ".tmp";
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        CORE_LOG("ReplayRecorderManager: Failed to open file for writing: %s", tempPath.c_str());
+        return false;
+    }
+    size_t totalSize = data.size() * sizeof(uint32_t);
+    bool written = fwrite(data.data(), 1, totalSize, file) == totalSize;
+    written = fclose(file) == 0 && written;
+    remove(filePath.c_str());
+    if (!written || rename(tempPath.c_str(), filePath.c_str()) != 0) {
+        CORE_LOG("ReplayRecorderManager: Failed to write replay: %s", filePath.c_str());
+        remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void ReplayRecorderManager::appendVarint(uint32_t value)
+{
+    while (value >= 0x80) {
+        _stream.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    _stream.push_back(static_cast<uint8_t>(value));
+}
+
+void ReplayRecorderManager::appendCheckpoint(std::vector<uint8_t>* stream, const GameModel* gameModel,
+                                             const UndoModel* undoModel)
+{
+    uint64_t hash = ReplayPlayerService::computeStateHash(gameModel, undoModel);
+    uint8_t bytes[sizeof(hash)];
+    memcpy(bytes, &hash, sizeof(hash));
+    stream->push_back(kReplayCheckpointTag);
+    stream->insert(stream->end(), bytes, bytes + sizeof(hash));
+}
@@ -0,0 +1,108 @@
+#ifndef __REPLAY_RECORDER_MANAGER_H__
+#define __REPLAY_RECORDER_MANAGER_H__
+
+#include "../models/GameModel.h"
+#include "../models/UndoModel.h"
+#include "../services/GameSnapshotService.h"
+#include "../services/ReplayPlayerService.h"
+#include "../utils/CardPosition.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class ReplayRecorderManager
+ * @brief 回放录制管理器
+ * @details 关卡开始时保存起始快照，之后把到达控制器输入入口的每个输入（包括被规则拒绝的）
+ *          按时间顺序追加到内存中的输入流，一条输入通常只占2~3字节；每kCheckpointInterval条输入
+ *          插入一个状态哈希检查点，回放时用于定位第一处不一致
+ *          文件格式见ReplayPlayerService.h，由ReplayPlayerService无头回放
+ *          作为Controller的成员变量，不实现为单例
+ */
+class ReplayRecorderManager
+{
+public:
+    /**
+     * @brief 每多少条输入插入一个检查点
+     */
+    static const int kCheckpointInterval = 16;
+    
+    /**
+     * @brief 构造函数
+     */
+    ReplayRecorderManager();
+    
+    /**
+     * @brief 开始新的录制（关卡开始或恢复后调用），丢弃之前的录制
+     * @param levelId 关卡ID
+     * @param gameModel 起始状态的游戏数据模型
+     * @param undoModel 起始状态的撤销数据模型（包括重做记录）
+     * @param trayPosition 底牌堆位置
+     * @return 快照写入失败时返回false（之后的输入被忽略）
+     */
+    bool startRecording(int levelId, const GameModel* gameModel, const UndoModel* undoModel,
+                        const CardPosition& trayPosition);
+    
+    /**
+     * @brief 记录一条输入（在控制器处理输入之前调用）
+     * @param type 输入类型
+     * @param cardId 点击的卡牌ID（其他输入忽略）
+     * @param gameModel 处理输入前的游戏数据模型（写检查点时使用）
+     * @param undoModel 处理输入前的撤销数据模型
+     */
+    void recordInput(ReplayInputType type, int cardId, const GameModel* gameModel, const UndoModel* undoModel);
+    
+    /**
+     * @brief 生成回放文件内容
+     * @param gameModel 当前的游戏数据模型（用于结尾检查点）
+     * @param undoModel 当前的撤销数据模型
+     * @param outData 输出文件内容（按uint32_t存放，保证4字节对齐，可直接交给ReplayPlayerService）
+     * @return 没有录制时返回false
+     */
+    bool getReplayData(const GameModel* gameModel, const UndoModel* undoModel, std::vector<uint32_t>* outData) const;
+    
+    /**
+     * @brief 把回放写入文件（先写临时文件再替换）
+     * @param filePath 文件路径
+     * @param gameModel 当前的游戏数据模型
+     * @param undoModel 当前的撤销数据模型
+     * @return 写入失败时返回false
+     */
+    bool saveReplay(const std::string& filePath, const GameModel* gameModel, const UndoModel* undoModel) const;
+    
+    /**
+     * @brief 是否正在录制
+     */
+    bool isRecording() const { return _recording; }
+    
+    /**
+     * @brief 获取已记录的输入数量
+     */
+    int getInputCount() const { return static_cast<int>(_inputCount); }
+    
+private:
+    /**
+     * @brief 追加一个varint
+     */
+    void appendVarint(uint32_t value);
+    
+    /**
+     * @brief 向输出流追加一个检查点
+     */
+    static void appendCheckpoint(std::vector<uint8_t>* stream, const GameModel* gameModel, const UndoModel* undoModel);
+    
+    ReplayRecorderManager(const ReplayRecorderManager&) = delete;
+    ReplayRecorderManager& operator=(const ReplayRecorderManager&) = delete;
+    
+private:
+    bool _recording;                                    // 是否正在录制
+    int _levelId;                                       // 关卡ID
+    CardPosition _trayPosition;                         // 底牌堆位置
+    std::vector<uint32_t> _snapshot;                    // 起始快照（补齐到4字节）
+    std::vector<uint8_t> _stream;                       // 输入流（复用容量）
+    uint32_t _inputCount;                               // 已记录的输入数量
+    std::chrono::steady_clock::time_point _lastInputTime; // 上一条输入（或开始录制）的时间
+};
+
+#endif // __REPLAY_RECORDER_MANAGER_H__
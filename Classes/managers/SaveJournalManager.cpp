@@ -0,0 +1,374 @@
+#include "SaveJournalManager.h"
+#include "UndoManager.h"
+#include "../services/GameRulesService.h"
+#include "../services/GameSnapshotService.h"
+#include "../utils/CoreLog.h"
+#include "../utils/Crc32.h"
+#include "../utils/TraceProfiler.h"
+#include <cstddef>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+const char SaveJournalManager::kMagic[4] = { 'G', 'J', 'N', 'L' };
+
+static_assert(sizeof(SaveJournalHeader) == 24, "SaveJournalHeader layout");
+static_assert(sizeof(SaveJournalRecord) == 28, "SaveJournalRecord layout");
+
+namespace {
+
+/**
+ * @brief 把文件缓冲交给操作系统并写入存储设备
+ */
+bool syncFile(FILE* file)
+{
+    if (fflush(file) != 0) {
+        return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+/**
+ * @brief 用新文件原子替换目标文件
+ */
+bool replaceFile(const std::string& fromPath, const std::string& toPath)
+{
+#ifdef _WIN32
+    return MoveFileExA(fromPath.c_str(), toPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    if (rename(fromPath.c_str(), toPath.c_str()) != 0) {
+        return false;
+    }
+    
+    // 同步所在目录，保证重命名本身也已写入
+    size_t slash = toPath.find_last_of('/');
+    std::string dirPath = slash == std::string::npos ? "." : toPath.substr(0, slash + 1);
+    int dirFd = open(dirPath.c_str(), O_RDONLY);
+    if (dirFd >= 0) {
+        fsync(dirFd);
+        ::close(dirFd);
+    }
+    return true;
+#endif
+}
+
+uint32_t computeRecordCrc(const SaveJournalRecord& record)
+{
+    return Crc32::compute(&record, offsetof(SaveJournalRecord, crc));
+}
+
+} // namespace
+
+SaveJournalManager::SaveJournalManager()
+    : _file(nullptr)
+    , _levelId(0)
+    , _recordCount(0)
+    , _unsyncedCount(0)
+{
+}
+
+SaveJournalManager::~SaveJournalManager()
+{
+    close();
+}
+
+void SaveJournalManager::init(const std::string& filePath)
+{
+    close();
+    _filePath = filePath;
+}
+
+bool SaveJournalManager::startJournal(int levelId, const GameModel* gameModel, const UndoModel* undoModel)
+{
+    return writeJournal(levelId, gameModel, undoModel);
+}
+
+bool SaveJournalManager::appendMove(const UndoAction& action, const CardPosition& trayPosition,
+                                    const GameModel* gameModel, const UndoModel* undoModel)
+{
+    SaveJournalRecord record;
+    memset(&record, 0, sizeof(record));
+    switch (action.type) {
+        case UAT_REPLACE_TRAY_FROM_STACK:
+            record.type = SJRT_REPLACE_TRAY_FROM_STACK;
+            break;
+        
+        case UAT_REPLACE_TRAY_FROM_PLAYFIELD:
+            record.type = SJRT_REPLACE_TRAY_FROM_PLAYFIELD;
+            break;
+        
+        default:
+            return false;
+    }
+    record.fromCardId = action.fromCardId;
+    record.toCardId = action.toCardId;
+    record.trayX = trayPosition.x;
+    record.trayY = trayPosition.y;
+    return appendRecord(&record, gameModel, undoModel);
+}
+
+bool SaveJournalManager::appendUndo(const GameModel* gameModel, const UndoModel* undoModel)
+{
+    SaveJournalRecord record;
+    memset(&record, 0, sizeof(record));
+    record.type = SJRT_UNDO;
+    record.fromCardId = -1;
+    record.toCardId = -1;
+    return appendRecord(&record, gameModel, undoModel);
+}
+
+bool SaveJournalManager::appendRedo(const UndoAction& action, const CardPosition& trayPosition,
+                                    const GameModel* gameModel, const UndoModel* undoModel)
+{
+    SaveJournalRecord record;
+    memset(&record, 0, sizeof(record));
+    record.type = SJRT_REDO;
+    record.fromCardId = action.fromCardId;
+    record.toCardId = action.toCardId;
+    record.trayX = trayPosition.x;
+    record.trayY = trayPosition.y;
+    return appendRecord(&record, gameModel, undoModel);
+}
+
+bool SaveJournalManager::sync()
+{
+    if (!_file || _unsyncedCount == 0) {
+        return true;
+    }
+    
+    _unsyncedCount = 0;
+    if (!syncFile(_file)) {
+        CORE_LOG("SaveJournalManager: Failed to sync journal: %s", _filePath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void SaveJournalManager::close()
+{
+    if (_file) {
+        sync();
+        fclose(_file);
+        _file = nullptr;
+    }
+    _recordCount = 0;
+    _unsyncedCount = 0;
+}
+
+void SaveJournalManager::discard()
+{
+    close();
+    if (!_filePath.empty()) {
+        remove(_filePath.c_str());
+    }
+}
+
+bool SaveJournalManager::restoreJournal(GameModel* gameModel, UndoModel* undoModel, int* outLevelId)
+{
+    TRACE_ZONE("SaveJournalManager::restoreJournal");
+    
+    close();
+    if (_filePath.empty() || !gameModel || !undoModel) {
+        return false;
+    }
+    
+    FILE* file = fopen(_filePath.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (fileSize < static_cast<long>(sizeof(SaveJournalHeader))) {
+        fclose(file);
+        return false;
+    }
+    _buffer.resize(static_cast<size_t>(fileSize) / sizeof(uint32_t) + 1);
+    size_t size = fread(_buffer.data(), 1, static_cast<size_t>(fileSize), file);
+    fclose(file);
+    if (size < sizeof(SaveJournalHeader)) {
+        return false;
+    }
+    
+    // 校验文件头和基础快照
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(_buffer.data());
+    SaveJournalHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion
+        || header.headerCrc != Crc32::compute(&header, offsetof(SaveJournalHeader, headerCrc))
+        || header.snapshotSize % sizeof(uint32_t) != 0
+        || header.snapshotSize > size - sizeof(SaveJournalHeader)) {
+        CORE_LOG("SaveJournalManager: Invalid journal header: %s", _filePath.c_str());
+        return false;
+    }
+    const uint8_t* snapshot = data + sizeof(SaveJournalHeader);
+    if (Crc32::compute(snapshot, header.snapshotSize) != header.snapshotCrc
+        || !GameSnapshotService::readSnapshot(snapshot, header.snapshotSize, gameModel, undoModel)) {
+        CORE_LOG("SaveJournalManager: Invalid base snapshot: %s", _filePath.c_str());
+        return false;
+    }
+    
+    // 按顺序重放记录，遇到不完整、校验失败或与状态不一致的记录时停止
+    UndoManager undoManager;
+    undoManager.init(undoModel);
+    size_t offset = sizeof(SaveJournalHeader) + header.snapshotSize;
+    uint32_t recordCount = 0;
+    while (offset + sizeof(SaveJournalRecord) <= size) {
+        SaveJournalRecord record;
+        memcpy(&record, data + offset, sizeof(record));
+        if (record.crc != computeRecordCrc(record) || record.sequence != recordCount
+            || !replayRecord(record, gameModel, undoModel, &undoManager)) {
+            break;
+        }
+        offset += sizeof(SaveJournalRecord);
+        recordCount++;
+    }
+    if (offset < size) {
+        CORE_LOG("SaveJournalManager: Discarded %d bytes of torn or invalid records", static_cast<int>(size - offset));
+    }
+    
+    // 恢复后的状态立即作为新的基础快照，损坏的尾部不会留在日志中
+    if (outLevelId) {
+        *outLevelId = header.levelId;
+    }
+    writeJournal(header.levelId, gameModel, undoModel);
+    return true;
+}
+
+bool SaveJournalManager::appendRecord(SaveJournalRecord* record, const GameModel* gameModel, const UndoModel* undoModel)
+{
+    if (!_file) {
+        return false;
+    }
+    
+    record->sequence = _recordCount;
+    record->crc = computeRecordCrc(*record);
+    
+    // 立即交给操作系统，fsync按批进行
+    if (fwrite(record, sizeof(SaveJournalRecord), 1, _file) != 1 || fflush(_file) != 0) {
+        CORE_LOG("SaveJournalManager: Failed to append journal record: %s", _filePath.c_str());
+        fclose(_file);
+        _file = nullptr;
+        return false;
+    }
+    _recordCount++;
+    _unsyncedCount++;
+    
+    if (_recordCount >= static_cast<uint32_t>(kCompactInterval)) {
+        return writeJournal(_levelId, gameModel, undoModel);
+    }
+    if (_unsyncedCount >= kSyncInterval) {
+        return sync();
+    }
+    return true;
+}
+
+bool SaveJournalManager::writeJournal(int levelId, const GameModel* gameModel, const UndoModel* undoModel)
+{
+    if (_file) {
+        fclose(_file);
+        _file = nullptr;
+    }
+    _recordCount = 0;
+    _unsyncedCount = 0;
+    if (_filePath.empty() || !gameModel) {
+        return false;
+    }
+    
+    // 文件头和快照写入同一个缓冲区，快照补齐到4字节
+    size_t snapshotSize = GameSnapshotService::getSnapshotSize(gameModel, undoModel);
+    size_t paddedSize = (snapshotSize + sizeof(uint32_t) - 1) / sizeof(uint32_t) * sizeof(uint32_t);
+    size_t headerWords = sizeof(SaveJournalHeader) / sizeof(uint32_t);
+    _buffer.assign(headerWords + paddedSize / sizeof(uint32_t), 0);
+    uint8_t* snapshot = reinterpret_cast<uint8_t*>(_buffer.data() + headerWords);
+    if (GameSnapshotService::writeSnapshot(gameModel, undoModel, snapshot, paddedSize) != snapshotSize) {
+        CORE_LOG("SaveJournalManager: Failed to write base snapshot");
+        return false;
+    }
+    
+    SaveJournalHeader header;
+    memcpy(header.magic, kMagic, sizeof(header.magic));
+    header.version = kVersion;
+    header.levelId = levelId;
+    header.snapshotSize = static_cast<uint32_t>(paddedSize);
+    header.snapshotCrc = Crc32::compute(snapshot, paddedSize);
+    header.headerCrc = Crc32::compute(&header, offsetof(SaveJournalHeader, headerCrc));
+    memcpy(_buffer.data(), &header, sizeof(header));
+    
+    // 先完整写入临时文件再替换，写到一半崩溃时旧日志仍然有效
+    std::string tempPath = _filePath + ".tmp";
+    FILE* tempFile = fopen(tempPath.c_str(), "wb");
+    if (!tempFile) {
+        CORE_LOG("SaveJournalManager: Failed to open file for writing: %s", tempPath.c_str());
+        return false;
+    }
+    size_t totalSize = _buffer.size() * sizeof(uint32_t);
+    bool written = fwrite(_buffer.data(), 1, totalSize, tempFile) == totalSize && syncFile(tempFile);
+    written = fclose(tempFile) == 0 && written;
+    if (!written || !replaceFile(tempPath, _filePath)) {
+        CORE_LOG("SaveJournalManager: Failed to write journal: %s", _filePath.c_str());
+        remove(tempPath.c_str());
+        return false;
+    }
+    
+    _file = fopen(_filePath.c_str(), "ab");
+    if (!_file) {
+        CORE_LOG("SaveJournalManager: Failed to open journal for appending: %s", _filePath.c_str());
+        return false;
+    }
+    _levelId = levelId;
+    return true;
+}
+
+bool SaveJournalManager::replayRecord(const SaveJournalRecord& record, GameModel* gameModel, const UndoModel* undoModel,
+                                      UndoManager* undoManager)
+{
+    if (record.type == SJRT_UNDO) {
+        return undoManager->canUndo() && undoManager->performUndo(gameModel);
+    }
+    
+    // 重做只移动撤销记录的游标，之后的可重做记录保留
+    if (record.type == SJRT_REDO) {
+        if (!undoManager->canRedo()) {
+            return false;
+        }
+        UndoAction expected = undoModel->peekRedoAction();
+        if (expected.fromCardId != record.fromCardId || expected.toCardId != record.toCardId) {
+            return false;
+        }
+        UndoAction action;
+        return undoManager->performRedo(gameModel, CardPosition(record.trayX, record.trayY), &action);
+    }
+    
+    UndoAction action;
+    switch (record.type) {
+        case SJRT_REPLACE_TRAY_FROM_STACK:
+            action.type = UAT_REPLACE_TRAY_FROM_STACK;
+            break;
+        
+        case SJRT_REPLACE_TRAY_FROM_PLAYFIELD:
+            action.type = UAT_REPLACE_TRAY_FROM_PLAYFIELD;
+            break;
+        
+        default:
+            return false;
+    }
+    action.fromCardId = record.fromCardId;
+    action.toCardId = record.toCardId;
+    if (!GameRulesService::applyAction(gameModel, action, CardPosition(record.trayX, record.trayY))) {
+        return false;
+    }
+    
+    undoManager->recordAction(action);
+    return true;
+}
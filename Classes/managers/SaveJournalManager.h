@@ -0,0 +1,210 @@
+#ifndef __SAVE_JOURNAL_MANAGER_H__
+#define __SAVE_JOURNAL_MANAGER_H__
+
+#include "../models/GameModel.h"
+#include "../models/UndoModel.h"
+#include "../utils/CardPosition.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+class UndoManager;
+
+/**
+ * @file SaveJournalManager.h
+ * @brief 自动存档日志格式
+ * @details 日志文件只追加写入，所有字段为小端：
+ *          [SaveJournalHeader][基础快照（GameSnapshotService格式，snapshotSize字节）][SaveJournalRecord ...]
+ *          基础快照是关卡开始（或上次压缩）时的完整状态，之后每次操作、撤销或重做追加一条定长记录
+ */
+
+/**
+ * @enum SaveJournalRecordType
+ * @brief 日志记录类型
+ */
+enum SaveJournalRecordType
+{
+    SJRT_REPLACE_TRAY_FROM_STACK,       // 从备用牌堆翻牌替换底牌
+    SJRT_REPLACE_TRAY_FROM_PLAYFIELD,   // 从主牌区匹配替换底牌
+    SJRT_UNDO,                          // 撤销上一次操作
+    SJRT_REDO                           // 重做下一条可重做记录（不清除之后的可重做记录）
+};
+
+/**
+ * @struct SaveJournalHeader
+ * @brief 日志文件头（24字节）
+ */
+struct SaveJournalHeader
+{
+    char magic[4];          // 文件标识"GJNL"
+    uint32_t version;       // 格式版本
+    int32_t levelId;        // 关卡ID
+    uint32_t snapshotSize;  // 基础快照字节数（4的倍数）
+    uint32_t snapshotCrc;   // 基础快照的CRC32
+    uint32_t headerCrc;     // 以上字段的CRC32
+};
+
+/**
+ * @struct SaveJournalRecord
+ * @brief 日志记录（28字节）
+ * @details 操作记录保存操作产生的UndoAction和新底牌位置；撤销记录只有类型和序号；
+ *          重做记录保存重做的卡牌ID（恢复时校验与可重做记录一致）和底牌位置
+ */
+struct SaveJournalRecord
+{
+    uint32_t sequence;      // 记录序号（从0开始连续递增）
+    int32_t type;           // 记录类型（SaveJournalRecordType）
+    int32_t fromCardId;     // 移到底牌堆的卡牌ID
+    int32_t toCardId;       // 被替换的底牌ID
+    float trayX;            // 底牌堆位置
+    float trayY;
+    uint32_t crc;           // 以上字段的CRC32
+};
+
+/**
+ * @class SaveJournalManager
+ * @brief 自动存档日志管理器
+ * @details 关卡开始时写入基础快照，之后每次操作只追加一条定长记录，存档开销与卡牌数量无关
+ *          每条记录写入后立即交给操作系统（应用崩溃不丢失），每kSyncInterval条或调用sync时才fsync，
+ *          断电时最多丢失最近几条记录；记录带序号和CRC，末尾写了一半的记录在恢复时被丢弃
+ *          记录达到kCompactInterval条时把当前状态写成新的基础快照（先写临时文件再原子替换）
+ *          恢复时读取基础快照并按记录重放操作、撤销和重做（撤销和重做只移动撤销记录的游标），
+ *          随后立即压缩（快照同时保存可重做记录），丢弃损坏的尾部
+ *          作为Controller的成员变量，不实现为单例
+ */
+class SaveJournalManager
+{
+public:
+    /**
+     * @brief 文件标识与当前格式版本
+     */
+    static const char kMagic[4];
+    static const uint32_t kVersion = 3;
+    
+    /**
+     * @brief 每追加多少条记录fsync一次
+     */
+    static const int kSyncInterval = 8;
+    
+    /**
+     * @brief 记录达到多少条时压缩为新的基础快照
+     */
+    static const int kCompactInterval = 256;
+    
+    /**
+     * @brief 构造函数
+     */
+    SaveJournalManager();
+    
+    /**
+     * @brief 析构函数（同步并关闭日志）
+     */
+    ~SaveJournalManager();
+    
+    /**
+     * @brief 初始化
+     * @param filePath 日志文件路径（压缩时使用同目录下的filePath.tmp）
+     */
+    void init(const std::string& filePath);
+    
+    /**
+     * @brief 开始新日志（关卡开始时调用），写入基础快照并打开日志等待追加
+     * @param levelId 关卡ID
+     * @param gameModel 游戏数据模型
+     * @param undoModel 撤销数据模型
+     * @return 写入失败时返回false（之后的追加被忽略）
+     */
+    bool startJournal(int levelId, const GameModel* gameModel, const UndoModel* undoModel);
+    
+    /**
+     * @brief 追加一条操作记录（操作已应用到模型之后调用）
+     * @param action 操作产生的撤销记录
+     * @param trayPosition 操作时使用的底牌堆位置
+     * @param gameModel 操作后的游戏数据模型（压缩时使用）
+     * @param undoModel 操作后的撤销数据模型（压缩时使用）
+     * @return 写入失败时返回false
+     */
+    bool appendMove(const UndoAction& action, const CardPosition& trayPosition,
+                    const GameModel* gameModel, const UndoModel* undoModel);
+    
+    /**
+     * @brief 追加一条撤销记录（撤销已应用到模型之后调用）
+     * @param gameModel 撤销后的游戏数据模型（压缩时使用）
+     * @param undoModel 撤销后的撤销数据模型（压缩时使用）
+     * @return 写入失败时返回false
+     */
+    bool appendUndo(const GameModel* gameModel, const UndoModel* undoModel);
+    
+    /**
+     * @brief 追加一条重做记录（重做已应用到模型之后调用）
+     * @param action 重做的撤销记录
+     * @param trayPosition 重做时使用的底牌堆位置
+     * @param gameModel 重做后的游戏数据模型（压缩时使用）
+     * @param undoModel 重做后的撤销数据模型（压缩时使用）
+     * @return 写入失败时返回false
+     */
+    bool appendRedo(const UndoAction& action, const CardPosition& trayPosition,
+                    const GameModel* gameModel, const UndoModel* undoModel);
+    
+    /**
+     * @brief 把已追加的记录fsync到存储设备（应用进入后台时调用）
+     * @return 同步失败时返回false
+     */
+    bool sync();
+    
+    /**
+     * @brief 同步并关闭日志（文件保留，可再次恢复）
+     */
+    void close();
+    
+    /**
+     * @brief 关闭并删除日志（关卡结束时调用）
+     */
+    void discard();
+    
+    /**
+     * @brief 从日志恢复游戏，恢复后打开日志继续追加
+     * @param gameModel 输出游戏数据模型（原有内容被替换）
+     * @param undoModel 输出撤销数据模型（原有内容被替换）
+     * @param outLevelId 输出关卡ID
+     * @return 没有日志或基础快照损坏时返回false；尾部记录损坏只丢弃损坏的记录
+     */
+    bool restoreJournal(GameModel* gameModel, UndoModel* undoModel, int* outLevelId);
+    
+    /**
+     * @brief 获取当前日志中的记录数量
+     */
+    int getRecordCount() const { return static_cast<int>(_recordCount); }
+    
+private:
+    /**
+     * @brief 填写序号和CRC后追加记录，按需同步或压缩
+     */
+    bool appendRecord(SaveJournalRecord* record, const GameModel* gameModel, const UndoModel* undoModel);
+    
+    /**
+     * @brief 以当前状态为基础快照写出新日志（写临时文件后原子替换），并打开等待追加
+     */
+    bool writeJournal(int levelId, const GameModel* gameModel, const UndoModel* undoModel);
+    
+    /**
+     * @brief 把一条记录重放到模型上
+     * @return 记录与模型状态不一致时返回false
+     */
+    static bool replayRecord(const SaveJournalRecord& record, GameModel* gameModel, const UndoModel* undoModel,
+                             UndoManager* undoManager);
+    
+    SaveJournalManager(const SaveJournalManager&) = delete;
+    SaveJournalManager& operator=(const SaveJournalManager&) = delete;
+    
+private:
+    std::string _filePath;                  // 日志文件路径
+    FILE* _file;                            // 追加写入的日志文件（未打开时为nullptr）
+    int _levelId;                           // 当前日志的关卡ID
+    uint32_t _recordCount;                  // 当前日志中的记录数量
+    int _unsyncedCount;                     // 尚未fsync的记录数量
+    std::vector<uint32_t> _buffer;          // 快照读写缓冲区（4字节对齐，复用）
+};
+
+#endif // __SAVE_JOURNAL_MANAGER_H__
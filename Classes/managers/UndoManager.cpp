@@ -1,10 +1,11 @@
 #include "UndoManager.h"
-#include "cocos2d.h"
-
-USING_NS_CC;
+#include "../services/GameRulesService.h"
+#include "../utils/CoreLog.h"
+#include "../utils/TraceProfiler.h"
 
 UndoManager::UndoManager()
     : _undoModel(nullptr)
+    , _moveTree(nullptr)
     , _animationCallback(nullptr)
 {
 }
@@ -18,26 +19,36 @@ void UndoManager::init(UndoModel* undoModel)
     _undoModel = undoModel;
 }
 
+void UndoManager::setMoveTree(MoveTree* moveTree)
+{
+    _moveTree = moveTree;
+}
+
 void UndoManager::recordAction(const UndoAction& action)
 {
     if (_undoModel) {
         _undoModel->pushAction(action);
-        CCLOG("UndoManager: Recorded action type=%d, fromCardId=%d, toCardId=%d", 
+        if (_moveTree) {
+            _moveTree->recordMove(action);
+        }
+        CORE_LOG("UndoManager: Recorded action type=%d, fromCardId=%d, toCardId=%d", 
               action.type, action.fromCardId, action.toCardId);
     }
 }
 
 bool UndoManager::performUndo(GameModel* gameModel)
 {
+    TRACE_ZONE("UndoManager::performUndo");
+    
     if (!_undoModel || !gameModel || !canUndo()) {
-        CCLOG("UndoManager: Cannot undo");
+        CORE_LOG("UndoManager: Cannot undo");
         return false;
     }
     
     // 弹出最后一个操作
     UndoAction action = _undoModel->popAction();
     
-    CCLOG("UndoManager: Performing undo, type=%d, fromCardId=%d, toCardId=%d", 
+    CORE_LOG("UndoManager: Performing undo, type=%d, fromCardId=%d, toCardId=%d", 
           action.type, action.fromCardId, action.toCardId);
     
     // 根据操作类型执行相应的撤销逻辑
@@ -45,16 +56,20 @@ bool UndoManager::performUndo(GameModel* gameModel)
         case UAT_REPLACE_TRAY_FROM_STACK:
             undoReplaceTrayFromStack(action, gameModel);
             break;
-            
+        
         case UAT_REPLACE_TRAY_FROM_PLAYFIELD:
             undoReplaceTrayFromPlayfield(action, gameModel);
             break;
-            
+        
         default:
-            CCLOG("UndoManager: Unknown action type");
+            CORE_LOG("UndoManager: Unknown action type");
             return false;
     }
     
+    if (_moveTree) {
+        _moveTree->stepBack(action);
+    }
+    
     // 通知View层执行撤销动画
     if (_animationCallback) {
         _animationCallback(action);
@@ -68,11 +83,48 @@ bool UndoManager::canUndo() const
     return _undoModel && _undoModel->canUndo();
 }
 
+bool UndoManager::performRedo(GameModel* gameModel, const CardPosition& trayPosition, UndoAction* outAction)
+{
+    TRACE_ZONE("UndoManager::performRedo");
+    
+    if (!canRedo()) {
+        CORE_LOG("UndoManager: Cannot redo");
+        return false;
+    }
+    
+    if (_moveTree) {
+        const MoveTreeNode* branch = _moveTree->getRedoChild();
+        return redoAction(branch->action, branch, gameModel, trayPosition, outAction);
+    }
+    return redoAction(_undoModel->peekRedoAction(), nullptr, gameModel, trayPosition, outAction);
+}
+
+bool UndoManager::performRedoBranch(GameModel* gameModel, const CardPosition& trayPosition,
+                                    const MoveTreeNode* branch, UndoAction* outAction)
+{
+    if (!_undoModel || !_moveTree || !branch || branch->parent != _moveTree->getCurrent()) {
+        CORE_LOG("UndoManager: Invalid redo branch");
+        return false;
+    }
+    return redoAction(branch->action, branch, gameModel, trayPosition, outAction);
+}
+
+bool UndoManager::canRedo() const
+{
+    if (!_undoModel) {
+        return false;
+    }
+    return _moveTree ? _moveTree->getRedoChild() != nullptr : _undoModel->canRedo();
+}
+
 void UndoManager::clearHistory()
 {
     if (_undoModel) {
         _undoModel->clear();
     }
+    if (_moveTree) {
+        _moveTree->clear();
+    }
 }
 
 void UndoManager::setUndoAnimationCallback(const UndoAnimationCallback& callback)
@@ -92,7 +144,7 @@ void UndoManager::undoReplaceTrayFromStack(const UndoAction& action, GameModel*
     CardModel* toCard = gameModel->getCardById(toCardId);
     
     if (!fromCard || !toCard) {
-        CCLOG("UndoManager: Card not found in undoReplaceTrayFromStack");
+        CORE_LOG("UndoManager: Card not found in undoReplaceTrayFromStack");
         return;
     }
     
@@ -100,17 +152,14 @@ void UndoManager::undoReplaceTrayFromStack(const UndoAction& action, GameModel*
     fromCard->setLocation(CL_STACK);
     fromCard->setFlipped(false);
     fromCard->setClickable(false);
-    fromCard->setPosition(action.fromPosition);
+    fromCard->setPosition(fromCard->getHomePosition());
     
-    std::vector<int> stackIds = gameModel->getStackCardIds();
-    stackIds.push_back(fromCardId);
-    gameModel->setStackCardIds(stackIds);
+    gameModel->pushToStack(fromCardId);
     
-    // 恢复toCard为底牌
+    // 恢复toCard为底牌（被替换后位置未变）
     toCard->setLocation(CL_TRAY);
     toCard->setFlipped(true);
     toCard->setClickable(false);
-    toCard->setPosition(action.toPosition);
     
     gameModel->setTrayCardId(toCardId);
 }
@@ -127,25 +176,50 @@ void UndoManager::undoReplaceTrayFromPlayfield(const UndoAction& action, GameMod
     CardModel* toCard = gameModel->getCardById(toCardId);
     
     if (!fromCard || !toCard) {
-        CCLOG("UndoManager: Card not found in undoReplaceTrayFromPlayfield");
+        CORE_LOG("UndoManager: Card not found in undoReplaceTrayFromPlayfield");
         return;
     }
     
-    // 将fromCard放回主牌区
+    // 将fromCard放回主牌区原来的位置（可点击状态由insertToPlayfield按遮挡关系设置，它压住的卡牌同时变为不可点击）
     fromCard->setLocation(CL_PLAYFIELD);
     fromCard->setFlipped(true);
-    fromCard->setClickable(true);
-    fromCard->setPosition(action.fromPosition);
+    fromCard->setPosition(fromCard->getHomePosition());
     
-    std::vector<int> playfieldIds = gameModel->getPlayfieldCardIds();
-    playfieldIds.push_back(fromCardId);
-    gameModel->setPlayfieldCardIds(playfieldIds);
+    gameModel->insertToPlayfield(fromCardId);
     
-    // 恢复toCard为底牌
+    // 恢复toCard为底牌（被替换后位置未变）
     toCard->setLocation(CL_TRAY);
     toCard->setFlipped(true);
     toCard->setClickable(false);
-    toCard->setPosition(action.toPosition);
     
     gameModel->setTrayCardId(toCardId);
-} 
\ No newline at end of file
+}
+
+bool UndoManager::redoAction(const UndoAction& action, const MoveTreeNode* branch, GameModel* gameModel,
+                             const CardPosition& trayPosition, UndoAction* outAction)
+{
+    if (!GameRulesService::applyAction(gameModel, action, trayPosition)) {
+        CORE_LOG("UndoManager: Redo action does not match current state");
+        return false;
+    }
+    
+    CORE_LOG("UndoManager: Performing redo, type=%d, fromCardId=%d, toCardId=%d",
+          action.type, action.fromCardId, action.toCardId);
+    
+    // 重做的正是最近撤销的记录时把它移回撤销记录，否则（选择了其他分支）作为新记录添加
+    UndoAction redoTop = _undoModel->peekRedoAction();
+    if (_undoModel->canRedo() && redoTop.type == action.type && redoTop.fromCardId == action.fromCardId
+        && redoTop.toCardId == action.toCardId) {
+        _undoModel->redoAction();
+    } else {
+        _undoModel->pushAction(action);
+    }
+    if (_moveTree) {
+        _moveTree->stepForward(branch);
+    }
+    
+    if (outAction) {
+        *outAction = action;
+    }
+    return true;
+}
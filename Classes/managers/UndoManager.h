@@ -3,12 +3,15 @@
 
 #include "../models/UndoModel.h"
 #include "../models/GameModel.h"
+#include "../models/MoveTree.h"
+#include "../utils/CardPosition.h"
 #include <functional>
 
 /**
  * @class UndoManager
  * @brief 撤销管理器
- * @details 管理撤销功能，持有UndoModel数据并提供撤销操作
+ * @details 管理撤销和重做功能，持有UndoModel数据并提供撤销、重做操作
+ *          可选地同步维护一棵MoveTree，保留撤销后被放弃的分支供复盘分析
  *          作为Controller的成员变量，不实现为单例
  *          通过回调接口与其他模块交互
  */
@@ -37,6 +40,13 @@ public:
      */
     void init(UndoModel* undoModel);
     
+    /**
+     * @brief 设置操作树（可为nullptr，不记录分支）
+     * @param moveTree 操作树，当前节点视为当前状态
+     * @details 设置后重做沿操作树进行，可以选择被放弃的分支
+     */
+    void setMoveTree(MoveTree* moveTree);
+    
     /**
      * @brief 记录一次操作（用于撤销）
      * @param action 操作数据
@@ -58,7 +68,33 @@ public:
     bool canUndo() const;
     
     /**
-     * @brief 清空所有撤销记录
+     * @brief 重做最近撤销的操作（设置了操作树时为当前节点的默认分支）
+     * @param gameModel 游戏数据模型
+     * @param trayPosition 底牌堆位置
+     * @param outAction 输出重做的操作，可为nullptr
+     * @return 如果成功重做返回true
+     * @details 通过GameRulesService重新执行操作，与正常操作修改模型的路径相同
+     */
+    bool performRedo(GameModel* gameModel, const CardPosition& trayPosition, UndoAction* outAction);
+    
+    /**
+     * @brief 沿操作树的指定分支重做
+     * @param gameModel 游戏数据模型
+     * @param trayPosition 底牌堆位置
+     * @param branch 操作树当前节点的子节点
+     * @param outAction 输出重做的操作，可为nullptr
+     * @return 没有操作树、branch不是当前节点的子节点或操作与状态不一致时返回false
+     */
+    bool performRedoBranch(GameModel* gameModel, const CardPosition& trayPosition,
+                           const MoveTreeNode* branch, UndoAction* outAction);
+    
+    /**
+     * @brief 检查是否可以重做
+     */
+    bool canRedo() const;
+    
+    /**
+     * @brief 清空所有撤销、重做记录和操作树
      */
     void clearHistory();
     
@@ -83,8 +119,16 @@ private:
      */
     void undoReplaceTrayFromPlayfield(const UndoAction& action, GameModel* gameModel);
     
+    /**
+     * @brief 重新执行操作并更新撤销记录和操作树
+     * @param branch 操作树中对应的子节点（没有操作树时为nullptr）
+     */
+    bool redoAction(const UndoAction& action, const MoveTreeNode* branch, GameModel* gameModel,
+                    const CardPosition& trayPosition, UndoAction* outAction);
+    
 private:
     UndoModel* _undoModel;                      // 撤销数据模型
+    MoveTree* _moveTree;                        // 操作树（可为nullptr）
     UndoAnimationCallback _animationCallback;   // 动画回调
 };
 
@@ -0,0 +1,203 @@
+#include "CardCoverGraph.h"
+#include "../utils/SpatialGrid.h"
+#include <algorithm>
+
+CardCoverGraph::CardCoverGraph()
+{
+}
+
+void CardCoverGraph::clear()
+{
+    _drawOrder.clear();
+    _coveredOffsets.clear();
+    _coveredIds.clear();
+    _coverCounts.clear();
+    _present.clear();
+    _drawRanks.clear();
+}
+
+void CardCoverGraph::build(const std::vector<int>& cardIds, const std::vector<CardPosition>& positions)
+{
+    clear();
+    
+    int maxCardId = -1;
+    size_t cardCount = std::min(cardIds.size(), positions.size());
+    for (size_t i = 0; i < cardCount; i++) {
+        maxCardId = std::max(maxCardId, cardIds[i]);
+    }
+    if (maxCardId < 0) {
+        return;
+    }
+    
+    size_t idCount = static_cast<size_t>(maxCardId) + 1;
+    _coverCounts.assign(idCount, 0);
+    _present.assign(idCount, 0);
+    _drawRanks.assign(idCount, -1);
+    
+    // 按绘制顺序插入网格：插入前查到的重叠卡牌都在下层，即被当前卡牌压住
+    std::vector<std::vector<int> > coveredLists(idCount);
+    SpatialGrid grid;
+    std::vector<int> overlaps;
+    for (size_t i = 0; i < cardCount; i++) {
+        int cardId = cardIds[i];
+        if (cardId < 0) {
+            continue;
+        }
+        CardRect rect = makeCardRect(positions[i]);
+        overlaps.clear();
+        grid.query(rect, &overlaps);
+        std::vector<int>& covered = coveredLists[cardId];
+        covered.insert(covered.end(), overlaps.begin(), overlaps.end());
+        grid.insert(cardId, rect);
+        _drawRanks[cardId] = static_cast<int>(_drawOrder.size());
+        _drawOrder.push_back(cardId);
+    }
+    
+    // 展平为压缩邻接表
+    _coveredOffsets.assign(idCount + 1, 0);
+    for (size_t cardId = 0; cardId < idCount; cardId++) {
+        _coveredOffsets[cardId + 1] = _coveredOffsets[cardId] + static_cast<int>(coveredLists[cardId].size());
+    }
+    _coveredIds.reserve(_coveredOffsets[idCount]);
+    for (size_t cardId = 0; cardId < idCount; cardId++) {
+        std::sort(coveredLists[cardId].begin(), coveredLists[cardId].end());
+        _coveredIds.insert(_coveredIds.end(), coveredLists[cardId].begin(), coveredLists[cardId].end());
+    }
+    
+    setPresentCards(std::vector<int>(cardIds.begin(), cardIds.begin() + cardCount));
+}
+
+bool CardCoverGraph::restore(const int* drawOrder, int cardCount, const int* coveredOffsets, int idCount,
+                             const int* coveredIds, int edgeCount)
+{
+    clear();
+    if (idCount <= 0) {
+        return cardCount == 0 && edgeCount == 0;
+    }
+    
+    _drawRanks.assign(idCount, -1);
+    for (int i = 0; i < cardCount; i++) {
+        if (drawOrder[i] < 0 || drawOrder[i] >= idCount || _drawRanks[drawOrder[i]] >= 0) {
+            clear();
+            return false;
+        }
+        _drawRanks[drawOrder[i]] = i;
+    }
+    
+    // 偏移单调递增，边只在图中的卡牌之间
+    if (coveredOffsets[0] != 0 || coveredOffsets[idCount] != edgeCount) {
+        clear();
+        return false;
+    }
+    for (int cardId = 0; cardId < idCount; cardId++) {
+        int begin = coveredOffsets[cardId];
+        int end = coveredOffsets[cardId + 1];
+        if (end < begin || (end > begin && _drawRanks[cardId] < 0)) {
+            clear();
+            return false;
+        }
+    }
+    for (int i = 0; i < edgeCount; i++) {
+        if (coveredIds[i] < 0 || coveredIds[i] >= idCount || _drawRanks[coveredIds[i]] < 0) {
+            clear();
+            return false;
+        }
+    }
+    
+    _drawOrder.assign(drawOrder, drawOrder + cardCount);
+    _coveredOffsets.assign(coveredOffsets, coveredOffsets + idCount + 1);
+    _coveredIds.assign(coveredIds, coveredIds + edgeCount);
+    _coverCounts.assign(idCount, 0);
+    _present.assign(idCount, 0);
+    setPresentCards(_drawOrder);
+    return true;
+}
+
+void CardCoverGraph::setPresentCards(const std::vector<int>& cardIds)
+{
+    std::fill(_present.begin(), _present.end(), 0);
+    std::fill(_coverCounts.begin(), _coverCounts.end(), 0);
+    
+    for (int cardId : cardIds) {
+        if (contains(cardId)) {
+            _present[cardId] = 1;
+        }
+    }
+    for (size_t cardId = 0; cardId < _present.size(); cardId++) {
+        if (!_present[cardId]) {
+            continue;
+        }
+        for (int i = _coveredOffsets[cardId]; i < _coveredOffsets[cardId + 1]; i++) {
+            _coverCounts[_coveredIds[i]]++;
+        }
+    }
+}
+
+int CardCoverGraph::getDrawRank(int cardId) const
+{
+    if (cardId < 0 || static_cast<size_t>(cardId) >= _drawRanks.size()) {
+        return -1;
+    }
+    return _drawRanks[cardId];
+}
+
+bool CardCoverGraph::contains(int cardId) const
+{
+    return getDrawRank(cardId) >= 0;
+}
+
+bool CardCoverGraph::isPresent(int cardId) const
+{
+    return contains(cardId) && _present[cardId];
+}
+
+bool CardCoverGraph::isCovered(int cardId) const
+{
+    return contains(cardId) && _coverCounts[cardId] > 0;
+}
+
+void CardCoverGraph::removeCard(int cardId, std::vector<int>* outUncoveredIds)
+{
+    if (!isPresent(cardId)) {
+        return;
+    }
+    
+    _present[cardId] = 0;
+    for (int i = _coveredOffsets[cardId]; i < _coveredOffsets[cardId + 1]; i++) {
+        int coveredId = _coveredIds[i];
+        if (--_coverCounts[coveredId] == 0 && _present[coveredId] && outUncoveredIds) {
+            outUncoveredIds->push_back(coveredId);
+        }
+    }
+}
+
+void CardCoverGraph::restoreCard(int cardId, std::vector<int>* outCoveredIds)
+{
+    if (!contains(cardId) || _present[cardId]) {
+        return;
+    }
+    
+    _present[cardId] = 1;
+    for (int i = _coveredOffsets[cardId]; i < _coveredOffsets[cardId + 1]; i++) {
+        int coveredId = _coveredIds[i];
+        if (_coverCounts[coveredId]++ == 0 && _present[coveredId] && outCoveredIds) {
+            outCoveredIds->push_back(coveredId);
+        }
+    }
+}
+
+void CardCoverGraph::getCoveredCards(int cardId, const int** outBegin, const int** outEnd) const
+{
+    const int* begin = nullptr;
+    const int* end = nullptr;
+    if (contains(cardId) && !_coveredIds.empty()) {
+        begin = _coveredIds.data() + _coveredOffsets[cardId];
+        end = _coveredIds.data() + _coveredOffsets[cardId + 1];
+    }
+    if (outBegin) {
+        *outBegin = begin;
+    }
+    if (outEnd) {
+        *outEnd = end;
+    }
+}
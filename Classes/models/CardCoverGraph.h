@@ -0,0 +1,127 @@
+#ifndef __CARD_COVER_GRAPH_H__
+#define __CARD_COVER_GRAPH_H__
+
+#include "../utils/CardPosition.h"
+#include <vector>
+
+/**
+ * @class CardCoverGraph
+ * @brief 主牌区卡牌遮挡关系（有向无环图）
+ * @details 卡牌按绘制顺序排列，后绘制的卡牌与先绘制的卡牌矩形有重叠时，前者压住后者；
+ *          边只从后绘制的卡牌指向先绘制的卡牌，因此天然无环
+ *          构建时通过SpatialGrid只检测相邻格子中的卡牌，边以压缩邻接表（CSR）按卡牌ID存储
+ *          每张卡牌记录压住它的在场卡牌数量，卡牌离开或回到主牌区时只更新它压住的卡牌，
+ *          计数为0的在场卡牌即为未被遮挡（可点击）的卡牌
+ */
+class CardCoverGraph
+{
+public:
+    /**
+     * @brief 构造函数
+     */
+    CardCoverGraph();
+    
+    /**
+     * @brief 清空遮挡关系
+     */
+    void clear();
+    
+    /**
+     * @brief 根据卡牌位置构建遮挡关系（所有卡牌初始均在场）
+     * @param cardIds 卡牌ID（非负），按绘制顺序排列（后面的卡牌绘制在上层）
+     * @param positions 与cardIds一一对应的卡牌中心坐标
+     */
+    void build(const std::vector<int>& cardIds, const std::vector<CardPosition>& positions);
+    
+    /**
+     * @brief 从压缩邻接表恢复遮挡关系（读取存档时使用，不重新检测重叠）
+     * @param drawOrder 卡牌绘制顺序
+     * @param cardCount 绘制顺序中的卡牌数量
+     * @param coveredOffsets 按卡牌ID下标的边起始位置（长度为idCount+1）
+     * @param idCount 卡牌ID上限（最大卡牌ID+1，没有卡牌时为0）
+     * @param coveredIds 被压住的卡牌ID
+     * @param edgeCount 边数量
+     * @return 数据不一致时返回false（遮挡关系被清空）
+     * @details 恢复后所有卡牌均在场，复用已有容量，不重新分配内存
+     */
+    bool restore(const int* drawOrder, int cardCount, const int* coveredOffsets, int idCount,
+                 const int* coveredIds, int edgeCount);
+    
+    /**
+     * @brief 重新设置在场卡牌并重算遮挡计数
+     * @param cardIds 在场卡牌ID（不在图中的ID忽略）
+     */
+    void setPresentCards(const std::vector<int>& cardIds);
+    
+    /**
+     * @brief 卡牌是否在图中
+     */
+    bool contains(int cardId) const;
+    
+    /**
+     * @brief 获取卡牌在绘制顺序中的序号（即在初始主牌区中的顺序，不在图中返回-1）
+     */
+    int getDrawRank(int cardId) const;
+    
+    /**
+     * @brief 卡牌是否在场
+     */
+    bool isPresent(int cardId) const;
+    
+    /**
+     * @brief 卡牌是否被在场卡牌压住（不在图中的卡牌视为未被压住）
+     */
+    bool isCovered(int cardId) const;
+    
+    /**
+     * @brief 卡牌离开主牌区
+     * @param cardId 卡牌ID
+     * @param outUncoveredIds 输出因此变为未被遮挡的在场卡牌ID（追加，可为nullptr）
+     */
+    void removeCard(int cardId, std::vector<int>* outUncoveredIds);
+    
+    /**
+     * @brief 卡牌回到主牌区
+     * @param cardId 卡牌ID
+     * @param outCoveredIds 输出因此变为被遮挡的在场卡牌ID（追加，可为nullptr）
+     */
+    void restoreCard(int cardId, std::vector<int>* outCoveredIds);
+    
+    /**
+     * @brief 获取卡牌直接压住的卡牌
+     * @param cardId 卡牌ID
+     * @param outBegin 输出起始指针
+     * @param outEnd 输出结束指针（不在图中或没有压住卡牌时与outBegin相等）
+     */
+    void getCoveredCards(int cardId, const int** outBegin, const int** outEnd) const;
+    
+    /**
+     * @brief 获取构建时的卡牌绘制顺序
+     */
+    const std::vector<int>& getDrawOrder() const { return _drawOrder; }
+    
+    /**
+     * @brief 获取按卡牌ID下标的边起始位置（长度为ID上限+1，没有卡牌时为空）
+     */
+    const std::vector<int>& getCoveredOffsets() const { return _coveredOffsets; }
+    
+    /**
+     * @brief 获取所有边的被压住卡牌ID（按压住它的卡牌ID分段）
+     */
+    const std::vector<int>& getCoveredIds() const { return _coveredIds; }
+    
+    /**
+     * @brief 获取边数量
+     */
+    int getEdgeCount() const { return static_cast<int>(_coveredIds.size()); }
+    
+private:
+    std::vector<int> _drawOrder;            // 构建时的卡牌绘制顺序
+    std::vector<int> _coveredOffsets;       // 按卡牌ID下标的边起始位置（长度为ID上限+1）
+    std::vector<int> _coveredIds;           // 被压住的卡牌ID
+    std::vector<int> _coverCounts;          // 压住该卡牌的在场卡牌数量（按卡牌ID下标）
+    std::vector<char> _present;             // 是否在场（按卡牌ID下标，不在图中为0）
+    std::vector<int> _drawRanks;            // 在绘制顺序中的序号（按卡牌ID下标，不在图中为-1）
+};
+
+#endif // __CARD_COVER_GRAPH_H__
@@ -6,7 +6,8 @@ CardModel::CardModel(CardFaceType face, CardSuitType suit, int cardId)
     , _face(face)
     , _suit(suit)
     , _location(CL_NONE)
-    , _position(cocos2d::Vec2::ZERO)
+    , _position()
+    , _homePosition()
     , _isFlipped(false)
     , _isClickable(false)
 {
@@ -36,6 +37,7 @@ int CardModel::getFaceValue() const
     return static_cast<int>(_face) + 1;
 }
 
+#if POKER_CORE_JSON
 rapidjson::Value CardModel::serialize(rapidjson::Document::AllocatorType& allocator) const
 {
     rapidjson::Value obj(rapidjson::kObjectType);
@@ -50,6 +52,11 @@ rapidjson::Value CardModel::serialize(rapidjson::Document::AllocatorType& alloca
     pos.AddMember("y", _position.y, allocator);
     obj.AddMember("position", pos, allocator);
     
+    rapidjson::Value homePos(rapidjson::kObjectType);
+    homePos.AddMember("x", _homePosition.x, allocator);
+    homePos.AddMember("y", _homePosition.y, allocator);
+    obj.AddMember("homePosition", homePos, allocator);
+    
     obj.AddMember("isFlipped", _isFlipped, allocator);
     obj.AddMember("isClickable", _isClickable, allocator);
     
@@ -75,10 +82,16 @@ void CardModel::deserialize(const rapidjson::Value& json)
         _position.x = pos["x"].GetFloat();
         _position.y = pos["y"].GetFloat();
     }
+    if (json.HasMember("homePosition")) {
+        const auto& pos = json["homePosition"];
+        _homePosition.x = pos["x"].GetFloat();
+        _homePosition.y = pos["y"].GetFloat();
+    }
     if (json.HasMember("isFlipped")) {
         _isFlipped = json["isFlipped"].GetBool();
     }
     if (json.HasMember("isClickable")) {
         _isClickable = json["isClickable"].GetBool();
     }
-} 
\ No newline at end of file
+} 
+#endif
@@ -1,9 +1,11 @@
 #ifndef __CARD_MODEL_H__
 #define __CARD_MODEL_H__
 
-#include "cocos2d.h"
 #include "../utils/CardDefines.h"
+#include "../utils/CardPosition.h"
+#if POKER_CORE_JSON
 #include "json/document.h"
+#endif
 
 /**
  * @class CardModel
@@ -32,7 +34,8 @@ public:
     CardFaceType getFace() const { return _face; }
     CardSuitType getSuit() const { return _suit; }
     CardLocation getLocation() const { return _location; }
-    const cocos2d::Vec2& getPosition() const { return _position; }
+    const CardPosition& getPosition() const { return _position; }
+    const CardPosition& getHomePosition() const { return _homePosition; }
     bool isFlipped() const { return _isFlipped; }
     bool isClickable() const { return _isClickable; }
     
@@ -41,7 +44,8 @@ public:
     void setFace(CardFaceType face) { _face = face; }
     void setSuit(CardSuitType suit) { _suit = suit; }
     void setLocation(CardLocation location) { _location = location; }
-    void setPosition(const cocos2d::Vec2& position) { _position = position; }
+    void setPosition(const CardPosition& position) { _position = position; }
+    void setHomePosition(const CardPosition& position) { _homePosition = position; }
     void setFlipped(bool flipped) { _isFlipped = flipped; }
     void setClickable(bool clickable) { _isClickable = clickable; }
     
@@ -59,6 +63,7 @@ public:
      */
     int getFaceValue() const;
     
+#if POKER_CORE_JSON
     /**
      * @brief 序列化为JSON
      * @return JSON对象
@@ -70,13 +75,15 @@ public:
      * @param json JSON对象
      */
     void deserialize(const rapidjson::Value& json);
+#endif
     
 private:
     int _cardId;                    // 卡牌唯一ID
     CardFaceType _face;             // 牌面类型
     CardSuitType _suit;             // 花色类型
     CardLocation _location;         // 当前位置
-    cocos2d::Vec2 _position;        // 屏幕坐标位置
+    CardPosition _position;         // 屏幕坐标位置
+    CardPosition _homePosition;     // 发牌位置（撤销移回主牌区或备用牌堆时恢复）
     bool _isFlipped;                // 是否翻开
     bool _isClickable;              // 是否可点击
 };
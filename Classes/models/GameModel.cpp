@@ -2,58 +2,353 @@
 #include <algorithm>
 
 GameModel::GameModel()
-    : _trayCardId(-1)
+    : _cardCount(0)
+    , _usedChunkCards(0)
+    , _trayFaceValue(-1)
+    , _trayCardId(-1)
 {
 }
 
 GameModel::~GameModel()
 {
     clear();
+    
+    for (size_t i = 0; i < _cardChunks.size(); i++) {
+        delete[] _cardChunks[i];
+    }
 }
 
 void GameModel::clear()
 {
-    // 释放所有卡牌内存
-    for (auto& pair : _cards) {
-        delete pair.second;
+    // 释放addCard接管的卡牌，内存块保留复用
+    for (size_t i = 0; i < _adoptedCards.size(); i++) {
+        delete _adoptedCards[i];
+    }
+    _adoptedCards.clear();
+    _freeCards.clear();
+    _usedChunkCards = 0;
+    
+    _cardSlots.clear();
+    _cardCount = 0;
+    for (int i = 0; i < kFaceBucketCount; i++) {
+        _faceBuckets[i].clear();
     }
-    _cards.clear();
+    _bucketSlotById.clear();
+    _trayFaceValue = -1;
+    _coverGraph.clear();
+    _clickableChangedIds.clear();
+    _clickableChangedFlags.clear();
     _playfieldCardIds.clear();
     _stackCardIds.clear();
     _trayCardId = -1;
 }
 
+CardModel* GameModel::createCard(CardFaceType face, CardSuitType suit, int cardId)
+{
+    if (cardId < 0) {
+        return nullptr;
+    }
+    
+    CardModel* card = allocateCard();
+    *card = CardModel(face, suit, cardId);
+    registerCard(card);
+    return card;
+}
+
 void GameModel::addCard(CardModel* card)
 {
-    if (card) {
-        _cards[card->getCardId()] = card;
+    if (card && card->getCardId() >= 0) {
+        _adoptedCards.push_back(card);
+        registerCard(card);
     }
 }
 
 CardModel* GameModel::getCardById(int cardId) const
 {
-    auto it = _cards.find(cardId);
-    if (it != _cards.end()) {
-        return it->second;
+    if (cardId >= 0 && static_cast<size_t>(cardId) < _cardSlots.size()) {
+        return _cardSlots[cardId];
     }
     return nullptr;
 }
 
 void GameModel::removeCard(int cardId)
 {
-    auto it = _cards.find(cardId);
-    if (it != _cards.end()) {
-        delete it->second;
-        _cards.erase(it);
+    CardModel* card = getCardById(cardId);
+    if (card) {
+        unindexPlayfieldCard(cardId);
+        _cardSlots[cardId] = nullptr;
+        _cardCount--;
+        releaseCard(card);
+    }
+}
+
+CardModel* GameModel::allocateCard()
+{
+    if (!_freeCards.empty()) {
+        CardModel* card = _freeCards.back();
+        _freeCards.pop_back();
+        return card;
+    }
+    
+    size_t chunkIndex = _usedChunkCards / kCardChunkSize;
+    if (chunkIndex == _cardChunks.size()) {
+        _cardChunks.push_back(new CardModel[kCardChunkSize]);
+    }
+    CardModel* card = &_cardChunks[chunkIndex][_usedChunkCards % kCardChunkSize];
+    _usedChunkCards++;
+    return card;
+}
+
+void GameModel::releaseCard(CardModel* card)
+{
+    auto it = std::find(_adoptedCards.begin(), _adoptedCards.end(), card);
+    if (it != _adoptedCards.end()) {
+        delete card;
+        _adoptedCards.erase(it);
+    } else {
+        _freeCards.push_back(card);
+    }
+}
+
+void GameModel::registerCard(CardModel* card)
+{
+    size_t cardId = static_cast<size_t>(card->getCardId());
+    if (cardId >= _cardSlots.size()) {
+        _cardSlots.resize(cardId + 1, nullptr);
+    }
+    
+    bool indexed = false;
+    if (_cardSlots[cardId]) {
+        // 替换同ID的卡牌：牌面可能不同，需重新索引
+        indexed = cardId < _bucketSlotById.size() && _bucketSlotById[cardId] >= 0;
+        unindexPlayfieldCard(static_cast<int>(cardId));
+        releaseCard(_cardSlots[cardId]);
+    } else {
+        _cardCount++;
+    }
+    _cardSlots[cardId] = card;
+    
+    if (indexed) {
+        indexPlayfieldCard(static_cast<int>(cardId));
+    }
+    if (card->getCardId() == _trayCardId) {
+        _trayFaceValue = card->getFaceValue();
+    }
+}
+
+void GameModel::setPlayfieldCardIds(const std::vector<int>& cardIds)
+{
+    setPlayfieldCardIds(cardIds.data(), cardIds.size());
+}
+
+void GameModel::setPlayfieldCardIds(const int* cardIds, size_t count)
+{
+    for (size_t i = 0; i < _playfieldCardIds.size(); i++) {
+        unindexPlayfieldCard(_playfieldCardIds[i]);
     }
+    _playfieldCardIds.assign(cardIds, cardIds + count);
+    _coverGraph.setPresentCards(_playfieldCardIds);
+    for (size_t i = 0; i < _playfieldCardIds.size(); i++) {
+        updateCardCover(_playfieldCardIds[i]);
+    }
+}
+
+void GameModel::setTrayCardId(int cardId)
+{
+    _trayCardId = cardId;
+    
+    const CardModel* trayCard = getCardById(cardId);
+    _trayFaceValue = trayCard ? trayCard->getFaceValue() : -1;
 }
 
 void GameModel::removeFromPlayfield(int cardId)
 {
-    auto it = std::find(_playfieldCardIds.begin(), _playfieldCardIds.end(), cardId);
+    // 主牌区按绘制顺序排列时二分查找，否则（不在遮挡关系中的卡牌）顺序查找
+    auto it = _playfieldCardIds.end();
+    int drawRank = _coverGraph.getDrawRank(cardId);
+    if (drawRank >= 0) {
+        it = _playfieldCardIds.begin() + lowerBoundPlayfield(drawRank);
+    }
+    if (it == _playfieldCardIds.end() || *it != cardId) {
+        it = std::find(_playfieldCardIds.begin(), _playfieldCardIds.end(), cardId);
+    }
     if (it != _playfieldCardIds.end()) {
         _playfieldCardIds.erase(it);
+        unindexPlayfieldCard(cardId);
+        
+        // 被该卡牌压住的卡牌可能因此露出
+        _coverChangedIds.clear();
+        _coverGraph.removeCard(cardId, &_coverChangedIds);
+        for (size_t i = 0; i < _coverChangedIds.size(); i++) {
+            updateCardCover(_coverChangedIds[i]);
+        }
+    }
+}
+
+void GameModel::insertToPlayfield(int cardId)
+{
+    int drawRank = _coverGraph.getDrawRank(cardId);
+    if (drawRank >= 0) {
+        _playfieldCardIds.insert(_playfieldCardIds.begin() + lowerBoundPlayfield(drawRank), cardId);
+    } else {
+        _playfieldCardIds.push_back(cardId);
+    }
+    
+    // 被该卡牌重新压住的卡牌变为不可点击
+    _coverChangedIds.clear();
+    _coverGraph.restoreCard(cardId, &_coverChangedIds);
+    for (size_t i = 0; i < _coverChangedIds.size(); i++) {
+        updateCardCover(_coverChangedIds[i]);
+    }
+    updateCardCover(cardId);
+}
+
+void GameModel::buildCoverGraph(const std::vector<int>& cardIds, const std::vector<CardPosition>& positions)
+{
+    _coverGraph.build(cardIds, positions);
+    applyCoverGraph();
+}
+
+bool GameModel::restoreCoverGraph(const int* drawOrder, int cardCount, const int* coveredOffsets, int idCount,
+                                  const int* coveredIds, int edgeCount)
+{
+    bool restored = _coverGraph.restore(drawOrder, cardCount, coveredOffsets, idCount, coveredIds, edgeCount);
+    applyCoverGraph();
+    return restored;
+}
+
+void GameModel::applyCoverGraph()
+{
+    _coverGraph.setPresentCards(_playfieldCardIds);
+    for (size_t i = 0; i < _playfieldCardIds.size(); i++) {
+        updateCardCover(_playfieldCardIds[i]);
+    }
+    
+    // 初始状态由视图创建时读取，不作为变化通知
+    takeClickableChanges(nullptr);
+}
+
+void GameModel::takeClickableChanges(std::vector<int>* outCardIds)
+{
+    if (outCardIds) {
+        outCardIds->insert(outCardIds->end(), _clickableChangedIds.begin(), _clickableChangedIds.end());
+    }
+    for (size_t i = 0; i < _clickableChangedIds.size(); i++) {
+        _clickableChangedFlags[_clickableChangedIds[i]] = 0;
+    }
+    _clickableChangedIds.clear();
+}
+
+void GameModel::updateCardCover(int cardId)
+{
+    CardModel* card = getCardById(cardId);
+    if (!card) {
+        return;
+    }
+    
+    bool covered = _coverGraph.isCovered(cardId);
+    if (card->isClickable() == covered) {
+        card->setClickable(!covered);
+        
+        // 同一张卡牌在取出前多次变化只记录一次
+        size_t flagIndex = static_cast<size_t>(cardId);
+        if (flagIndex >= _clickableChangedFlags.size()) {
+            _clickableChangedFlags.resize(flagIndex + 1, 0);
+        }
+        if (!_clickableChangedFlags[flagIndex]) {
+            _clickableChangedFlags[flagIndex] = 1;
+            _clickableChangedIds.push_back(cardId);
+        }
+    }
+    if (covered) {
+        unindexPlayfieldCard(cardId);
+    } else {
+        indexPlayfieldCard(cardId);
+    }
+}
+
+void GameModel::getMatchableCardIds(std::vector<int>* outCardIds) const
+{
+    if (!outCardIds) {
+        return;
+    }
+    
+    const std::vector<int>* lower = getFaceBucket(_trayFaceValue - 1);
+    const std::vector<int>* upper = getFaceBucket(_trayFaceValue + 1);
+    if (lower) {
+        outCardIds->insert(outCardIds->end(), lower->begin(), lower->end());
+    }
+    if (upper) {
+        outCardIds->insert(outCardIds->end(), upper->begin(), upper->end());
+    }
+}
+
+bool GameModel::hasMatchableCard() const
+{
+    const std::vector<int>* lower = getFaceBucket(_trayFaceValue - 1);
+    const std::vector<int>* upper = getFaceBucket(_trayFaceValue + 1);
+    return (lower && !lower->empty()) || (upper && !upper->empty());
+}
+
+bool GameModel::hasAnyMove() const
+{
+    return hasMatchableCard() || !_stackCardIds.empty();
+}
+
+void GameModel::indexPlayfieldCard(int cardId)
+{
+    const CardModel* card = getCardById(cardId);
+    if (!card || _coverGraph.isCovered(cardId)) {
+        return;
+    }
+    
+    size_t slotIndex = static_cast<size_t>(cardId);
+    if (slotIndex >= _bucketSlotById.size()) {
+        _bucketSlotById.resize(slotIndex + 1, -1);
+    }
+    if (_bucketSlotById[slotIndex] >= 0) {
+        return;
+    }
+    
+    std::vector<int>& bucket = _faceBuckets[card->getFaceValue()];
+    _bucketSlotById[slotIndex] = static_cast<int>(bucket.size());
+    bucket.push_back(cardId);
+}
+
+void GameModel::unindexPlayfieldCard(int cardId)
+{
+    const CardModel* card = getCardById(cardId);
+    if (!card || static_cast<size_t>(cardId) >= _bucketSlotById.size() || _bucketSlotById[cardId] < 0) {
+        return;
+    }
+    
+    // 与桶尾交换后删除
+    std::vector<int>& bucket = _faceBuckets[card->getFaceValue()];
+    int slot = _bucketSlotById[cardId];
+    int lastCardId = bucket.back();
+    bucket[slot] = lastCardId;
+    _bucketSlotById[lastCardId] = slot;
+    bucket.pop_back();
+    _bucketSlotById[cardId] = -1;
+}
+
+const std::vector<int>* GameModel::getFaceBucket(int faceValue) const
+{
+    if (faceValue < 0 || faceValue >= kFaceBucketCount) {
+        return nullptr;
     }
+    return &_faceBuckets[faceValue];
+}
+
+size_t GameModel::lowerBoundPlayfield(int drawRank) const
+{
+    // 不在遮挡关系中的卡牌（序号-1）排在末尾
+    auto it = std::lower_bound(_playfieldCardIds.begin(), _playfieldCardIds.end(), drawRank,
+                               [this](int cardId, int rank) {
+                                   int cardRank = _coverGraph.getDrawRank(cardId);
+                                   return cardRank >= 0 && cardRank < rank;
+                               });
+    return static_cast<size_t>(it - _playfieldCardIds.begin());
 }
 
 int GameModel::popFromStack()
@@ -72,6 +367,7 @@ bool GameModel::isGameWon() const
     return _playfieldCardIds.empty();
 }
 
+#if POKER_CORE_JSON
 rapidjson::Document GameModel::serialize() const
 {
     rapidjson::Document doc;
@@ -80,8 +376,8 @@ rapidjson::Document GameModel::serialize() const
     
     // 序列化所有卡牌
     rapidjson::Value cardsArray(rapidjson::kArrayType);
-    for (const auto& pair : _cards) {
-        cardsArray.PushBack(pair.second->serialize(allocator), allocator);
+    for (const CardModel* card : getAllCards()) {
+        cardsArray.PushBack(card->serialize(allocator), allocator);
     }
     doc.AddMember("cards", cardsArray, allocator);
     
@@ -112,16 +408,19 @@ void GameModel::deserialize(const rapidjson::Document& json)
     if (json.HasMember("cards")) {
         const auto& cardsArray = json["cards"];
         for (rapidjson::SizeType i = 0; i < cardsArray.Size(); i++) {
-            CardModel* card = new CardModel();
-            card->deserialize(cardsArray[i]);
-            addCard(card);
+            CardModel card;
+            card.deserialize(cardsArray[i]);
+            CardModel* arenaCard = createCard(card.getFace(), card.getSuit(), card.getCardId());
+            if (arenaCard) {
+                *arenaCard = card;
+            }
         }
     }
     
     if (json.HasMember("playfieldCardIds")) {
         const auto& array = json["playfieldCardIds"];
         for (rapidjson::SizeType i = 0; i < array.Size(); i++) {
-            _playfieldCardIds.push_back(array[i].GetInt());
+            insertToPlayfield(array[i].GetInt());
         }
     }
     
@@ -133,6 +432,16 @@ void GameModel::deserialize(const rapidjson::Document& json)
     }
     
     if (json.HasMember("trayCardId")) {
-        _trayCardId = json["trayCardId"].GetInt();
+        setTrayCardId(json["trayCardId"].GetInt());
+    }
+    
+    // 存档中只有当前主牌区，遮挡关系按剩余卡牌的位置重建
+    std::vector<CardPosition> positions;
+    positions.reserve(_playfieldCardIds.size());
+    for (int id : _playfieldCardIds) {
+        const CardModel* card = getCardById(id);
+        positions.push_back(card ? card->getPosition() : CardPosition());
     }
-} 
\ No newline at end of file
+    buildCoverGraph(_playfieldCardIds, positions);
+} 
+#endif
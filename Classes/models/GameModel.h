@@ -1,20 +1,85 @@
 #ifndef __GAME_MODEL_H__
 #define __GAME_MODEL_H__
 
-#include "cocos2d.h"
+#include "CardCoverGraph.h"
 #include "CardModel.h"
+#include <cstddef>
+#include <cstdint>
 #include <vector>
-#include <map>
 
 /**
  * @class GameModel
  * @brief 游戏数据模型
  * @details 存储游戏的运行时数据，包括所有卡牌、游戏状态等
- *          支持序列化和反序列化，用于存档功能
+ *          存档使用GameSnapshotService的二进制快照，JSON序列化只用于调试
+ *
+ *          卡牌存放在按块分配的连续内存池中，通过按卡牌ID下标的数组查找（ID由生成器连续分配）；
+ *          卡牌指针在卡牌被移除前保持不变，clear后内存块保留复用，重新加载关卡时不再逐张分配
+ *          主牌区卡牌另按牌面数值分桶索引，随主牌区和底牌的变化增量更新，
+ *          用于快速查询可与底牌匹配的卡牌（提示、自动操作、无路可走检测）
+ *          主牌区卡牌之间的遮挡关系由CardCoverGraph维护：被压住的卡牌不可点击、不进入牌面索引，
+ *          卡牌离开或回到主牌区时只更新受影响的卡牌
  */
 class GameModel
 {
 public:
+    /**
+     * @class CardRange
+     * @brief 所有卡牌的遍历范围（按卡牌ID升序，元素为CardModel*）
+     */
+    class CardRange
+    {
+    public:
+        class const_iterator
+        {
+        public:
+            const_iterator(const std::vector<CardModel*>* slots, size_t index)
+                : _slots(slots)
+                , _index(index)
+            {
+                skipEmpty();
+            }
+            
+            CardModel* operator*() const { return (*_slots)[_index]; }
+            
+            const_iterator& operator++()
+            {
+                _index++;
+                skipEmpty();
+                return *this;
+            }
+            
+            bool operator==(const const_iterator& other) const { return _index == other._index; }
+            bool operator!=(const const_iterator& other) const { return _index != other._index; }
+            
+        private:
+            void skipEmpty()
+            {
+                while (_index < _slots->size() && !(*_slots)[_index]) {
+                    _index++;
+                }
+            }
+            
+            const std::vector<CardModel*>* _slots;
+            size_t _index;
+        };
+        
+        CardRange(const std::vector<CardModel*>* slots, size_t count)
+            : _slots(slots)
+            , _count(count)
+        {
+        }
+        
+        const_iterator begin() const { return const_iterator(_slots, 0); }
+        const_iterator end() const { return const_iterator(_slots, _slots->size()); }
+        size_t size() const { return _count; }
+        bool empty() const { return _count == 0; }
+        
+    private:
+        const std::vector<CardModel*>* _slots;
+        size_t _count;
+    };
+    
     /**
      * @brief 构造函数
      */
@@ -30,9 +95,19 @@ public:
      */
     void clear();
     
+    /**
+     * @brief 在内存池中创建卡牌并添加到游戏中
+     * @param face 牌面类型
+     * @param suit 花色类型
+     * @param cardId 卡牌唯一ID（非负，已存在时替换原卡牌）
+     * @return 卡牌指针（由GameModel管理），ID无效时返回nullptr
+     */
+    CardModel* createCard(CardFaceType face, CardSuitType suit, int cardId);
+    
     /**
      * @brief 添加卡牌到游戏中
-     * @param card 卡牌指针
+     * @param card 堆上分配的卡牌指针（由GameModel接管并释放）
+     * @details 新代码应使用createCard，避免逐张堆分配
      */
     void addCard(CardModel* card);
     
@@ -51,9 +126,9 @@ public:
     
     /**
      * @brief 获取所有卡牌
-     * @return 卡牌映射表
+     * @return 按卡牌ID升序的遍历范围
      */
-    const std::map<int, CardModel*>& getAllCards() const { return _cards; }
+    CardRange getAllCards() const { return CardRange(&_cardSlots, _cardCount); }
     
     /**
      * @brief 获取主牌区的卡牌列表
@@ -62,10 +137,17 @@ public:
     const std::vector<int>& getPlayfieldCardIds() const { return _playfieldCardIds; }
     
     /**
-     * @brief 设置主牌区卡牌列表
+     * @brief 设置主牌区卡牌列表（卡牌须已添加，用于重建牌面索引）
      * @param cardIds 卡牌ID列表
      */
-    void setPlayfieldCardIds(const std::vector<int>& cardIds) { _playfieldCardIds = cardIds; }
+    void setPlayfieldCardIds(const std::vector<int>& cardIds);
+    
+    /**
+     * @brief 设置主牌区卡牌列表（复用已有容量，读取存档时使用）
+     * @param cardIds 卡牌ID数组
+     * @param count 卡牌数量
+     */
+    void setPlayfieldCardIds(const int* cardIds, size_t count);
     
     /**
      * @brief 获取备用牌堆的卡牌列表
@@ -79,6 +161,13 @@ public:
      */
     void setStackCardIds(const std::vector<int>& cardIds) { _stackCardIds = cardIds; }
     
+    /**
+     * @brief 设置备用牌堆卡牌列表（复用已有容量，读取存档时使用）
+     * @param cardIds 卡牌ID数组
+     * @param count 卡牌数量
+     */
+    void setStackCardIds(const int* cardIds, size_t count) { _stackCardIds.assign(cardIds, cardIds + count); }
+    
     /**
      * @brief 获取当前底牌堆顶部卡牌ID
      * @return 底牌ID，如果没有返回-1
@@ -89,40 +178,181 @@ public:
      * @brief 设置底牌堆顶部卡牌ID
      * @param cardId 卡牌ID
      */
-    void setTrayCardId(int cardId) { _trayCardId = cardId; }
+    void setTrayCardId(int cardId);
     
     /**
-     * @brief 从主牌区移除卡牌
+     * @brief 从主牌区移除卡牌（其余卡牌保持原顺序）
      * @param cardId 卡牌ID
      */
     void removeFromPlayfield(int cardId);
     
+    /**
+     * @brief 把卡牌放回主牌区原来的位置（撤销时使用）
+     * @param cardId 卡牌ID
+     * @details 主牌区ID列表保持初始顺序（遮挡关系的绘制顺序），卡牌按绘制序号插回，不在遮挡关系中的卡牌放到末尾
+     *          卡牌及其压住的卡牌的可点击状态按遮挡关系更新
+     */
+    void insertToPlayfield(int cardId);
+    
+    /**
+     * @brief 根据卡牌位置构建主牌区遮挡关系
+     * @param cardIds 参与遮挡计算的卡牌ID，按绘制顺序排列（后面的卡牌压住前面重叠的卡牌），
+     *                通常为关卡的全部主牌区卡牌
+     * @param positions 与cardIds一一对应的卡牌中心坐标
+     * @details 以当前主牌区作为在场卡牌，同时设置主牌区卡牌的可点击状态
+     */
+    void buildCoverGraph(const std::vector<int>& cardIds, const std::vector<CardPosition>& positions);
+    
+    /**
+     * @brief 从存档数据恢复主牌区遮挡关系
+     * @details 参数含义见CardCoverGraph::restore；以当前主牌区作为在场卡牌，同时设置可点击状态
+     * @return 数据不一致时返回false（遮挡关系被清空）
+     */
+    bool restoreCoverGraph(const int* drawOrder, int cardCount, const int* coveredOffsets, int idCount,
+                           const int* coveredIds, int edgeCount);
+    
+    /**
+     * @brief 获取主牌区遮挡关系
+     */
+    const CardCoverGraph& getCoverGraph() const { return _coverGraph; }
+    
+    /**
+     * @brief 卡牌是否被主牌区其他卡牌压住
+     */
+    bool isCardCovered(int cardId) const { return _coverGraph.isCovered(cardId); }
+    
+    /**
+     * @brief 取出上次调用以来可点击状态发生变化的主牌区卡牌
+     * @param outCardIds 输出卡牌ID（追加，每张卡牌最多一次；为nullptr时只丢弃）
+     * @details 视图层据此只刷新受影响的卡牌；未取出的变化按卡牌去重，最多与卡牌数量相同，
+     *          没有视图的调用者（工具、求解器）不取出也不会无限增长
+     */
+    void takeClickableChanges(std::vector<int>* outCardIds);
+    
+    /**
+     * @brief 获取可与当前底牌匹配的主牌区卡牌
+     * @param outCardIds 输出卡牌ID（追加，顺序不保证）
+     * @details 只访问底牌数值±1两个桶，复杂度与结果数量成正比
+     */
+    void getMatchableCardIds(std::vector<int>* outCardIds) const;
+    
+    /**
+     * @brief 主牌区是否有可与当前底牌匹配的卡牌
+     */
+    bool hasMatchableCard() const;
+    
+    /**
+     * @brief 是否还有可执行的操作（可匹配的卡牌或备用牌堆未空）
+     * @return 返回false表示无路可走
+     */
+    bool hasAnyMove() const;
+    
     /**
      * @brief 从备用牌堆弹出顶部卡牌
      * @return 弹出的卡牌ID，如果牌堆为空返回-1
      */
     int popFromStack();
     
+    /**
+     * @brief 把卡牌放回备用牌堆顶部（撤销时使用）
+     * @param cardId 卡牌ID
+     */
+    void pushToStack(int cardId) { _stackCardIds.push_back(cardId); }
+    
     /**
      * @brief 检查游戏是否胜利
      * @return 如果主牌区为空返回true
      */
     bool isGameWon() const;
     
+#if POKER_CORE_JSON
     /**
-     * @brief 序列化为JSON
+     * @brief 序列化为JSON（仅用于调试查看，存档使用GameSnapshotService的二进制快照）
      * @return JSON文档
      */
     rapidjson::Document serialize() const;
     
     /**
-     * @brief 从JSON反序列化
+     * @brief 从JSON反序列化（仅用于调试）
      * @param json JSON文档
+     * @details JSON中没有遮挡关系，按剩余主牌区卡牌的位置重建，撤销放回的卡牌不参与遮挡
      */
     void deserialize(const rapidjson::Document& json);
+#endif
+    
+private:
+    GameModel(const GameModel&) = delete;
+    GameModel& operator=(const GameModel&) = delete;
+    
+    /**
+     * @brief 从内存池取一张卡牌（优先复用已移除的卡牌）
+     */
+    CardModel* allocateCard();
+    
+    /**
+     * @brief 释放卡牌：内存池中的卡牌回收复用，addCard接管的卡牌直接删除
+     */
+    void releaseCard(CardModel* card);
+    
+    /**
+     * @brief 把卡牌登记到ID下标数组（已存在时释放原卡牌）
+     */
+    void registerCard(CardModel* card);
+    
+    /**
+     * @brief 以当前主牌区作为在场卡牌，刷新所有主牌区卡牌的遮挡状态
+     */
+    void applyCoverGraph();
+    
+    /**
+     * @brief 按遮挡关系更新主牌区卡牌的可点击状态和牌面索引
+     */
+    void updateCardCover(int cardId);
+    
+    /**
+     * @brief 把主牌区卡牌加入牌面索引（被压住的卡牌不加入）
+     */
+    void indexPlayfieldCard(int cardId);
+    
+    /**
+     * @brief 从牌面索引移除主牌区卡牌
+     */
+    void unindexPlayfieldCard(int cardId);
+    
+    /**
+     * @brief 获取主牌区中第一张绘制序号不小于drawRank的卡牌的下标（主牌区保持绘制顺序）
+     */
+    size_t lowerBoundPlayfield(int drawRank) const;
+    
+    /**
+     * @brief 获取牌面数值对应的桶，超出范围返回nullptr
+     */
+    const std::vector<int>* getFaceBucket(int faceValue) const;
+    
+    /**
+     * @brief 每个内存块的卡牌数量
+     */
+    static const int kCardChunkSize = 64;
+    
+    /**
+     * @brief 牌面索引桶数量（牌面数值0~13，0为无牌面）
+     */
+    static const int kFaceBucketCount = CFT_NUM_CARD_FACE_TYPES + 1;
     
 private:
-    std::map<int, CardModel*> _cards;           // 所有卡牌的映射表 (cardId -> CardModel)
+    std::vector<CardModel*> _cardSlots;         // 按卡牌ID下标的卡牌指针（空位为nullptr）
+    size_t _cardCount;                          // 卡牌数量
+    std::vector<CardModel*> _cardChunks;        // 卡牌内存块（每块kCardChunkSize张）
+    size_t _usedChunkCards;                     // 内存块中已分配的卡牌数量
+    std::vector<CardModel*> _freeCards;         // 已移除、可复用的内存池卡牌
+    std::vector<CardModel*> _adoptedCards;      // 通过addCard接管的堆上卡牌
+    std::vector<int> _faceBuckets[kFaceBucketCount];    // 按牌面数值分桶的主牌区卡牌ID
+    std::vector<int> _bucketSlotById;           // 卡牌在所在桶中的下标（按卡牌ID下标，-1表示不在主牌区）
+    int _trayFaceValue;                         // 底牌牌面数值，没有底牌时为-1
+    CardCoverGraph _coverGraph;                 // 主牌区遮挡关系
+    std::vector<int> _coverChangedIds;          // 遮挡状态变化的卡牌（临时缓冲）
+    std::vector<int> _clickableChangedIds;      // 可点击状态变化、尚未被取出的卡牌（不重复）
+    std::vector<uint8_t> _clickableChangedFlags; // 卡牌是否已在_clickableChangedIds中（按卡牌ID下标）
     std::vector<int> _playfieldCardIds;         // 主牌区卡牌ID列表
     std::vector<int> _stackCardIds;             // 备用牌堆卡牌ID列表
     int _trayCardId;                            // 底牌堆顶部卡牌ID
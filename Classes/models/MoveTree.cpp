@@ -0,0 +1,87 @@
+#include "MoveTree.h"
+
+MoveTree::MoveTree()
+    : _nodeCount(0)
+    , _root(nullptr)
+    , _current(nullptr)
+{
+    clear();
+}
+
+MoveTree::~MoveTree()
+{
+    for (MoveTreeNode* chunk : _nodeChunks) {
+        delete[] chunk;
+    }
+    _nodeChunks.clear();
+}
+
+void MoveTree::clear()
+{
+    _nodeCount = 0;
+    _root = allocateNode(UndoAction(), nullptr);
+    _current = _root;
+}
+
+const MoveTreeNode* MoveTree::recordMove(const UndoAction& action)
+{
+    // 相同状态下的相同操作复用已有子节点
+    MoveTreeNode* child = _current->firstChild;
+    while (child && (child->action.type != action.type || child->action.fromCardId != action.fromCardId
+                     || child->action.toCardId != action.toCardId)) {
+        child = child->nextSibling;
+    }
+    if (!child) {
+        child = allocateNode(action, _current);
+        child->nextSibling = _current->firstChild;
+        _current->firstChild = child;
+    }
+    
+    _current->redoChild = child;
+    _current = child;
+    return child;
+}
+
+void MoveTree::stepBack(const UndoAction& action)
+{
+    if (!_current->parent) {
+        // 撤销到开始记录之前的状态（例如读档后继续撤销）
+        MoveTreeNode* root = allocateNode(UndoAction(), nullptr);
+        _current->action = action;
+        _current->parent = root;
+        root->firstChild = _current;
+        _root = root;
+    }
+    
+    _current->parent->redoChild = _current;
+    _current = _current->parent;
+}
+
+const MoveTreeNode* MoveTree::stepForward(const MoveTreeNode* child)
+{
+    MoveTreeNode* next = child ? const_cast<MoveTreeNode*>(child) : _current->redoChild;
+    if (!next || next->parent != _current) {
+        return nullptr;
+    }
+    
+    _current->redoChild = next;
+    _current = next;
+    return next;
+}
+
+MoveTreeNode* MoveTree::allocateNode(const UndoAction& action, MoveTreeNode* parent)
+{
+    int chunkIndex = _nodeCount / kNodeChunkSize;
+    if (chunkIndex == static_cast<int>(_nodeChunks.size())) {
+        _nodeChunks.push_back(new MoveTreeNode[kNodeChunkSize]);
+    }
+    
+    MoveTreeNode* node = &_nodeChunks[chunkIndex][_nodeCount % kNodeChunkSize];
+    _nodeCount++;
+    node->action = action;
+    node->parent = parent;
+    node->firstChild = nullptr;
+    node->nextSibling = nullptr;
+    node->redoChild = nullptr;
+    return node;
+}
@@ -0,0 +1,107 @@
+#ifndef __MOVE_TREE_H__
+#define __MOVE_TREE_H__
+
+#include "UndoModel.h"
+#include <vector>
+
+/**
+ * @struct MoveTreeNode
+ * @brief 操作树节点
+ * @details 每个节点表示从父节点状态执行一次操作后到达的状态，子节点按兄弟链表连接
+ */
+struct MoveTreeNode
+{
+    UndoAction action;          // 从父节点到达该节点的操作（根节点为空操作）
+    MoveTreeNode* parent;       // 父节点（根节点为nullptr）
+    MoveTreeNode* firstChild;   // 第一个子节点
+    MoveTreeNode* nextSibling;  // 下一个兄弟节点
+    MoveTreeNode* redoChild;    // 最近一次经过的子节点（重做的默认分支）
+};
+
+/**
+ * @class MoveTree
+ * @brief 操作树数据模型
+ * @details 记录一局游戏中走过的所有分支：撤销后走了别的操作时，原来的分支保留在树中，
+ *          相同状态下执行相同操作时复用已有节点（共享公共前缀）
+ *          节点从按块分配的内存池中取出，clear后内存块复用；撤销和重做只移动当前节点，都是O(1)，
+ *          记录新操作时只在当前节点的子节点（不超过当前可走的操作数）中查找
+ *          根节点是开始记录（或clear）时的状态，撤销到根节点之前时在根节点之上补出新的根节点
+ *          供复盘分析使用，由UndoManager在记录、撤销、重做时同步更新
+ */
+class MoveTree
+{
+public:
+    /**
+     * @brief 构造函数（只有根节点）
+     */
+    MoveTree();
+    
+    /**
+     * @brief 析构函数
+     */
+    ~MoveTree();
+    
+    /**
+     * @brief 清空所有分支，只保留根节点（内存块保留复用）
+     */
+    void clear();
+    
+    /**
+     * @brief 获取根节点（已知的最早状态）
+     */
+    const MoveTreeNode* getRoot() const { return _root; }
+    
+    /**
+     * @brief 获取当前状态对应的节点
+     */
+    const MoveTreeNode* getCurrent() const { return _current; }
+    
+    /**
+     * @brief 获取节点总数（包括根节点）
+     */
+    int getNodeCount() const { return _nodeCount; }
+    
+    /**
+     * @brief 在当前节点下记录一次新操作并前进到该子节点
+     * @param action 操作产生的撤销记录
+     * @return 子节点（已有相同操作的子节点时直接复用）
+     */
+    const MoveTreeNode* recordMove(const UndoAction& action);
+    
+    /**
+     * @brief 撤销时回到父节点
+     * @param action 被撤销的操作（当前节点是根节点时，用它在根节点之上补出父节点）
+     */
+    void stepBack(const UndoAction& action);
+    
+    /**
+     * @brief 重做时前进到子节点
+     * @param child 当前节点的子节点（nullptr表示当前节点的默认重做分支）
+     * @return 前进到的节点，child不是当前节点的子节点或没有可重做的分支时返回nullptr
+     */
+    const MoveTreeNode* stepForward(const MoveTreeNode* child);
+    
+    /**
+     * @brief 获取当前节点的默认重做分支（没有时返回nullptr）
+     */
+    const MoveTreeNode* getRedoChild() const { return _current->redoChild; }
+    
+private:
+    /**
+     * @brief 从内存池中取出一个节点（内存池不足时分配新的内存块）
+     */
+    MoveTreeNode* allocateNode(const UndoAction& action, MoveTreeNode* parent);
+    
+    MoveTree(const MoveTree&) = delete;
+    MoveTree& operator=(const MoveTree&) = delete;
+    
+private:
+    static const int kNodeChunkSize = 256;      // 每个内存块的节点数量
+    
+    std::vector<MoveTreeNode*> _nodeChunks;     // 节点内存块（每块kNodeChunkSize个）
+    int _nodeCount;                             // 已使用的节点数量
+    MoveTreeNode* _root;                        // 根节点
+    MoveTreeNode* _current;                     // 当前状态对应的节点
+};
+
+#endif // __MOVE_TREE_H__
@@ -0,0 +1,245 @@
+#include "PackedGameState.h"
+
+namespace {
+
+// Zobrist键的固定种子
+const uint64_t kZobristSeed = 0x5A0B5157A7E5EEDULL;
+
+uint64_t splitMix64(uint64_t* state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+PackedGameLayout::PackedGameLayout()
+    : _playfieldCount(0)
+    , _stackCount(0)
+{
+}
+
+PackedGameLayout* PackedGameLayout::createFromGameModel(const GameModel* gameModel)
+{
+    if (!gameModel) {
+        return nullptr;
+    }
+    
+    const std::vector<int>& playfieldIds = gameModel->getPlayfieldCardIds();
+    const std::vector<int>& stackIds = gameModel->getStackCardIds();
+    GameModel::CardRange cards = gameModel->getAllCards();
+    if (static_cast<int>(playfieldIds.size()) > kMaxPlayfieldCards
+        || static_cast<int>(cards.size()) > kMaxCards) {
+        return nullptr;
+    }
+    
+    PackedGameLayout* layout = new PackedGameLayout();
+    
+    // 主牌区、备用牌堆按列表顺序编号
+    bool valid = true;
+    for (size_t i = 0; i < playfieldIds.size() && valid; i++) {
+        const CardModel* card = gameModel->getCardById(playfieldIds[i]);
+        valid = card && layout->getCardIndex(card->getCardId()) < 0;
+        if (valid) {
+            layout->appendCard(card);
+        }
+    }
+    layout->_playfieldCount = layout->getCardCount();
+    
+    for (size_t i = 0; i < stackIds.size() && valid; i++) {
+        const CardModel* card = gameModel->getCardById(stackIds[i]);
+        valid = card && layout->getCardIndex(card->getCardId()) < 0;
+        if (valid) {
+            layout->appendCard(card);
+        }
+    }
+    layout->_stackCount = layout->getCardCount() - layout->_playfieldCount;
+    
+    if (!valid) {
+        delete layout;
+        return nullptr;
+    }
+    
+    // 其余卡牌（底牌和被压住的底牌）按ID顺序编号
+    for (const CardModel* card : cards) {
+        if (layout->getCardIndex(card->getCardId()) < 0) {
+            layout->appendCard(card);
+        }
+    }
+    
+    layout->initCoverMasks(gameModel);
+    layout->initZobristKeys();
+    if (!layout->packState(gameModel, &layout->_initialState)) {
+        delete layout;
+        return nullptr;
+    }
+    return layout;
+}
+
+bool PackedGameLayout::packState(const GameModel* gameModel, PackedGameState* outState) const
+{
+    if (!gameModel || !outState) {
+        return false;
+    }
+    
+    PackedGameState state;
+    state.layout = this;
+    
+    // 主牌区须为布局主牌区的子序列（保持顺序）
+    const std::vector<int>& playfieldIds = gameModel->getPlayfieldCardIds();
+    int previousSlot = -1;
+    for (size_t i = 0; i < playfieldIds.size(); i++) {
+        int slot = getCardIndex(playfieldIds[i]);
+        if (slot <= previousSlot || slot >= _playfieldCount) {
+            return false;
+        }
+        state.playfieldMask |= 1ULL << slot;
+        state.hash ^= _playfieldKeys[slot];
+        previousSlot = slot;
+    }
+    
+    // 备用牌堆须为布局备用牌堆的前缀
+    const std::vector<int>& stackIds = gameModel->getStackCardIds();
+    if (static_cast<int>(stackIds.size()) > _stackCount) {
+        return false;
+    }
+    for (size_t i = 0; i < stackIds.size(); i++) {
+        if (stackIds[i] != _cardIds[_playfieldCount + i]) {
+            return false;
+        }
+    }
+    state.stackCount = static_cast<uint16_t>(stackIds.size());
+    state.hash ^= _stackKeys[state.stackCount];
+    
+    int trayCardId = gameModel->getTrayCardId();
+    if (trayCardId >= 0) {
+        int trayIndex = getCardIndex(trayCardId);
+        if (trayIndex < 0) {
+            return false;
+        }
+        state.trayCardIndex = static_cast<uint16_t>(trayIndex);
+        state.hash ^= _trayKeys[trayIndex];
+    }
+    
+    *outState = state;
+    return true;
+}
+
+GameModel* PackedGameLayout::createGameModel(const PackedGameState& state, const CardPosition& trayPosition) const
+{
+    if (state.layout != this) {
+        return nullptr;
+    }
+    
+    GameModel* gameModel = new GameModel();
+    std::vector<int> playfieldIds;
+    std::vector<int> stackIds;
+    
+    for (int i = 0; i < getCardCount(); i++) {
+        CardModel* card = gameModel->createCard(getFace(i), getSuit(i), _cardIds[i]);
+        CardLocation location = state.getLocation(i);
+        bool moved = location != getInitialLocation(i);
+        
+        card->setLocation(location);
+        card->setPosition(moved ? trayPosition : _positions[i]);
+        card->setHomePosition(_homePositions[i]);
+        card->setFlipped(moved || (_cardFlags[i] & kFlagFlipped) != 0);
+        card->setClickable((_cardFlags[i] & kFlagClickable) != 0);
+        
+        if (location == CL_PLAYFIELD) {
+            playfieldIds.push_back(_cardIds[i]);
+        } else if (location == CL_STACK) {
+            stackIds.push_back(_cardIds[i]);
+        }
+    }
+    
+    gameModel->setPlayfieldCardIds(playfieldIds);
+    gameModel->setStackCardIds(stackIds);
+    gameModel->setTrayCardId(state.trayCardIndex == PackedGameState::kNoCard ? -1 : _cardIds[state.trayCardIndex]);
+    
+    // 按原绘制顺序重建遮挡关系，已离开主牌区的卡牌保留在图中（不在场）
+    std::vector<int> coverCardIds;
+    std::vector<CardPosition> coverPositions;
+    coverCardIds.reserve(_coverDrawOrder.size());
+    coverPositions.reserve(_coverDrawOrder.size());
+    for (size_t i = 0; i < _coverDrawOrder.size(); i++) {
+        coverCardIds.push_back(_cardIds[_coverDrawOrder[i]]);
+        coverPositions.push_back(_positions[_coverDrawOrder[i]]);
+    }
+    gameModel->buildCoverGraph(coverCardIds, coverPositions);
+    return gameModel;
+}
+
+int PackedGameLayout::getCardIndex(int cardId) const
+{
+    auto it = _cardIndexById.find(cardId);
+    if (it != _cardIndexById.end()) {
+        return it->second;
+    }
+    return -1;
+}
+
+void PackedGameLayout::appendCard(const CardModel* card)
+{
+    uint8_t flags = static_cast<uint8_t>((card->getLocation() + 1) & 0x03);
+    if (card->isFlipped()) {
+        flags |= kFlagFlipped;
+    }
+    if (card->isClickable()) {
+        flags |= kFlagClickable;
+    }
+    
+    _cardIndexById[card->getCardId()] = getCardCount();
+    _cardIds.push_back(card->getCardId());
+    _packedCards.push_back(static_cast<uint8_t>(((card->getFace() + 1) & 0x0F) | (((card->getSuit() + 1) & 0x07) << 4)));
+    _cardFlags.push_back(flags);
+    _positions.push_back(card->getPosition());
+    _homePositions.push_back(card->getHomePosition());
+}
+
+void PackedGameLayout::initCoverMasks(const GameModel* gameModel)
+{
+    const CardCoverGraph& coverGraph = gameModel->getCoverGraph();
+    _coverMasks.assign(_playfieldCount, 0);
+    
+    for (int slot = 0; slot < _playfieldCount; slot++) {
+        const int* begin = nullptr;
+        const int* end = nullptr;
+        coverGraph.getCoveredCards(_cardIds[slot], &begin, &end);
+        for (const int* it = begin; it != end; ++it) {
+            int coveredSlot = getCardIndex(*it);
+            if (coveredSlot >= 0 && coveredSlot < _playfieldCount) {
+                _coverMasks[coveredSlot] |= 1ULL << slot;
+            }
+        }
+    }
+    
+    // 主牌区列表顺序可能因撤销而与绘制顺序不同，还原时按图中的绘制顺序重建
+    const std::vector<int>& drawOrder = coverGraph.getDrawOrder();
+    for (size_t i = 0; i < drawOrder.size(); i++) {
+        int slot = getCardIndex(drawOrder[i]);
+        if (slot >= 0 && slot < _playfieldCount) {
+            _coverDrawOrder.push_back(slot);
+        }
+    }
+}
+
+void PackedGameLayout::initZobristKeys()
+{
+    uint64_t seed = kZobristSeed;
+    
+    _playfieldKeys.resize(_playfieldCount);
+    for (int i = 0; i < _playfieldCount; i++) {
+        _playfieldKeys[i] = splitMix64(&seed);
+    }
+    _stackKeys.resize(_stackCount + 1);
+    for (int i = 0; i <= _stackCount; i++) {
+        _stackKeys[i] = splitMix64(&seed);
+    }
+    _trayKeys.resize(getCardCount());
+    for (int i = 0; i < getCardCount(); i++) {
+        _trayKeys[i] = splitMix64(&seed);
+    }
+}
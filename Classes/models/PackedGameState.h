@@ -0,0 +1,262 @@
+#ifndef __PACKED_GAME_STATE_H__
+#define __PACKED_GAME_STATE_H__
+
+#include "GameModel.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class PackedGameLayout;
+
+/**
+ * @struct PackedGameState
+ * @brief 紧凑的游戏状态
+ * @details 用于求解器、模拟器和回放中需要大量复制和哈希的场景
+ *          只保存随操作变化的部分：主牌区剩余位掩码、备用牌堆剩余张数（游标）和底牌序号，
+ *          卡牌本身（ID、牌面、花色、初始位置和发牌位置）保存在共享的PackedGameLayout中
+ *          结构体可平凡复制（32字节），Zobrist哈希随操作增量更新
+ */
+struct PackedGameState
+{
+    /**
+     * @brief 无底牌时的底牌序号
+     */
+    static const uint16_t kNoCard = 0xFFFF;
+    
+    uint64_t playfieldMask;             // 主牌区剩余卡牌位掩码（第i位对应主牌区第i张）
+    uint64_t hash;                      // Zobrist哈希
+    const PackedGameLayout* layout;     // 所属牌局布局
+    uint16_t stackCount;                // 备用牌堆剩余张数（布局中备用牌堆的前stackCount张）
+    uint16_t trayCardIndex;             // 底牌在布局中的序号
+    
+    PackedGameState()
+        : playfieldMask(0)
+        , hash(0)
+        , layout(nullptr)
+        , stackCount(0)
+        , trayCardIndex(kNoCard)
+    {
+    }
+    
+    bool operator==(const PackedGameState& other) const
+    {
+        return playfieldMask == other.playfieldMask && stackCount == other.stackCount
+            && trayCardIndex == other.trayCardIndex && layout == other.layout;
+    }
+    
+    bool operator!=(const PackedGameState& other) const
+    {
+        return !(*this == other);
+    }
+    
+    /**
+     * @brief 检查游戏是否胜利（主牌区为空）
+     */
+    bool isGameWon() const { return playfieldMask == 0; }
+    
+    /**
+     * @brief 检查主牌区第slot张卡牌是否在场、未被压住且可与底牌匹配
+     */
+    inline bool canMatchWithTray(int slot) const;
+    
+    /**
+     * @brief 主牌区第slot张卡牌与底牌匹配并成为新底牌
+     * @return 不在场或无法匹配时返回false，状态不变
+     */
+    inline bool replaceTrayFromPlayfield(int slot);
+    
+    /**
+     * @brief 从备用牌堆翻开顶牌作为新底牌
+     * @return 备用牌堆为空或没有底牌时返回false，状态不变
+     */
+    inline bool replaceTrayFromStack();
+    
+    /**
+     * @brief 获取卡牌当前所在区域
+     * @param cardIndex 卡牌在布局中的序号
+     */
+    inline CardLocation getLocation(int cardIndex) const;
+    
+    /**
+     * @brief 获取打包的卡牌信息：bit0-3牌面+1，bit4-6花色+1，bit7-8位置+1
+     * @param cardIndex 卡牌在布局中的序号
+     */
+    inline uint16_t getPackedCard(int cardIndex) const;
+};
+
+/**
+ * @class PackedGameLayout
+ * @brief 紧凑状态对应的牌局布局（只读，多个状态共享）
+ * @details 卡牌按"主牌区（列表顺序）、备用牌堆（列表顺序）、其他卡牌（当前底牌和已被压住的底牌）"编号，
+ *          每张卡牌的牌面和花色打包在一个字节中
+ *          从GameModel创建布局后，可以把同一牌局的任意后续GameModel打包成状态，
+ *          也可以把状态还原成GameModel：仍在原区域的卡牌保持布局中的位置和翻开/可点击标记，
+ *          离开原区域的卡牌按GameRulesService的规则移到底牌位置并翻开；
+ *          所有卡牌的发牌位置（撤销时移回的位置）原样保存，从对局中途创建布局时也不会变成当前位置
+ *          主牌区遮挡关系保存为每个位置的遮挡位掩码（压住该卡牌的主牌区位置集合）
+ */
+class PackedGameLayout
+{
+public:
+    /**
+     * @brief 支持的主牌区卡牌数量上限（位掩码宽度）
+     */
+    static const int kMaxPlayfieldCards = 64;
+    
+    /**
+     * @brief 支持的卡牌总数上限
+     */
+    static const int kMaxCards = PackedGameState::kNoCard;
+    
+    /**
+     * @brief 从游戏模型创建布局
+     * @param gameModel 游戏数据模型（以其当前状态作为布局）
+     * @return 布局指针（由调用者释放），超出上限时返回nullptr
+     */
+    static PackedGameLayout* createFromGameModel(const GameModel* gameModel);
+    
+    /**
+     * @brief 创建布局时游戏模型的状态
+     */
+    const PackedGameState& getInitialState() const { return _initialState; }
+    
+    /**
+     * @brief 把同一牌局的游戏模型打包成状态
+     * @param gameModel 游戏数据模型（主牌区须为布局主牌区的子序列，备用牌堆须为布局备用牌堆的前缀）
+     * @param outState 输出状态
+     * @return 模型不属于该布局时返回false
+     */
+    bool packState(const GameModel* gameModel, PackedGameState* outState) const;
+    
+    /**
+     * @brief 把状态还原成游戏模型
+     * @param state 紧凑状态（须属于该布局）
+     * @param trayPosition 离开原区域的卡牌使用的底牌位置（与GameRulesService的参数相同）
+     * @return 新建的游戏模型（由调用者释放）
+     */
+    GameModel* createGameModel(const PackedGameState& state, const CardPosition& trayPosition) const;
+    
+    int getCardCount() const { return static_cast<int>(_cardIds.size()); }
+    int getPlayfieldCount() const { return _playfieldCount; }
+    int getStackCount() const { return _stackCount; }
+    int getCardId(int cardIndex) const { return _cardIds[cardIndex]; }
+    CardFaceType getFace(int cardIndex) const { return static_cast<CardFaceType>((_packedCards[cardIndex] & 0x0F) - 1); }
+    CardSuitType getSuit(int cardIndex) const { return static_cast<CardSuitType>(((_packedCards[cardIndex] >> 4) & 0x07) - 1); }
+    int getFaceValue(int cardIndex) const { return _packedCards[cardIndex] & 0x0F; }
+    uint8_t getPackedFaceAndSuit(int cardIndex) const { return _packedCards[cardIndex]; }
+    CardLocation getInitialLocation(int cardIndex) const { return static_cast<CardLocation>((_cardFlags[cardIndex] & 0x03) - 1); }
+    const CardPosition& getInitialPosition(int cardIndex) const { return _positions[cardIndex]; }
+    const CardPosition& getHomePosition(int cardIndex) const { return _homePositions[cardIndex]; }
+    
+    /**
+     * @brief 获取压住主牌区第slot张卡牌的主牌区位置掩码
+     */
+    uint64_t getCoverMask(int slot) const { return _coverMasks[slot]; }
+    
+    /**
+     * @brief 根据卡牌ID获取序号
+     * @return 不存在返回-1
+     */
+    int getCardIndex(int cardId) const;
+    
+    // Zobrist键
+    uint64_t getPlayfieldKey(int slot) const { return _playfieldKeys[slot]; }
+    uint64_t getStackKey(int stackCount) const { return _stackKeys[stackCount]; }
+    uint64_t getTrayKey(int cardIndex) const { return cardIndex == PackedGameState::kNoCard ? 0 : _trayKeys[cardIndex]; }
+    
+private:
+    PackedGameLayout();
+    
+    PackedGameLayout(const PackedGameLayout&) = delete;
+    PackedGameLayout& operator=(const PackedGameLayout&) = delete;
+    
+    /**
+     * @brief 添加一张卡牌
+     */
+    void appendCard(const CardModel* card);
+    
+    /**
+     * @brief 从游戏模型的遮挡关系提取遮挡位掩码和绘制顺序
+     */
+    void initCoverMasks(const GameModel* gameModel);
+    
+    /**
+     * @brief 生成Zobrist键（固定种子，同一牌局的哈希在不同进程中一致）
+     */
+    void initZobristKeys();
+    
+    // 卡牌标记位
+    static const uint8_t kFlagFlipped = 0x04;
+    static const uint8_t kFlagClickable = 0x08;
+    
+private:
+    int _playfieldCount;                            // 主牌区卡牌数量
+    int _stackCount;                                // 备用牌堆卡牌数量
+    std::vector<int> _cardIds;                      // 卡牌ID
+    std::vector<uint8_t> _packedCards;              // 牌面+1（低4位）与花色+1（高3位）
+    std::vector<uint8_t> _cardFlags;                // 初始位置+1（低2位）与翻开/可点击标记
+    std::vector<CardPosition> _positions;           // 初始位置坐标
+    std::vector<CardPosition> _homePositions;       // 发牌位置坐标（CardModel::getHomePosition）
+    std::vector<uint64_t> _coverMasks;              // 主牌区每个位置的遮挡位掩码
+    std::vector<int> _coverDrawOrder;               // 参与遮挡计算的主牌区位置（按绘制顺序）
+    std::unordered_map<int, int> _cardIndexById;    // 卡牌ID -> 序号
+    std::vector<uint64_t> _playfieldKeys;           // 主牌区卡牌在场的键
+    std::vector<uint64_t> _stackKeys;               // 备用牌堆剩余张数的键
+    std::vector<uint64_t> _trayKeys;                // 底牌序号的键
+    PackedGameState _initialState;                  // 初始状态
+};
+
+inline bool PackedGameState::canMatchWithTray(int slot) const
+{
+    if (slot < 0 || slot >= layout->getPlayfieldCount() || !(playfieldMask & (1ULL << slot))
+        || (layout->getCoverMask(slot) & playfieldMask) || trayCardIndex == kNoCard) {
+        return false;
+    }
+    int diff = layout->getFaceValue(slot) - layout->getFaceValue(trayCardIndex);
+    return diff == 1 || diff == -1;
+}
+
+inline bool PackedGameState::replaceTrayFromPlayfield(int slot)
+{
+    if (!canMatchWithTray(slot)) {
+        return false;
+    }
+    hash ^= layout->getPlayfieldKey(slot) ^ layout->getTrayKey(trayCardIndex) ^ layout->getTrayKey(slot);
+    playfieldMask &= ~(1ULL << slot);
+    trayCardIndex = static_cast<uint16_t>(slot);
+    return true;
+}
+
+inline bool PackedGameState::replaceTrayFromStack()
+{
+    if (stackCount == 0 || trayCardIndex == kNoCard) {
+        return false;
+    }
+    int newTrayIndex = layout->getPlayfieldCount() + stackCount - 1;
+    hash ^= layout->getStackKey(stackCount) ^ layout->getStackKey(stackCount - 1)
+        ^ layout->getTrayKey(trayCardIndex) ^ layout->getTrayKey(newTrayIndex);
+    stackCount--;
+    trayCardIndex = static_cast<uint16_t>(newTrayIndex);
+    return true;
+}
+
+inline CardLocation PackedGameState::getLocation(int cardIndex) const
+{
+    int playfieldCount = layout->getPlayfieldCount();
+    if (cardIndex < playfieldCount) {
+        return (playfieldMask & (1ULL << cardIndex)) ? CL_PLAYFIELD : CL_TRAY;
+    }
+    if (cardIndex < playfieldCount + layout->getStackCount()) {
+        return (cardIndex - playfieldCount < stackCount) ? CL_STACK : CL_TRAY;
+    }
+    return layout->getInitialLocation(cardIndex);
+}
+
+inline uint16_t PackedGameState::getPackedCard(int cardIndex) const
+{
+    return static_cast<uint16_t>(layout->getPackedFaceAndSuit(cardIndex)
+                                 | ((getLocation(cardIndex) + 1) << 7));
+}
+
+#endif // __PACKED_GAME_STATE_H__
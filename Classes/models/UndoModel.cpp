@@ -1,6 +1,10 @@
 #include "UndoModel.h"
 
-UndoModel::UndoModel()
+UndoModel::UndoModel(int capacity)
+    : _actions(capacity > 0 ? capacity : 0)
+    , _head(0)
+    , _count(0)
+    , _redoCount(0)
 {
 }
 
@@ -11,31 +15,81 @@ UndoModel::~UndoModel()
 
 void UndoModel::pushAction(const UndoAction& action)
 {
-    _actions.push_back(action);
+    _redoCount = 0;
+    if (_actions.empty()) {
+        return;
+    }
+    
+    if (_count == getCapacity()) {
+        // 已满：覆盖最早的记录
+        _actions[_head] = action;
+        _head = wrapIndex(_head + 1);
+        return;
+    }
+    
+    _actions[wrapIndex(_head + _count)] = action;
+    _count++;
 }
 
 UndoAction UndoModel::popAction()
 {
-    if (_actions.empty()) {
+    if (_count == 0) {
+        return UndoAction();
+    }
+    
+    _count--;
+    _redoCount++;
+    return _actions[wrapIndex(_head + _count)];
+}
+
+UndoAction UndoModel::redoAction()
+{
+    if (_redoCount == 0) {
         return UndoAction();
     }
     
-    UndoAction action = _actions.back();
-    _actions.pop_back();
-    return action;
+    _redoCount--;
+    _count++;
+    return _actions[wrapIndex(_head + _count - 1)];
+}
+
+UndoAction UndoModel::peekRedoAction() const
+{
+    if (_redoCount == 0) {
+        return UndoAction();
+    }
+    return _actions[wrapIndex(_head + _count)];
 }
 
 void UndoModel::clear()
 {
-    _actions.clear();
+    _head = 0;
+    _count = 0;
+    _redoCount = 0;
 }
 
 bool UndoModel::canUndo() const
 {
-    return !_actions.empty();
+    return _count > 0;
 }
 
 int UndoModel::getActionCount() const
 {
-    return static_cast<int>(_actions.size());
-} 
\ No newline at end of file
+    return _count;
+}
+
+void UndoModel::setCapacity(int capacity)
+{
+    capacity = capacity > 0 ? capacity : 0;
+    int keepCount = _count < capacity ? _count : capacity;
+    
+    // 按从早到晚的顺序保留最近的keepCount条记录
+    std::vector<UndoAction> actions(capacity);
+    for (int i = 0; i < keepCount; i++) {
+        actions[i] = getAction(_count - keepCount + i);
+    }
+    _actions.swap(actions);
+    _head = 0;
+    _count = keepCount;
+    _redoCount = 0;
+}
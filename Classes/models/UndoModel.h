@@ -1,7 +1,6 @@
 #ifndef __UNDO_MODEL_H__
 #define __UNDO_MODEL_H__
 
-#include "cocos2d.h"
 #include <vector>
 
 /**
@@ -17,22 +16,20 @@ enum UndoActionType
 
 /**
  * @struct UndoAction
- * @brief 单次撤销操作的数据结构
+ * @brief 单次撤销操作的数据结构（12字节）
+ * @details 不保存位置，撤销时由卡牌ID从模型中恢复：
+ *          移动的卡牌回到发牌位置（CardModel::getHomePosition），被替换的底牌位置一直未变
  */
 struct UndoAction
 {
     UndoActionType type;            // 操作类型
     int fromCardId;                 // 源卡牌ID（移动的卡牌）
     int toCardId;                   // 目标卡牌ID（被替换的卡牌）
-    cocos2d::Vec2 fromPosition;     // 源位置
-    cocos2d::Vec2 toPosition;       // 目标位置
     
     UndoAction()
         : type(UAT_NONE)
         , fromCardId(-1)
         , toCardId(-1)
-        , fromPosition(cocos2d::Vec2::ZERO)
-        , toPosition(cocos2d::Vec2::ZERO)
     {
     }
 };
@@ -41,14 +38,23 @@ struct UndoAction
  * @class UndoModel
  * @brief 撤销操作数据模型
  * @details 存储游戏的撤销操作历史记录
+ *          使用固定容量的环形缓冲区，记录已满时覆盖最早的记录，
+ *          添加和弹出都是O(1)，构造后不再分配内存
+ *          弹出的记录留在缓冲区中作为重做记录，直到添加新记录
  */
 class UndoModel
 {
 public:
+    /**
+     * @brief 默认最多保存的撤销记录数量
+     */
+    static const int kDefaultCapacity = 512;
+    
     /**
      * @brief 构造函数
+     * @param capacity 最多保存的撤销记录数量
      */
-    UndoModel();
+    explicit UndoModel(int capacity = kDefaultCapacity);
     
     /**
      * @brief 析构函数
@@ -56,19 +62,30 @@ public:
     ~UndoModel();
     
     /**
-     * @brief 添加一条撤销记录
+     * @brief 添加一条撤销记录（已满时丢弃最早的记录），同时清空重做记录
      * @param action 撤销操作
      */
     void pushAction(const UndoAction& action);
     
     /**
-     * @brief 弹出最后一条撤销记录
+     * @brief 弹出最后一条撤销记录，它成为最近的重做记录
      * @return 撤销操作，如果没有记录返回空操作
      */
     UndoAction popAction();
     
     /**
-     * @brief 清空所有撤销记录
+     * @brief 把最近的重做记录移回撤销记录
+     * @return 重做的操作，如果没有重做记录返回空操作
+     */
+    UndoAction redoAction();
+    
+    /**
+     * @brief 获取最近的重做记录（没有时返回空操作）
+     */
+    UndoAction peekRedoAction() const;
+    
+    /**
+     * @brief 清空所有撤销和重做记录
      */
     void clear();
     
@@ -78,14 +95,60 @@ public:
      */
     bool canUndo() const;
     
+    /**
+     * @brief 检查是否有可重做的操作
+     */
+    bool canRedo() const { return _redoCount > 0; }
+    
     /**
      * @brief 获取撤销记录数量
      * @return 记录数量
      */
     int getActionCount() const;
     
+    /**
+     * @brief 按记录顺序获取撤销记录（存档时使用）
+     * @param index 序号（0为保存的最早记录）
+     */
+    const UndoAction& getAction(int index) const { return _actions[wrapIndex(_head + index)]; }
+    
+    /**
+     * @brief 获取重做记录数量
+     */
+    int getRedoCount() const { return _redoCount; }
+    
+    /**
+     * @brief 按重做顺序获取重做记录（录制回放时使用）
+     * @param index 序号（0为下一次重做的记录）
+     */
+    const UndoAction& getRedoAction(int index) const { return _actions[wrapIndex(_head + _count + index)]; }
+    
+    /**
+     * @brief 获取最多保存的撤销记录数量
+     */
+    int getCapacity() const { return static_cast<int>(_actions.size()); }
+    
+    /**
+     * @brief 修改最多保存的撤销记录数量，超出新容量的最早记录和全部重做记录被丢弃
+     * @param capacity 新容量
+     */
+    void setCapacity(int capacity);
+    
+private:
+    /**
+     * @brief 把[0, 2*容量)内的位置折回缓冲区下标
+     */
+    int wrapIndex(int index) const
+    {
+        int capacity = static_cast<int>(_actions.size());
+        return index >= capacity ? index - capacity : index;
+    }
+    
 private:
-    std::vector<UndoAction> _actions;  // 撤销操作历史记录栈
+    std::vector<UndoAction> _actions;  // 环形缓冲区（长度即容量）
+    int _head;                         // 最早记录的下标
+    int _count;                        // 记录数量
+    int _redoCount;                    // 紧跟在撤销记录之后的重做记录数量
 };
 
 #endif // __UNDO_MODEL_H__ 
\ No newline at end of file
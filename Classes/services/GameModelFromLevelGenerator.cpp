@@ -1,12 +1,52 @@
 #include "GameModelFromLevelGenerator.h"
+#include "../utils/TraceProfiler.h"
 
-int GameModelFromLevelGenerator::s_nextCardId = 0;
+thread_local int GameModelFromLevelGenerator::s_nextCardId = 0;
+
+namespace {
+
+/**
+ * @brief LevelConfig到关卡数据源接口的适配
+ */
+class LevelConfigSource
+{
+public:
+    explicit LevelConfigSource(const LevelConfig* levelConfig)
+        : _levelConfig(levelConfig)
+    {
+    }
+    
+    int getPlayfieldCount() const { return static_cast<int>(_levelConfig->getPlayfieldCards().size()); }
+    int getStackCount() const { return static_cast<int>(_levelConfig->getStackCards().size()); }
+    const CardConfig& getPlayfieldCard(int index) const { return _levelConfig->getPlayfieldCards()[index]; }
+    const CardConfig& getStackCard(int index) const { return _levelConfig->getStackCards()[index]; }
+    
+private:
+    const LevelConfig* _levelConfig;
+};
+
+} // namespace
 
 GameModel* GameModelFromLevelGenerator::generateGameModel(const LevelConfig* levelConfig)
 {
     if (!levelConfig) {
         return nullptr;
     }
+    return generateFromSource(LevelConfigSource(levelConfig));
+}
+
+GameModel* GameModelFromLevelGenerator::generateGameModel(const LevelView& level)
+{
+    if (!level.isValid()) {
+        return nullptr;
+    }
+    return generateFromSource(level);
+}
+
+template <typename LevelSource>
+GameModel* GameModelFromLevelGenerator::generateFromSource(const LevelSource& source)
+{
+    TRACE_ZONE("GameModelFromLevelGenerator::generateGameModel");
     
     GameModel* gameModel = new GameModel();
     
@@ -14,35 +54,43 @@ GameModel* GameModelFromLevelGenerator::generateGameModel(const LevelConfig* lev
     s_nextCardId = 0;
     
     // 生成主牌区卡牌
-    const auto& playfieldCards = levelConfig->getPlayfieldCards();
-    for (const auto& cardConfig : playfieldCards) {
+    int playfieldCount = source.getPlayfieldCount();
+    std::vector<int> playfieldIds;
+    std::vector<CardPosition> playfieldPositions;
+    playfieldIds.reserve(playfieldCount);
+    playfieldPositions.reserve(playfieldCount);
+    
+    for (int i = 0; i < playfieldCount; i++) {
+        const CardConfig& cardConfig = source.getPlayfieldCard(i);
         int cardId = getNextCardId();
-        CardModel* card = new CardModel(cardConfig.face, cardConfig.suit, cardId);
+        CardModel* card = gameModel->createCard(cardConfig.face, cardConfig.suit, cardId);
         card->setPosition(cardConfig.position);
+        card->setHomePosition(cardConfig.position);
         card->setLocation(CL_PLAYFIELD);
         card->setFlipped(true);      // 主牌区的牌默认翻开
-        card->setClickable(true);    // 主牌区的牌默认可点击
-        
-        gameModel->addCard(card);
         
         // 将卡牌ID添加到主牌区列表
-        std::vector<int> playfieldIds = gameModel->getPlayfieldCardIds();
         playfieldIds.push_back(cardId);
-        gameModel->setPlayfieldCardIds(playfieldIds);
+        playfieldPositions.push_back(cardConfig.position);
     }
     
+    gameModel->setPlayfieldCardIds(playfieldIds);
+    
+    // 按配置顺序计算遮挡（后配置的卡牌绘制在上层），只有未被压住的牌可点击
+    gameModel->buildCoverGraph(playfieldIds, playfieldPositions);
+    
     // 生成备用牌堆卡牌
-    const auto& stackCards = levelConfig->getStackCards();
+    int stackCount = source.getStackCount();
     std::vector<int> stackIds;
+    stackIds.reserve(stackCount);
     
-    for (const auto& cardConfig : stackCards) {
+    for (int i = 0; i < stackCount; i++) {
+        const CardConfig& cardConfig = source.getStackCard(i);
         int cardId = getNextCardId();
-        CardModel* card = new CardModel(cardConfig.face, cardConfig.suit, cardId);
+        CardModel* card = gameModel->createCard(cardConfig.face, cardConfig.suit, cardId);
         card->setLocation(CL_STACK);
         card->setFlipped(false);     // 备用牌堆的牌默认覆盖
         card->setClickable(false);   // 备用牌堆的牌默认不可点击
-        
-        gameModel->addCard(card);
         stackIds.push_back(cardId);
     }
     
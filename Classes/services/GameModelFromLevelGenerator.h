@@ -2,6 +2,7 @@
 #define __GAME_MODEL_FROM_LEVEL_GENERATOR_H__
 
 #include "../configs/models/LevelConfig.h"
+#include "../configs/models/LevelPack.h"
 #include "../models/GameModel.h"
 
 /**
@@ -20,14 +21,28 @@ public:
      */
     static GameModel* generateGameModel(const LevelConfig* levelConfig);
     
+    /**
+     * @brief 从关卡包中的关卡生成游戏数据模型（直接读取关卡包内存，不经过LevelConfig）
+     * @param level 关卡视图
+     * @return 生成的游戏数据模型，调用方负责释放内存；视图无效时返回nullptr
+     */
+    static GameModel* generateGameModel(const LevelView& level);
+    
 private:
+    /**
+     * @brief 从关卡数据源生成游戏数据模型
+     * @details LevelSource需提供getPlayfieldCount/getPlayfieldCard/getStackCount/getStackCard
+     */
+    template <typename LevelSource>
+    static GameModel* generateFromSource(const LevelSource& source);
+    
     /**
      * @brief 生成下一个唯一的卡牌ID
      * @return 卡牌ID
      */
     static int getNextCardId();
     
-    static int s_nextCardId;  // 静态卡牌ID计数器
+    static thread_local int s_nextCardId;  // 卡牌ID计数器（每个线程独立，支持多线程生成）
 };
 
 #endif // __GAME_MODEL_FROM_LEVEL_GENERATOR_H__ 
\ No newline at end of file
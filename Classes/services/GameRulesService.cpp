@@ -0,0 +1,115 @@
+#include "GameRulesService.h"
+
+bool GameRulesService::canMatchWithTray(const GameModel* gameModel, int cardId)
+{
+    if (!gameModel) {
+        return false;
+    }
+    
+    CardModel* card = gameModel->getCardById(cardId);
+    CardModel* trayCard = gameModel->getCardById(gameModel->getTrayCardId());
+    
+    if (!card || !trayCard) {
+        return false;
+    }
+    
+    // 被其他主牌区卡牌压住的牌不能操作
+    if (card->getLocation() == CL_PLAYFIELD && gameModel->isCardCovered(cardId)) {
+        return false;
+    }
+    
+    // 检查是否可以匹配（牌面数值差1）
+    return card->canMatchWith(trayCard);
+}
+
+bool GameRulesService::replaceTrayFromStack(GameModel* gameModel, const CardPosition& trayPosition,
+                                            UndoAction* outAction)
+{
+    if (!gameModel || gameModel->getStackCardIds().empty()) {
+        return false;
+    }
+    
+    // 获取当前底牌和备用牌堆顶牌（先检查再弹出，避免失败时丢牌）
+    int oldTrayCardId = gameModel->getTrayCardId();
+    int newTrayCardId = gameModel->getStackCardIds().back();
+    
+    CardModel* oldTrayCard = gameModel->getCardById(oldTrayCardId);
+    CardModel* newTrayCard = gameModel->getCardById(newTrayCardId);
+    
+    if (!oldTrayCard || !newTrayCard) {
+        return false;
+    }
+    
+    // 记录撤销操作（在修改数据前）
+    if (outAction) {
+        outAction->type = UAT_REPLACE_TRAY_FROM_STACK;
+        outAction->fromCardId = newTrayCardId;
+        outAction->toCardId = oldTrayCardId;
+    }
+    
+    gameModel->popFromStack();
+    
+    newTrayCard->setLocation(CL_TRAY);
+    newTrayCard->setFlipped(true);
+    newTrayCard->setPosition(trayPosition);
+    gameModel->setTrayCardId(newTrayCardId);
+    
+    return true;
+}
+
+bool GameRulesService::replaceTrayFromPlayfield(GameModel* gameModel, int playfieldCardId,
+                                                const CardPosition& trayPosition, UndoAction* outAction)
+{
+    if (!gameModel) {
+        return false;
+    }
+    
+    CardModel* playfieldCard = gameModel->getCardById(playfieldCardId);
+    int oldTrayCardId = gameModel->getTrayCardId();
+    CardModel* oldTrayCard = gameModel->getCardById(oldTrayCardId);
+    
+    if (!playfieldCard || !oldTrayCard) {
+        return false;
+    }
+    
+    // 记录撤销操作（在修改数据前）
+    if (outAction) {
+        outAction->type = UAT_REPLACE_TRAY_FROM_PLAYFIELD;
+        outAction->fromCardId = playfieldCardId;
+        outAction->toCardId = oldTrayCardId;
+    }
+    
+    // 从主牌区移除，并移动到底牌堆
+    gameModel->removeFromPlayfield(playfieldCardId);
+    
+    playfieldCard->setLocation(CL_TRAY);
+    playfieldCard->setPosition(trayPosition);
+    gameModel->setTrayCardId(playfieldCardId);
+    
+    return true;
+}
+
+bool GameRulesService::applyAction(GameModel* gameModel, const UndoAction& action, const CardPosition& trayPosition)
+{
+    // 先确认记录描述的正是当前状态下的操作，再修改模型
+    if (!gameModel || gameModel->getTrayCardId() != action.toCardId) {
+        return false;
+    }
+    
+    if (action.type == UAT_REPLACE_TRAY_FROM_STACK) {
+        const std::vector<int>& stackIds = gameModel->getStackCardIds();
+        if (stackIds.empty() || stackIds.back() != action.fromCardId) {
+            return false;
+        }
+        return replaceTrayFromStack(gameModel, trayPosition, nullptr);
+    }
+    
+    if (action.type == UAT_REPLACE_TRAY_FROM_PLAYFIELD) {
+        const CardModel* card = gameModel->getCardById(action.fromCardId);
+        if (!card || card->getLocation() != CL_PLAYFIELD || !canMatchWithTray(gameModel, action.fromCardId)) {
+            return false;
+        }
+        return replaceTrayFromPlayfield(gameModel, action.fromCardId, trayPosition, nullptr);
+    }
+    return false;
+}
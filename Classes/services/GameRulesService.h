@@ -0,0 +1,56 @@
+#ifndef __GAME_RULES_SERVICE_H__
+#define __GAME_RULES_SERVICE_H__
+
+#include "../models/GameModel.h"
+#include "../models/UndoModel.h"
+#include "../utils/CardPosition.h"
+
+/**
+ * @class GameRulesService
+ * @brief 游戏规则服务
+ * @details 无状态服务，实现底牌/备用牌堆/主牌区之间的状态转换和匹配规则
+ *          不依赖引擎与视图，客户端的GameController和无头模拟器共用同一套规则
+ */
+class GameRulesService
+{
+public:
+    /**
+     * @brief 检查主牌区卡牌是否可以与底牌匹配（被其他卡牌压住的卡牌不能匹配）
+     * @param gameModel 游戏数据模型
+     * @param cardId 主牌区卡牌ID
+     * @return 如果可以匹配返回true
+     */
+    static bool canMatchWithTray(const GameModel* gameModel, int cardId);
+    
+    /**
+     * @brief 从备用牌堆翻牌替换底牌
+     * @param gameModel 游戏数据模型
+     * @param trayPosition 底牌堆位置
+     * @param outAction 输出本次操作对应的撤销记录，可为nullptr
+     * @return 是否成功翻牌
+     */
+    static bool replaceTrayFromStack(GameModel* gameModel, const CardPosition& trayPosition, UndoAction* outAction);
+    
+    /**
+     * @brief 用主牌区的卡牌替换底牌
+     * @param gameModel 游戏数据模型
+     * @param playfieldCardId 主牌区卡牌ID
+     * @param trayPosition 底牌堆位置
+     * @param outAction 输出本次操作对应的撤销记录，可为nullptr
+     * @return 是否成功替换
+     * @details 不检查匹配规则，调用方需先调用canMatchWithTray
+     */
+    static bool replaceTrayFromPlayfield(GameModel* gameModel, int playfieldCardId,
+                                         const CardPosition& trayPosition, UndoAction* outAction);
+    
+    /**
+     * @brief 重新执行一次已记录的操作（重做、读档重放使用）
+     * @param gameModel 游戏数据模型
+     * @param action 操作产生的撤销记录
+     * @param trayPosition 底牌堆位置
+     * @return 记录与当前状态不一致（底牌、牌堆顶或可匹配性不符）时返回false，模型不被修改
+     */
+    static bool applyAction(GameModel* gameModel, const UndoAction& action, const CardPosition& trayPosition);
+};
+
+#endif // __GAME_RULES_SERVICE_H__
@@ -0,0 +1,273 @@
+#include "GameSnapshotService.h"
+#include <cstring>
+#include <limits>
+
+const char GameSnapshotService::kMagic[4] = { 'G', 'S', 'N', 'P' };
+
+static_assert(sizeof(GameSnapshotHeader) == 48, "GameSnapshotHeader layout");
+static_assert(sizeof(GameSnapshotCard) == 24, "GameSnapshotCard layout");
+static_assert(sizeof(GameSnapshotUndoAction) == 12, "GameSnapshotUndoAction layout");
+static_assert(sizeof(int) == sizeof(int32_t), "card id arrays are read in place");
+
+namespace {
+
+const uint8_t kCardFlagFlipped = 0x01;
+const uint8_t kCardFlagClickable = 0x02;
+
+bool isLittleEndianHost()
+{
+    const uint16_t probe = 1;
+    return *reinterpret_cast<const uint8_t*>(&probe) == 1;
+}
+
+/**
+ * @brief 按字节写入一个值并前移写入位置
+ */
+template <typename T>
+void writeValue(uint8_t** cursor, const T& value)
+{
+    memcpy(*cursor, &value, sizeof(T));
+    *cursor += sizeof(T);
+}
+
+void writeIds(uint8_t** cursor, const std::vector<int>& ids)
+{
+    if (!ids.empty()) {
+        memcpy(*cursor, ids.data(), ids.size() * sizeof(int32_t));
+        *cursor += ids.size() * sizeof(int32_t);
+    }
+}
+
+/**
+ * @brief 按快照头计算快照字节数
+ */
+uint64_t computeSnapshotSize(const GameSnapshotHeader& header)
+{
+    uint64_t offsetCount = header.graphIdCount > 0 ? static_cast<uint64_t>(header.graphIdCount) + 1 : 0;
+    uint64_t idCount = static_cast<uint64_t>(header.playfieldCount) + header.stackCount
+        + header.graphCardCount + offsetCount + header.graphEdgeCount;
+    return sizeof(GameSnapshotHeader)
+        + static_cast<uint64_t>(header.cardCount) * sizeof(GameSnapshotCard)
+        + idCount * sizeof(int32_t)
+        + (static_cast<uint64_t>(header.undoCount) + header.redoCount) * sizeof(GameSnapshotUndoAction);
+}
+
+/**
+ * @brief 卡牌ID列表中的卡牌是否都存在
+ */
+bool allCardsExist(const GameModel* gameModel, const int* cardIds, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        if (!gameModel->getCardById(cardIds[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+size_t GameSnapshotService::getSnapshotSize(const GameModel* gameModel, const UndoModel* undoModel)
+{
+    if (!gameModel) {
+        return 0;
+    }
+    
+    const CardCoverGraph& coverGraph = gameModel->getCoverGraph();
+    size_t idCount = gameModel->getPlayfieldCardIds().size() + gameModel->getStackCardIds().size()
+        + coverGraph.getDrawOrder().size() + coverGraph.getCoveredOffsets().size()
+        + coverGraph.getCoveredIds().size();
+    size_t undoCount = undoModel ? static_cast<size_t>(undoModel->getActionCount() + undoModel->getRedoCount()) : 0;
+    return sizeof(GameSnapshotHeader)
+        + gameModel->getAllCards().size() * sizeof(GameSnapshotCard)
+        + idCount * sizeof(int32_t)
+        + undoCount * sizeof(GameSnapshotUndoAction);
+}
+
+size_t GameSnapshotService::writeSnapshot(const GameModel* gameModel, const UndoModel* undoModel,
+                                          void* buffer, size_t capacity)
+{
+    size_t size = getSnapshotSize(gameModel, undoModel);
+    if (size == 0 || !buffer || size > capacity || size > std::numeric_limits<uint32_t>::max()) {
+        return 0;
+    }
+    
+    const CardCoverGraph& coverGraph = gameModel->getCoverGraph();
+    size_t offsetCount = coverGraph.getCoveredOffsets().size();
+    if (offsetCount > static_cast<size_t>(kMaxCardId) + 2) {
+        return 0;
+    }
+    
+    GameSnapshotHeader header;
+    memcpy(header.magic, kMagic, sizeof(header.magic));
+    header.version = kVersion;
+    header.totalSize = static_cast<uint32_t>(size);
+    header.trayCardId = gameModel->getTrayCardId();
+    header.cardCount = static_cast<uint32_t>(gameModel->getAllCards().size());
+    header.playfieldCount = static_cast<uint32_t>(gameModel->getPlayfieldCardIds().size());
+    header.stackCount = static_cast<uint32_t>(gameModel->getStackCardIds().size());
+    header.undoCount = undoModel ? static_cast<uint32_t>(undoModel->getActionCount()) : 0;
+    header.redoCount = undoModel ? static_cast<uint32_t>(undoModel->getRedoCount()) : 0;
+    header.graphCardCount = static_cast<uint32_t>(coverGraph.getDrawOrder().size());
+    header.graphIdCount = offsetCount > 0 ? static_cast<uint32_t>(offsetCount - 1) : 0;
+    header.graphEdgeCount = static_cast<uint32_t>(coverGraph.getCoveredIds().size());
+    
+    uint8_t* cursor = static_cast<uint8_t*>(buffer);
+    writeValue(&cursor, header);
+    
+    for (const CardModel* card : gameModel->getAllCards()) {
+        if (card->getCardId() > kMaxCardId) {
+            return 0;
+        }
+        GameSnapshotCard record;
+        record.cardId = card->getCardId();
+        record.x = card->getPosition().x;
+        record.y = card->getPosition().y;
+        record.homeX = card->getHomePosition().x;
+        record.homeY = card->getHomePosition().y;
+        record.face = static_cast<int8_t>(card->getFace());
+        record.suit = static_cast<int8_t>(card->getSuit());
+        record.location = static_cast<int8_t>(card->getLocation());
+        record.flags = (card->isFlipped() ? kCardFlagFlipped : 0) | (card->isClickable() ? kCardFlagClickable : 0);
+        writeValue(&cursor, record);
+    }
+    
+    writeIds(&cursor, gameModel->getPlayfieldCardIds());
+    writeIds(&cursor, gameModel->getStackCardIds());
+    writeIds(&cursor, coverGraph.getDrawOrder());
+    writeIds(&cursor, coverGraph.getCoveredOffsets());
+    writeIds(&cursor, coverGraph.getCoveredIds());
+    
+    for (uint32_t i = 0; i < header.undoCount + header.redoCount; i++) {
+        const UndoAction& action = i < header.undoCount
+            ? undoModel->getAction(static_cast<int>(i))
+            : undoModel->getRedoAction(static_cast<int>(i - header.undoCount));
+        GameSnapshotUndoAction record;
+        record.type = action.type;
+        record.fromCardId = action.fromCardId;
+        record.toCardId = action.toCardId;
+        writeValue(&cursor, record);
+    }
+    return size;
+}
+
+bool GameSnapshotService::readSnapshot(const void* data, size_t size, GameModel* gameModel, UndoModel* undoModel)
+{
+    if (!gameModel) {
+        return false;
+    }
+    gameModel->clear();
+    if (undoModel) {
+        undoModel->clear();
+    }
+    
+    // 格式按小端存储，ID数组直接在缓冲区中使用
+    if (!data || size < sizeof(GameSnapshotHeader) || !isLittleEndianHost()
+        || (reinterpret_cast<uintptr_t>(data) & 3) != 0) {
+        return false;
+    }
+    
+    GameSnapshotHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (!validateHeader(header, size)) {
+        return false;
+    }
+    
+    if (!readSections(static_cast<const uint8_t*>(data), header, gameModel, undoModel)) {
+        gameModel->clear();
+        if (undoModel) {
+            undoModel->clear();
+        }
+        return false;
+    }
+    return true;
+}
+
+bool GameSnapshotService::validateHeader(const GameSnapshotHeader& header, size_t size)
+{
+    if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+        return false;
+    }
+    if (header.totalSize > size || header.graphIdCount > static_cast<uint32_t>(kMaxCardId) + 1) {
+        return false;
+    }
+    return computeSnapshotSize(header) == header.totalSize;
+}
+
+bool GameSnapshotService::readSections(const uint8_t* data, const GameSnapshotHeader& header,
+                                       GameModel* gameModel, UndoModel* undoModel)
+{
+    const uint8_t* cursor = data + sizeof(GameSnapshotHeader);
+    
+    const GameSnapshotCard* cards = reinterpret_cast<const GameSnapshotCard*>(cursor);
+    cursor += header.cardCount * sizeof(GameSnapshotCard);
+    for (uint32_t i = 0; i < header.cardCount; i++) {
+        const GameSnapshotCard& record = cards[i];
+        if (record.cardId < 0 || record.cardId > kMaxCardId || gameModel->getCardById(record.cardId)) {
+            return false;
+        }
+        if (record.face < CFT_NONE || record.face >= CFT_NUM_CARD_FACE_TYPES
+            || record.suit < CST_NONE || record.suit >= CST_NUM_CARD_SUIT_TYPES
+            || record.location < CL_NONE || record.location > CL_STACK) {
+            return false;
+        }
+        
+        CardModel* card = gameModel->createCard(static_cast<CardFaceType>(record.face),
+                                                static_cast<CardSuitType>(record.suit), record.cardId);
+        card->setLocation(static_cast<CardLocation>(record.location));
+        card->setPosition(CardPosition(record.x, record.y));
+        card->setHomePosition(CardPosition(record.homeX, record.homeY));
+        card->setFlipped((record.flags & kCardFlagFlipped) != 0);
+        card->setClickable((record.flags & kCardFlagClickable) != 0);
+    }
+    
+    const int* playfieldIds = reinterpret_cast<const int*>(cursor);
+    cursor += header.playfieldCount * sizeof(int32_t);
+    const int* stackIds = reinterpret_cast<const int*>(cursor);
+    cursor += header.stackCount * sizeof(int32_t);
+    if (!allCardsExist(gameModel, playfieldIds, header.playfieldCount)
+        || !allCardsExist(gameModel, stackIds, header.stackCount)
+        || (header.trayCardId != -1 && !gameModel->getCardById(header.trayCardId))) {
+        return false;
+    }
+    gameModel->setPlayfieldCardIds(playfieldIds, header.playfieldCount);
+    gameModel->setStackCardIds(stackIds, header.stackCount);
+    gameModel->setTrayCardId(header.trayCardId);
+    
+    const int* drawOrder = reinterpret_cast<const int*>(cursor);
+    cursor += header.graphCardCount * sizeof(int32_t);
+    const int* coveredOffsets = reinterpret_cast<const int*>(cursor);
+    cursor += (header.graphIdCount > 0 ? header.graphIdCount + 1 : 0) * sizeof(int32_t);
+    const int* coveredIds = reinterpret_cast<const int*>(cursor);
+    cursor += header.graphEdgeCount * sizeof(int32_t);
+    if (!gameModel->restoreCoverGraph(drawOrder, static_cast<int>(header.graphCardCount), coveredOffsets,
+                                      static_cast<int>(header.graphIdCount), coveredIds,
+                                      static_cast<int>(header.graphEdgeCount))) {
+        return false;
+    }
+    
+    if (!undoModel) {
+        return true;
+    }
+    // 可重做记录先按顺序压入，再逐条弹出，回到撤销与重做的分界处
+    const GameSnapshotUndoAction* actions = reinterpret_cast<const GameSnapshotUndoAction*>(cursor);
+    for (uint32_t i = 0; i < header.undoCount + header.redoCount; i++) {
+        const GameSnapshotUndoAction& record = actions[i];
+        if (record.type != UAT_REPLACE_TRAY_FROM_STACK && record.type != UAT_REPLACE_TRAY_FROM_PLAYFIELD) {
+            return false;
+        }
+        if (!gameModel->getCardById(record.fromCardId) || !gameModel->getCardById(record.toCardId)) {
+            return false;
+        }
+        
+        UndoAction action;
+        action.type = static_cast<UndoActionType>(record.type);
+        action.fromCardId = record.fromCardId;
+        action.toCardId = record.toCardId;
+        undoModel->pushAction(action);
+    }
+    for (uint32_t i = 0; i < header.redoCount; i++) {
+        undoModel->popAction();
+    }
+    return true;
+}
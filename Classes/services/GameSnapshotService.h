@@ -0,0 +1,133 @@
+#ifndef __GAME_SNAPSHOT_SERVICE_H__
+#define __GAME_SNAPSHOT_SERVICE_H__
+
+#include "../models/GameModel.h"
+#include "../models/UndoModel.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file GameSnapshotService.h
+ * @brief 二进制存档快照格式
+ * @details 一个快照同时保存GameModel和UndoModel，所有字段为小端、4字节对齐：
+ *          [GameSnapshotHeader][GameSnapshotCard x cardCount]
+ *          [主牌区ID x playfieldCount][备用牌堆ID x stackCount]
+ *          [遮挡关系：绘制顺序 x graphCardCount][边偏移 x (graphIdCount+1)][被压住的卡牌ID x graphEdgeCount]
+ *          [GameSnapshotUndoAction x undoCount][GameSnapshotUndoAction x redoCount]
+ *          遮挡关系按原样保存，撤销放回主牌区的卡牌读档后仍能压住下层卡牌
+ *          可重做记录按重做顺序保存（下一个重做的在前），读档后仍可重做
+ */
+
+/**
+ * @struct GameSnapshotHeader
+ * @brief 快照文件头（48字节）
+ */
+struct GameSnapshotHeader
+{
+    char magic[4];              // 文件标识"GSNP"
+    uint32_t version;           // 格式版本
+    uint32_t totalSize;         // 快照总字节数
+    int32_t trayCardId;         // 底牌ID（没有时为-1）
+    uint32_t cardCount;         // 卡牌数量
+    uint32_t playfieldCount;    // 主牌区卡牌数量
+    uint32_t stackCount;        // 备用牌堆卡牌数量
+    uint32_t undoCount;         // 撤销记录数量
+    uint32_t graphCardCount;    // 遮挡关系中的卡牌数量
+    uint32_t graphIdCount;      // 遮挡关系的卡牌ID上限（最大卡牌ID+1，没有时为0）
+    uint32_t graphEdgeCount;    // 遮挡关系的边数量
+    uint32_t redoCount;         // 可重做记录数量
+};
+
+/**
+ * @struct GameSnapshotCard
+ * @brief 卡牌记录（24字节）
+ */
+struct GameSnapshotCard
+{
+    int32_t cardId;     // 卡牌ID
+    float x;            // 位置X坐标
+    float y;            // 位置Y坐标
+    float homeX;        // 发牌位置X坐标
+    float homeY;        // 发牌位置Y坐标
+    int8_t face;        // 牌面（CardFaceType）
+    int8_t suit;        // 花色（CardSuitType）
+    int8_t location;    // 位置（CardLocation）
+    uint8_t flags;      // 翻开/可点击标记
+};
+
+/**
+ * @struct GameSnapshotUndoAction
+ * @brief 撤销记录（12字节）
+ */
+struct GameSnapshotUndoAction
+{
+    int32_t type;       // 操作类型（UndoActionType）
+    int32_t fromCardId; // 源卡牌ID
+    int32_t toCardId;   // 目标卡牌ID
+};
+
+/**
+ * @class GameSnapshotService
+ * @brief 二进制存档快照服务
+ * @details 无状态服务，每次操作后自动存档使用
+ *          写入到调用方预先分配的缓冲区，不构建中间对象；
+ *          读取时直接使用缓冲区中的数组，GameModel/UndoModel复用已有的内存池和容量，
+ *          读入相同规模的关卡时不再分配内存
+ *          GameModel::serialize的JSON格式只用于调试查看
+ */
+class GameSnapshotService
+{
+public:
+    /**
+     * @brief 文件标识与当前格式版本
+     */
+    static const char kMagic[4];
+    static const uint32_t kVersion = 3;
+    
+    /**
+     * @brief 快照中允许的最大卡牌ID（防止损坏的数据导致超大分配）
+     */
+    static const int kMaxCardId = (1 << 20) - 1;
+    
+    /**
+     * @brief 计算快照字节数
+     * @param gameModel 游戏数据模型
+     * @param undoModel 撤销数据模型（可为nullptr，不保存撤销记录）
+     */
+    static size_t getSnapshotSize(const GameModel* gameModel, const UndoModel* undoModel);
+    
+    /**
+     * @brief 写入快照
+     * @param gameModel 游戏数据模型
+     * @param undoModel 撤销数据模型（可为nullptr）
+     * @param buffer 输出缓冲区（无对齐要求）
+     * @param capacity 缓冲区字节数
+     * @return 写入的字节数，缓冲区不足或卡牌ID超出上限时返回0
+     */
+    static size_t writeSnapshot(const GameModel* gameModel, const UndoModel* undoModel,
+                                void* buffer, size_t capacity);
+    
+    /**
+     * @brief 读取快照
+     * @param data 快照数据（至少4字节对齐）
+     * @param size 数据字节数（不小于快照头中的totalSize）
+     * @param gameModel 输出游戏数据模型（原有内容被替换）
+     * @param undoModel 输出撤销数据模型（可为nullptr，忽略撤销记录；超出其容量的最早记录被丢弃）
+     * @return 格式错误或数据不一致时返回false，此时gameModel和undoModel被清空
+     */
+    static bool readSnapshot(const void* data, size_t size, GameModel* gameModel, UndoModel* undoModel);
+    
+private:
+    /**
+     * @brief 校验快照头（各段长度之和必须等于totalSize）
+     */
+    static bool validateHeader(const GameSnapshotHeader& header, size_t size);
+    
+    /**
+     * @brief 读取快照数据（gameModel和undoModel已清空）
+     */
+    static bool readSections(const uint8_t* data, const GameSnapshotHeader& header,
+                             GameModel* gameModel, UndoModel* undoModel);
+};
+
+#endif // __GAME_SNAPSHOT_SERVICE_H__
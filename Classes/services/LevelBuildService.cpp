@@ -0,0 +1,40 @@
+#include "LevelBuildService.h"
+#include "GameModelFromLevelGenerator.h"
+#include "ProceduralLevelGenerator.h"
+#include "../utils/CoreLog.h"
+#include "../utils/TraceProfiler.h"
+#if POKER_CORE_JSON
+#include "../configs/loaders/LevelConfigLoader.h"
+#endif
+#include <utility>
+
+GameModel* LevelBuildService::buildGameModel(LevelLoadInput& input)
+{
+    TRACE_ZONE("LevelBuildService::buildGameModel");
+    
+    if (input.packLevel.isValid()) {
+        return GameModelFromLevelGenerator::generateGameModel(input.packLevel);
+    }
+    
+    LevelConfig* levelConfig = nullptr;
+#if POKER_CORE_JSON
+    if (!input.json.empty()) {
+        levelConfig = LevelConfigLoader::loadFromString(std::move(input.json));
+        input.json.clear();
+        if (!levelConfig) {
+            CORE_LOG("LevelBuildService: JSON parse error in level %d", input.levelId);
+        }
+    }
+#endif
+    if (!levelConfig && input.layout) {
+        levelConfig = ProceduralLevelGenerator::generateLevelConfig(*input.layout, input.seed, input.difficulty);
+    }
+    if (!levelConfig) {
+        return nullptr;
+    }
+    
+    levelConfig->setLevelId(input.levelId);
+    GameModel* gameModel = GameModelFromLevelGenerator::generateGameModel(levelConfig);
+    delete levelConfig;
+    return gameModel;
+}
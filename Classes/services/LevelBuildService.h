@@ -0,0 +1,24 @@
+#ifndef __LEVEL_BUILD_SERVICE_H__
+#define __LEVEL_BUILD_SERVICE_H__
+
+#include "../configs/models/LevelLoadInput.h"
+#include "../models/GameModel.h"
+
+/**
+ * @class LevelBuildService
+ * @brief 关卡生成服务
+ * @details 无状态服务，把主线程准备好的LevelLoadInput解析并生成为GameModel
+ *          只使用核心库（不读取文件，日志只通过CORE_LOG），可在工作线程中调用
+ */
+class LevelBuildService
+{
+public:
+    /**
+     * @brief 从关卡输入生成游戏数据模型
+     * @param input 关卡输入（JSON内容会被原地解析，调用后不再可用）
+     * @return 生成的游戏数据模型，调用方负责释放内存；所有来源都失败时返回nullptr
+     */
+    static GameModel* buildGameModel(LevelLoadInput& input);
+};
+
+#endif // __LEVEL_BUILD_SERVICE_H__
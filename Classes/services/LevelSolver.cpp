@@ -0,0 +1,58 @@
+#include "LevelSolver.h"
+#include "LevelSolverSearch.h"
+#include <unordered_map>
+
+namespace {
+
+/**
+ * @class LocalSolverTable
+ * @brief 单线程置换表（精确键，不丢弃条目）
+ */
+class LocalSolverTable
+{
+public:
+    bool find(const SolverStateKey& key, SolverSubtreeResult* outResult) const
+    {
+        auto it = _entries.find(key);
+        if (it == _entries.end()) {
+            return false;
+        }
+        *outResult = it->second;
+        return true;
+    }
+    
+    void store(const SolverStateKey& key, const SolverSubtreeResult& result)
+    {
+        _entries[key] = result;
+    }
+    
+private:
+    std::unordered_map<SolverStateKey, SolverSubtreeResult, SolverStateKeyHash> _entries;
+};
+
+} // namespace
+
+LevelSolveResult LevelSolver::solve(const GameModel* gameModel)
+{
+    LevelSolveResult result;
+    if (!gameModel) {
+        return result;
+    }
+    
+    SolverDeal deal;
+    if (!deal.init(gameModel)) {
+        return result;
+    }
+    
+    LocalSolverTable table;
+    SolverSearch<LocalSolverTable> search(deal, table);
+    SolverSubtreeResult root = search.search(deal.getRootKey());
+    
+    result.supported = true;
+    result.winnable = root.winningLines > 0;
+    result.minStackDraws = root.minStackDraws;
+    result.minMoveCount = result.winnable ? deal.getPlayfieldCount() + root.minStackDraws : -1;
+    result.winningLineCount = root.winningLines;
+    result.nodesExpanded = search.getNodesExpanded();
+    return result;
+}
@@ -0,0 +1,61 @@
+#ifndef __LEVEL_SOLVER_H__
+#define __LEVEL_SOLVER_H__
+
+#include "../models/GameModel.h"
+
+/**
+ * @struct LevelSolveResult
+ * @brief 关卡求解结果
+ */
+struct LevelSolveResult
+{
+    bool supported;                         // 是否支持求解（主牌区超过上限时为false）
+    bool winnable;                          // 是否存在必胜路线
+    int minStackDraws;                      // 获胜所需的最少翻牌次数，不可胜时为-1
+    int minMoveCount;                       // 获胜所需的最少操作数（匹配+翻牌），不可胜时为-1
+    unsigned long long winningLineCount;    // 不同获胜路线的数量（溢出时饱和到最大值）
+    unsigned long long nodesExpanded;       // 搜索展开的状态数
+    
+    LevelSolveResult()
+        : supported(false)
+        , winnable(false)
+        , minStackDraws(-1)
+        , minMoveCount(-1)
+        , winningLineCount(0)
+        , nodesExpanded(0)
+    {
+    }
+};
+
+/**
+ * @class LevelSolver
+ * @brief 关卡求解服务
+ * @details 无状态服务，从GameModel的当前状态出发，对"主牌区匹配"和"备用牌堆翻牌"
+ *          两种操作做深度优先穷举，判断关卡是否可胜、最少翻牌次数以及获胜路线数量
+ *
+ *          状态只取决于剩余主牌区卡牌（位掩码）、备用牌堆剩余张数和底牌牌面数值，
+ *          每步操作都会减少一张卡牌，状态图无环，因此置换表中缓存的子树结果是精确的
+ *          多线程批量求解见BatchSolverManager
+ */
+class LevelSolver
+{
+public:
+    /**
+     * @brief 支持求解的主牌区卡牌数量上限
+     */
+    static const int kMaxPlayfieldCards = 64;
+    
+    /**
+     * @brief 支持求解的备用牌堆卡牌数量上限
+     */
+    static const int kMaxStackCards = 4095;
+    
+    /**
+     * @brief 求解关卡
+     * @param gameModel 游戏数据模型（从其当前状态开始求解）
+     * @return 求解结果
+     */
+    static LevelSolveResult solve(const GameModel* gameModel);
+};
+
+#endif // __LEVEL_SOLVER_H__
@@ -0,0 +1,331 @@
+#ifndef __LEVEL_SOLVER_SEARCH_H__
+#define __LEVEL_SOLVER_SEARCH_H__
+
+#include "LevelSolver.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @file LevelSolverSearch.h
+ * @brief 关卡求解的搜索实现
+ * @details LevelSolver（单线程）与BatchSolverManager（多线程）共用的牌局数据和深度优先搜索，
+ *          两者只在置换表的实现上不同，置换表通过模板参数传入
+ *          仅供求解器和难度评估（DifficultyEstimatorManager）内部使用
+ */
+
+/**
+ * @struct SolverStateKey
+ * @brief 搜索状态：剩余主牌区位掩码 + (备用牌堆剩余张数 << 4 | 底牌数值)
+ */
+struct SolverStateKey
+{
+    uint64_t playfieldMask;     // 剩余主牌区卡牌位掩码
+    uint32_t stackAndTray;      // 备用牌堆剩余张数与底牌数值
+    
+    bool operator==(const SolverStateKey& other) const
+    {
+        return playfieldMask == other.playfieldMask && stackAndTray == other.stackAndTray;
+    }
+    
+    int getStackCount() const { return static_cast<int>(stackAndTray >> 4); }
+    int getTrayValue() const { return static_cast<int>(stackAndTray & 0xF); }
+    
+    static SolverStateKey make(uint64_t playfieldMask, int stackCount, int trayValue)
+    {
+        SolverStateKey key = { playfieldMask, (static_cast<uint32_t>(stackCount) << 4) | static_cast<uint32_t>(trayValue) };
+        return key;
+    }
+};
+
+/**
+ * @struct SolverStateKeyHash
+ * @brief 搜索状态哈希（splitmix64终结函数，保证低位也充分混合）
+ */
+struct SolverStateKeyHash
+{
+    uint64_t hash64(const SolverStateKey& key) const
+    {
+        uint64_t h = key.playfieldMask ^ (static_cast<uint64_t>(key.stackAndTray) * 0x9E3779B97F4A7C15ULL);
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+        return h ^ (h >> 31);
+    }
+    
+    size_t operator()(const SolverStateKey& key) const
+    {
+        return static_cast<size_t>(hash64(key));
+    }
+};
+
+/**
+ * @struct SolverSubtreeResult
+ * @brief 某个状态出发的子树求解结果
+ */
+struct SolverSubtreeResult
+{
+    int minStackDraws;                  // 最少翻牌次数，-1表示不可胜
+    unsigned long long winningLines;    // 获胜路线数量（溢出时饱和）
+    
+    static SolverSubtreeResult won()
+    {
+        SolverSubtreeResult result = { 0, 1 };
+        return result;
+    }
+    
+    static SolverSubtreeResult lost()
+    {
+        SolverSubtreeResult result = { -1, 0 };
+        return result;
+    }
+    
+    /**
+     * @brief 合并一个子状态的结果
+     * @param child 子状态结果
+     * @param stackDrawCost 到达子状态是否消耗一次翻牌（0或1）
+     */
+    void merge(const SolverSubtreeResult& child, int stackDrawCost)
+    {
+        if (child.winningLines == 0) {
+            return;
+        }
+        int draws = child.minStackDraws + stackDrawCost;
+        if (minStackDraws < 0 || draws < minStackDraws) {
+            minStackDraws = draws;
+        }
+        unsigned long long sum = winningLines + child.winningLines;
+        winningLines = sum < winningLines ? std::numeric_limits<unsigned long long>::max() : sum;
+    }
+};
+
+/**
+ * @class SolverDeal
+ * @brief 从GameModel提取的只读牌局数据
+ */
+class SolverDeal
+{
+public:
+    static const int kMinFaceValue = 1;     // 牌面数值下限（A）
+    static const int kMaxFaceValue = 13;    // 牌面数值上限（K），数值集合用第v位表示数值v
+    
+    SolverDeal()
+        : _hasCover(false)
+        , _rootKey(SolverStateKey::make(0, 0, 0))
+    {
+        for (int i = 0; i <= kMaxFaceValue + 1; i++) {
+            _valueMasks[i] = 0;
+        }
+    }
+    
+    /**
+     * @brief 从游戏模型提取牌局
+     * @param gameModel 游戏数据模型（使用其当前状态）
+     * @return 超出求解上限或数据不完整时返回false
+     */
+    bool init(const GameModel* gameModel)
+    {
+        const std::vector<int>& playfieldIds = gameModel->getPlayfieldCardIds();
+        const std::vector<int>& stackIds = gameModel->getStackCardIds();
+        if (static_cast<int>(playfieldIds.size()) > LevelSolver::kMaxPlayfieldCards
+            || static_cast<int>(stackIds.size()) > LevelSolver::kMaxStackCards) {
+            return false;
+        }
+        
+        uint64_t mask = 0;
+        for (size_t i = 0; i < playfieldIds.size(); i++) {
+            const CardModel* card = gameModel->getCardById(playfieldIds[i]);
+            if (!card) {
+                return false;
+            }
+            int value = card->getFaceValue();
+            _playfieldValues.push_back(value);
+            if (value >= kMinFaceValue && value <= kMaxFaceValue) {
+                _valueMasks[value] |= 1ULL << i;
+            }
+            mask |= 1ULL << i;
+        }
+        
+        // 遮挡关系：压住每个位置的主牌区位置集合
+        const CardCoverGraph& coverGraph = gameModel->getCoverGraph();
+        _coverMasks.assign(playfieldIds.size(), 0);
+        for (size_t i = 0; i < playfieldIds.size(); i++) {
+            const int* begin = nullptr;
+            const int* end = nullptr;
+            coverGraph.getCoveredCards(playfieldIds[i], &begin, &end);
+            for (const int* it = begin; it != end; ++it) {
+                for (size_t j = 0; j < playfieldIds.size(); j++) {
+                    if (playfieldIds[j] == *it) {
+                        _coverMasks[j] |= 1ULL << i;
+                        _hasCover = true;
+                        break;
+                    }
+                }
+            }
+        }
+        
+        // 备用牌堆从尾部弹出，前缀数值集合用于判断剩余牌堆中是否还有某个数值
+        _stackValueSets.push_back(0);
+        for (size_t i = 0; i < stackIds.size(); i++) {
+            const CardModel* card = gameModel->getCardById(stackIds[i]);
+            if (!card) {
+                return false;
+            }
+            int value = card->getFaceValue();
+            _stackValues.push_back(value);
+            _stackValueSets.push_back(_stackValueSets.back() | valueBit(value));
+        }
+        
+        const CardModel* trayCard = gameModel->getCardById(gameModel->getTrayCardId());
+        int trayValue = trayCard ? trayCard->getFaceValue() : 0;
+        _rootKey = SolverStateKey::make(mask, static_cast<int>(stackIds.size()), trayValue);
+        return true;
+    }
+    
+    const SolverStateKey& getRootKey() const { return _rootKey; }
+    int getPlayfieldCount() const { return static_cast<int>(_playfieldValues.size()); }
+    int getPlayfieldValue(int index) const { return _playfieldValues[index]; }
+    int getStackValue(int index) const { return _stackValues[index]; }
+    
+    /**
+     * @brief ±1规则：可与底牌匹配且未被压住的主牌区卡牌位掩码
+     */
+    uint64_t getMatchCandidates(const SolverStateKey& key) const
+    {
+        int trayValue = key.getTrayValue();
+        uint64_t candidates = key.playfieldMask & (valueMask(trayValue - 1) | valueMask(trayValue + 1));
+        if (!_hasCover) {
+            return candidates;
+        }
+        
+        uint64_t uncovered = 0;
+        while (candidates) {
+            int index = lowestBitIndex(candidates);
+            candidates &= candidates - 1;
+            if ((_coverMasks[index] & key.playfieldMask) == 0) {
+                uncovered |= 1ULL << index;
+            }
+        }
+        return uncovered;
+    }
+    
+    /**
+     * @brief 剪枝：主牌区某个数值在剩余卡牌（含底牌）中已没有相差1的数值，则必定无法清空
+     */
+    bool isDeadEnd(const SolverStateKey& key) const
+    {
+        unsigned int playfieldValues = 0;
+        for (int value = kMinFaceValue; value <= kMaxFaceValue; value++) {
+            if (key.playfieldMask & _valueMasks[value]) {
+                playfieldValues |= 1u << value;
+            }
+        }
+        
+        unsigned int available = playfieldValues | _stackValueSets[key.getStackCount()] | valueBit(key.getTrayValue());
+        unsigned int neighbours = (available << 1) | (available >> 1);
+        return (playfieldValues & ~neighbours) != 0;
+    }
+    
+    /**
+     * @brief 取最低位的下标
+     */
+    static int lowestBitIndex(uint64_t bits)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(bits);
+#else
+        int index = 0;
+        while ((bits & 1) == 0) {
+            bits >>= 1;
+            index++;
+        }
+        return index;
+#endif
+    }
+    
+private:
+    static unsigned int valueBit(int value)
+    {
+        return (value >= kMinFaceValue && value <= kMaxFaceValue) ? (1u << value) : 0u;
+    }
+    
+    uint64_t valueMask(int value) const
+    {
+        return (value >= kMinFaceValue && value <= kMaxFaceValue) ? _valueMasks[value] : 0;
+    }
+    
+private:
+    uint64_t _valueMasks[kMaxFaceValue + 2];    // 每个数值对应的主牌区位掩码
+    std::vector<int> _playfieldValues;          // 主牌区每个位置的数值
+    std::vector<uint64_t> _coverMasks;          // 压住每个位置的主牌区位置掩码
+    bool _hasCover;                             // 是否存在遮挡关系
+    std::vector<int> _stackValues;              // 备用牌堆数值（尾部为顶部）
+    std::vector<unsigned int> _stackValueSets;  // 备用牌堆前n张的数值集合
+    SolverStateKey _rootKey;                    // 初始状态
+};
+
+/**
+ * @class SolverSearch
+ * @brief 深度优先搜索
+ * @details Table需提供：
+ *          bool find(const SolverStateKey&, SolverSubtreeResult*)
+ *          void store(const SolverStateKey&, const SolverSubtreeResult&)
+ */
+template <typename Table>
+class SolverSearch
+{
+public:
+    SolverSearch(const SolverDeal& deal, Table& table)
+        : _deal(deal)
+        , _table(table)
+        , _nodesExpanded(0)
+    {
+    }
+    
+    SolverSubtreeResult search(const SolverStateKey& key)
+    {
+        if (key.playfieldMask == 0) {
+            return SolverSubtreeResult::won();
+        }
+        
+        SolverSubtreeResult result;
+        if (_table.find(key, &result)) {
+            return result;
+        }
+        
+        _nodesExpanded++;
+        result = SolverSubtreeResult::lost();
+        
+        if (!_deal.isDeadEnd(key)) {
+            int stackCount = key.getStackCount();
+            
+            uint64_t candidates = _deal.getMatchCandidates(key);
+            while (candidates) {
+                int index = SolverDeal::lowestBitIndex(candidates);
+                candidates &= candidates - 1;
+                SolverStateKey child = SolverStateKey::make(key.playfieldMask & ~(1ULL << index),
+                                                            stackCount, _deal.getPlayfieldValue(index));
+                result.merge(search(child), 0);
+            }
+            
+            // 翻开备用牌堆顶牌
+            if (stackCount > 0) {
+                SolverStateKey child = SolverStateKey::make(key.playfieldMask, stackCount - 1,
+                                                            _deal.getStackValue(stackCount - 1));
+                result.merge(search(child), 1);
+            }
+        }
+        
+        _table.store(key, result);
+        return result;
+    }
+    
+    unsigned long long getNodesExpanded() const { return _nodesExpanded; }
+    
+private:
+    const SolverDeal& _deal;            // 牌局数据
+    Table& _table;                      // 置换表
+    unsigned long long _nodesExpanded;  // 展开状态数
+};
+
+#endif // __LEVEL_SOLVER_SEARCH_H__
@@ -0,0 +1,157 @@
+#include "ProceduralLevelGenerator.h"
+#include "../utils/SeededRandom.h"
+#include "../utils/TraceProfiler.h"
+#include <vector>
+
+namespace {
+
+/**
+ * @brief 随机选择与face相邻的点数（A和K只有一个方向）
+ */
+int nextAdjacentFace(int face, SeededRandom* random)
+{
+    if (face <= CFT_ACE) {
+        return face + 1;
+    }
+    if (face >= CFT_KING) {
+        return face - 1;
+    }
+    return random->nextBelow(2) == 0 ? face - 1 : face + 1;
+}
+
+/**
+ * @brief 为牌面选择使用次数最少的花色（并列时随机），尽量避免出现完全相同的卡牌
+ */
+CardSuitType pickSuit(int face, int suitCounts[][CST_NUM_CARD_SUIT_TYPES], SeededRandom* random)
+{
+    int start = random->nextBelow(CST_NUM_CARD_SUIT_TYPES);
+    int bestSuit = start;
+    for (int i = 1; i < CST_NUM_CARD_SUIT_TYPES; i++) {
+        int suit = (start + i) % CST_NUM_CARD_SUIT_TYPES;
+        if (suitCounts[face][suit] < suitCounts[face][bestSuit]) {
+            bestSuit = suit;
+        }
+    }
+    suitCounts[face][bestSuit]++;
+    return static_cast<CardSuitType>(bestSuit);
+}
+
+} // namespace
+
+bool ProceduralLevelGenerator::generateLevel(const LevelLayoutTemplate& layout, uint64_t seed, float difficulty,
+                                             LevelConfig* outConfig)
+{
+    TRACE_ZONE("ProceduralLevelGenerator::generateLevel");
+    
+    if (!outConfig) {
+        return false;
+    }
+    outConfig->clear();
+    int stackCount = layout.getStackCount();
+    if (stackCount < 1) {
+        return false;
+    }
+    
+    SeededRandom random(seed);
+    int playfieldCount = layout.getPlayfieldCount();
+    int drawCount = getRequiredStackDraws(stackCount, difficulty);
+    
+    // 倒推时可放回的卡牌：它压住的卡牌都已放回
+    std::vector<int> pendingCounts(playfieldCount);
+    std::vector<int> readyIndices;
+    readyIndices.reserve(playfieldCount);
+    for (int i = 0; i < playfieldCount; i++) {
+        const int* begin = nullptr;
+        const int* end = nullptr;
+        layout.getCoveredCards(i, &begin, &end);
+        pendingCounts[i] = static_cast<int>(end - begin);
+        if (pendingCounts[i] == 0) {
+            readyIndices.push_back(i);
+        }
+    }
+    
+    // 从获胜状态倒推，最后一步（倒推的第一步）一定是主牌区的卡牌
+    std::vector<int> playfieldFaces(playfieldCount, CFT_NONE);
+    std::vector<int> drawnFaces;
+    drawnFaces.reserve(drawCount);
+    int trayFace = random.nextBelow(CFT_NUM_CARD_FACE_TYPES);
+    int remainingPlayfield = playfieldCount;
+    int remainingDraws = drawCount;
+    while (remainingPlayfield > 0 || remainingDraws > 0) {
+        // 翻牌均匀地插入主牌区的操作之间
+        bool draw = remainingDraws > 0
+                    && (remainingPlayfield == 0 || (remainingPlayfield < playfieldCount
+                        && random.nextBelow(remainingPlayfield + remainingDraws) < remainingDraws));
+        if (draw) {
+            drawnFaces.push_back(trayFace);
+            trayFace = random.nextBelow(CFT_NUM_CARD_FACE_TYPES);
+            remainingDraws--;
+            continue;
+        }
+        
+        int slot = random.nextBelow(static_cast<int>(readyIndices.size()));
+        int index = readyIndices[slot];
+        readyIndices[slot] = readyIndices.back();
+        readyIndices.pop_back();
+        playfieldFaces[index] = trayFace;
+        trayFace = nextAdjacentFace(trayFace, &random);
+        remainingPlayfield--;
+        
+        const int* begin = nullptr;
+        const int* end = nullptr;
+        layout.getCoveringCards(index, &begin, &end);
+        for (const int* it = begin; it != end; it++) {
+            if (--pendingCounts[*it] == 0) {
+                readyIndices.push_back(*it);
+            }
+        }
+    }
+    
+    // 备用牌堆从末尾翻牌：底部是路线中用不到的备用牌，之后是倒推出的翻牌（最后翻的在下），
+    // 末尾是开局翻到底牌堆的牌
+    int suitCounts[CFT_NUM_CARD_FACE_TYPES][CST_NUM_CARD_SUIT_TYPES] = {};
+    const std::vector<CardPosition>& positions = layout.getPlayfieldPositions();
+    for (int i = 0; i < playfieldCount; i++) {
+        CardFaceType face = static_cast<CardFaceType>(playfieldFaces[i]);
+        outConfig->addPlayfieldCard(CardConfig(face, pickSuit(face, suitCounts, &random), positions[i]));
+    }
+    int spareCount = stackCount - 1 - drawCount;
+    for (int i = 0; i < spareCount; i++) {
+        CardFaceType face = static_cast<CardFaceType>(random.nextBelow(CFT_NUM_CARD_FACE_TYPES));
+        outConfig->addStackCard(CardConfig(face, pickSuit(face, suitCounts, &random), CardPosition()));
+    }
+    for (int drawnFace : drawnFaces) {
+        CardFaceType face = static_cast<CardFaceType>(drawnFace);
+        outConfig->addStackCard(CardConfig(face, pickSuit(face, suitCounts, &random), CardPosition()));
+    }
+    CardFaceType trayCardFace = static_cast<CardFaceType>(trayFace);
+    outConfig->addStackCard(CardConfig(trayCardFace, pickSuit(trayCardFace, suitCounts, &random), CardPosition()));
+    return true;
+}
+
+LevelConfig* ProceduralLevelGenerator::generateLevelConfig(const LevelLayoutTemplate& layout, uint64_t seed,
+                                                           float difficulty)
+{
+    LevelConfig* levelConfig = new LevelConfig();
+    if (!generateLevel(layout, seed, difficulty, levelConfig)) {
+        delete levelConfig;
+        return nullptr;
+    }
+    return levelConfig;
+}
+
+int ProceduralLevelGenerator::getRequiredStackDraws(int stackCount, float difficulty)
+{
+    if (stackCount <= 1) {
+        return 0;
+    }
+    if (!(difficulty > 0.0f)) {
+        difficulty = 0.0f;
+    } else if (difficulty > 1.0f) {
+        difficulty = 1.0f;
+    }
+    
+    // 难度为1时所有备用牌都在路线上，难度为0时路线不需要翻牌
+    int drawCount = static_cast<int>(difficulty * (stackCount - 1) + 0.5f);
+    return drawCount < stackCount - 1 ? drawCount : stackCount - 1;
+}
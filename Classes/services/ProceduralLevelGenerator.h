@@ -0,0 +1,50 @@
+#ifndef __PROCEDURAL_LEVEL_GENERATOR_H__
+#define __PROCEDURAL_LEVEL_GENERATOR_H__
+
+#include "../configs/models/LevelConfig.h"
+#include "../configs/models/LevelLayoutTemplate.h"
+#include <cstdint>
+
+/**
+ * @class ProceduralLevelGenerator
+ * @brief 按种子生成关卡的服务
+ * @details 无状态服务，在布局模板上填入牌面生成LevelConfig
+ *          从已获胜的状态倒推：主牌区为空、底牌为随机牌面，每一步要么把一张卡牌放回主牌区
+ *          （它压住的卡牌都已放回，牌面取当前底牌，底牌变为相邻点数），要么把底牌放回备用牌堆
+ *          （底牌变为随机牌面）；正向看就是一条合法的获胜路线，因此生成的关卡必定可胜
+ *          难度决定路线中需要从备用牌堆翻牌的次数：难度越高，多余的备用牌越少，
+ *          玩家走错一步后可用来补救的翻牌越少
+ *          只使用SeededRandom，同一模板、种子和难度在任何平台上生成相同的关卡，可只发布种子
+ */
+class ProceduralLevelGenerator
+{
+public:
+    /**
+     * @brief 生成关卡配置
+     * @param layout 布局模板（备用牌堆卡牌数量至少为1）
+     * @param seed 种子
+     * @param difficulty 难度（0~1，超出范围时截断）
+     * @param outConfig 输出关卡配置（原有卡牌被清空，关卡ID不变）
+     * @return 模板无效时返回false
+     */
+    static bool generateLevel(const LevelLayoutTemplate& layout, uint64_t seed, float difficulty, LevelConfig* outConfig);
+    
+    /**
+     * @brief 生成关卡配置
+     * @param layout 布局模板
+     * @param seed 种子
+     * @param difficulty 难度（0~1）
+     * @return 生成的关卡配置，调用方负责释放内存；模板无效时返回nullptr
+     */
+    static LevelConfig* generateLevelConfig(const LevelLayoutTemplate& layout, uint64_t seed, float difficulty);
+    
+    /**
+     * @brief 计算路线中需要从备用牌堆翻牌的次数（不包括开局翻出的底牌）
+     * @param stackCount 备用牌堆卡牌数量
+     * @param difficulty 难度（0~1）
+     * @return 0到stackCount-1之间的翻牌次数，其余备用牌在路线中用不到
+     */
+    static int getRequiredStackDraws(int stackCount, float difficulty);
+};
+
+#endif // __PROCEDURAL_LEVEL_GENERATOR_H__
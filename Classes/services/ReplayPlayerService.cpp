@@ -0,0 +1,173 @@
+#include "ReplayPlayerService.h"
+#include "GameRulesService.h"
+#include "GameSnapshotService.h"
+#include "../managers/UndoManager.h"
+#include "../utils/Crc32.h"
+#include <cstring>
+
+const char ReplayPlayerService::kMagic[4] = { 'G', 'R', 'P', 'L' };
+
+static_assert(sizeof(ReplayFileHeader) == 36, "ReplayFileHeader layout");
+
+namespace {
+
+/**
+ * @brief 把一个32位值混入哈希（FNV-1a，按整数而非字节）
+ */
+uint64_t mixHash(uint64_t hash, uint32_t value)
+{
+    return (hash ^ value) * 0x100000001B3ULL;
+}
+
+/**
+ * @brief 读取一个varint并前移读取位置
+ * @return 数据不完整或超过32位时返回false
+ */
+bool readVarint(const uint8_t** cursor, const uint8_t* end, uint32_t* outValue)
+{
+    uint32_t value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (*cursor >= end) {
+            return false;
+        }
+        uint8_t byte = *(*cursor)++;
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *outValue = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+ReplayResult ReplayPlayerService::playReplay(const void* data, size_t size, GameModel* gameModel, UndoModel* undoModel)
+{
+    ReplayResult result;
+    if (!data || !gameModel || !undoModel || size < sizeof(ReplayFileHeader)) {
+        return result;
+    }
+    
+    // 校验文件头、各段长度和CRC
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    ReplayFileHeader header;
+    memcpy(&header, bytes, sizeof(header));
+    uint64_t dataSize = static_cast<uint64_t>(header.snapshotSize) + header.streamSize;
+    if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion
+        || header.snapshotSize % sizeof(uint32_t) != 0 || dataSize > size - sizeof(ReplayFileHeader)
+        || Crc32::compute(bytes + sizeof(ReplayFileHeader), static_cast<size_t>(dataSize)) != header.dataCrc) {
+        return result;
+    }
+    // 快照中已包括开始录制时的可重做记录
+    const uint8_t* snapshot = bytes + sizeof(ReplayFileHeader);
+    if (!GameSnapshotService::readSnapshot(snapshot, header.snapshotSize, gameModel, undoModel)) {
+        return result;
+    }
+    UndoManager undoManager;
+    undoManager.init(undoModel);
+    CardPosition trayPosition(header.trayX, header.trayY);
+    result.loaded = true;
+    result.levelId = header.levelId;
+    
+    // 按顺序执行输入，遇到检查点时比较状态哈希
+    const uint8_t* cursor = snapshot + header.snapshotSize;
+    const uint8_t* end = cursor + header.streamSize;
+    uint32_t timeMs = 0;
+    while (cursor < end) {
+        uint8_t tag = *cursor++;
+        if (tag == kReplayCheckpointTag) {
+            uint64_t expectedHash = 0;
+            if (end - cursor < static_cast<ptrdiff_t>(sizeof(expectedHash))) {
+                return result;
+            }
+            memcpy(&expectedHash, cursor, sizeof(expectedHash));
+            cursor += sizeof(expectedHash);
+            if (computeStateHash(gameModel, undoModel) != expectedHash) {
+                result.mismatchInputIndex = result.inputCount;
+                result.finalHash = computeStateHash(gameModel, undoModel);
+                return result;
+            }
+            result.checkpointCount++;
+            continue;
+        }
+        
+        uint32_t delta = 0;
+        uint32_t cardValue = 0;
+        if (tag > RIT_REDO_CLICK || !readVarint(&cursor, end, &delta)
+            || (tag == RIT_CARD_CLICK && !readVarint(&cursor, end, &cardValue))) {
+            return result;
+        }
+        timeMs += delta;
+        int cardId = static_cast<int>(cardValue) - 1;
+        if (applyInput(gameModel, &undoManager, static_cast<ReplayInputType>(tag), cardId, trayPosition)) {
+            result.acceptedCount++;
+        }
+        result.inputCount++;
+        result.durationMs = timeMs;
+    }
+    
+    result.matched = true;
+    result.won = gameModel->isGameWon();
+    result.finalHash = computeStateHash(gameModel, undoModel);
+    return result;
+}
+
+bool ReplayPlayerService::applyInput(GameModel* gameModel, UndoManager* undoManager, ReplayInputType type, int cardId,
+                                     const CardPosition& trayPosition)
+{
+    UndoAction action;
+    switch (type) {
+        case RIT_CARD_CLICK: {
+            // 只有主牌区未被压住且能与底牌匹配的卡牌响应点击
+            const CardModel* card = gameModel->getCardById(cardId);
+            if (!card || card->getLocation() != CL_PLAYFIELD || !GameRulesService::canMatchWithTray(gameModel, cardId)
+                || !GameRulesService::replaceTrayFromPlayfield(gameModel, cardId, trayPosition, &action)) {
+                return false;
+            }
+            undoManager->recordAction(action);
+            return true;
+        }
+        
+        case RIT_STACK_CLICK:
+            if (!GameRulesService::replaceTrayFromStack(gameModel, trayPosition, &action)) {
+                return false;
+            }
+            undoManager->recordAction(action);
+            return true;
+        
+        case RIT_UNDO_CLICK:
+            return undoManager->canUndo() && undoManager->performUndo(gameModel);
+        
+        case RIT_REDO_CLICK:
+            return undoManager->canRedo() && undoManager->performRedo(gameModel, trayPosition, &action);
+        
+        default:
+            return false;
+    }
+}
+
+uint64_t ReplayPlayerService::computeStateHash(const GameModel* gameModel, const UndoModel* undoModel)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    const std::vector<int>& playfieldIds = gameModel->getPlayfieldCardIds();
+    hash = mixHash(hash, static_cast<uint32_t>(playfieldIds.size()));
+    for (int cardId : playfieldIds) {
+        hash = mixHash(hash, static_cast<uint32_t>(cardId));
+    }
+    const std::vector<int>& stackIds = gameModel->getStackCardIds();
+    hash = mixHash(hash, static_cast<uint32_t>(stackIds.size()));
+    for (int cardId : stackIds) {
+        hash = mixHash(hash, static_cast<uint32_t>(cardId));
+    }
+    hash = mixHash(hash, static_cast<uint32_t>(gameModel->getTrayCardId()));
+    if (undoModel) {
+        hash = mixHash(hash, static_cast<uint32_t>(undoModel->getActionCount()));
+        hash = mixHash(hash, static_cast<uint32_t>(undoModel->getRedoCount()));
+    }
+    
+    // splitmix64终结函数，使低位也充分混合
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+    return hash ^ (hash >> 31);
+}
@@ -0,0 +1,135 @@
+#ifndef __REPLAY_PLAYER_SERVICE_H__
+#define __REPLAY_PLAYER_SERVICE_H__
+
+#include "../models/GameModel.h"
+#include "../models/UndoModel.h"
+#include "../utils/CardPosition.h"
+#include <cstddef>
+#include <cstdint>
+
+class UndoManager;
+
+/**
+ * @file ReplayPlayerService.h
+ * @brief 回放文件格式
+ * @details 所有字段为小端：
+ *          [ReplayFileHeader][开始录制时的快照（GameSnapshotService格式，包括可重做记录，snapshotSize字节）]
+ *          [输入流（streamSize字节）]
+ *          输入流由变长记录组成，每条记录以一个字节的类型开始：
+ *          - 输入（ReplayInputType）：距上一条输入的毫秒数（varint），点击卡牌时再跟卡牌ID+1（varint）
+ *          - 检查点（kReplayCheckpointTag）：8字节状态哈希，为执行下一条输入之前（或文件末尾）的状态
+ */
+
+/**
+ * @enum ReplayInputType
+ * @brief 回放输入类型（与GameController的输入入口一一对应）
+ */
+enum ReplayInputType
+{
+    RIT_CARD_CLICK,     // 点击卡牌（handleCardClick）
+    RIT_STACK_CLICK,    // 点击备用牌堆（handleStackClick）
+    RIT_UNDO_CLICK,     // 点击撤销按钮（handleUndoClick）
+    RIT_REDO_CLICK      // 点击重做按钮（handleRedoClick）
+};
+
+/**
+ * @brief 输入流中检查点记录的类型字节
+ */
+static const uint8_t kReplayCheckpointTag = 0xFF;
+
+/**
+ * @struct ReplayFileHeader
+ * @brief 回放文件头（36字节）
+ */
+struct ReplayFileHeader
+{
+    char magic[4];          // 文件标识"GRPL"
+    uint32_t version;       // 格式版本
+    int32_t levelId;        // 关卡ID
+    float trayX;            // 录制时的底牌堆位置
+    float trayY;
+    uint32_t snapshotSize;  // 快照字节数（4的倍数）
+    uint32_t streamSize;    // 输入流字节数
+    uint32_t inputCount;    // 输入数量
+    uint32_t dataCrc;       // 快照和输入流的CRC32
+};
+
+/**
+ * @struct ReplayResult
+ * @brief 回放结果
+ */
+struct ReplayResult
+{
+    bool loaded;                // 文件头、快照和CRC是否有效
+    bool matched;               // 所有检查点是否一致（不一致时在第一个不一致的检查点停止）
+    int levelId;                // 关卡ID
+    int inputCount;             // 已执行的输入数量
+    int acceptedCount;          // 被规则接受（改变了状态）的输入数量
+    int checkpointCount;        // 校验通过的检查点数量
+    int mismatchInputIndex;     // 不一致的检查点之后的输入序号（一致时为-1）
+    uint32_t durationMs;        // 最后一条已执行输入距开始录制的毫秒数
+    bool won;                   // 回放结束时是否胜利
+    uint64_t finalHash;         // 回放结束时的状态哈希
+    
+    ReplayResult()
+        : loaded(false)
+        , matched(false)
+        , levelId(0)
+        , inputCount(0)
+        , acceptedCount(0)
+        , checkpointCount(0)
+        , mismatchInputIndex(-1)
+        , durationMs(0)
+        , won(false)
+        , finalHash(0)
+    {
+    }
+};
+
+/**
+ * @class ReplayPlayerService
+ * @brief 无头回放服务
+ * @details 无状态服务，把回放文件中的输入按原顺序在模型层重新执行，不创建视图、不播放动画，
+ *          在每个检查点比较状态哈希；用于用线上回放回归测试规则修改、精确重现玩家反馈的问题
+ *          输入的处理与GameController的输入入口一致（不合法的输入同样被忽略）
+ *          读取快照时复用传入模型的内存，连续回放大量文件时不重复分配
+ */
+class ReplayPlayerService
+{
+public:
+    /**
+     * @brief 文件标识与当前格式版本
+     */
+    static const char kMagic[4];
+    static const uint32_t kVersion = 2;
+    
+    /**
+     * @brief 回放
+     * @param data 回放文件内容（4字节对齐）
+     * @param size 字节数
+     * @param gameModel 工作用的游戏数据模型（原有内容被替换，回放后为结束时的状态）
+     * @param undoModel 工作用的撤销数据模型（原有内容被替换）
+     * @return 回放结果
+     */
+    static ReplayResult playReplay(const void* data, size_t size, GameModel* gameModel, UndoModel* undoModel);
+    
+    /**
+     * @brief 执行一条输入（与GameController对应的输入入口相同的规则）
+     * @param gameModel 游戏数据模型
+     * @param undoManager 撤销管理器
+     * @param type 输入类型
+     * @param cardId 点击的卡牌ID（其他输入忽略）
+     * @param trayPosition 底牌堆位置
+     * @return 输入被接受并改变了状态时返回true
+     */
+    static bool applyInput(GameModel* gameModel, UndoManager* undoManager, ReplayInputType type, int cardId,
+                           const CardPosition& trayPosition);
+    
+    /**
+     * @brief 计算状态哈希
+     * @details 包括主牌区（按顺序）、备用牌堆、底牌和撤销/重做记录数量，不包括坐标等视图相关数据
+     */
+    static uint64_t computeStateHash(const GameModel* gameModel, const UndoModel* undoModel);
+};
+
+#endif // __REPLAY_PLAYER_SERVICE_H__
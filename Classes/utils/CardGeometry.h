@@ -0,0 +1,58 @@
+#ifndef __CARD_GEOMETRY_H__
+#define __CARD_GEOMETRY_H__
+
+#include "CardPosition.h"
+
+/**
+ * @file CardGeometry.h
+ * @brief 卡牌尺寸与矩形
+ * @details 卡牌视图（CardView）和遮挡计算（CardCoverGraph）共用同一套尺寸，
+ *          卡牌坐标为卡牌中心点（与Sprite默认锚点一致）
+ */
+
+static const float kCardWidth = 120.0f;     // 卡牌宽度
+static const float kCardHeight = 168.0f;    // 卡牌高度
+
+/**
+ * @struct CardRect
+ * @brief 轴对齐矩形（设计分辨率坐标）
+ */
+struct CardRect
+{
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+    
+    /**
+     * @brief 两个矩形是否有重叠面积（只接触边缘不算重叠）
+     */
+    bool intersects(const CardRect& other) const
+    {
+        return minX < other.maxX && other.minX < maxX && minY < other.maxY && other.minY < maxY;
+    }
+    
+    /**
+     * @brief 点是否在矩形内（含边缘）
+     */
+    bool contains(const CardPosition& point) const
+    {
+        return point.x >= minX && point.x <= maxX && point.y >= minY && point.y <= maxY;
+    }
+};
+
+/**
+ * @brief 以卡牌中心坐标构造卡牌矩形
+ */
+inline CardRect makeCardRect(const CardPosition& center)
+{
+    CardRect rect = {
+        center.x - kCardWidth * 0.5f,
+        center.y - kCardHeight * 0.5f,
+        center.x + kCardWidth * 0.5f,
+        center.y + kCardHeight * 0.5f
+    };
+    return rect;
+}
+
+#endif // __CARD_GEOMETRY_H__
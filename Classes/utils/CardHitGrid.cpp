@@ -0,0 +1,185 @@
+#include "CardHitGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/**
+ * @brief 矩形与格子范围的交集
+ */
+CardRect clipToCell(const CardRect& rect, const CardRect& cellRect)
+{
+    CardRect clipped = {
+        std::max(rect.minX, cellRect.minX),
+        std::max(rect.minY, cellRect.minY),
+        std::min(rect.maxX, cellRect.maxX),
+        std::min(rect.maxY, cellRect.maxY)
+    };
+    return clipped;
+}
+
+/**
+ * @brief outer是否完全包含inner（含边缘）
+ */
+bool containsRect(const CardRect& outer, const CardRect& inner)
+{
+    return inner.minX >= outer.minX && inner.maxX <= outer.maxX && inner.minY >= outer.minY && inner.maxY <= outer.maxY;
+}
+
+} // namespace
+
+void CardHitGrid::clear()
+{
+    _cells.clear();
+    _cards.clear();
+}
+
+void CardHitGrid::setCard(int cardId, const CardPosition& center, int drawOrder, bool clickable)
+{
+    if (cardId < 0) {
+        return;
+    }
+    
+    removeCard(cardId);
+    CardEntry entry = { cardId, drawOrder, clickable, makeCardRect(center) };
+    _cards[cardId] = entry;
+    insertToCells(entry);
+}
+
+void CardHitGrid::moveCard(int cardId, const CardPosition& center)
+{
+    auto it = _cards.find(cardId);
+    if (it == _cards.end()) {
+        return;
+    }
+    
+    removeFromCells(it->second);
+    it->second.rect = makeCardRect(center);
+    insertToCells(it->second);
+}
+
+void CardHitGrid::setClickable(int cardId, bool clickable)
+{
+    auto it = _cards.find(cardId);
+    if (it == _cards.end() || it->second.clickable == clickable) {
+        return;
+    }
+    
+    it->second.clickable = clickable;
+    const CardRect& rect = it->second.rect;
+    int maxX = cellX(rect.maxX);
+    int maxY = cellY(rect.maxY);
+    for (int x = cellX(rect.minX); x <= maxX; x++) {
+        for (int y = cellY(rect.minY); y <= maxY; y++) {
+            auto cellIt = _cells.find(cellKey(x, y));
+            if (cellIt == _cells.end()) {
+                continue;
+            }
+            for (CardEntry& entry : cellIt->second.entries) {
+                if (entry.cardId == cardId) {
+                    entry.clickable = clickable;
+                }
+            }
+            for (CardEntry& entry : cellIt->second.visible) {
+                if (entry.cardId == cardId) {
+                    entry.clickable = clickable;
+                }
+            }
+        }
+    }
+}
+
+void CardHitGrid::removeCard(int cardId)
+{
+    auto it = _cards.find(cardId);
+    if (it != _cards.end()) {
+        removeFromCells(it->second);
+        _cards.erase(it);
+    }
+}
+
+int CardHitGrid::findTopmostClickable(const CardPosition& point) const
+{
+    auto cellIt = _cells.find(cellKey(cellX(point.x), cellY(point.y)));
+    if (cellIt == _cells.end()) {
+        return -1;
+    }
+    // 第一张包含该点的卡牌就是触摸点处可见的卡牌，它下面的卡牌都被盖住，不可点击时直接返回
+    for (const CardEntry& entry : cellIt->second.visible) {
+        if (entry.rect.contains(point)) {
+            return entry.clickable ? entry.cardId : -1;
+        }
+    }
+    return -1;
+}
+
+void CardHitGrid::insertToCells(const CardEntry& entry)
+{
+    int maxX = cellX(entry.rect.maxX);
+    int maxY = cellY(entry.rect.maxY);
+    for (int x = cellX(entry.rect.minX); x <= maxX; x++) {
+        for (int y = cellY(entry.rect.minY); y <= maxY; y++) {
+            HitCell& cell = _cells[cellKey(x, y)];
+            auto position = std::upper_bound(cell.entries.begin(), cell.entries.end(), entry,
+                                             [](const CardEntry& a, const CardEntry& b) {
+                                                 return a.drawOrder > b.drawOrder;
+                                             });
+            cell.entries.insert(position, entry);
+            rebuildVisible(x, y, &cell);
+        }
+    }
+}
+
+void CardHitGrid::removeFromCells(const CardEntry& entry)
+{
+    int cardId = entry.cardId;
+    int maxX = cellX(entry.rect.maxX);
+    int maxY = cellY(entry.rect.maxY);
+    for (int x = cellX(entry.rect.minX); x <= maxX; x++) {
+        for (int y = cellY(entry.rect.minY); y <= maxY; y++) {
+            auto cellIt = _cells.find(cellKey(x, y));
+            if (cellIt == _cells.end()) {
+                continue;
+            }
+            std::vector<CardEntry>& entries = cellIt->second.entries;
+            entries.erase(std::remove_if(entries.begin(), entries.end(), [cardId](const CardEntry& other) {
+                return other.cardId == cardId;
+            }), entries.end());
+            if (entries.empty()) {
+                _cells.erase(cellIt);
+            } else {
+                rebuildVisible(x, y, &cellIt->second);
+            }
+        }
+    }
+}
+
+void CardHitGrid::rebuildVisible(int x, int y, HitCell* cell)
+{
+    // 被上面某一张卡牌盖住时，一定也被盖住那张卡牌的可见卡牌盖住（包含关系可传递），只需和可见卡牌比较
+    CardRect cellRect = { x * kCardWidth, y * kCardHeight, (x + 1) * kCardWidth, (y + 1) * kCardHeight };
+    cell->visible.clear();
+    for (const CardEntry& entry : cell->entries) {
+        CardRect clipped = clipToCell(entry.rect, cellRect);
+        bool covered = false;
+        for (const CardEntry& upper : cell->visible) {
+            if (containsRect(clipToCell(upper.rect, cellRect), clipped)) {
+                covered = true;
+                break;
+            }
+        }
+        if (!covered) {
+            cell->visible.push_back(entry);
+        }
+    }
+}
+
+int CardHitGrid::cellX(float x)
+{
+    return static_cast<int>(std::floor(x / kCardWidth));
+}
+
+int CardHitGrid::cellY(float y)
+{
+    return static_cast<int>(std::floor(y / kCardHeight));
+}
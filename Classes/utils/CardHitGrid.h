@@ -0,0 +1,126 @@
+#ifndef __CARD_HIT_GRID_H__
+#define __CARD_HIT_GRID_H__
+
+#include "CardGeometry.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class CardHitGrid
+ * @brief 卡牌点击检测索引
+ * @details 与SpatialGrid相同的均匀网格（格子边长为卡牌尺寸），每个格子中的卡牌按绘制顺序从上到下排列，
+ *          并带有矩形和可点击状态；触摸点只检查所在的一个格子，从最上面的卡牌开始，遇到第一张包含该点的
+ *          卡牌即返回（它可点击时返回它，否则返回-1，下面的卡牌都被它盖住）
+ *          每个格子另外保存一份可见卡牌列表：在格子范围内被上面某一张卡牌完全盖住的卡牌不会被点到，
+ *          不放入列表（叠在同一位置的备用牌堆、底牌堆在每个格子中只剩最上面一张）
+ *          查找是对可见列表的线性扫描，最坏情况（该点落在空隙里）扫描整个可见列表，
+ *          耗时取决于格子内互不包含的卡牌数量，与牌桌上的卡牌总数无关，但不是对数复杂度；
+ *          登记、移动和移除卡牌时重建它覆盖的格子的可见列表，每个格子O(格子内卡牌数 x 可见卡牌数)
+ *          GameView用它代替每张卡牌一个触摸监听器，CoreBench用它测量点击检测的耗时
+ */
+class CardHitGrid
+{
+public:
+    /**
+     * @brief 清空所有卡牌
+     */
+    void clear();
+    
+    /**
+     * @brief 登记或更新卡牌
+     * @param cardId 卡牌ID（非负）
+     * @param center 卡牌中心坐标
+     * @param drawOrder 绘制顺序（越大越靠上）
+     * @param clickable 是否可点击
+     */
+    void setCard(int cardId, const CardPosition& center, int drawOrder, bool clickable);
+    
+    /**
+     * @brief 移动卡牌（保持绘制顺序和可点击状态，未登记时忽略）
+     * @param cardId 卡牌ID
+     * @param center 新的卡牌中心坐标
+     */
+    void moveCard(int cardId, const CardPosition& center);
+    
+    /**
+     * @brief 设置卡牌是否可点击（未登记时忽略）
+     */
+    void setClickable(int cardId, bool clickable);
+    
+    /**
+     * @brief 移除卡牌
+     */
+    void removeCard(int cardId);
+    
+    /**
+     * @brief 查找包含该点、绘制在最上面的可点击卡牌
+     * @details 只看触摸点处最上面的卡牌：它不可点击时返回-1，不再向下查找被它盖住的卡牌
+     * @param point 触摸点
+     * @return 卡牌ID，没有时返回-1
+     */
+    int findTopmostClickable(const CardPosition& point) const;
+    
+    /**
+     * @brief 获取已登记的卡牌数量
+     */
+    int size() const { return static_cast<int>(_cards.size()); }
+    
+private:
+    /**
+     * @struct CardEntry
+     * @brief 登记的卡牌（格子中保存副本，查询时不需要再按ID查找）
+     */
+    struct CardEntry
+    {
+        int cardId;         // 卡牌ID
+        int drawOrder;      // 绘制顺序
+        bool clickable;     // 是否可点击
+        CardRect rect;      // 卡牌矩形
+    };
+    
+    /**
+     * @struct HitCell
+     * @brief 格子内的卡牌（都按绘制顺序从上到下）
+     */
+    struct HitCell
+    {
+        std::vector<CardEntry> entries;     // 与格子重叠的全部卡牌
+        std::vector<CardEntry> visible;     // 没有在格子范围内被上面某一张卡牌完全盖住的卡牌（查找只扫描这些）
+    };
+    
+    /**
+     * @brief 把卡牌插入它覆盖的所有格子（保持每个格子按绘制顺序从上到下）
+     */
+    void insertToCells(const CardEntry& entry);
+    
+    /**
+     * @brief 从卡牌覆盖的所有格子中移除
+     */
+    void removeFromCells(const CardEntry& entry);
+    
+    /**
+     * @brief 重建格子的可见卡牌列表
+     */
+    static void rebuildVisible(int x, int y, HitCell* cell);
+    
+    /**
+     * @brief 坐标所在的格子行列号
+     */
+    static int cellX(float x);
+    static int cellY(float y);
+    
+    /**
+     * @brief 格子行列号打包成键
+     */
+    static int64_t cellKey(int x, int y)
+    {
+        return static_cast<int64_t>((static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y));
+    }
+    
+private:
+    std::unordered_map<int64_t, HitCell> _cells;                    // 格子键 -> 格子内的卡牌
+    std::unordered_map<int, CardEntry> _cards;                      // 卡牌ID -> 卡牌
+};
+
+#endif // __CARD_HIT_GRID_H__
@@ -0,0 +1,43 @@
+#ifndef __CARD_POSITION_H__
+#define __CARD_POSITION_H__
+
+/**
+ * @file CardPosition.h
+ * @brief 与引擎无关的二维坐标
+ * @details 规则核心库不依赖Cocos2d-x，模型层统一使用该结构存储位置，
+ *          视图层通过CardPositionConvert.h与cocos2d::Vec2互相转换
+ */
+
+/**
+ * @struct CardPosition
+ * @brief 卡牌坐标（设计分辨率下的屏幕坐标）
+ */
+struct CardPosition
+{
+    float x;    // X坐标
+    float y;    // Y坐标
+    
+    CardPosition()
+        : x(0.0f)
+        , y(0.0f)
+    {
+    }
+    
+    CardPosition(float px, float py)
+        : x(px)
+        , y(py)
+    {
+    }
+    
+    bool operator==(const CardPosition& other) const
+    {
+        return x == other.x && y == other.y;
+    }
+    
+    bool operator!=(const CardPosition& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+#endif // __CARD_POSITION_H__
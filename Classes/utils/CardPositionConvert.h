@@ -0,0 +1,33 @@
+#ifndef __CARD_POSITION_CONVERT_H__
+#define __CARD_POSITION_CONVERT_H__
+
+#include "cocos2d.h"
+#include "CardPosition.h"
+
+/**
+ * @file CardPositionConvert.h
+ * @brief CardPosition与cocos2d::Vec2之间的转换
+ * @details 仅供客户端（视图层、控制器层）使用，规则核心库不包含该文件
+ */
+
+/**
+ * @brief 模型坐标转换为引擎坐标
+ * @param position 模型坐标
+ * @return 引擎坐标
+ */
+inline cocos2d::Vec2 toVec2(const CardPosition& position)
+{
+    return cocos2d::Vec2(position.x, position.y);
+}
+
+/**
+ * @brief 引擎坐标转换为模型坐标
+ * @param vec 引擎坐标
+ * @return 模型坐标
+ */
+inline CardPosition toCardPosition(const cocos2d::Vec2& vec)
+{
+    return CardPosition(vec.x, vec.y);
+}
+
+#endif // __CARD_POSITION_CONVERT_H__
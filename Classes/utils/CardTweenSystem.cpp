@@ -0,0 +1,215 @@
+#include "CardTweenSystem.h"
+#include "TraceProfiler.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief 补间进度（0~1，时长<=0时直接完成）
+ */
+float getProgress(float elapsed, float duration)
+{
+    if (duration <= 0.0f) {
+        return 1.0f;
+    }
+    return std::min(1.0f, std::max(0.0f, elapsed / duration));
+}
+
+uint64_t getTraceTime()
+{
+#if POKER_TRACE
+    return TraceProfiler::now();
+#else
+    return 0;
+#endif
+}
+
+void recordTweenZone(const char* name, uint64_t startNs)
+{
+#if POKER_TRACE
+    TraceProfiler::recordAsyncZone(name, startNs, TraceProfiler::now());
+#else
+    (void)name;
+    (void)startNs;
+#endif
+}
+
+} // namespace
+
+void CardTweenSystem::reserve(int tweenCount, int maxCardId)
+{
+    _tweens.reserve(tweenCount);
+    _callbacks.reserve(tweenCount);
+    if (maxCardId >= static_cast<int>(_indexByCardId.size())) {
+        _indexByCardId.resize(maxCardId + 1, -1);
+    }
+}
+
+void CardTweenSystem::moveTo(int cardId, const CardPosition& from, const CardPosition& to, float duration,
+                             const CompleteCallback& callback)
+{
+    if (cardId < 0) {
+        return;
+    }
+    
+    CardTween& tween = acquireTween(cardId);
+    tween.moveState = CTS_RUNNING;
+    tween.moveFrom = from;
+    tween.moveTarget = to;
+    tween.position = from;
+    tween.moveElapsed = 0.0f;
+    tween.moveDuration = duration;
+    tween.moveStartNs = getTraceTime();
+    _callbacks[_indexByCardId[cardId]] = callback;
+}
+
+void CardTweenSystem::flip(int cardId, bool showFront, float duration)
+{
+    if (cardId < 0) {
+        return;
+    }
+    
+    // 从当前缩放开始收缩：前半段缩放为1-2t，由当前缩放反推进度，动画不跳变
+    CardTween& tween = acquireTween(cardId);
+    float scaleX = tween.flipState == CTS_RUNNING ? tween.scaleX : 1.0f;
+    tween.flipState = CTS_RUNNING;
+    tween.showFront = showFront;
+    tween.faceSwitched = false;
+    tween.scaleX = scaleX;
+    tween.flipElapsed = (1.0f - scaleX) * 0.5f * std::max(duration, 0.0f);
+    tween.flipDuration = duration;
+    tween.flipStartNs = getTraceTime();
+}
+
+void CardTweenSystem::cancel(int cardId)
+{
+    int index = findIndex(cardId);
+    if (index >= 0) {
+        removeAt(index);
+    }
+}
+
+void CardTweenSystem::clear()
+{
+    for (const CardTween& tween : _tweens) {
+        _indexByCardId[tween.cardId] = -1;
+    }
+    _tweens.clear();
+    _callbacks.clear();
+}
+
+const CardTween* CardTweenSystem::findTween(int cardId) const
+{
+    int index = findIndex(cardId);
+    return index >= 0 ? &_tweens[index] : nullptr;
+}
+
+void CardTweenSystem::update(float dt)
+{
+    for (CardTween& tween : _tweens) {
+        tween.faceSwitchedThisFrame = false;
+        
+        if (tween.moveState == CTS_RUNNING) {
+            tween.moveElapsed += dt;
+            float t = getProgress(tween.moveElapsed, tween.moveDuration);
+            tween.position.x = tween.moveFrom.x + (tween.moveTarget.x - tween.moveFrom.x) * t;
+            tween.position.y = tween.moveFrom.y + (tween.moveTarget.y - tween.moveFrom.y) * t;
+            if (t >= 1.0f) {
+                tween.moveState = CTS_FINISHED;
+                recordTweenZone("CardTween::move", tween.moveStartNs);
+            }
+        }
+        
+        if (tween.flipState == CTS_RUNNING) {
+            tween.flipElapsed += dt;
+            float t = getProgress(tween.flipElapsed, tween.flipDuration);
+            if (t < 0.5f) {
+                tween.scaleX = 1.0f - 2.0f * t;
+            } else {
+                if (!tween.faceSwitched) {
+                    tween.faceSwitched = true;
+                    tween.faceSwitchedThisFrame = true;
+                }
+                tween.scaleX = 2.0f * t - 1.0f;
+            }
+            if (t >= 1.0f) {
+                tween.flipState = CTS_FINISHED;
+                recordTweenZone("CardTween::flip", tween.flipStartNs);
+            }
+        }
+    }
+}
+
+void CardTweenSystem::removeFinished(std::vector<CompleteCallback>* outCallbacks)
+{
+    // 倒序遍历：移除时与最后一个交换，交换过来的补间已经检查过
+    for (int index = static_cast<int>(_tweens.size()) - 1; index >= 0; index--) {
+        CardTween& tween = _tweens[index];
+        if (tween.moveState == CTS_FINISHED) {
+            tween.moveState = CTS_NONE;
+            if (_callbacks[index] && outCallbacks) {
+                outCallbacks->push_back(std::move(_callbacks[index]));
+            }
+            _callbacks[index] = nullptr;
+        }
+        if (tween.flipState == CTS_FINISHED) {
+            tween.flipState = CTS_NONE;
+        }
+        if (tween.moveState == CTS_NONE && tween.flipState == CTS_NONE) {
+            removeAt(index);
+        }
+    }
+}
+
+CardTween& CardTweenSystem::acquireTween(int cardId)
+{
+    int index = findIndex(cardId);
+    if (index >= 0) {
+        return _tweens[index];
+    }
+    
+    if (cardId >= static_cast<int>(_indexByCardId.size())) {
+        _indexByCardId.resize(cardId + 1, -1);
+    }
+    _indexByCardId[cardId] = static_cast<int>(_tweens.size());
+    
+    CardTween tween;
+    tween.cardId = cardId;
+    tween.moveState = CTS_NONE;
+    tween.moveElapsed = 0.0f;
+    tween.moveDuration = 0.0f;
+    tween.moveStartNs = 0;
+    tween.flipState = CTS_NONE;
+    tween.showFront = false;
+    tween.faceSwitched = false;
+    tween.faceSwitchedThisFrame = false;
+    tween.scaleX = 1.0f;
+    tween.flipElapsed = 0.0f;
+    tween.flipDuration = 0.0f;
+    tween.flipStartNs = 0;
+    _tweens.push_back(tween);
+    _callbacks.push_back(nullptr);
+    return _tweens.back();
+}
+
+void CardTweenSystem::removeAt(int index)
+{
+    int lastIndex = static_cast<int>(_tweens.size()) - 1;
+    _indexByCardId[_tweens[index].cardId] = -1;
+    if (index != lastIndex) {
+        _tweens[index] = _tweens[lastIndex];
+        _callbacks[index].swap(_callbacks[lastIndex]);
+        _indexByCardId[_tweens[index].cardId] = index;
+    }
+    _tweens.pop_back();
+    _callbacks.pop_back();
+}
+
+int CardTweenSystem::findIndex(int cardId) const
+{
+    if (cardId < 0 || cardId >= static_cast<int>(_indexByCardId.size())) {
+        return -1;
+    }
+    return _indexByCardId[cardId];
+}
@@ -0,0 +1,154 @@
+#ifndef __CARD_TWEEN_SYSTEM_H__
+#define __CARD_TWEEN_SYSTEM_H__
+
+#include "CardPosition.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief 补间通道的状态
+ */
+enum CardTweenState
+{
+    CTS_NONE,           // 没有补间
+    CTS_RUNNING,        // 进行中
+    CTS_FINISHED        // 本帧完成（应用最终值后由removeFinished清除）
+};
+
+/**
+ * @struct CardTween
+ * @brief 一张卡牌的补间（移动和翻牌两个通道）
+ */
+struct CardTween
+{
+    int cardId;                     // 卡牌ID
+    
+    CardTweenState moveState;       // 移动通道状态
+    CardPosition moveFrom;          // 移动起点
+    CardPosition moveTarget;        // 移动终点
+    CardPosition position;          // 当前位置
+    float moveElapsed;              // 移动已进行的时间（秒）
+    float moveDuration;             // 移动时长（秒）
+    uint64_t moveStartNs;           // 移动开始时间（跟踪构建中记录异步区间）
+    
+    CardTweenState flipState;       // 翻牌通道状态
+    bool showFront;                 // 翻牌后是否显示正面
+    bool faceSwitched;              // 是否已过翻牌中点（已切换牌面）
+    bool faceSwitchedThisFrame;     // 本帧是否刚切换牌面（视图需要更新纹理）
+    float scaleX;                   // 当前横向缩放
+    float flipElapsed;              // 翻牌已进行的时间（秒）
+    float flipDuration;             // 翻牌时长（秒）
+    uint64_t flipStartNs;           // 翻牌开始时间（跟踪构建中记录异步区间）
+};
+
+/**
+ * @class CardTweenSystem
+ * @brief 卡牌补间系统
+ * @details 代替每次动画新建的MoveTo/ScaleTo/Sequence/CallFunc：所有进行中的补间保存在一个连续数组中，
+ *          每帧一次遍历全部推进；每张卡牌最多一个补间，按卡牌ID直接索引，预留容量后开始和结束补间都不分配内存
+ *          同一卡牌再次移动时从当前位置改为新的终点（重定向），不会排队执行过时的移动；被替换或取消的
+ *          移动不再调用完成回调
+ *          与引擎无关：GameView每帧调用update，把getTweens中的位置、缩放和牌面应用到卡牌视图，
+ *          再调用removeFinished取出完成回调执行
+ */
+class CardTweenSystem
+{
+public:
+    /**
+     * @brief 移动完成回调函数类型（不传回调时不分配内存）
+     */
+    using CompleteCallback = std::function<void()>;
+    
+    /**
+     * @brief 预留容量
+     * @param tweenCount 同时进行的补间数量（通常为卡牌数量）
+     * @param maxCardId 最大卡牌ID
+     */
+    void reserve(int tweenCount, int maxCardId);
+    
+    /**
+     * @brief 开始移动（卡牌已在移动时改为从当前位置移到新的终点，旧的完成回调被丢弃）
+     * @param cardId 卡牌ID（非负）
+     * @param from 起点（通常为视图的当前位置）
+     * @param to 终点
+     * @param duration 时长（秒，<=0时在下一次update完成）
+     * @param callback 完成回调
+     */
+    void moveTo(int cardId, const CardPosition& from, const CardPosition& to, float duration,
+                const CompleteCallback& callback = nullptr);
+    
+    /**
+     * @brief 开始翻牌：横向缩放到0，切换牌面，再恢复
+     * @details 卡牌已在翻牌时从当前缩放继续，中点之后切换到新的牌面
+     * @param cardId 卡牌ID（非负）
+     * @param showFront 是否显示正面
+     * @param duration 时长（秒）
+     */
+    void flip(int cardId, bool showFront, float duration);
+    
+    /**
+     * @brief 取消卡牌的补间（视图停在当前状态，不调用完成回调）
+     */
+    void cancel(int cardId);
+    
+    /**
+     * @brief 取消所有补间
+     */
+    void clear();
+    
+    /**
+     * @brief 卡牌是否有进行中的补间
+     */
+    bool isAnimating(int cardId) const { return findIndex(cardId) >= 0; }
+    
+    /**
+     * @brief 获取卡牌的补间（没有时返回nullptr；开始或移除补间后失效）
+     */
+    const CardTween* findTween(int cardId) const;
+    
+    /**
+     * @brief 推进所有补间
+     * @param dt 经过的时间（秒）
+     */
+    void update(float dt);
+    
+    /**
+     * @brief 获取所有补间（update之后应用到视图；通道状态为CTS_NONE的不需要应用）
+     */
+    const std::vector<CardTween>& getTweens() const { return _tweens; }
+    
+    /**
+     * @brief 清除本帧完成的通道，移除两个通道都结束的补间
+     * @param outCallbacks 输出本帧完成的移动的回调（追加；回调中可以开始新的补间）
+     */
+    void removeFinished(std::vector<CompleteCallback>* outCallbacks);
+    
+    /**
+     * @brief 获取进行中的补间数量
+     */
+    int size() const { return static_cast<int>(_tweens.size()); }
+    
+private:
+    /**
+     * @brief 获取卡牌的补间，没有时在数组末尾新建
+     */
+    CardTween& acquireTween(int cardId);
+    
+    /**
+     * @brief 移除数组中的补间（与最后一个交换）
+     */
+    void removeAt(int index);
+    
+    /**
+     * @brief 获取卡牌补间在数组中的下标，没有时返回-1
+     */
+    int findIndex(int cardId) const;
+    
+private:
+    std::vector<CardTween> _tweens;                 // 进行中的补间（连续存储）
+    std::vector<CompleteCallback> _callbacks;       // 与_tweens对应的移动完成回调
+    std::vector<int> _indexByCardId;                // 卡牌ID -> _tweens下标（没有时为-1）
+};
+
+#endif // __CARD_TWEEN_SYSTEM_H__
@@ -0,0 +1,70 @@
+#include "CoreLog.h"
+#include <cstdarg>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+CoreLog::LogSink CoreLog::s_sink = nullptr;
+
+namespace {
+
+std::thread::id s_sinkThread;               // 设置输出函数的线程
+std::mutex s_deferredMutex;                 // 保护暂存队列
+std::deque<std::string> s_deferredMessages; // 其他线程暂存的日志
+
+} // namespace
+
+void CoreLog::setSink(LogSink sink)
+{
+    flush();
+    
+    std::lock_guard<std::mutex> lock(s_deferredMutex);
+    s_sink = sink;
+    s_sinkThread = std::this_thread::get_id();
+    s_deferredMessages.clear();
+}
+
+void CoreLog::log(const char* format, ...)
+{
+    if (!s_sink) {
+        return;
+    }
+    
+    char buffer[1024];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    
+    if (std::this_thread::get_id() == s_sinkThread) {
+        s_sink(buffer);
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(s_deferredMutex);
+    if (static_cast<int>(s_deferredMessages.size()) < kMaxDeferredCount) {
+        s_deferredMessages.push_back(buffer);
+    }
+}
+
+void CoreLog::flush()
+{
+    if (std::this_thread::get_id() != s_sinkThread) {
+        return;
+    }
+    
+    std::deque<std::string> messages;
+    {
+        std::lock_guard<std::mutex> lock(s_deferredMutex);
+        messages.swap(s_deferredMessages);
+    }
+    
+    if (!s_sink) {
+        return;
+    }
+    for (const std::string& message : messages) {
+        s_sink(message.c_str());
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef __CORE_LOG_H__
+#define __CORE_LOG_H__
+
+/**
+ * @file CoreLog.h
+ * @brief 规则核心库的日志接口
+ * @details 核心库不能依赖CCLOG，日志通过可替换的输出函数转发。
+ *          未设置输出函数时CORE_LOG只做一次判断，不会格式化字符串，
+ *          适合无头模拟等对性能敏感的场景
+ *          输出函数只在设置它的线程上调用：其他线程（如关卡预加载线程）的日志先放入
+ *          有上限的队列，由设置线程调用flush时输出，引擎日志不会在工作线程中执行
+ */
+
+/**
+ * @class CoreLog
+ * @brief 核心库日志工具
+ */
+class CoreLog
+{
+public:
+    /**
+     * @brief 日志输出函数类型
+     * @details 参数为已格式化的日志内容
+     */
+    using LogSink = void (*)(const char* message);
+    
+    /**
+     * @brief 其他线程最多暂存的日志条数（超出后丢弃）
+     */
+    static const int kMaxDeferredCount = 64;
+    
+    /**
+     * @brief 设置日志输出函数（记录调用线程为输出线程）
+     * @param sink 输出函数，传nullptr关闭日志
+     */
+    static void setSink(LogSink sink);
+    
+    /**
+     * @brief 是否设置了日志输出函数
+     */
+    static bool hasSink() { return s_sink != nullptr; }
+    
+    /**
+     * @brief 格式化并输出一条日志
+     * @param format printf风格的格式字符串
+     */
+    static void log(const char* format, ...);
+    
+    /**
+     * @brief 输出其他线程暂存的日志
+     * @details 只在输出线程上生效，其他线程调用时不做任何事
+     */
+    static void flush();
+    
+private:
+    static LogSink s_sink;  // 日志输出函数
+};
+
+#define CORE_LOG(format, ...)                               \
+    do {                                                    \
+        if (CoreLog::hasSink()) {                           \
+            CoreLog::log(format, ##__VA_ARGS__);            \
+        }                                                   \
+    } while (0)
+
+#endif // __CORE_LOG_H__
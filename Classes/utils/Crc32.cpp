@@ -0,0 +1,37 @@
+#include "Crc32.h"
+
+namespace {
+
+/**
+ * @struct Crc32Table
+ * @brief 按字节查表的余数表
+ */
+struct Crc32Table
+{
+    uint32_t values[256];
+    
+    Crc32Table()
+    {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; bit++) {
+                value = (value & 1) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+            }
+            values[i] = value;
+        }
+    }
+};
+
+const Crc32Table s_table;
+
+} // namespace
+
+uint32_t Crc32::compute(const void* data, size_t size, uint32_t crc)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc = s_table.values[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
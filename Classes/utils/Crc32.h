@@ -0,0 +1,25 @@
+#ifndef __CRC32_H__
+#define __CRC32_H__
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class Crc32
+ * @brief CRC-32校验（IEEE 802.3多项式，与zlib的crc32结果相同）
+ * @details 用于存档日志检测写入不完整或损坏的数据
+ */
+class Crc32
+{
+public:
+    /**
+     * @brief 计算校验值
+     * @param data 数据
+     * @param size 字节数
+     * @param crc 之前数据的校验值（分段计算时传入上一段的结果，首段为0）
+     * @return 校验值
+     */
+    static uint32_t compute(const void* data, size_t size, uint32_t crc = 0);
+};
+
+#endif // __CRC32_H__
@@ -0,0 +1,31 @@
+#include "DrawCallCounter.h"
+
+USING_NS_CC;
+
+EventListenerCustom* DrawCallCounter::s_listener = nullptr;
+int DrawCallCounter::s_lastFrameDrawCalls = 0;
+int DrawCallCounter::s_maxDrawCalls = 0;
+
+void DrawCallCounter::start()
+{
+    if (s_listener) {
+        return;
+    }
+    
+    // 渲染器在每帧开始时清零统计，绘制结束时即为这一帧的合批数
+    auto director = Director::getInstance();
+    s_listener = director->getEventDispatcher()->addCustomEventListener(Director::EVENT_AFTER_DRAW, [](EventCustom*) {
+        s_lastFrameDrawCalls = static_cast<int>(Director::getInstance()->getRenderer()->getDrawnBatches());
+        if (s_lastFrameDrawCalls > s_maxDrawCalls) {
+            s_maxDrawCalls = s_lastFrameDrawCalls;
+        }
+    });
+}
+
+void DrawCallCounter::stop()
+{
+    if (s_listener) {
+        Director::getInstance()->getEventDispatcher()->removeEventListener(s_listener);
+        s_listener = nullptr;
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef __DRAW_CALL_COUNTER_H__
+#define __DRAW_CALL_COUNTER_H__
+
+#include "cocos2d.h"
+
+/**
+ * @class DrawCallCounter
+ * @brief 每帧绘制调用计数
+ * @details 在每帧绘制结束（Director::EVENT_AFTER_DRAW）时读取渲染器的合批数，记录最近一帧和最大值，
+ *          用于确认卡牌合批没有被打断；仅供客户端使用，无头环境下的估算见CardAtlasLayout::countDrawCalls
+ */
+class DrawCallCounter
+{
+public:
+    /**
+     * @brief 开始计数（重复调用无效）
+     */
+    static void start();
+    
+    /**
+     * @brief 停止计数
+     */
+    static void stop();
+    
+    /**
+     * @brief 获取最近一帧的绘制调用数
+     */
+    static int getLastFrameDrawCalls() { return s_lastFrameDrawCalls; }
+    
+    /**
+     * @brief 获取开始计数（或上次重置）以来单帧的最大绘制调用数
+     */
+    static int getMaxDrawCalls() { return s_maxDrawCalls; }
+    
+    /**
+     * @brief 重置最大值（例如进入新关卡时）
+     */
+    static void resetMaxDrawCalls() { s_maxDrawCalls = 0; }
+    
+private:
+    static cocos2d::EventListenerCustom* s_listener;    // 绘制结束事件监听器
+    static int s_lastFrameDrawCalls;                    // 最近一帧的绘制调用数
+    static int s_maxDrawCalls;                          // 单帧最大绘制调用数
+};
+
+#endif // __DRAW_CALL_COUNTER_H__
@@ -0,0 +1,68 @@
+#ifndef __SEEDED_RANDOM_H__
+#define __SEEDED_RANDOM_H__
+
+#include <cstdint>
+
+/**
+ * @class SeededRandom
+ * @brief 可复现的伪随机数生成器（splitmix64）
+ * @details 只使用定宽整数运算，同一种子在任何平台、编译器和标准库上产生相同的序列，
+ *          不使用std::uniform_int_distribution等实现相关的分布
+ *          相邻的种子（如关卡ID）也会得到互不相关的序列
+ *          对象很小且不共享状态，多线程时每个线程各持有一个
+ */
+class SeededRandom
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param seed 种子
+     */
+    explicit SeededRandom(uint64_t seed = 0)
+        : _state(seed)
+    {
+    }
+    
+    /**
+     * @brief 重新设置种子
+     */
+    void setSeed(uint64_t seed) { _state = seed; }
+    
+    /**
+     * @brief 生成下一个64位随机数
+     */
+    uint64_t next64()
+    {
+        uint64_t z = (_state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    
+    /**
+     * @brief 生成下一个32位随机数
+     */
+    uint32_t next32() { return static_cast<uint32_t>(next64() >> 32); }
+    
+    /**
+     * @brief 生成[0, bound)内的随机整数（bound不大于0时返回0）
+     * @details 乘法取高位映射到区间，偏差不超过bound/2^32，不需要取模和拒绝采样
+     */
+    int nextBelow(int bound)
+    {
+        if (bound <= 0) {
+            return 0;
+        }
+        return static_cast<int>((static_cast<uint64_t>(next32()) * static_cast<uint32_t>(bound)) >> 32);
+    }
+    
+    /**
+     * @brief 生成[0, 1)内的随机浮点数（24位精度）
+     */
+    float nextFloat() { return static_cast<float>(next32() >> 8) * (1.0f / 16777216.0f); }
+    
+private:
+    uint64_t _state;    // 当前状态
+};
+
+#endif // __SEEDED_RANDOM_H__
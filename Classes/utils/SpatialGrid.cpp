@@ -0,0 +1,116 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellWidth, float cellHeight)
+    : _cellWidth(cellWidth > 0.0f ? cellWidth : kCardWidth)
+    , _cellHeight(cellHeight > 0.0f ? cellHeight : kCardHeight)
+{
+}
+
+void SpatialGrid::clear()
+{
+    _cells.clear();
+    _rects.clear();
+}
+
+void SpatialGrid::insert(int id, const CardRect& rect)
+{
+    if (id < 0) {
+        return;
+    }
+    
+    remove(id);
+    _rects[id] = rect;
+    
+    int maxX = cellX(rect.maxX);
+    int maxY = cellY(rect.maxY);
+    for (int x = cellX(rect.minX); x <= maxX; x++) {
+        for (int y = cellY(rect.minY); y <= maxY; y++) {
+            _cells[cellKey(x, y)].push_back(id);
+        }
+    }
+}
+
+void SpatialGrid::remove(int id)
+{
+    auto rectIt = _rects.find(id);
+    if (rectIt == _rects.end()) {
+        return;
+    }
+    
+    const CardRect& rect = rectIt->second;
+    int maxX = cellX(rect.maxX);
+    int maxY = cellY(rect.maxY);
+    for (int x = cellX(rect.minX); x <= maxX; x++) {
+        for (int y = cellY(rect.minY); y <= maxY; y++) {
+            auto cellIt = _cells.find(cellKey(x, y));
+            if (cellIt == _cells.end()) {
+                continue;
+            }
+            std::vector<int>& ids = cellIt->second;
+            ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+            if (ids.empty()) {
+                _cells.erase(cellIt);
+            }
+        }
+    }
+    _rects.erase(rectIt);
+}
+
+void SpatialGrid::query(const CardRect& rect, std::vector<int>* outIds) const
+{
+    if (!outIds) {
+        return;
+    }
+    
+    int minX = cellX(rect.minX);
+    int minY = cellY(rect.minY);
+    int maxX = cellX(rect.maxX);
+    int maxY = cellY(rect.maxY);
+    for (int x = minX; x <= maxX; x++) {
+        for (int y = minY; y <= maxY; y++) {
+            auto cellIt = _cells.find(cellKey(x, y));
+            if (cellIt == _cells.end()) {
+                continue;
+            }
+            for (int id : cellIt->second) {
+                const CardRect& other = _rects.find(id)->second;
+                if (!other.intersects(rect)) {
+                    continue;
+                }
+                // 矩形可能跨多个格子：只在重叠区域左下角所在的格子里输出，避免重复
+                if (cellX(std::max(rect.minX, other.minX)) == x && cellY(std::max(rect.minY, other.minY)) == y) {
+                    outIds->push_back(id);
+                }
+            }
+        }
+    }
+}
+
+void SpatialGrid::queryPoint(const CardPosition& point, std::vector<int>* outIds) const
+{
+    if (!outIds) {
+        return;
+    }
+    
+    auto cellIt = _cells.find(cellKey(cellX(point.x), cellY(point.y)));
+    if (cellIt == _cells.end()) {
+        return;
+    }
+    for (int id : cellIt->second) {
+        if (_rects.find(id)->second.contains(point)) {
+            outIds->push_back(id);
+        }
+    }
+}
+
+int SpatialGrid::cellX(float x) const
+{
+    return static_cast<int>(std::floor(x / _cellWidth));
+}
+
+int SpatialGrid::cellY(float y) const
+{
+    return static_cast<int>(std::floor(y / _cellHeight));
+}
@@ -0,0 +1,85 @@
+#ifndef __SPATIAL_GRID_H__
+#define __SPATIAL_GRID_H__
+
+#include "CardGeometry.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class SpatialGrid
+ * @brief 均匀网格空间索引
+ * @details 平面按固定边长划分为格子，只为非空格子分配存储；
+ *          每个矩形登记到它覆盖的所有格子中，查询只检查查询范围覆盖的格子，
+ *          格子边长接近卡牌尺寸时每个矩形只占少数几个格子，n张卡牌的两两重叠检测从O(n²)降到接近O(n)
+ */
+class SpatialGrid
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param cellWidth 格子宽度（<=0时使用卡牌宽度）
+     * @param cellHeight 格子高度（<=0时使用卡牌高度）
+     */
+    SpatialGrid(float cellWidth = kCardWidth, float cellHeight = kCardHeight);
+    
+    /**
+     * @brief 清空所有矩形
+     */
+    void clear();
+    
+    /**
+     * @brief 插入矩形（ID已存在时先移除旧矩形）
+     * @param id 矩形ID（非负）
+     * @param rect 矩形
+     */
+    void insert(int id, const CardRect& rect);
+    
+    /**
+     * @brief 移除矩形
+     * @param id 矩形ID
+     */
+    void remove(int id);
+    
+    /**
+     * @brief 查询与矩形有重叠面积的所有ID
+     * @param rect 查询矩形
+     * @param outIds 输出ID（追加，每个ID只出现一次，顺序不保证）
+     */
+    void query(const CardRect& rect, std::vector<int>* outIds) const;
+    
+    /**
+     * @brief 查询包含某点的所有ID
+     * @param point 查询点
+     * @param outIds 输出ID（追加，每个ID只出现一次，顺序不保证）
+     */
+    void queryPoint(const CardPosition& point, std::vector<int>* outIds) const;
+    
+    /**
+     * @brief 获取已插入的矩形数量
+     */
+    int size() const { return static_cast<int>(_rects.size()); }
+    
+private:
+    /**
+     * @brief 坐标所在的格子行列号
+     */
+    int cellX(float x) const;
+    int cellY(float y) const;
+    
+    /**
+     * @brief 格子行列号打包成键
+     */
+    static int64_t cellKey(int x, int y)
+    {
+        return static_cast<int64_t>((static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y));
+    }
+    
+private:
+    float _cellWidth;                                       // 格子宽度
+    float _cellHeight;                                      // 格子高度
+    std::unordered_map<int64_t, std::vector<int> > _cells;  // 格子键 -> 格子内的ID
+    std::unordered_map<int, CardRect> _rects;               // ID -> 矩形
+};
+
+#endif // __SPATIAL_GRID_H__
@@ -0,0 +1,205 @@
+#include "TraceProfiler.h"
+
+#if POKER_TRACE
+
+#include "CoreLog.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief 一个区间（名称只保存指针）
+ */
+struct TraceEvent
+{
+    const char* name;       // 区间名称
+    uint64_t startNs;       // 开始时间
+    uint64_t endNs;         // 结束时间
+    uint32_t async;         // 是否为异步区间
+    uint32_t reserved;      // 对齐
+};
+
+/**
+ * @brief 线程的环形缓冲区（只有所属线程写入）
+ * @details writeIndex是已写入的区间总数，写完区间后以release发布；导出方先acquire读取，
+ *          复制后再读一次，判断复制期间哪些槽位可能已被覆盖
+ */
+struct ThreadBuffer
+{
+    std::atomic<uint64_t> writeIndex;           // 已写入的区间总数
+    std::atomic<const char*> threadName;        // 线程名称
+    int threadId;                               // 跟踪视图中的线程ID
+    TraceEvent events[TraceProfiler::kThreadCapacity];
+};
+
+const uint64_t kCapacity = static_cast<uint64_t>(TraceProfiler::kThreadCapacity);
+const std::chrono::steady_clock::time_point s_startTime = std::chrono::steady_clock::now();
+thread_local ThreadBuffer* t_buffer = nullptr;
+
+/**
+ * @brief 所有线程的缓冲区（线程退出后仍保留，导出时可以读到）
+ */
+std::mutex& getRegistryMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<ThreadBuffer*>& getRegistry()
+{
+    static std::vector<ThreadBuffer*> buffers;
+    return buffers;
+}
+
+/**
+ * @brief 获取当前线程的缓冲区，第一次调用时分配并登记
+ */
+ThreadBuffer* getThreadBuffer()
+{
+    if (!t_buffer) {
+        ThreadBuffer* buffer = new ThreadBuffer();
+        buffer->writeIndex.store(0, std::memory_order_relaxed);
+        buffer->threadName.store(nullptr, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(getRegistryMutex());
+        buffer->threadId = static_cast<int>(getRegistry().size()) + 1;
+        getRegistry().push_back(buffer);
+        t_buffer = buffer;
+    }
+    return t_buffer;
+}
+
+void appendEvent(const char* name, uint64_t startNs, uint64_t endNs, bool async)
+{
+    ThreadBuffer* buffer = getThreadBuffer();
+    uint64_t index = buffer->writeIndex.load(std::memory_order_relaxed);
+    TraceEvent& event = buffer->events[index & (kCapacity - 1)];
+    event.name = name;
+    event.startNs = startNs;
+    event.endNs = endNs < startNs ? startNs : endNs;
+    event.async = async ? 1 : 0;
+    buffer->writeIndex.store(index + 1, std::memory_order_release);
+}
+
+/**
+ * @brief 输出JSON字符串（转义引号、反斜杠和控制字符）
+ */
+void writeJsonString(FILE* file, const char* text)
+{
+    fputc('"', file);
+    for (const char* c = text ? text : ""; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', file);
+            fputc(*c, file);
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            fprintf(file, "\\u%04x", static_cast<unsigned int>(static_cast<unsigned char>(*c)));
+        } else {
+            fputc(*c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+} // namespace
+
+static_assert((TraceProfiler::kThreadCapacity & (TraceProfiler::kThreadCapacity - 1)) == 0,
+              "kThreadCapacity must be a power of two");
+
+uint64_t TraceProfiler::now()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - s_startTime).count());
+}
+
+void TraceProfiler::recordZone(const char* name, uint64_t startNs, uint64_t endNs)
+{
+    appendEvent(name, startNs, endNs, false);
+}
+
+void TraceProfiler::recordAsyncZone(const char* name, uint64_t startNs, uint64_t endNs)
+{
+    appendEvent(name, startNs, endNs, true);
+}
+
+void TraceProfiler::setThreadName(const char* name)
+{
+    getThreadBuffer()->threadName.store(name, std::memory_order_release);
+}
+
+bool TraceProfiler::writeChromeTrace(const std::string& filePath)
+{
+    std::vector<ThreadBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(getRegistryMutex());
+        buffers = getRegistry();
+    }
+    
+    FILE* file = fopen(filePath.c_str(), "wb");
+    if (!file) {
+        CORE_LOG("TraceProfiler: Failed to open file for writing: %s", filePath.c_str());
+        return false;
+    }
+    
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+    bool first = true;
+    unsigned long long asyncId = 0;
+    std::vector<TraceEvent> events;
+    for (ThreadBuffer* buffer : buffers) {
+        const char* threadName = buffer->threadName.load(std::memory_order_acquire);
+        if (threadName) {
+            fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":",
+                    first ? "" : ",\n", buffer->threadId);
+            writeJsonString(file, threadName);
+            fputs("}}", file);
+            first = false;
+        }
+        
+        // 复制最近的区间；复制后所属线程可能又写入了一些，丢弃这期间可能被覆盖的槽位
+        uint64_t endIndex = buffer->writeIndex.load(std::memory_order_acquire);
+        uint64_t beginIndex = endIndex > kCapacity ? endIndex - kCapacity : 0;
+        events.clear();
+        for (uint64_t index = beginIndex; index < endIndex; index++) {
+            events.push_back(buffer->events[index & (kCapacity - 1)]);
+        }
+        uint64_t afterIndex = buffer->writeIndex.load(std::memory_order_acquire);
+        uint64_t firstValid = afterIndex >= kCapacity ? afterIndex - kCapacity + 1 : 0;
+        size_t skipCount = firstValid > beginIndex ? static_cast<size_t>(firstValid - beginIndex) : 0;
+        
+        for (size_t i = skipCount; i < events.size(); i++) {
+            const TraceEvent& event = events[i];
+            double startUs = event.startNs / 1000.0;
+            double endUs = event.endNs / 1000.0;
+            fputs(first ? "" : ",\n", file);
+            first = false;
+            if (event.async) {
+                // 异步区间用b/e事件对表示，同一线程上可以互相交错
+                asyncId++;
+                fputs("{\"name\":", file);
+                writeJsonString(file, event.name);
+                fprintf(file, ",\"cat\":\"async\",\"ph\":\"b\",\"id\":%llu,\"ts\":%.3f,\"pid\":1,\"tid\":%d},\n",
+                        asyncId, startUs, buffer->threadId);
+                fputs("{\"name\":", file);
+                writeJsonString(file, event.name);
+                fprintf(file, ",\"cat\":\"async\",\"ph\":\"e\",\"id\":%llu,\"ts\":%.3f,\"pid\":1,\"tid\":%d}",
+                        asyncId, endUs, buffer->threadId);
+            } else {
+                fputs("{\"name\":", file);
+                writeJsonString(file, event.name);
+                fprintf(file, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                        startUs, endUs - startUs, buffer->threadId);
+            }
+        }
+    }
+    fputs("\n]}\n", file);
+    
+    if (fclose(file) != 0) {
+        CORE_LOG("TraceProfiler: Failed to write trace: %s", filePath.c_str());
+        return false;
+    }
+    return true;
+}
+
+#endif // POKER_TRACE
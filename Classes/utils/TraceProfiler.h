@@ -0,0 +1,109 @@
+#ifndef __TRACE_PROFILER_H__
+#define __TRACE_PROFILER_H__
+
+/**
+ * @file TraceProfiler.h
+ * @brief 轻量级跟踪区间
+ * @details Debug构建（或CMake选项POKER_TRACE=ON）定义POKER_TRACE=1，此时TRACE_ZONE在作用域内记录一个区间，
+ *          每个线程写入自己的无锁环形缓冲区，可导出为Chrome跟踪事件JSON（chrome://tracing或Perfetto打开）
+ *          发布构建中宏展开为空语句，TraceProfiler和TraceZone也不参与编译，调用代码需要放在#if POKER_TRACE内
+ */
+
+#ifndef POKER_TRACE
+#define POKER_TRACE 0
+#endif
+
+#if POKER_TRACE
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @class TraceProfiler
+ * @brief 跟踪区间记录与导出
+ * @details 每个线程第一次记录时分配一个容量为kThreadCapacity的环形缓冲区并登记（只有登记时加锁），
+ *          之后只有该线程写入，写满后覆盖最旧的区间；区间名称只保存指针，必须是字符串常量
+ *          导出可以在其他线程进行，导出期间被覆盖的区间会被丢弃
+ */
+class TraceProfiler
+{
+public:
+    /**
+     * @brief 每个线程最多保留的区间数量
+     */
+    static const int kThreadCapacity = 1 << 15;
+    
+    /**
+     * @brief 当前时间（纳秒，从进程开始计时）
+     */
+    static uint64_t now();
+    
+    /**
+     * @brief 记录当前线程上的一个区间
+     * @param name 区间名称（字符串常量）
+     * @param startNs 开始时间（now()的返回值）
+     * @param endNs 结束时间
+     */
+    static void recordZone(const char* name, uint64_t startNs, uint64_t endNs);
+    
+    /**
+     * @brief 记录一个异步区间（例如动画），可以与同一线程上的其他区间交错
+     * @param name 区间名称（字符串常量）
+     * @param startNs 开始时间
+     * @param endNs 结束时间
+     */
+    static void recordAsyncZone(const char* name, uint64_t startNs, uint64_t endNs);
+    
+    /**
+     * @brief 设置当前线程在跟踪视图中的名称
+     * @param name 线程名称（字符串常量）
+     */
+    static void setThreadName(const char* name);
+    
+    /**
+     * @brief 把所有线程缓冲区中的区间写入Chrome跟踪事件JSON文件
+     * @param filePath 文件路径
+     * @return 写入失败时返回false
+     */
+    static bool writeChromeTrace(const std::string& filePath);
+};
+
+/**
+ * @class TraceZone
+ * @brief 作用域区间：构造时计时，析构时记录
+ */
+class TraceZone
+{
+public:
+    explicit TraceZone(const char* name)
+        : _name(name)
+        , _startNs(TraceProfiler::now())
+    {
+    }
+    
+    ~TraceZone()
+    {
+        TraceProfiler::recordZone(_name, _startNs, TraceProfiler::now());
+    }
+    
+private:
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+    
+    const char* _name;      // 区间名称
+    uint64_t _startNs;      // 开始时间
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_ZONE(name) TraceZone TRACE_CONCAT(traceZone, __LINE__)(name)
+#define TRACE_THREAD_NAME(name) TraceProfiler::setThreadName(name)
+
+#else
+
+#define TRACE_ZONE(name) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+
+#endif // POKER_TRACE
+
+#endif // __TRACE_PROFILER_H__
@@ -0,0 +1,190 @@
+#ifndef __WORK_STEALING_DEQUE_H__
+#define __WORK_STEALING_DEQUE_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class WorkStealingDeque
+ * @brief 无锁工作窃取双端队列（Chase-Lev）
+ * @details 所有者线程在底部push/pop（后进先出，保持缓存局部性），
+ *          其他线程从顶部steal（先进先出，窃取较大的子任务）
+ *          环形数组满时扩容，旧数组保留到析构时释放，避免窃取者读到已释放的内存
+ *          内存序参考 Lê et al. "Correct and Efficient Work-Stealing for Weak Memory Models"
+ * @tparam T 元素类型（指针或其他可平凡复制的小类型）
+ */
+template <typename T>
+class WorkStealingDeque
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param capacity 初始容量（会向上取整为2的幂）
+     */
+    explicit WorkStealingDeque(int64_t capacity = 256)
+        : _top(0)
+        , _bottom(0)
+    {
+        int64_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        Array* array = new Array(size);
+        _arrays.push_back(array);
+        _array.store(array, std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief 析构函数
+     */
+    ~WorkStealingDeque()
+    {
+        for (size_t i = 0; i < _arrays.size(); i++) {
+            delete _arrays[i];
+        }
+    }
+    
+    /**
+     * @brief 压入元素（仅所有者线程调用）
+     * @param item 元素
+     */
+    void push(T item)
+    {
+        int64_t bottom = _bottom.load(std::memory_order_relaxed);
+        int64_t top = _top.load(std::memory_order_acquire);
+        Array* array = _array.load(std::memory_order_relaxed);
+        
+        if (bottom - top > array->capacity - 1) {
+            array = grow(array, top, bottom);
+        }
+        
+        array->put(bottom, item);
+        _bottom.store(bottom + 1, std::memory_order_release);
+    }
+    
+    /**
+     * @brief 从底部弹出元素（仅所有者线程调用）
+     * @param outItem 输出元素
+     * @return 队列为空返回false
+     */
+    bool pop(T* outItem)
+    {
+        int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+        Array* array = _array.load(std::memory_order_relaxed);
+        _bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = _top.load(std::memory_order_relaxed);
+        
+        if (top > bottom) {
+            // 队列为空
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+        
+        *outItem = array->get(bottom);
+        if (top == bottom) {
+            // 只剩最后一个元素，与窃取者竞争
+            bool won = _top.compare_exchange_strong(top, top + 1,
+                                                    std::memory_order_seq_cst, std::memory_order_relaxed);
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+    
+    /**
+     * @brief 从顶部窃取元素（任意线程调用）
+     * @param outItem 输出元素
+     * @return 队列为空或竞争失败返回false
+     */
+    bool steal(T* outItem)
+    {
+        int64_t top = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = _bottom.load(std::memory_order_acquire);
+        
+        if (top >= bottom) {
+            return false;
+        }
+        
+        Array* array = _array.load(std::memory_order_acquire);
+        T item = array->get(top);
+        if (!_top.compare_exchange_strong(top, top + 1,
+                                          std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        *outItem = item;
+        return true;
+    }
+    
+    /**
+     * @brief 估算当前元素数量（并发时仅供参考）
+     */
+    int64_t sizeApprox() const
+    {
+        int64_t bottom = _bottom.load(std::memory_order_relaxed);
+        int64_t top = _top.load(std::memory_order_relaxed);
+        return bottom > top ? bottom - top : 0;
+    }
+    
+private:
+    /**
+     * @struct Array
+     * @brief 环形数组
+     */
+    struct Array
+    {
+        int64_t capacity;               // 容量（2的幂）
+        int64_t mask;                   // 下标掩码
+        std::atomic<T>* items;          // 元素
+        
+        explicit Array(int64_t size)
+            : capacity(size)
+            , mask(size - 1)
+            , items(new std::atomic<T>[size])
+        {
+        }
+        
+        ~Array()
+        {
+            delete[] items;
+        }
+        
+        T get(int64_t index) const
+        {
+            return items[index & mask].load(std::memory_order_relaxed);
+        }
+        
+        void put(int64_t index, T item)
+        {
+            items[index & mask].store(item, std::memory_order_relaxed);
+        }
+    };
+    
+    /**
+     * @brief 扩容为两倍容量（仅所有者线程调用）
+     */
+    Array* grow(Array* array, int64_t top, int64_t bottom)
+    {
+        Array* larger = new Array(array->capacity * 2);
+        for (int64_t i = top; i < bottom; i++) {
+            larger->put(i, array->get(i));
+        }
+        _arrays.push_back(larger);
+        _array.store(larger, std::memory_order_release);
+        return larger;
+    }
+    
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+    
+private:
+    std::atomic<int64_t> _top;          // 顶部下标（窃取端）
+    std::atomic<int64_t> _bottom;       // 底部下标（所有者端）
+    std::atomic<Array*> _array;         // 当前环形数组
+    std::vector<Array*> _arrays;        // 所有分配过的数组（析构时释放）
+};
+
+#endif // __WORK_STEALING_DEQUE_H__
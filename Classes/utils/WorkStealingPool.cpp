@@ -0,0 +1,151 @@
+#include "WorkStealingPool.h"
+#include <chrono>
+
+namespace {
+
+// 当前线程所属的线程池及序号（非工作线程为nullptr/-1）
+thread_local WorkStealingPool* t_currentPool = nullptr;
+thread_local int t_workerIndex = -1;
+
+// 空闲线程在没有任务时的休眠上限（兜底可能错过的唤醒）
+const std::chrono::milliseconds kIdleWaitTimeout(1);
+
+unsigned int nextRandom(unsigned int* state)
+{
+    // xorshift32
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+    : _sleepingCount(0)
+    , _pendingCount(0)
+    , _stopping(false)
+{
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+        if (threadCount <= 0) {
+            threadCount = 1;
+        }
+    }
+    
+    for (int i = 0; i < threadCount; i++) {
+        _deques.push_back(new WorkStealingDeque<Task*>());
+    }
+    for (int i = 0; i < threadCount; i++) {
+        _threads.push_back(std::thread(&WorkStealingPool::workerLoop, this, i));
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    waitIdle();
+    
+    _stopping.store(true);
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _wakeCondition.notify_all();
+    }
+    for (size_t i = 0; i < _threads.size(); i++) {
+        _threads[i].join();
+    }
+    for (size_t i = 0; i < _deques.size(); i++) {
+        delete _deques[i];
+    }
+}
+
+void WorkStealingPool::submit(const Task& task)
+{
+    Task* heapTask = new Task(task);
+    _pendingCount.fetch_add(1);
+    
+    if (t_currentPool == this) {
+        _deques[t_workerIndex]->push(heapTask);
+    } else {
+        std::lock_guard<std::mutex> lock(_injectMutex);
+        _injectQueue.push_back(heapTask);
+    }
+    
+    if (_sleepingCount.load() > 0) {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _wakeCondition.notify_one();
+    }
+}
+
+void WorkStealingPool::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(_idleMutex);
+    _idleCondition.wait(lock, [this]() {
+        return _pendingCount.load() == 0;
+    });
+}
+
+void WorkStealingPool::workerLoop(int workerIndex)
+{
+    t_currentPool = this;
+    t_workerIndex = workerIndex;
+    unsigned int randomState = 0x9E3779B9u ^ static_cast<unsigned int>(workerIndex * 0x85EBCA6Bu + 1);
+    
+    while (!_stopping.load()) {
+        Task* task = acquireTask(workerIndex, &randomState);
+        if (task) {
+            runTask(task);
+            continue;
+        }
+        
+        // 没有可执行的任务，短暂休眠
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleepingCount.fetch_add(1);
+        _wakeCondition.wait_for(lock, kIdleWaitTimeout);
+        _sleepingCount.fetch_sub(1);
+    }
+    
+    t_currentPool = nullptr;
+    t_workerIndex = -1;
+}
+
+WorkStealingPool::Task* WorkStealingPool::acquireTask(int workerIndex, unsigned int* randomState)
+{
+    Task* task = nullptr;
+    
+    // 1. 自己的队列
+    if (_deques[workerIndex]->pop(&task)) {
+        return task;
+    }
+    
+    // 2. 从随机位置开始依次尝试窃取
+    int threadCount = static_cast<int>(_deques.size());
+    int start = static_cast<int>(nextRandom(randomState) % static_cast<unsigned int>(threadCount));
+    for (int i = 0; i < threadCount; i++) {
+        int victim = (start + i) % threadCount;
+        if (victim != workerIndex && _deques[victim]->steal(&task)) {
+            return task;
+        }
+    }
+    
+    // 3. 注入队列
+    std::lock_guard<std::mutex> lock(_injectMutex);
+    if (!_injectQueue.empty()) {
+        task = _injectQueue.front();
+        _injectQueue.pop_front();
+        return task;
+    }
+    return nullptr;
+}
+
+void WorkStealingPool::runTask(Task* task)
+{
+    (*task)();
+    delete task;
+    
+    if (_pendingCount.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(_idleMutex);
+        _idleCondition.notify_all();
+    }
+}
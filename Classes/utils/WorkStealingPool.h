@@ -0,0 +1,98 @@
+#ifndef __WORK_STEALING_POOL_H__
+#define __WORK_STEALING_POOL_H__
+
+#include "WorkStealingDeque.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkStealingPool
+ * @brief 工作窃取线程池
+ * @details 每个工作线程持有一个WorkStealingDeque：工作线程内提交的任务压入自己的队列，
+ *          空闲线程随机窃取其他线程的任务；非工作线程提交的任务进入共享的注入队列
+ *          适合递归拆分的任务（例如搜索树的子树）
+ */
+class WorkStealingPool
+{
+public:
+    /**
+     * @brief 任务类型
+     */
+    using Task = std::function<void()>;
+    
+    /**
+     * @brief 构造函数
+     * @param threadCount 工作线程数量，<=0时使用硬件并发数
+     */
+    explicit WorkStealingPool(int threadCount);
+    
+    /**
+     * @brief 析构函数（等待已提交的任务完成后退出所有线程）
+     */
+    ~WorkStealingPool();
+    
+    /**
+     * @brief 提交任务
+     * @param task 任务
+     */
+    void submit(const Task& task);
+    
+    /**
+     * @brief 阻塞等待所有已提交的任务（包括任务中再提交的任务）完成
+     * @details 不能在工作线程中调用
+     */
+    void waitIdle();
+    
+    /**
+     * @brief 获取工作线程数量
+     */
+    int getThreadCount() const { return static_cast<int>(_threads.size()); }
+    
+private:
+    /**
+     * @brief 工作线程主循环
+     * @param workerIndex 工作线程序号
+     */
+    void workerLoop(int workerIndex);
+    
+    /**
+     * @brief 获取一个任务（自己的队列 -> 窃取 -> 注入队列）
+     * @param workerIndex 工作线程序号
+     * @param randomState 随机数状态（用于选择窃取目标）
+     * @return 任务指针，没有任务返回nullptr
+     */
+    Task* acquireTask(int workerIndex, unsigned int* randomState);
+    
+    /**
+     * @brief 运行并释放任务
+     * @param task 任务指针
+     */
+    void runTask(Task* task);
+    
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    
+private:
+    std::vector<std::thread> _threads;                  // 工作线程
+    std::vector<WorkStealingDeque<Task*>*> _deques;     // 每个工作线程的任务队列
+    
+    std::mutex _injectMutex;                            // 注入队列锁
+    std::deque<Task*> _injectQueue;                     // 非工作线程提交的任务
+    
+    std::mutex _sleepMutex;                             // 休眠锁
+    std::condition_variable _wakeCondition;             // 唤醒空闲线程
+    std::atomic<int> _sleepingCount;                    // 休眠中的线程数
+    
+    std::mutex _idleMutex;                              // 空闲等待锁
+    std::condition_variable _idleCondition;             // 所有任务完成通知
+    std::atomic<long long> _pendingCount;               // 未完成的任务数
+    
+    std::atomic<bool> _stopping;                        // 是否正在退出
+};
+
+#endif // __WORK_STEALING_POOL_H__
@@ -0,0 +1,166 @@
+#include "CardGlyphCache.h"
+#include "../configs/models/CardAtlasLayout.h"
+#include "../configs/models/CardResConfig.h"
+#include "../utils/CardGeometry.h"
+
+USING_NS_CC;
+
+static const char* kGlyphFontName = "Arial";
+static const float kFaceFontSize = 40.0f;       // 牌面名称字号（与原先的Label相同）
+static const float kSuitFontSize = 24.0f;       // 角落花色符号字号
+static const float kBorderWidth = 2.0f;         // 边框宽度
+static const float kCornerMargin = 6.0f;        // 花色符号到卡牌边缘的距离
+
+Texture2D* CardGlyphCache::s_faceTextures[CFT_NUM_CARD_FACE_TYPES] = {};
+Texture2D* CardGlyphCache::s_suitTextures[CST_NUM_CARD_SUIT_TYPES] = {};
+std::vector<RenderTexture*> CardGlyphCache::s_atlasPages;
+
+namespace {
+
+/**
+ * @brief 花色底色（与CardAtlasTool相同）
+ */
+Color4F getSuitColor(CardSuitType suit)
+{
+    switch (suit) {
+        case CST_CLUBS:    return Color4F(0.2f, 0.8f, 0.2f, 1.0f);     // 绿色
+        case CST_DIAMONDS: return Color4F(0.8f, 0.2f, 0.2f, 1.0f);     // 红色
+        case CST_HEARTS:   return Color4F(0.8f, 0.4f, 0.6f, 1.0f);     // 粉色
+        case CST_SPADES:   return Color4F(0.2f, 0.2f, 0.8f, 1.0f);     // 蓝色
+        default:           return Color4F(0.5f, 0.5f, 0.5f, 1.0f);     // 灰色
+    }
+}
+
+/**
+ * @brief 创建一个字形精灵（每次盖章都是新节点，只共用纹理，不重新光栅化）
+ * @details 渲染纹理的第0行是GL坐标的底部，帧在纹理中按上下颠倒绘制，读出来才是正的
+ */
+Sprite* createGlyphSprite(Texture2D* texture, const Vec2& position)
+{
+    Sprite* sprite = Sprite::createWithTexture(texture);
+    sprite->setFlippedY(true);
+    sprite->setPosition(position);
+    return sprite;
+}
+
+} // namespace
+
+Texture2D* CardGlyphCache::getFaceTexture(CardFaceType face)
+{
+    if (face <= CFT_NONE || face >= CFT_NUM_CARD_FACE_TYPES) {
+        return nullptr;
+    }
+    if (!s_faceTextures[face]) {
+        s_faceTextures[face] = createTextTexture(CardResConfig::getFaceName(face), kFaceFontSize);
+    }
+    return s_faceTextures[face];
+}
+
+Texture2D* CardGlyphCache::getSuitTexture(CardSuitType suit)
+{
+    if (suit <= CST_NONE || suit >= CST_NUM_CARD_SUIT_TYPES) {
+        return nullptr;
+    }
+    if (!s_suitTextures[suit]) {
+        s_suitTextures[suit] = createTextTexture(CardResConfig::getSuitSymbol(suit), kSuitFontSize);
+    }
+    return s_suitTextures[suit];
+}
+
+bool CardGlyphCache::renderCardAtlas()
+{
+    if (!s_atlasPages.empty()) {
+        return true;
+    }
+    
+    CardAtlasLayout layout(static_cast<int>(kCardWidth), static_cast<int>(kCardHeight));
+    if (!layout.isValid()) {
+        return false;
+    }
+    
+    auto frameCache = SpriteFrameCache::getInstance();
+    for (int page = 0; page < layout.getPageCount(); page++) {
+        auto renderTexture = RenderTexture::create(layout.getPageWidth(), layout.getPageHeight(),
+                                                   Texture2D::PixelFormat::RGBA8888);
+        if (!renderTexture) {
+            return false;
+        }
+        
+        // 一页的全部卡牌：一个DrawNode画底色和边框，文字用字形纹理盖章
+        auto pageNode = Node::create();
+        auto drawNode = DrawNode::create();
+        pageNode->addChild(drawNode);
+        std::vector<std::pair<int, Rect> > frames;
+        for (int frameIndex = 0; frameIndex < CardAtlasLayout::kFrameCount; frameIndex++) {
+            if (layout.getPageIndex(frameIndex) != page) {
+                continue;
+            }
+            int x = 0;
+            int y = 0;
+            layout.getFrameOrigin(frameIndex, &x, &y);
+            Rect rect(x, y, kCardWidth, kCardHeight);
+            frames.push_back(std::make_pair(frameIndex, rect));
+            
+            Vec2 origin(rect.getMinX(), rect.getMinY());
+            Vec2 destination(rect.getMaxX(), rect.getMaxY());
+            if (frameIndex == CardAtlasLayout::kBackFrameIndex) {
+                drawNode->drawSolidRect(origin, destination, Color4F(0.16f, 0.2f, 0.43f, 1.0f));
+            } else {
+                CardSuitType suit = static_cast<CardSuitType>(frameIndex / CFT_NUM_CARD_FACE_TYPES);
+                CardFaceType face = static_cast<CardFaceType>(frameIndex % CFT_NUM_CARD_FACE_TYPES);
+                drawNode->drawSolidRect(origin, destination, getSuitColor(suit));
+                
+                // 帧上下颠倒：卡牌顶部在GL坐标的较小一侧
+                Texture2D* faceTexture = getFaceTexture(face);
+                Texture2D* suitTexture = getSuitTexture(suit);
+                if (faceTexture) {
+                    pageNode->addChild(createGlyphSprite(faceTexture, Vec2(rect.getMidX(), rect.getMidY())));
+                }
+                if (suitTexture) {
+                    Size suitSize = suitTexture->getContentSize();
+                    Vec2 position(rect.getMinX() + kCornerMargin + suitSize.width / 2,
+                                  rect.getMinY() + kCornerMargin + suitSize.height / 2);
+                    pageNode->addChild(createGlyphSprite(suitTexture, position));
+                }
+            }
+            drawNode->drawSolidRect(origin, Vec2(destination.x, origin.y + kBorderWidth), Color4F::WHITE);
+            drawNode->drawSolidRect(Vec2(origin.x, destination.y - kBorderWidth), destination, Color4F::WHITE);
+            drawNode->drawSolidRect(origin, Vec2(origin.x + kBorderWidth, destination.y), Color4F::WHITE);
+            drawNode->drawSolidRect(Vec2(destination.x - kBorderWidth, origin.y), destination, Color4F::WHITE);
+        }
+        
+        // 立即执行渲染命令，节点在这之后即可释放
+        renderTexture->beginWithClear(0.0f, 0.0f, 0.0f, 0.0f);
+        pageNode->visit();
+        renderTexture->end();
+        Director::getInstance()->getRenderer()->render();
+        
+        Texture2D* texture = renderTexture->getSprite()->getTexture();
+        for (const std::pair<int, Rect>& frame : frames) {
+            std::string frameName;
+            if (frame.first == CardAtlasLayout::kBackFrameIndex) {
+                frameName = CardResConfig::getCardBackTexture();
+            } else {
+                frameName = CardResConfig::getCardFrontTexture(
+                    static_cast<CardFaceType>(frame.first % CFT_NUM_CARD_FACE_TYPES),
+                    static_cast<CardSuitType>(frame.first / CFT_NUM_CARD_FACE_TYPES));
+            }
+            frameCache->addSpriteFrame(SpriteFrame::createWithTexture(texture, frame.second), frameName);
+        }
+        renderTexture->retain();
+        s_atlasPages.push_back(renderTexture);
+    }
+    
+    CCLOG("CardGlyphCache: Rendered card atlas at runtime (%d pages)", layout.getPageCount());
+    return true;
+}
+
+Texture2D* CardGlyphCache::createTextTexture(const std::string& text, float fontSize)
+{
+    Texture2D* texture = new (std::nothrow) Texture2D();
+    if (texture && texture->initWithString(text.c_str(), kGlyphFontName, fontSize)) {
+        return texture;
+    }
+    CC_SAFE_RELEASE(texture);
+    return nullptr;
+}
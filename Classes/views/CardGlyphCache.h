@@ -0,0 +1,50 @@
+#ifndef __CARD_GLYPH_CACHE_H__
+#define __CARD_GLYPH_CACHE_H__
+
+#include "cocos2d.h"
+#include "../utils/CardDefines.h"
+#include <vector>
+
+/**
+ * @class CardGlyphCache
+ * @brief 卡牌文字的字形缓存
+ * @details 13个牌面名称和4个花色符号每个进程只通过系统字体光栅化一次，保存为纹理供所有卡牌和关卡复用
+ *          没有构建时生成的卡牌图集（例如用cocos compile构建）时，用这些字形在运行时渲染一份
+ *          同样排布、同样帧名称的图集，卡牌视图的创建不再涉及文字，关卡开始的耗时与卡牌数量无关
+ */
+class CardGlyphCache
+{
+public:
+    /**
+     * @brief 获取牌面名称的字形纹理（第一次调用时光栅化）
+     * @param face 牌面类型
+     * @return 纹理，牌面无效时返回nullptr
+     */
+    static cocos2d::Texture2D* getFaceTexture(CardFaceType face);
+    
+    /**
+     * @brief 获取花色符号的字形纹理（第一次调用时光栅化）
+     * @param suit 花色类型
+     * @return 纹理，花色无效时返回nullptr
+     */
+    static cocos2d::Texture2D* getSuitTexture(CardSuitType suit);
+    
+    /**
+     * @brief 在运行时渲染卡牌图集，并以CardResConfig的纹理路径为名称加入SpriteFrameCache
+     * @details 排布与CardAtlasLayout相同；已渲染过时直接返回true
+     * @return 渲染失败时返回false
+     */
+    static bool renderCardAtlas();
+    
+private:
+    /**
+     * @brief 用系统字体把文字光栅化为纹理
+     */
+    static cocos2d::Texture2D* createTextTexture(const std::string& text, float fontSize);
+    
+    static cocos2d::Texture2D* s_faceTextures[CFT_NUM_CARD_FACE_TYPES];     // 牌面名称字形
+    static cocos2d::Texture2D* s_suitTextures[CST_NUM_CARD_SUIT_TYPES];     // 花色符号字形
+    static std::vector<cocos2d::RenderTexture*> s_atlasPages;               // 运行时渲染的图集页
+};
+
+#endif // __CARD_GLYPH_CACHE_H__
@@ -1,10 +1,33 @@
 #include "CardView.h"
+#include "CardGlyphCache.h"
+#include "../configs/models/CardAtlasLayout.h"
+#include "../utils/CardGeometry.h"
+#include "../utils/CardPositionConvert.h"
 
 USING_NS_CC;
 
-// 卡牌尺寸常量
-static const float kCardWidth = 120.0f;
-static const float kCardHeight = 168.0f;
+namespace {
+
+/**
+ * @brief 图集不可用时占位矩形的花色颜色
+ */
+Color3B getPlaceholderColor(CardSuitType suit)
+{
+    switch (suit) {
+        case CST_CLUBS:    return Color3B(51, 204, 51);     // 绿色
+        case CST_DIAMONDS: return Color3B(204, 51, 51);     // 红色
+        case CST_HEARTS:   return Color3B(204, 102, 153);   // 粉色
+        case CST_SPADES:   return Color3B(51, 51, 204);     // 蓝色
+        default:           return Color3B(128, 128, 128);   // 灰色
+    }
+}
+
+/**
+ * @brief 图集不可用时背面占位矩形的颜色（深蓝，和各花色的正面颜色区分开）
+ */
+const Color3B kBackPlaceholderColor(20, 30, 80);
+
+} // namespace
 
 CardView::CardView()
     : _cardId(-1)
@@ -12,17 +35,40 @@ CardView::CardView()
     , _suit(CST_NONE)
     , _isFlipped(false)
     , _isClickable(false)
-    , _clickCallback(nullptr)
-    , _touchListener(nullptr)
 {
 }
 
 CardView::~CardView()
 {
-    if (_touchListener) {
-        _eventDispatcher->removeEventListener(_touchListener);
-        _touchListener = nullptr;
+}
+
+bool CardView::s_cardAtlasLoaded = false;
+
+void CardView::loadCardAtlas()
+{
+    if (s_cardAtlasLoaded) {
+        return;
+    }
+    
+    auto fileUtils = FileUtils::getInstance();
+    auto frameCache = SpriteFrameCache::getInstance();
+    CardAtlasLayout layout(static_cast<int>(kCardWidth), static_cast<int>(kCardHeight));
+    bool loaded = layout.isValid();
+    for (int page = 0; page < layout.getPageCount(); page++) {
+        std::string plistPath = CardResConfig::getCardAtlasPlist(page);
+        if (!fileUtils->isFileExist(plistPath)) {
+            CCLOG("CardView: Card atlas not found: %s", plistPath.c_str());
+            loaded = false;
+            break;
+        }
+        frameCache->addSpriteFramesWithFile(plistPath);
+    }
+    
+    // 没有构建时生成的图集时，用字形缓存在运行时渲染一份同样帧名称的图集
+    if (!loaded) {
+        loaded = CardGlyphCache::renderCardAtlas();
     }
+    s_cardAtlasLoaded = loaded;
 }
 
 CardView* CardView::create(const CardModel* cardModel)
@@ -38,72 +84,27 @@ CardView* CardView::create(const CardModel* cardModel)
 
 bool CardView::init(const CardModel* cardModel)
 {
-    if (!cardModel) {
-        return false;
-    }
-    
-    // 初始化数据
-    _cardId = cardModel->getCardId();
-    _face = cardModel->getFace();
-    _suit = cardModel->getSuit();
-    _isFlipped = cardModel->isFlipped();
-    _isClickable = cardModel->isClickable();
-    
-    // 获取纹理路径
-    std::string texturePath;
-    if (_isFlipped) {
-        texturePath = CardResConfig::getCardFrontTexture(_face, _suit);
+    // 卡牌是单个图集精灵，没有子节点，所有卡牌共用一张纹理；先以背面初始化，再绑定卡牌
+    SpriteFrame* frame = getCardFrame(false);
+    if (frame) {
+        if (!Sprite::initWithSpriteFrame(frame)) {
+            return false;
+        }
     } else {
-        texturePath = CardResConfig::getCardBackTexture();
-    }
-    
-    // 初始化Sprite（使用纯色替代，因为暂无图片资源）
-    if (!Sprite::init()) {
-        return false;
+        // 图集不可用时用花色颜色的纯色矩形占位（共用引擎的白色纹理，同样可以合批）
+        if (!Sprite::init()) {
+            return false;
+        }
+        this->setTextureRect(Rect(0, 0, kCardWidth, kCardHeight));
     }
     
-    // 创建一个彩色矩形作为卡牌占位符
-    auto drawNode = DrawNode::create();
-    
-    // 根据花色设置不同颜色
-    Color4F cardColor;
-    switch (_suit) {
-        case CST_CLUBS:    cardColor = Color4F(0.2f, 0.8f, 0.2f, 1.0f); break; // 绿色
-        case CST_DIAMONDS: cardColor = Color4F(0.8f, 0.2f, 0.2f, 1.0f); break; // 红色
-        case CST_HEARTS:   cardColor = Color4F(0.8f, 0.4f, 0.6f, 1.0f); break; // 粉色
-        case CST_SPADES:   cardColor = Color4F(0.2f, 0.2f, 0.8f, 1.0f); break; // 蓝色
-        default:           cardColor = Color4F(0.5f, 0.5f, 0.5f, 1.0f); break; // 灰色
+    if (cardModel) {
+        updateDisplay(cardModel);
+        this->setPosition(toVec2(cardModel->getPosition()));
+    } else {
+        updateTexture(false);
     }
     
-    // 绘制卡牌矩形
-    Vec2 rect[4] = {
-        Vec2(0, 0),
-        Vec2(kCardWidth, 0),
-        Vec2(kCardWidth, kCardHeight),
-        Vec2(0, kCardHeight)
-    };
-    drawNode->drawSolidPoly(rect, 4, cardColor);
-    
-    // 添加边框
-    drawNode->drawPoly(rect, 4, true, Color4F::WHITE);
-    
-    // 添加牌面文字
-    auto label = Label::createWithSystemFont(
-        CardResConfig::getFaceName(_face), 
-        "Arial", 
-        40
-    );
-    label->setPosition(Vec2(kCardWidth/2, kCardHeight/2));
-    label->setColor(Color3B::WHITE);
-    drawNode->addChild(label);
-    
-    this->addChild(drawNode);
-    this->setContentSize(Size(kCardWidth, kCardHeight));
-    this->setPosition(cardModel->getPosition());
-    
-    // 初始化触摸监听器
-    initTouchListener();
-    
     return true;
 }
 
@@ -113,6 +114,9 @@ void CardView::updateDisplay(const CardModel* cardModel)
         return;
     }
     
+    _cardId = cardModel->getCardId();
+    _face = cardModel->getFace();
+    _suit = cardModel->getSuit();
     _isFlipped = cardModel->isFlipped();
     _isClickable = cardModel->isClickable();
     
@@ -120,100 +124,50 @@ void CardView::updateDisplay(const CardModel* cardModel)
     setClickable(_isClickable);
 }
 
-void CardView::setClickCallback(const CardClickCallback& callback)
+void CardView::unbind()
 {
-    _clickCallback = callback;
+    // 补间由GameView在回收前取消；外部挂在视图上的动作和定时回调在这里停掉，避免池中的视图继续运行
+    this->stopAllActions();
+    this->unscheduleAllCallbacks();
+    this->setScale(1.0f);
+    _cardId = -1;
+    setClickable(false);
 }
 
-void CardView::moveToPosition(const Vec2& targetPosition, float duration, 
-                              const std::function<void()>& callback)
+void CardView::showFace(bool showFront)
 {
-    auto moveTo = MoveTo::create(duration, targetPosition);
-    
-    if (callback) {
-        auto callFunc = CallFunc::create(callback);
-        auto sequence = Sequence::create(moveTo, callFunc, nullptr);
-        this->runAction(sequence);
-    } else {
-        this->runAction(moveTo);
-    }
-}
-
-void CardView::flipCard(bool showFront, float duration)
-{
-    // 简单的翻牌效果：缩放到0再恢复，中间切换纹理
-    auto scaleToZero = ScaleTo::create(duration / 2, 0.0f, 1.0f);
-    auto updateTexture = CallFunc::create([this, showFront]() {
-        this->updateTexture(showFront);
-    });
-    auto scaleBack = ScaleTo::create(duration / 2, 1.0f, 1.0f);
-    
-    auto sequence = Sequence::create(scaleToZero, updateTexture, scaleBack, nullptr);
-    this->runAction(sequence);
-    
     _isFlipped = showFront;
+    updateTexture(showFront);
 }
 
 void CardView::setClickable(bool clickable)
 {
     _isClickable = clickable;
-    
-    if (_touchListener) {
-        _touchListener->setEnabled(clickable);
-    }
 }
 
-void CardView::initTouchListener()
+void CardView::updateTexture(bool showFront)
 {
-    _touchListener = EventListenerTouchOneByOne::create();
-    _touchListener->setSwallowTouches(true);
-    
-    _touchListener->onTouchBegan = [this](Touch* touch, Event* event) -> bool {
-        if (!_isClickable) {
-            return false;
-        }
-        
-        // 检查触摸点是否在卡牌范围内
-        Vec2 locationInNode = this->convertToNodeSpace(touch->getLocation());
-        Size size = this->getContentSize();
-        Rect rect = Rect(0, 0, size.width, size.height);
-        
-        if (rect.containsPoint(locationInNode)) {
-            // 点击效果：稍微缩小
-            this->setScale(0.95f);
-            return true;
-        }
-        return false;
-    };
-    
-    _touchListener->onTouchEnded = [this](Touch* touch, Event* event) {
-        // 恢复原始大小
-        this->setScale(1.0f);
-        
-        // 触发点击回调
-        if (_clickCallback) {
-            _clickCallback(_cardId);
-        }
-    };
-    
-    _touchListener->onTouchCancelled = [this](Touch* touch, Event* event) {
-        // 恢复原始大小
-        this->setScale(1.0f);
-    };
-    
-    _eventDispatcher->addEventListenerWithSceneGraphPriority(_touchListener, this);
-    _touchListener->setEnabled(_isClickable);
+    // 切换图集中的帧，纹理不变，不影响合批
+    SpriteFrame* frame = getCardFrame(showFront);
+    if (frame) {
+        this->setSpriteFrame(frame);
+    } else {
+        this->setColor(showFront ? getPlaceholderColor(_suit) : kBackPlaceholderColor);
+    }
 }
 
-void CardView::updateTexture(bool showFront)
+SpriteFrame* CardView::getCardFrame(bool showFront) const
 {
-    std::string texturePath;
+    // 没有加载图集时不查找，避免每张卡牌都输出找不到帧的日志
+    if (!s_cardAtlasLoaded) {
+        return nullptr;
+    }
+    
+    std::string frameName;
     if (showFront) {
-        texturePath = CardResConfig::getCardFrontTexture(_face, _suit);
+        frameName = CardResConfig::getCardFrontTexture(_face, _suit);
     } else {
-        texturePath = CardResConfig::getCardBackTexture();
+        frameName = CardResConfig::getCardBackTexture();
     }
-    
-    // 尝试加载纹理（实际项目中需要资源文件）
-    // 这里暂时保持原样，等资源文件准备好后会自动加载
+    return SpriteFrameCache::getInstance()->getSpriteFrameByName(frameName);
 } 
\ No newline at end of file
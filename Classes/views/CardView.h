@@ -4,36 +4,37 @@
 #include "cocos2d.h"
 #include "../models/CardModel.h"
 #include "../configs/models/CardResConfig.h"
-#include <functional>
 
 /**
  * @class CardView
  * @brief 卡牌视图
- * @details UI视图层，负责单张卡牌的显示和交互
- *          可持有const类型的model指针，通过回调接口与Controller交互
+ * @details UI视图层，负责单张卡牌的显示
+ *          可持有const类型的model指针；触摸由GameView统一检测（CardHitGrid），
+ *          移动和翻牌动画由GameView的CardTweenSystem驱动，卡牌视图不注册触摸监听器也不运行动作
  */
 class CardView : public cocos2d::Sprite
 {
 public:
-    /**
-     * @brief 卡牌点击回调函数类型
-     */
-    using CardClickCallback = std::function<void(int cardId)>;
-    
     /**
      * @brief 创建卡牌视图
-     * @param cardModel 卡牌数据模型（const指针）
+     * @param cardModel 卡牌数据模型（const指针），为nullptr时创建未绑定卡牌的视图（对象池预热）
      * @return 卡牌视图指针
      */
     static CardView* create(const CardModel* cardModel);
     
     /**
      * @brief 初始化
-     * @param cardModel 卡牌数据模型（const指针）
+     * @param cardModel 卡牌数据模型（const指针），可以为nullptr
      * @return 是否初始化成功
      */
     bool init(const CardModel* cardModel);
     
+    /**
+     * @brief 加载卡牌图集（CardAtlasTool生成，没有时由CardGlyphCache在运行时渲染；已加载时跳过）
+     * @details 所有卡牌共用图集纹理，相邻绘制的卡牌由渲染器合批为一次绘制调用
+     */
+    static void loadCardAtlas();
+    
     /**
      * @brief 获取卡牌ID
      */
@@ -41,38 +42,34 @@ public:
     
     /**
      * @brief 更新卡牌显示（根据model的状态）
+     * @details 同时更新卡牌ID和牌面，对象池复用视图时用于绑定到另一张卡牌（不修改位置）
      * @param cardModel 卡牌数据模型
      */
     void updateDisplay(const CardModel* cardModel);
     
     /**
-     * @brief 设置卡牌点击回调
-     * @param callback 回调函数
-     */
-    void setClickCallback(const CardClickCallback& callback);
-    
-    /**
-     * @brief 执行移动到目标位置的动画
-     * @param targetPosition 目标位置
-     * @param duration 动画时长（秒）
-     * @param callback 动画完成回调
+     * @brief 解除与卡牌的绑定（放回对象池前调用）
+     * @details 停止动作和定时回调，恢复缩放并设为不可点击（补间由GameView取消）
      */
-    void moveToPosition(const cocos2d::Vec2& targetPosition, float duration, 
-                       const std::function<void()>& callback = nullptr);
+    void unbind();
     
     /**
-     * @brief 翻牌动画
+     * @brief 切换显示正面或背面（不播放动画，翻牌动画由GameView的补间系统在中点调用）
      * @param showFront 是否显示正面
-     * @param duration 动画时长（秒）
      */
-    void flipCard(bool showFront, float duration = 0.3f);
+    void showFace(bool showFront);
     
     /**
-     * @brief 设置是否可点击
+     * @brief 设置是否可点击（只记录状态，点击检测由GameView完成）
      * @param clickable 是否可点击
      */
     void setClickable(bool clickable);
     
+    /**
+     * @brief 是否可点击
+     */
+    bool isClickable() const { return _isClickable; }
+    
 private:
     /**
      * @brief 构造函数
@@ -85,15 +82,17 @@ private:
     virtual ~CardView();
     
     /**
-     * @brief 初始化触摸事件监听器
+     * @brief 更新卡牌纹理
+     * @param showFront 是否显示正面
      */
-    void initTouchListener();
+    void updateTexture(bool showFront);
     
     /**
-     * @brief 更新卡牌纹理
+     * @brief 获取卡牌在图集中的帧
      * @param showFront 是否显示正面
+     * @return 图集未加载时返回nullptr
      */
-    void updateTexture(bool showFront);
+    cocos2d::SpriteFrame* getCardFrame(bool showFront) const;
     
 private:
     int _cardId;                                    // 卡牌ID
@@ -101,8 +100,8 @@ private:
     CardSuitType _suit;                             // 花色类型
     bool _isFlipped;                                // 是否翻开
     bool _isClickable;                              // 是否可点击
-    CardClickCallback _clickCallback;               // 点击回调
-    cocos2d::EventListenerTouchOneByOne* _touchListener;  // 触摸监听器
+    
+    static bool s_cardAtlasLoaded;                  // 卡牌图集是否可用
 };
 
 #endif // __CARD_VIEW_H__ 
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "CardViewPool.h"
+#include "../utils/CardPositionConvert.h"
+
+USING_NS_CC;
+
+CardViewPool::CardViewPool()
+    : _hitCount(0)
+    , _missCount(0)
+    , _createdCount(0)
+{
+}
+
+CardViewPool::~CardViewPool()
+{
+    // cocos2d::Vector释放持有的引用
+    _freeViews.clear();
+}
+
+void CardViewPool::prewarm(int count)
+{
+    // 预热的视图按图集帧初始化，图集在第一次预热时加载
+    CardView::loadCardAtlas();
+    
+    while (getFreeCount() < count) {
+        CardView* cardView = CardView::create(nullptr);
+        if (!cardView) {
+            break;
+        }
+        _createdCount++;
+        _freeViews.pushBack(cardView);
+    }
+}
+
+CardView* CardViewPool::acquire(const CardModel* cardModel)
+{
+    if (!cardModel) {
+        return nullptr;
+    }
+    
+    if (_freeViews.empty()) {
+        _missCount++;
+        CardView* cardView = CardView::create(cardModel);
+        if (cardView) {
+            _createdCount++;
+        }
+        return cardView;
+    }
+    
+    // 池释放引用前先autorelease，和新建的视图一样由之后加入的父节点持有
+    _hitCount++;
+    CardView* cardView = _freeViews.back();
+    cardView->retain();
+    cardView->autorelease();
+    _freeViews.popBack();
+    cardView->updateDisplay(cardModel);
+    cardView->setPosition(toVec2(cardModel->getPosition()));
+    return cardView;
+}
+
+void CardViewPool::release(CardView* cardView)
+{
+    if (!cardView) {
+        return;
+    }
+    
+    cardView->unbind();
+    _freeViews.pushBack(cardView);
+    // 动作和定时回调已在unbind中停止，这里不cleanup，免得暂停调度器后复用时还要恢复
+    cardView->removeFromParentAndCleanup(false);
+}
+
+void CardViewPool::resetStats()
+{
+    _hitCount = 0;
+    _missCount = 0;
+}
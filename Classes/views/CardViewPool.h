@@ -0,0 +1,77 @@
+#ifndef __CARD_VIEW_POOL_H__
+#define __CARD_VIEW_POOL_H__
+
+#include "cocos2d.h"
+#include "CardView.h"
+
+/**
+ * @class CardViewPool
+ * @brief 卡牌视图对象池
+ * @details 由GameController持有，跨关卡复用卡牌视图：关卡结束时GameView把卡牌视图放回池中，
+ *          下一关取出后通过CardView::updateDisplay绑定到新的卡牌，避免每关重新创建精灵
+ */
+class CardViewPool
+{
+public:
+    /**
+     * @brief 构造函数
+     */
+    CardViewPool();
+    
+    /**
+     * @brief 析构函数（释放池中的视图）
+     */
+    ~CardViewPool();
+    
+    /**
+     * @brief 预先创建视图，使池中至少有count个空闲视图
+     * @param count 空闲视图数量
+     */
+    void prewarm(int count);
+    
+    /**
+     * @brief 取出一个视图并绑定到卡牌（池为空时新建）
+     * @param cardModel 卡牌数据模型
+     * @return 已绑定并设置好位置的视图（autorelease，由加入的父节点持有），失败时返回nullptr
+     */
+    CardView* acquire(const CardModel* cardModel);
+    
+    /**
+     * @brief 把视图放回池中（解除绑定并从父节点移除）
+     * @param cardView 卡牌视图
+     */
+    void release(CardView* cardView);
+    
+    /**
+     * @brief 获取空闲视图数量
+     */
+    int getFreeCount() const { return static_cast<int>(_freeViews.size()); }
+    
+    /**
+     * @brief 获取命中次数（取出时复用了空闲视图）
+     */
+    int getHitCount() const { return _hitCount; }
+    
+    /**
+     * @brief 获取未命中次数（取出时池为空，新建了视图）
+     */
+    int getMissCount() const { return _missCount; }
+    
+    /**
+     * @brief 获取池创建的视图总数（含预热）
+     */
+    int getCreatedCount() const { return _createdCount; }
+    
+    /**
+     * @brief 重置命中和未命中次数（例如进入新关卡时）
+     */
+    void resetStats();
+    
+private:
+    cocos2d::Vector<CardView*> _freeViews;  // 空闲视图（池持有引用）
+    int _hitCount;                          // 命中次数
+    int _missCount;                         // 未命中次数
+    int _createdCount;                      // 创建的视图总数
+};
+
+#endif // __CARD_VIEW_POOL_H__
@@ -1,4 +1,6 @@
 #include "GameView.h"
+#include "../utils/CardPositionConvert.h"
+#include "../utils/TraceProfiler.h"
 #include "ui/CocosGUI.h"
 
 USING_NS_CC;
@@ -13,9 +15,28 @@ static const float kTrayPosY = 400.0f;          // 底牌堆Y坐标（向上移
 static const float kStackPosY = 400.0f;         // 备用牌堆Y坐标（和底牌堆同高）
 static const float kUndoButtonPosY = 250.0f;    // 撤销按钮Y坐标（也向上移）
 
-GameView* GameView::create()
+// 卡牌绘制顺序 = 所在层的ZOrder * kLayerDrawOrderStride + 在层中加入的顺序
+static const int kLayerDrawOrderStride = 1 << 20;
+
+GameView::GameView()
+    : _cardViewPool(nullptr)
+    , _nextDrawOrder(0)
+    , _pressedCardId(-1)
+    , _playfieldLayer(nullptr)
+    , _trayLayer(nullptr)
+    , _stackLayer(nullptr)
+    , _undoButton(nullptr)
+    , _redoButton(nullptr)
+    , _stackSprite(nullptr)
+{
+}
+
+GameView* GameView::create(CardViewPool* cardViewPool)
 {
     GameView* view = new (std::nothrow) GameView();
+    if (view) {
+        view->_cardViewPool = cardViewPool;
+    }
     if (view && view->init()) {
         view->autorelease();
         return view;
@@ -30,32 +51,37 @@ bool GameView::init()
         return false;
     }
     
+    CardView::loadCardAtlas();
+    
     // 创建各个区域
     createPlayfieldArea();
     createTrayArea();
     createStackArea();
     createUIButtons();
+    createCardTouchListener();
+    
+    // 每帧推进卡牌补间
+    this->scheduleUpdate();
     
     return true;
 }
 
 void GameView::initGameView(const GameModel* gameModel)
 {
+    TRACE_ZONE("GameView::initGameView");
+    
     if (!gameModel) {
         return;
     }
     
     // 清空现有卡牌视图
-    for (auto& pair : _cardViews) {
-        pair.second->removeFromParent();
-    }
-    _cardViews.clear();
+    recycleCardViews();
+    int cardCount = static_cast<int>(gameModel->getAllCards().size());
+    _cardTweens.reserve(cardCount, cardCount);
     
-    // 创建所有卡牌视图
-    const auto& allCards = gameModel->getAllCards();
-    for (const auto& pair : allCards) {
-        const CardModel* cardModel = pair.second;
-        CardView* cardView = CardView::create(cardModel);
+    // 创建所有卡牌视图（有对象池时复用上一关的视图）
+    for (const CardModel* cardModel : gameModel->getAllCards()) {
+        CardView* cardView = _cardViewPool ? _cardViewPool->acquire(cardModel) : CardView::create(cardModel);
         
         if (cardView) {
             _cardViews[cardModel->getCardId()] = cardView;
@@ -76,17 +102,44 @@ void GameView::initGameView(const GameModel* gameModel)
                 default:
                     break;
             }
-            
-            // 设置卡牌点击回调
-            cardView->setClickCallback([this](int cardId) {
-                if (_cardClickCallback) {
-                    _cardClickCallback(cardId);
-                }
-            });
+            addCardToHitGrid(cardView);
         }
     }
 }
 
+void GameView::update(float dt)
+{
+    if (_cardTweens.size() == 0) {
+        return;
+    }
+    TRACE_ZONE("GameView::update");
+    
+    // 一次遍历推进并应用所有补间，本帧完成的补间应用最终值后移除
+    _cardTweens.update(dt);
+    for (const CardTween& tween : _cardTweens.getTweens()) {
+        CardView* cardView = getCardView(tween.cardId);
+        if (!cardView) {
+            continue;
+        }
+        if (tween.moveState != CTS_NONE) {
+            cardView->setPosition(toVec2(tween.position));
+        }
+        if (tween.flipState != CTS_NONE) {
+            if (tween.faceSwitchedThisFrame) {
+                cardView->showFace(tween.showFront);
+            }
+            cardView->setScaleX(tween.scaleX);
+        }
+    }
+    
+    // 完成回调在补间数组更新之后执行，回调中可以开始新的动画
+    _finishedTweenCallbacks.clear();
+    _cardTweens.removeFinished(&_finishedTweenCallbacks);
+    for (const CardTweenSystem::CompleteCallback& callback : _finishedTweenCallbacks) {
+        callback();
+    }
+}
+
 CardView* GameView::getCardView(int cardId) const
 {
     auto it = _cardViews.find(cardId);
@@ -96,6 +149,15 @@ CardView* GameView::getCardView(int cardId) const
     return nullptr;
 }
 
+void GameView::setCardClickable(int cardId, bool clickable)
+{
+    CardView* cardView = getCardView(cardId);
+    if (cardView) {
+        cardView->setClickable(clickable);
+        _cardHitGrid.setClickable(cardId, clickable);
+    }
+}
+
 void GameView::setCardClickCallback(const CardClickCallback& callback)
 {
     _cardClickCallback = callback;
@@ -111,12 +173,20 @@ void GameView::setUndoButtonClickCallback(const UndoButtonClickCallback& callbac
     _undoButtonClickCallback = callback;
 }
 
+void GameView::setRedoButtonClickCallback(const RedoButtonClickCallback& callback)
+{
+    _redoButtonClickCallback = callback;
+}
+
 void GameView::playCardMoveAnimation(int cardId, const Vec2& targetPosition, 
                                      float duration, const std::function<void()>& callback)
 {
     CardView* cardView = getCardView(cardId);
     if (cardView) {
-        cardView->moveToPosition(targetPosition, duration, callback);
+        // 模型已在目标位置，点击检测立即按目标位置进行
+        _cardHitGrid.moveCard(cardId, toCardPosition(targetPosition));
+        _cardTweens.moveTo(cardId, toCardPosition(cardView->getPosition()), toCardPosition(targetPosition),
+                           duration, callback);
     }
 }
 
@@ -127,7 +197,16 @@ void GameView::playMatchAnimation(int fromCardId, int toCardId, const std::funct
     
     if (fromCard && toCard) {
         Vec2 targetPos = toCard->getPosition();
-        fromCard->moveToPosition(targetPos, 0.3f, callback);
+        _cardHitGrid.moveCard(fromCardId, toCardPosition(targetPos));
+        _cardTweens.moveTo(fromCardId, toCardPosition(fromCard->getPosition()), toCardPosition(targetPos),
+                           0.3f, callback);
+    }
+}
+
+void GameView::playCardFlipAnimation(int cardId, bool showFront, float duration)
+{
+    if (getCardView(cardId)) {
+        _cardTweens.flip(cardId, showFront, duration);
     }
 }
 
@@ -139,15 +218,45 @@ void GameView::updateUndoButton(bool enabled)
     }
 }
 
+void GameView::updateRedoButton(bool enabled)
+{
+    if (_redoButton) {
+        _redoButton->setEnabled(enabled);
+        _redoButton->setBright(enabled);
+    }
+}
+
 void GameView::removeCardView(int cardId)
 {
     auto it = _cardViews.find(cardId);
     if (it != _cardViews.end()) {
-        it->second->removeFromParent();
+        _cardHitGrid.removeCard(cardId);
+        _cardTweens.cancel(cardId);
+        if (_cardViewPool) {
+            _cardViewPool->release(it->second);
+        } else {
+            it->second->removeFromParent();
+        }
         _cardViews.erase(it);
     }
 }
 
+void GameView::recycleCardViews()
+{
+    _cardTweens.clear();
+    for (auto& pair : _cardViews) {
+        if (_cardViewPool) {
+            _cardViewPool->release(pair.second);
+        } else {
+            pair.second->removeFromParent();
+        }
+    }
+    _cardViews.clear();
+    _cardHitGrid.clear();
+    _nextDrawOrder = 0;
+    _pressedCardId = -1;
+}
+
 void GameView::createPlayfieldArea()
 {
     _playfieldLayer = Layer::create();
@@ -186,7 +295,8 @@ void GameView::createStackArea()
     drawNode->addChild(label);
     
     drawNode->setPosition(stackPos);
-    _stackLayer->addChild(drawNode);
+    // 牌堆底座画在所有卡牌层下面，卡牌的绘制之间没有其他节点，可以合批
+    this->addChild(drawNode, 0);
     _stackSprite = drawNode;
     
     // 添加触摸监听器
@@ -231,6 +341,18 @@ void GameView::createUIButtons()
         }
     });
     this->addChild(_undoButton, 10);
+    
+    // 创建重做按钮（撤销按钮左侧）
+    _redoButton = ui::Button::create();
+    _redoButton->setTitleText("Redo");
+    _redoButton->setTitleFontSize(32);
+    _redoButton->setPosition(Vec2(kDesignWidth - 250, kUndoButtonPosY));
+    _redoButton->addClickEventListener([this](Ref* sender) {
+        if (_redoButtonClickCallback) {
+            _redoButtonClickCallback();
+        }
+    });
+    this->addChild(_redoButton, 10);
 }
 
 Vec2 GameView::getTrayPosition() const
@@ -243,4 +365,63 @@ Vec2 GameView::getStackPosition() const
 {
     // 备用牌堆位置：屏幕中央
     return Vec2(kDesignWidth / 2, kStackPosY);
-} 
\ No newline at end of file
+} 
+
+void GameView::createCardTouchListener()
+{
+    // 挂在主牌区层上：按钮和备用牌堆底座的监听器按绘制顺序各自处理，卡牌之间的遮挡由索引判断
+    auto listener = EventListenerTouchOneByOne::create();
+    listener->setSwallowTouches(true);
+    
+    listener->onTouchBegan = [this](Touch* touch, Event* event) -> bool {
+        // 各区域层都在原点，卡牌坐标即GameView坐标
+        Vec2 location = this->convertToNodeSpace(touch->getLocation());
+        int cardId = _cardHitGrid.findTopmostClickable(toCardPosition(location));
+        CardView* cardView = getCardView(cardId);
+        if (!cardView) {
+            return false;
+        }
+        
+        // 点击效果：稍微缩小
+        cardView->setScale(0.95f);
+        _pressedCardId = cardId;
+        return true;
+    };
+    
+    listener->onTouchEnded = [this](Touch* touch, Event* event) {
+        int cardId = _pressedCardId;
+        _pressedCardId = -1;
+        CardView* cardView = getCardView(cardId);
+        if (!cardView) {
+            return;
+        }
+        
+        // 恢复原始大小并触发点击回调
+        cardView->setScale(1.0f);
+        if (_cardClickCallback) {
+            _cardClickCallback(cardId);
+        }
+    };
+    
+    listener->onTouchCancelled = [this](Touch* touch, Event* event) {
+        CardView* cardView = getCardView(_pressedCardId);
+        if (cardView) {
+            cardView->setScale(1.0f);
+        }
+        _pressedCardId = -1;
+    };
+    
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, _playfieldLayer);
+}
+
+void GameView::addCardToHitGrid(CardView* cardView)
+{
+    Node* layer = cardView->getParent();
+    if (!layer) {
+        return;
+    }
+    
+    int drawOrder = layer->getLocalZOrder() * kLayerDrawOrderStride + _nextDrawOrder++;
+    _cardHitGrid.setCard(cardView->getCardId(), toCardPosition(cardView->getPosition()), drawOrder,
+                         cardView->isClickable());
+}
\ No newline at end of file
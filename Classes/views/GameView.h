@@ -4,7 +4,10 @@
 #include "cocos2d.h"
 #include "ui/CocosGUI.h"
 #include "CardView.h"
+#include "CardViewPool.h"
 #include "../models/GameModel.h"
+#include "../utils/CardHitGrid.h"
+#include "../utils/CardTweenSystem.h"
 #include <map>
 #include <functional>
 
@@ -13,6 +16,9 @@
  * @brief 游戏主视图
  * @details 管理整个游戏界面，包括主牌区、底牌堆、备用牌堆和UI按钮
  *          可持有const类型的model指针，通过回调接口与Controller交互
+ *          卡牌的点击由一个触摸监听器统一处理：卡牌矩形按绘制顺序登记在CardHitGrid中，
+ *          触摸点只检查所在格子中没有被完全盖住的卡牌，取最上面一张包含该点的卡牌（不可点击时忽略这次触摸）
+ *          卡牌的移动和翻牌动画由CardTweenSystem每帧统一推进，不为每次动画创建动作对象
  */
 class GameView : public cocos2d::Layer
 {
@@ -32,11 +38,17 @@ public:
      */
     using UndoButtonClickCallback = std::function<void()>;
     
+    /**
+     * @brief 重做按钮点击回调函数类型
+     */
+    using RedoButtonClickCallback = std::function<void()>;
+    
     /**
      * @brief 创建游戏视图
+     * @param cardViewPool 卡牌视图对象池（由调用者持有，生命周期长于GameView；为nullptr时不复用卡牌视图）
      * @return 游戏视图指针
      */
-    static GameView* create();
+    static GameView* create(CardViewPool* cardViewPool = nullptr);
     
     /**
      * @brief 初始化
@@ -44,6 +56,12 @@ public:
      */
     virtual bool init() override;
     
+    /**
+     * @brief 每帧推进卡牌补间并应用到卡牌视图
+     * @param dt 帧间隔（秒）
+     */
+    virtual void update(float dt) override;
+    
     /**
      * @brief 初始化游戏视图（从GameModel）
      * @param gameModel 游戏数据模型
@@ -57,6 +75,13 @@ public:
      */
     CardView* getCardView(int cardId) const;
     
+    /**
+     * @brief 设置卡牌是否可点击（同步卡牌视图和点击检测索引）
+     * @param cardId 卡牌ID
+     * @param clickable 是否可点击
+     */
+    void setCardClickable(int cardId, bool clickable);
+    
     /**
      * @brief 设置卡牌点击回调
      * @param callback 回调函数
@@ -75,8 +100,15 @@ public:
      */
     void setUndoButtonClickCallback(const UndoButtonClickCallback& callback);
     
+    /**
+     * @brief 设置重做按钮点击回调
+     * @param callback 回调函数
+     */
+    void setRedoButtonClickCallback(const RedoButtonClickCallback& callback);
+    
     /**
      * @brief 播放卡牌移动动画
+     * @details 卡牌正在移动时从当前位置改为移向新的目标位置，旧的完成回调不再调用
      * @param cardId 卡牌ID
      * @param targetPosition 目标位置
      * @param duration 动画时长
@@ -93,18 +125,37 @@ public:
      */
     void playMatchAnimation(int fromCardId, int toCardId, const std::function<void()>& callback = nullptr);
     
+    /**
+     * @brief 播放翻牌动画（横向缩放到0，切换牌面，再恢复）
+     * @param cardId 卡牌ID
+     * @param showFront 是否显示正面
+     * @param duration 动画时长
+     */
+    void playCardFlipAnimation(int cardId, bool showFront, float duration = 0.3f);
+    
     /**
      * @brief 更新撤销按钮状态
      * @param enabled 是否启用
      */
     void updateUndoButton(bool enabled);
     
+    /**
+     * @brief 更新重做按钮状态
+     * @param enabled 是否启用
+     */
+    void updateRedoButton(bool enabled);
+    
     /**
      * @brief 移除卡牌视图
      * @param cardId 卡牌ID
      */
     void removeCardView(int cardId);
     
+    /**
+     * @brief 移除所有卡牌视图（有对象池时放回池中，供下一关复用）
+     */
+    void recycleCardViews();
+    
     /**
      * @brief 获取底牌堆位置
      */
@@ -116,6 +167,11 @@ public:
     cocos2d::Vec2 getStackPosition() const;
     
 private:
+    /**
+     * @brief 构造函数
+     */
+    GameView();
+    
     /**
      * @brief 创建主牌区
      */
@@ -136,17 +192,36 @@ private:
      */
     void createUIButtons();
     
+    /**
+     * @brief 创建卡牌的触摸监听器（挂在主牌区层上，所有卡牌共用一个）
+     */
+    void createCardTouchListener();
+    
+    /**
+     * @brief 把卡牌登记到点击检测索引（在卡牌加入所在层之后调用）
+     * @param cardView 卡牌视图
+     */
+    void addCardToHitGrid(CardView* cardView);
+    
 private:
     std::map<int, CardView*> _cardViews;        // 所有卡牌视图的映射表
+    CardViewPool* _cardViewPool;                // 卡牌视图对象池（不持有，可以为nullptr）
+    CardHitGrid _cardHitGrid;                   // 卡牌点击检测索引（GameView坐标）
+    int _nextDrawOrder;                         // 下一张加入的卡牌在所在层中的绘制顺序
+    int _pressedCardId;                         // 正在按下的卡牌ID（没有时为-1）
+    CardTweenSystem _cardTweens;                // 卡牌补间
+    std::vector<CardTweenSystem::CompleteCallback> _finishedTweenCallbacks;  // 本帧完成的移动回调（复用）
     cocos2d::Layer* _playfieldLayer;            // 主牌区层
     cocos2d::Layer* _trayLayer;                 // 底牌堆层
     cocos2d::Layer* _stackLayer;                // 备用牌堆层
     cocos2d::ui::Button* _undoButton;           // 撤销按钮
+    cocos2d::ui::Button* _redoButton;           // 重做按钮
     cocos2d::Node* _stackSprite;                // 备用牌堆节点（可点击）
     
     CardClickCallback _cardClickCallback;       // 卡牌点击回调
     StackClickCallback _stackClickCallback;     // 备用牌堆点击回调
     UndoButtonClickCallback _undoButtonClickCallback;  // 撤销按钮点击回调
+    RedoButtonClickCallback _redoButtonClickCallback;  // 重做按钮点击回调
 };
 
 #endif // __GAME_VIEW_H__ 
\ No newline at end of file
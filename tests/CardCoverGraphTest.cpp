@@ -0,0 +1,279 @@
+#include "models/CardCoverGraph.h"
+#include "managers/UndoManager.h"
+#include "configs/models/LevelLayoutTemplate.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "services/GameRulesService.h"
+#include "services/ProceduralLevelGenerator.h"
+#include "utils/CardGeometry.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// 遮挡关系与逐对检查矩形重叠的结果一致：构建出的边、卡牌离开/回到主牌区后的遮挡状态和变化列表、
+// 从压缩邻接表恢复；在GameModel上随机走牌和撤销时可点击状态与重新计算的结果一致，被压住的卡牌不能匹配
+
+namespace {
+
+const CardPosition kTrayPosition(540.0f, 300.0f);
+
+struct CoverFixture
+{
+    std::vector<int> cardIds;               // 按绘制顺序
+    std::vector<CardPosition> positions;
+};
+
+/**
+ * 随机卡牌：ID打乱且不连续，坐标落在半张牌的网格上，既有重叠也有恰好接触边缘的卡牌
+ */
+CoverFixture createRandomCards(unsigned int seed, int cardCount)
+{
+    std::mt19937 random(seed);
+    CoverFixture fixture;
+    for (int i = 0; i < cardCount; i++) {
+        fixture.cardIds.push_back(i * 2 + 1);
+        float x = 100.0f + (random() % 12) * kCardWidth * 0.5f;
+        float y = 200.0f + (random() % 10) * kCardHeight * 0.5f;
+        fixture.positions.push_back(CardPosition(x, y));
+    }
+    std::shuffle(fixture.cardIds.begin(), fixture.cardIds.end(), random);
+    return fixture;
+}
+
+// 第i张卡牌直接压住的卡牌：绘制顺序在它之前且矩形重叠
+std::vector<int> bruteForceCovered(const CoverFixture& fixture, size_t index)
+{
+    std::vector<int> covered;
+    CardRect rect = makeCardRect(fixture.positions[index]);
+    for (size_t i = 0; i < index; i++) {
+        if (rect.intersects(makeCardRect(fixture.positions[i]))) {
+            covered.push_back(fixture.cardIds[i]);
+        }
+    }
+    std::sort(covered.begin(), covered.end());
+    return covered;
+}
+
+// 第i张卡牌是否被之后绘制的在场卡牌压住
+bool bruteForceIsCovered(const CoverFixture& fixture, const std::vector<char>& present, size_t index)
+{
+    CardRect rect = makeCardRect(fixture.positions[index]);
+    for (size_t i = index + 1; i < fixture.cardIds.size(); i++) {
+        if (present[i] && rect.intersects(makeCardRect(fixture.positions[i]))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<int> coveredCards(const CardCoverGraph& graph, int cardId)
+{
+    const int* begin = nullptr;
+    const int* end = nullptr;
+    graph.getCoveredCards(cardId, &begin, &end);
+    std::vector<int> covered(begin, end);
+    std::sort(covered.begin(), covered.end());
+    return covered;
+}
+
+std::vector<int> sorted(std::vector<int> cardIds)
+{
+    std::sort(cardIds.begin(), cardIds.end());
+    return cardIds;
+}
+
+GameModel* createGame(int seed)
+{
+    LevelLayoutTemplate layout;
+    if (!layout.initPeaks(3, 3, 16)) {
+        return nullptr;
+    }
+    LevelConfig* levelConfig = ProceduralLevelGenerator::generateLevelConfig(layout, seed, 0.5f);
+    if (!levelConfig) {
+        return nullptr;
+    }
+    GameModel* gameModel = GameModelFromLevelGenerator::generateGameModel(levelConfig);
+    delete levelConfig;
+    return gameModel;
+}
+
+} // namespace
+
+TEST(CardCoverGraphTest, BuildMatchesPairwiseOverlap)
+{
+    for (unsigned int seed = 1; seed <= 20; seed++) {
+        SCOPED_TRACE(seed);
+        CoverFixture fixture = createRandomCards(seed, 60);
+        CardCoverGraph graph;
+        graph.build(fixture.cardIds, fixture.positions);
+        
+        int edgeCount = 0;
+        std::vector<char> present(fixture.cardIds.size(), 1);
+        for (size_t i = 0; i < fixture.cardIds.size(); i++) {
+            int cardId = fixture.cardIds[i];
+            EXPECT_EQ(static_cast<int>(i), graph.getDrawRank(cardId));
+            EXPECT_TRUE(graph.isPresent(cardId));
+            std::vector<int> expected = bruteForceCovered(fixture, i);
+            EXPECT_EQ(expected, coveredCards(graph, cardId));
+            EXPECT_EQ(bruteForceIsCovered(fixture, present, i), graph.isCovered(cardId));
+            edgeCount += static_cast<int>(expected.size());
+        }
+        EXPECT_EQ(edgeCount, graph.getEdgeCount());
+        EXPECT_EQ(fixture.cardIds, graph.getDrawOrder());
+        EXPECT_FALSE(graph.contains(0));
+        EXPECT_EQ(-1, graph.getDrawRank(0));
+    }
+}
+
+TEST(CardCoverGraphTest, EdgeContactIsNotCover)
+{
+    CardCoverGraph graph;
+    std::vector<int> cardIds = { 0, 1, 2 };
+    std::vector<CardPosition> positions = {
+        CardPosition(100.0f, 100.0f),
+        CardPosition(100.0f + kCardWidth, 100.0f),
+        CardPosition(100.0f + kCardWidth - 1.0f, 100.0f + kCardHeight - 1.0f)
+    };
+    graph.build(cardIds, positions);
+    EXPECT_TRUE(coveredCards(graph, 1).empty());
+    EXPECT_EQ((std::vector<int>{ 0, 1 }), coveredCards(graph, 2));
+    EXPECT_TRUE(graph.isCovered(0));
+    EXPECT_TRUE(graph.isCovered(1));
+    EXPECT_FALSE(graph.isCovered(2));
+}
+
+TEST(CardCoverGraphTest, RemoveAndRestoreMatchRecompute)
+{
+    for (unsigned int seed = 1; seed <= 20; seed++) {
+        SCOPED_TRACE(seed);
+        CoverFixture fixture = createRandomCards(seed, 40);
+        CardCoverGraph graph;
+        graph.build(fixture.cardIds, fixture.positions);
+        std::vector<char> present(fixture.cardIds.size(), 1);
+        std::mt19937 random(seed);
+        
+        for (int step = 0; step < 300; step++) {
+            size_t index = random() % fixture.cardIds.size();
+            int cardId = fixture.cardIds[index];
+            
+            // 变化列表须恰好是遮挡状态改变的在场卡牌
+            std::vector<char> coveredBefore(fixture.cardIds.size(), 0);
+            for (size_t i = 0; i < fixture.cardIds.size(); i++) {
+                coveredBefore[i] = bruteForceIsCovered(fixture, present, i);
+            }
+            std::vector<int> changed;
+            if (present[index]) {
+                graph.removeCard(cardId, &changed);
+                present[index] = 0;
+            } else {
+                graph.restoreCard(cardId, &changed);
+                present[index] = 1;
+            }
+            
+            std::vector<int> expectedChanged;
+            for (size_t i = 0; i < fixture.cardIds.size(); i++) {
+                bool covered = bruteForceIsCovered(fixture, present, i);
+                EXPECT_EQ(present[i] != 0, graph.isPresent(fixture.cardIds[i]));
+                EXPECT_EQ(covered, graph.isCovered(fixture.cardIds[i]));
+                if (present[i] && i != index && covered != (coveredBefore[i] != 0)) {
+                    expectedChanged.push_back(fixture.cardIds[i]);
+                }
+            }
+            EXPECT_EQ(sorted(expectedChanged), sorted(changed));
+        }
+        
+        // 重复移除或恢复不改变状态
+        int cardId = fixture.cardIds.front();
+        std::vector<int> changed;
+        graph.restoreCard(cardId, nullptr);
+        graph.restoreCard(cardId, &changed);
+        EXPECT_TRUE(changed.empty());
+        EXPECT_TRUE(graph.isPresent(cardId));
+        graph.removeCard(cardId, nullptr);
+        graph.removeCard(cardId, &changed);
+        EXPECT_TRUE(changed.empty());
+        EXPECT_FALSE(graph.isPresent(cardId));
+    }
+}
+
+TEST(CardCoverGraphTest, RestoreFromAdjacencyMatchesBuild)
+{
+    CoverFixture fixture = createRandomCards(9, 50);
+    CardCoverGraph graph;
+    graph.build(fixture.cardIds, fixture.positions);
+    
+    CardCoverGraph restored;
+    const std::vector<int>& offsets = graph.getCoveredOffsets();
+    const std::vector<int>& coveredIds = graph.getCoveredIds();
+    ASSERT_TRUE(restored.restore(graph.getDrawOrder().data(), static_cast<int>(graph.getDrawOrder().size()),
+                                 offsets.data(), static_cast<int>(offsets.size()) - 1,
+                                 coveredIds.data(), graph.getEdgeCount()));
+    for (int cardId : fixture.cardIds) {
+        EXPECT_EQ(graph.getDrawRank(cardId), restored.getDrawRank(cardId));
+        EXPECT_EQ(coveredCards(graph, cardId), coveredCards(restored, cardId));
+        EXPECT_EQ(graph.isCovered(cardId), restored.isCovered(cardId));
+    }
+    
+    // 边引用图外的卡牌时拒绝恢复
+    std::vector<int> badCoveredIds = coveredIds;
+    ASSERT_FALSE(badCoveredIds.empty());
+    badCoveredIds[0] = 0;
+    EXPECT_FALSE(restored.restore(graph.getDrawOrder().data(), static_cast<int>(graph.getDrawOrder().size()),
+                                  offsets.data(), static_cast<int>(offsets.size()) - 1,
+                                  badCoveredIds.data(), graph.getEdgeCount()));
+}
+
+TEST(CardCoverGraphTest, GameModelClickableMatchesRecompute)
+{
+    for (int seed = 1; seed <= 10; seed++) {
+        SCOPED_TRACE(seed);
+        GameModel* gameModel = createGame(seed);
+        ASSERT_NE(nullptr, gameModel);
+        UndoModel undoModel;
+        UndoManager undoManager;
+        undoManager.init(&undoModel);
+        std::mt19937 random(seed);
+        
+        // 发牌时的绘制顺序和位置（卡牌离开主牌区后位置会变，用发牌位置重新计算）
+        CoverFixture fixture;
+        fixture.cardIds = gameModel->getCoverGraph().getDrawOrder();
+        for (int cardId : fixture.cardIds) {
+            fixture.positions.push_back(gameModel->getCardById(cardId)->getHomePosition());
+        }
+        
+        for (int step = 0; step < 80; step++) {
+            std::vector<char> present(fixture.cardIds.size(), 0);
+            for (size_t i = 0; i < fixture.cardIds.size(); i++) {
+                present[i] = gameModel->getCardById(fixture.cardIds[i])->getLocation() == CL_PLAYFIELD;
+            }
+            for (size_t i = 0; i < fixture.cardIds.size(); i++) {
+                if (!present[i]) {
+                    continue;
+                }
+                int cardId = fixture.cardIds[i];
+                bool covered = bruteForceIsCovered(fixture, present, i);
+                EXPECT_EQ(covered, gameModel->isCardCovered(cardId));
+                EXPECT_EQ(!covered, gameModel->getCardById(cardId)->isClickable());
+                if (covered) {
+                    EXPECT_FALSE(GameRulesService::canMatchWithTray(gameModel, cardId));
+                }
+            }
+            
+            std::vector<int> matchable;
+            gameModel->getMatchableCardIds(&matchable);
+            UndoAction action;
+            if (undoManager.canUndo() && random() % 4 == 0) {
+                ASSERT_TRUE(undoManager.performUndo(gameModel));
+            } else if (!matchable.empty()) {
+                int cardId = matchable[random() % matchable.size()];
+                ASSERT_TRUE(GameRulesService::replaceTrayFromPlayfield(gameModel, cardId, kTrayPosition, &action));
+                undoManager.recordAction(action);
+            } else if (GameRulesService::replaceTrayFromStack(gameModel, kTrayPosition, &action)) {
+                undoManager.recordAction(action);
+            } else {
+                break;
+            }
+        }
+        delete gameModel;
+    }
+}
@@ -0,0 +1,74 @@
+#include "utils/CardHitGrid.h"
+#include <gtest/gtest.h>
+
+// 点击检测只看触摸点处最上面的卡牌：不可点击时不向下查找；
+// 格子内被完全盖住的卡牌不参与查找，上面的卡牌移走或移除后重新可以点到
+
+namespace {
+
+const CardPosition kPileCenter(300.0f, 500.0f);
+
+} // namespace
+
+TEST(CardHitGridTest, TopmostCardWins)
+{
+    CardHitGrid grid;
+    grid.setCard(1, kPileCenter, 0, true);
+    grid.setCard(2, CardPosition(kPileCenter.x + 40.0f, kPileCenter.y), 1, true);
+    
+    // 重叠区域返回上面的卡牌，只露出下面卡牌的部分返回下面的卡牌
+    EXPECT_EQ(2, grid.findTopmostClickable(CardPosition(kPileCenter.x + 10.0f, kPileCenter.y)));
+    EXPECT_EQ(1, grid.findTopmostClickable(CardPosition(kPileCenter.x - 50.0f, kPileCenter.y)));
+    EXPECT_EQ(-1, grid.findTopmostClickable(CardPosition(kPileCenter.x + 200.0f, kPileCenter.y)));
+}
+
+TEST(CardHitGridTest, UnclickableTopCardBlocksCardsBeneath)
+{
+    CardHitGrid grid;
+    grid.setCard(1, kPileCenter, 0, true);
+    grid.setCard(2, CardPosition(kPileCenter.x + 40.0f, kPileCenter.y), 1, false);
+    
+    EXPECT_EQ(-1, grid.findTopmostClickable(CardPosition(kPileCenter.x + 10.0f, kPileCenter.y)));
+    EXPECT_EQ(1, grid.findTopmostClickable(CardPosition(kPileCenter.x - 50.0f, kPileCenter.y)));
+    
+    grid.setClickable(2, true);
+    EXPECT_EQ(2, grid.findTopmostClickable(CardPosition(kPileCenter.x + 10.0f, kPileCenter.y)));
+}
+
+TEST(CardHitGridTest, PileRevealsNextCardWhenTopIsRemoved)
+{
+    // 叠在同一位置的牌堆：只有最上面一张可以点到
+    CardHitGrid grid;
+    const int pileSize = 200;
+    for (int i = 0; i < pileSize; i++) {
+        grid.setCard(i, kPileCenter, i, true);
+    }
+    EXPECT_EQ(pileSize - 1, grid.findTopmostClickable(kPileCenter));
+    EXPECT_EQ(-1, grid.findTopmostClickable(CardPosition(kPileCenter.x + 100.0f, kPileCenter.y)));
+    
+    // 移除或移走上面的卡牌后，下面被盖住的卡牌重新可以点到
+    grid.removeCard(pileSize - 1);
+    EXPECT_EQ(pileSize - 2, grid.findTopmostClickable(kPileCenter));
+    grid.moveCard(pileSize - 2, CardPosition(kPileCenter.x + 500.0f, kPileCenter.y));
+    EXPECT_EQ(pileSize - 3, grid.findTopmostClickable(kPileCenter));
+    EXPECT_EQ(pileSize - 2, grid.findTopmostClickable(CardPosition(kPileCenter.x + 500.0f, kPileCenter.y)));
+    
+    // 被盖住时修改的可点击状态在露出后生效
+    grid.setClickable(pileSize - 4, false);
+    grid.removeCard(pileSize - 3);
+    EXPECT_EQ(-1, grid.findTopmostClickable(kPileCenter));
+    EXPECT_EQ(pileSize - 2, grid.size());
+}
+
+TEST(CardHitGridTest, StaggeredLayersKeepEdgesClickable)
+{
+    // 每层错开一点的卡牌：被盖住的部分点不到，露出的边缘仍然可以点到
+    CardHitGrid grid;
+    for (int layer = 0; layer < 8; layer++) {
+        grid.setCard(layer, CardPosition(kPileCenter.x + layer * 15.0f, kPileCenter.y), layer, true);
+    }
+    for (int layer = 0; layer < 8; layer++) {
+        float edgeX = kPileCenter.x - kCardWidth * 0.5f + layer * 15.0f + 5.0f;
+        EXPECT_EQ(layer, grid.findTopmostClickable(CardPosition(edgeX, kPileCenter.y)));
+    }
+}
@@ -0,0 +1,370 @@
+#include "models/GameModel.h"
+#include "managers/UndoManager.h"
+#include "configs/models/LevelLayoutTemplate.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "services/GameRulesService.h"
+#include "services/ProceduralLevelGenerator.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+// 卡牌内存池：指针在扩容后保持不变，移除的卡牌被复用，clear后复用原有内存块，
+// 同ID替换（包括addCard接管的堆上卡牌）；遍历按ID升序；未取出的可点击变化按卡牌去重；
+// 牌面桶查到的可匹配卡牌与逐张规则检查一致；放回主牌区的卡牌回到绘制顺序中的原位置
+
+namespace {
+
+const CardPosition kTrayPosition(540.0f, 300.0f);
+
+GameModel* createGame(int seed)
+{
+    LevelLayoutTemplate layout;
+    if (!layout.initPeaks(3, 3, 16)) {
+        return nullptr;
+    }
+    LevelConfig* levelConfig = ProceduralLevelGenerator::generateLevelConfig(layout, seed, 0.5f);
+    if (!levelConfig) {
+        return nullptr;
+    }
+    GameModel* gameModel = GameModelFromLevelGenerator::generateGameModel(levelConfig);
+    delete levelConfig;
+    return gameModel;
+}
+
+std::vector<int> collectCardIds(const GameModel& gameModel)
+{
+    std::vector<int> cardIds;
+    for (const CardModel* card : gameModel.getAllCards()) {
+        cardIds.push_back(card->getCardId());
+    }
+    return cardIds;
+}
+
+} // namespace
+
+TEST(GameModelTest, CardPointersStayValidAcrossChunks)
+{
+    // 超过多个内存块：先创建的卡牌指针和内容不受后续创建影响
+    GameModel gameModel;
+    const int cardCount = 1000;
+    std::vector<CardModel*> cards;
+    for (int i = 0; i < cardCount; i++) {
+        CardModel* card = gameModel.createCard(static_cast<CardFaceType>(i % CFT_NUM_CARD_FACE_TYPES),
+                                               static_cast<CardSuitType>(i % CST_NUM_CARD_SUIT_TYPES), i);
+        ASSERT_NE(nullptr, card);
+        cards.push_back(card);
+    }
+    
+    ASSERT_EQ(static_cast<size_t>(cardCount), gameModel.getAllCards().size());
+    for (int i = 0; i < cardCount; i++) {
+        EXPECT_EQ(cards[i], gameModel.getCardById(i));
+        EXPECT_EQ(i, cards[i]->getCardId());
+        EXPECT_EQ(static_cast<CardFaceType>(i % CFT_NUM_CARD_FACE_TYPES), cards[i]->getFace());
+    }
+    EXPECT_EQ(nullptr, gameModel.createCard(CFT_ACE, CST_CLUBS, -1));
+    EXPECT_EQ(nullptr, gameModel.getCardById(cardCount));
+}
+
+TEST(GameModelTest, RemovedCardsAreReused)
+{
+    GameModel gameModel;
+    for (int i = 0; i < 10; i++) {
+        gameModel.createCard(CFT_FIVE, CST_HEARTS, i);
+    }
+    CardModel* removed = gameModel.getCardById(3);
+    gameModel.removeCard(3);
+    EXPECT_EQ(nullptr, gameModel.getCardById(3));
+    EXPECT_EQ(9u, gameModel.getAllCards().size());
+    gameModel.removeCard(3);
+    EXPECT_EQ(9u, gameModel.getAllCards().size());
+    
+    // 新卡牌复用被移除卡牌的内存，内容完全是新的
+    CardModel* created = gameModel.createCard(CFT_KING, CST_SPADES, 20);
+    EXPECT_EQ(removed, created);
+    EXPECT_EQ(20, created->getCardId());
+    EXPECT_EQ(CFT_KING, created->getFace());
+    EXPECT_EQ(10u, gameModel.getAllCards().size());
+}
+
+TEST(GameModelTest, CreatingExistingIdReplacesCard)
+{
+    GameModel gameModel;
+    gameModel.createCard(CFT_FIVE, CST_HEARTS, 4);
+    gameModel.createCard(CFT_SIX, CST_CLUBS, 4);
+    ASSERT_EQ(1u, gameModel.getAllCards().size());
+    EXPECT_EQ(CFT_SIX, gameModel.getCardById(4)->getFace());
+    
+    // addCard接管的堆上卡牌替换池中卡牌，再被池中卡牌替换（被替换的堆上卡牌由模型释放）
+    gameModel.addCard(new CardModel(CFT_SEVEN, CST_DIAMONDS, 4));
+    ASSERT_EQ(1u, gameModel.getAllCards().size());
+    EXPECT_EQ(CFT_SEVEN, gameModel.getCardById(4)->getFace());
+    gameModel.addCard(new CardModel(CFT_EIGHT, CST_DIAMONDS, 4));
+    EXPECT_EQ(CFT_EIGHT, gameModel.getCardById(4)->getFace());
+    gameModel.createCard(CFT_NINE, CST_SPADES, 4);
+    ASSERT_EQ(1u, gameModel.getAllCards().size());
+    EXPECT_EQ(CFT_NINE, gameModel.getCardById(4)->getFace());
+    
+    gameModel.addCard(new CardModel(CFT_TEN, CST_SPADES, 5));
+    gameModel.removeCard(5);
+    EXPECT_EQ(nullptr, gameModel.getCardById(5));
+    EXPECT_EQ(1u, gameModel.getAllCards().size());
+}
+
+TEST(GameModelTest, ClearReusesChunks)
+{
+    GameModel gameModel;
+    std::set<CardModel*> previous;
+    for (int i = 0; i < 150; i++) {
+        previous.insert(gameModel.createCard(CFT_ACE, CST_CLUBS, i));
+    }
+    gameModel.addCard(new CardModel(CFT_TWO, CST_CLUBS, 200));
+    
+    gameModel.clear();
+    EXPECT_TRUE(gameModel.getAllCards().empty());
+    EXPECT_EQ(nullptr, gameModel.getCardById(0));
+    EXPECT_EQ(nullptr, gameModel.getCardById(200));
+    
+    for (int i = 0; i < 150; i++) {
+        CardModel* card = gameModel.createCard(CFT_QUEEN, CST_HEARTS, i);
+        EXPECT_TRUE(previous.count(card) > 0);
+        EXPECT_EQ(CFT_QUEEN, card->getFace());
+    }
+    EXPECT_EQ(150u, gameModel.getAllCards().size());
+}
+
+TEST(GameModelTest, AllCardsAreInAscendingIdOrder)
+{
+    // 创建顺序打乱、ID不连续
+    GameModel gameModel;
+    std::vector<int> cardIds;
+    for (int i = 0; i < 200; i++) {
+        cardIds.push_back(i * 3 + 1);
+    }
+    std::mt19937 random(5);
+    std::shuffle(cardIds.begin(), cardIds.end(), random);
+    for (int cardId : cardIds) {
+        gameModel.createCard(CFT_ACE, CST_CLUBS, cardId);
+    }
+    for (int i = 0; i < 50; i++) {
+        gameModel.removeCard(cardIds[i]);
+    }
+    
+    std::vector<int> expected(cardIds.begin() + 50, cardIds.end());
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(expected, collectCardIds(gameModel));
+    EXPECT_EQ(expected.size(), gameModel.getAllCards().size());
+}
+
+TEST(GameModelTest, UntakenClickableChangesStayBounded)
+{
+    // 没有视图取出变化时反复匹配、撤销：未取出的变化不重复，不超过卡牌数量
+    GameModel* gameModel = createGame(3);
+    ASSERT_NE(nullptr, gameModel);
+    UndoModel undoModel;
+    UndoManager undoManager;
+    undoManager.init(&undoModel);
+    
+    for (int round = 0; round < 200; round++) {
+        std::vector<int> matchable;
+        gameModel->getMatchableCardIds(&matchable);
+        UndoAction action;
+        bool moved = !matchable.empty()
+            && GameRulesService::replaceTrayFromPlayfield(gameModel, matchable[0], kTrayPosition, &action);
+        if (!moved) {
+            moved = GameRulesService::replaceTrayFromStack(gameModel, kTrayPosition, &action);
+        }
+        if (!moved) {
+            break;
+        }
+        undoManager.recordAction(action);
+        
+        // 每三步撤销两步，让同一批卡牌反复改变可点击状态
+        if (round % 3 == 2) {
+            ASSERT_TRUE(undoManager.performUndo(gameModel));
+            ASSERT_TRUE(undoManager.performUndo(gameModel));
+        }
+    }
+    
+    std::vector<int> changed;
+    gameModel->takeClickableChanges(&changed);
+    std::vector<int> unique = changed;
+    std::sort(unique.begin(), unique.end());
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+    EXPECT_FALSE(changed.empty());
+    EXPECT_EQ(unique.size(), changed.size());
+    EXPECT_LE(changed.size(), gameModel->getAllCards().size());
+    
+    // 取出后清空，下次只返回新的变化
+    changed.clear();
+    gameModel->takeClickableChanges(&changed);
+    EXPECT_TRUE(changed.empty());
+    delete gameModel;
+}
+
+TEST(GameModelTest, FaceBucketsMatchRulesRescan)
+{
+    // 随机匹配、翻牌和撤销：按牌面桶查到的可匹配卡牌与逐张用规则检查的结果相同
+    for (int seed = 1; seed <= 10; seed++) {
+        SCOPED_TRACE(seed);
+        GameModel* gameModel = createGame(seed);
+        ASSERT_NE(nullptr, gameModel);
+        UndoModel undoModel;
+        UndoManager undoManager;
+        undoManager.init(&undoModel);
+        std::mt19937 random(seed);
+        
+        for (int step = 0; step < 80; step++) {
+            std::vector<int> expected;
+            for (int cardId : gameModel->getPlayfieldCardIds()) {
+                if (GameRulesService::canMatchWithTray(gameModel, cardId)) {
+                    expected.push_back(cardId);
+                }
+            }
+            std::vector<int> matchable;
+            gameModel->getMatchableCardIds(&matchable);
+            std::sort(expected.begin(), expected.end());
+            std::sort(matchable.begin(), matchable.end());
+            ASSERT_EQ(expected, matchable);
+            EXPECT_EQ(!expected.empty(), gameModel->hasMatchableCard());
+            EXPECT_EQ(!expected.empty() || !gameModel->getStackCardIds().empty(), gameModel->hasAnyMove());
+            
+            UndoAction action;
+            if (undoManager.canUndo() && random() % 4 == 0) {
+                ASSERT_TRUE(undoManager.performUndo(gameModel));
+            } else if (!matchable.empty()) {
+                int cardId = matchable[random() % matchable.size()];
+                ASSERT_TRUE(GameRulesService::replaceTrayFromPlayfield(gameModel, cardId, kTrayPosition, &action));
+                undoManager.recordAction(action);
+            } else if (GameRulesService::replaceTrayFromStack(gameModel, kTrayPosition, &action)) {
+                undoManager.recordAction(action);
+            } else {
+                EXPECT_FALSE(gameModel->hasAnyMove());
+                break;
+            }
+        }
+        delete gameModel;
+    }
+}
+
+TEST(GameModelTest, FaceBucketsFollowCardReplacement)
+{
+    // 替换同ID的主牌区卡牌或底牌后，按新牌面查找
+    GameModel gameModel;
+    gameModel.createCard(CFT_FIVE, CST_CLUBS, 0);
+    gameModel.createCard(CFT_NINE, CST_CLUBS, 1);
+    gameModel.createCard(CFT_SIX, CST_HEARTS, 2);
+    gameModel.setPlayfieldCardIds(std::vector<int>{ 0, 1 });
+    gameModel.setTrayCardId(2);
+    
+    std::vector<int> matchable;
+    gameModel.getMatchableCardIds(&matchable);
+    EXPECT_EQ(std::vector<int>{ 0 }, matchable);
+    
+    gameModel.createCard(CFT_EIGHT, CST_CLUBS, 0);
+    EXPECT_FALSE(gameModel.hasMatchableCard());
+    EXPECT_FALSE(gameModel.hasAnyMove());
+    
+    gameModel.createCard(CFT_TEN, CST_HEARTS, 2);
+    matchable.clear();
+    gameModel.getMatchableCardIds(&matchable);
+    EXPECT_EQ(std::vector<int>{ 1 }, matchable);
+    
+    gameModel.removeFromPlayfield(1);
+    EXPECT_FALSE(gameModel.hasMatchableCard());
+    gameModel.pushToStack(1);
+    EXPECT_TRUE(gameModel.hasAnyMove());
+}
+
+TEST(GameModelTest, ReinsertedCardsKeepDrawOrder)
+{
+    // 任意顺序移出、任意顺序放回：主牌区恢复为原来的绘制顺序，遮挡状态同时恢复
+    GameModel* gameModel = createGame(11);
+    ASSERT_NE(nullptr, gameModel);
+    const std::vector<int> original = gameModel->getPlayfieldCardIds();
+    std::vector<bool> originalCovered;
+    for (int cardId : original) {
+        originalCovered.push_back(gameModel->isCardCovered(cardId));
+    }
+    
+    std::mt19937 random(11);
+    std::vector<int> removed(original.begin(), original.end());
+    std::shuffle(removed.begin(), removed.end(), random);
+    removed.resize(removed.size() / 2);
+    for (int cardId : removed) {
+        gameModel->removeFromPlayfield(cardId);
+    }
+    EXPECT_EQ(original.size() - removed.size(), gameModel->getPlayfieldCardIds().size());
+    
+    std::shuffle(removed.begin(), removed.end(), random);
+    for (int cardId : removed) {
+        gameModel->insertToPlayfield(cardId);
+    }
+    EXPECT_EQ(original, gameModel->getPlayfieldCardIds());
+    for (size_t i = 0; i < original.size(); i++) {
+        EXPECT_EQ(originalCovered[i], gameModel->isCardCovered(original[i]));
+    }
+    delete gameModel;
+}
+
+TEST(GameModelTest, UndoRestoresPlayfieldAndStackOrder)
+{
+    // 随机走牌、撤销和重做：主牌区始终按绘制顺序排列，撤销后主牌区和备用牌堆与走这一步之前完全相同
+    for (int seed = 1; seed <= 10; seed++) {
+        SCOPED_TRACE(seed);
+        GameModel* gameModel = createGame(seed);
+        ASSERT_NE(nullptr, gameModel);
+        UndoModel undoModel;
+        UndoManager undoManager;
+        undoManager.init(&undoModel);
+        std::mt19937 random(seed);
+        const CardCoverGraph& coverGraph = gameModel->getCoverGraph();
+        
+        // history[i]为第i步之前的主牌区和备用牌堆
+        std::vector<std::vector<int> > playfieldHistory;
+        std::vector<std::vector<int> > stackHistory;
+        
+        for (int step = 0; step < 120; step++) {
+            int operation = random() % 10;
+            if (operation < 3 && undoManager.canUndo()) {
+                ASSERT_TRUE(undoManager.performUndo(gameModel));
+                EXPECT_EQ(playfieldHistory.back(), gameModel->getPlayfieldCardIds());
+                EXPECT_EQ(stackHistory.back(), gameModel->getStackCardIds());
+                playfieldHistory.pop_back();
+                stackHistory.pop_back();
+            } else {
+                std::vector<int> playfieldBefore = gameModel->getPlayfieldCardIds();
+                std::vector<int> stackBefore = gameModel->getStackCardIds();
+                bool moved = false;
+                if (operation < 5 && undoManager.canRedo()) {
+                    moved = undoManager.performRedo(gameModel, kTrayPosition, nullptr);
+                    EXPECT_TRUE(moved);
+                } else {
+                    std::vector<int> matchable;
+                    gameModel->getMatchableCardIds(&matchable);
+                    UndoAction action;
+                    moved = !matchable.empty()
+                        && GameRulesService::replaceTrayFromPlayfield(gameModel, matchable[random() % matchable.size()],
+                                                                      kTrayPosition, &action);
+                    if (!moved) {
+                        moved = GameRulesService::replaceTrayFromStack(gameModel, kTrayPosition, &action);
+                    }
+                    if (moved) {
+                        undoManager.recordAction(action);
+                    }
+                }
+                if (moved) {
+                    playfieldHistory.push_back(playfieldBefore);
+                    stackHistory.push_back(stackBefore);
+                }
+            }
+            
+            const std::vector<int>& playfieldIds = gameModel->getPlayfieldCardIds();
+            for (size_t i = 1; i < playfieldIds.size(); i++) {
+                EXPECT_LT(coverGraph.getDrawRank(playfieldIds[i - 1]), coverGraph.getDrawRank(playfieldIds[i]));
+            }
+        }
+        delete gameModel;
+    }
+}
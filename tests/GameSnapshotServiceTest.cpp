@@ -0,0 +1,182 @@
+#include "services/GameSnapshotService.h"
+#include "managers/UndoManager.h"
+#include "configs/models/LevelLayoutTemplate.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "services/GameRulesService.h"
+#include "services/ProceduralLevelGenerator.h"
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+// 对局中途（有撤销记录和可重做记录）的快照往返：卡牌、各区域、遮挡关系、撤销与重做记录全部一致，
+// 读档后的重做与原对局的重做结果相同；撤销/重做记录引用不存在的卡牌时拒绝读取
+
+namespace {
+
+const CardPosition kTrayPosition(540.0f, 300.0f);
+
+class GameSnapshotServiceTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        LevelLayoutTemplate layout;
+        ASSERT_TRUE(layout.initPeaks(3, 3, 16));
+        LevelConfig* levelConfig = ProceduralLevelGenerator::generateLevelConfig(layout, 1234, 0.5f);
+        ASSERT_NE(nullptr, levelConfig);
+        _gameModel = GameModelFromLevelGenerator::generateGameModel(levelConfig);
+        delete levelConfig;
+        ASSERT_NE(nullptr, _gameModel);
+        _undoManager.init(&_undoModel);
+        
+        // 匹配优先，无法匹配时翻牌，最后撤销两步留下可重做记录
+        for (int step = 0; step < 12; step++) {
+            UndoAction action;
+            std::vector<int> matchable;
+            _gameModel->getMatchableCardIds(&matchable);
+            bool moved = !matchable.empty()
+                && GameRulesService::replaceTrayFromPlayfield(_gameModel, matchable[0], kTrayPosition, &action);
+            if (!moved) {
+                moved = GameRulesService::replaceTrayFromStack(_gameModel, kTrayPosition, &action);
+            }
+            if (!moved) {
+                break;
+            }
+            _undoManager.recordAction(action);
+        }
+        ASSERT_GE(_undoModel.getActionCount(), 4);
+        ASSERT_TRUE(_undoManager.performUndo(_gameModel));
+        ASSERT_TRUE(_undoManager.performUndo(_gameModel));
+        ASSERT_EQ(2, _undoModel.getRedoCount());
+    }
+    
+    void TearDown() override
+    {
+        delete _gameModel;
+    }
+    
+    std::vector<uint32_t> writeSnapshot() const
+    {
+        std::vector<uint32_t> buffer(GameSnapshotService::getSnapshotSize(_gameModel, &_undoModel) / sizeof(uint32_t) + 1);
+        size_t size = GameSnapshotService::writeSnapshot(_gameModel, &_undoModel, buffer.data(),
+                                                         buffer.size() * sizeof(uint32_t));
+        EXPECT_EQ(GameSnapshotService::getSnapshotSize(_gameModel, &_undoModel), size);
+        return buffer;
+    }
+    
+    size_t snapshotSize() const
+    {
+        return GameSnapshotService::getSnapshotSize(_gameModel, &_undoModel);
+    }
+    
+    static void expectSameAction(const UndoAction& expected, const UndoAction& actual)
+    {
+        EXPECT_EQ(expected.type, actual.type);
+        EXPECT_EQ(expected.fromCardId, actual.fromCardId);
+        EXPECT_EQ(expected.toCardId, actual.toCardId);
+    }
+    
+    void expectSameState(const GameModel* gameModel, const UndoModel* undoModel) const
+    {
+        EXPECT_EQ(_gameModel->getPlayfieldCardIds(), gameModel->getPlayfieldCardIds());
+        EXPECT_EQ(_gameModel->getStackCardIds(), gameModel->getStackCardIds());
+        EXPECT_EQ(_gameModel->getTrayCardId(), gameModel->getTrayCardId());
+        ASSERT_EQ(_gameModel->getAllCards().size(), gameModel->getAllCards().size());
+        for (const CardModel* card : _gameModel->getAllCards()) {
+            const CardModel* other = gameModel->getCardById(card->getCardId());
+            ASSERT_NE(nullptr, other);
+            EXPECT_EQ(card->getFace(), other->getFace());
+            EXPECT_EQ(card->getSuit(), other->getSuit());
+            EXPECT_EQ(card->getLocation(), other->getLocation());
+            EXPECT_EQ(card->getPosition(), other->getPosition());
+            EXPECT_EQ(card->getHomePosition(), other->getHomePosition());
+            EXPECT_EQ(card->isFlipped(), other->isFlipped());
+            EXPECT_EQ(card->isClickable(), other->isClickable());
+            EXPECT_EQ(_gameModel->isCardCovered(card->getCardId()), gameModel->isCardCovered(card->getCardId()));
+        }
+        
+        ASSERT_EQ(_undoModel.getActionCount(), undoModel->getActionCount());
+        for (int i = 0; i < _undoModel.getActionCount(); i++) {
+            expectSameAction(_undoModel.getAction(i), undoModel->getAction(i));
+        }
+        ASSERT_EQ(_undoModel.getRedoCount(), undoModel->getRedoCount());
+        for (int i = 0; i < _undoModel.getRedoCount(); i++) {
+            expectSameAction(_undoModel.getRedoAction(i), undoModel->getRedoAction(i));
+        }
+    }
+    
+    // 改动快照末尾第index条撤销/重做记录（从0开始，最后一条重做记录为0）的卡牌ID
+    void corruptActionCardId(std::vector<uint32_t>* buffer, int index, bool fromCard) const
+    {
+        uint8_t* bytes = reinterpret_cast<uint8_t*>(buffer->data());
+        size_t offset = snapshotSize() - (index + 1) * sizeof(GameSnapshotUndoAction)
+            + (fromCard ? offsetof(GameSnapshotUndoAction, fromCardId) : offsetof(GameSnapshotUndoAction, toCardId));
+        int32_t missingCardId = 100000;
+        memcpy(bytes + offset, &missingCardId, sizeof(missingCardId));
+    }
+    
+    GameModel* _gameModel = nullptr;
+    UndoModel _undoModel;
+    UndoManager _undoManager;
+};
+
+} // namespace
+
+TEST_F(GameSnapshotServiceTest, RoundTripKeepsUndoAndRedoHistory)
+{
+    std::vector<uint32_t> buffer = writeSnapshot();
+    GameModel restoredModel;
+    UndoModel restoredUndo;
+    ASSERT_TRUE(GameSnapshotService::readSnapshot(buffer.data(), snapshotSize(), &restoredModel, &restoredUndo));
+    expectSameState(&restoredModel, &restoredUndo);
+    
+    // 读档后逐条重做、再撤销，结果与原对局相同
+    UndoManager restoredManager;
+    restoredManager.init(&restoredUndo);
+    while (_undoManager.canRedo()) {
+        UndoAction action;
+        UndoAction restoredAction;
+        ASSERT_TRUE(_undoManager.performRedo(_gameModel, kTrayPosition, &action));
+        ASSERT_TRUE(restoredManager.performRedo(&restoredModel, kTrayPosition, &restoredAction));
+        expectSameAction(action, restoredAction);
+        expectSameState(&restoredModel, &restoredUndo);
+    }
+    EXPECT_FALSE(restoredManager.canRedo());
+    ASSERT_TRUE(_undoManager.performUndo(_gameModel));
+    ASSERT_TRUE(restoredManager.performUndo(&restoredModel));
+    expectSameState(&restoredModel, &restoredUndo);
+}
+
+TEST_F(GameSnapshotServiceTest, RoundTripIntoReusedModels)
+{
+    // 读入已有内容的模型：原有内容被替换
+    std::vector<uint32_t> buffer = writeSnapshot();
+    GameModel restoredModel;
+    UndoModel restoredUndo;
+    ASSERT_TRUE(GameSnapshotService::readSnapshot(buffer.data(), snapshotSize(), &restoredModel, &restoredUndo));
+    ASSERT_TRUE(GameSnapshotService::readSnapshot(buffer.data(), snapshotSize(), &restoredModel, &restoredUndo));
+    expectSameState(&restoredModel, &restoredUndo);
+}
+
+TEST_F(GameSnapshotServiceTest, RejectsUndoActionWithUnknownCard)
+{
+    // 重做记录在最后两条，之前是撤销记录
+    std::vector<uint32_t> buffer = writeSnapshot();
+    corruptActionCardId(&buffer, _undoModel.getRedoCount(), true);
+    GameModel restoredModel;
+    UndoModel restoredUndo;
+    EXPECT_FALSE(GameSnapshotService::readSnapshot(buffer.data(), snapshotSize(), &restoredModel, &restoredUndo));
+    EXPECT_TRUE(restoredModel.getAllCards().empty());
+    EXPECT_EQ(0, restoredUndo.getActionCount());
+}
+
+TEST_F(GameSnapshotServiceTest, RejectsRedoActionWithUnknownCard)
+{
+    std::vector<uint32_t> buffer = writeSnapshot();
+    corruptActionCardId(&buffer, 0, false);
+    GameModel restoredModel;
+    UndoModel restoredUndo;
+    EXPECT_FALSE(GameSnapshotService::readSnapshot(buffer.data(), snapshotSize(), &restoredModel, &restoredUndo));
+    EXPECT_EQ(0, restoredUndo.getRedoCount());
+}
@@ -0,0 +1,156 @@
+#include "configs/loaders/LevelConfigLoader.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+// SAX原地解析（loadFromString）的格式校验：合法关卡与DOM解析结果一致，
+// 未知成员被忽略，嵌套错误和截断的JSON解析失败而不是断言或返回半个关卡
+
+namespace {
+
+const char* kValidLevel =
+    "{\n"
+    "    \"Playfield\": [\n"
+    "        {\"CardFace\": 11, \"CardSuit\": 0, \"Position\": {\"x\": 250, \"y\": 1000}},\n"
+    "        {\"CardFace\": 2, \"CardSuit\": 3, \"Position\": {\"x\": 300.5, \"y\": -20}}\n"
+    "    ],\n"
+    "    \"Stack\": [\n"
+    "        {\"CardFace\": 0, \"CardSuit\": 2, \"Position\": {\"x\": 0, \"y\": 0}}\n"
+    "    ]\n"
+    "}\n";
+
+void expectSameCards(const std::vector<CardConfig>& expected, const std::vector<CardConfig>& actual)
+{
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(expected[i].face, actual[i].face);
+        EXPECT_EQ(expected[i].suit, actual[i].suit);
+        EXPECT_EQ(expected[i].position.x, actual[i].position.x);
+        EXPECT_EQ(expected[i].position.y, actual[i].position.y);
+    }
+}
+
+// 解析失败时返回true（同时释放意外得到的关卡）
+bool rejects(const std::string& json)
+{
+    LevelConfig* config = LevelConfigLoader::loadFromString(json);
+    delete config;
+    return config == nullptr;
+}
+
+} // namespace
+
+TEST(LevelConfigLoaderTest, ValidLevel)
+{
+    LevelConfig* config = LevelConfigLoader::loadFromString(kValidLevel);
+    ASSERT_NE(nullptr, config);
+    
+    const std::vector<CardConfig>& playfield = config->getPlayfieldCards();
+    ASSERT_EQ(2u, playfield.size());
+    EXPECT_EQ(CFT_QUEEN, playfield[0].face);
+    EXPECT_EQ(CST_CLUBS, playfield[0].suit);
+    EXPECT_EQ(250.0f, playfield[0].position.x);
+    EXPECT_EQ(1000.0f, playfield[0].position.y);
+    EXPECT_EQ(CFT_THREE, playfield[1].face);
+    EXPECT_EQ(CST_SPADES, playfield[1].suit);
+    EXPECT_EQ(300.5f, playfield[1].position.x);
+    EXPECT_EQ(-20.0f, playfield[1].position.y);
+    
+    ASSERT_EQ(1u, config->getStackCards().size());
+    EXPECT_EQ(CFT_ACE, config->getStackCards()[0].face);
+    EXPECT_EQ(CST_HEARTS, config->getStackCards()[0].suit);
+    delete config;
+}
+
+TEST(LevelConfigLoaderTest, MatchesDomParser)
+{
+    LevelConfig* saxConfig = LevelConfigLoader::loadFromString(kValidLevel);
+    LevelConfig* domConfig = LevelConfigLoader::loadFromStringDom(kValidLevel);
+    ASSERT_NE(nullptr, saxConfig);
+    ASSERT_NE(nullptr, domConfig);
+    expectSameCards(domConfig->getPlayfieldCards(), saxConfig->getPlayfieldCards());
+    expectSameCards(domConfig->getStackCards(), saxConfig->getStackCards());
+    delete saxConfig;
+    delete domConfig;
+}
+
+TEST(LevelConfigLoaderTest, UnknownKeysIgnored)
+{
+    LevelConfig* config = LevelConfigLoader::loadFromString(
+        "{\"Name\": \"test\", \"Meta\": {\"tags\": [1, {\"Playfield\": []}], \"v\": null},"
+        " \"Playfield\": [{\"Note\": [\"a\", {\"b\": true}], \"CardFace\": 4, \"CardSuit\": 1,"
+        "                  \"Position\": {\"z\": [1, 2], \"x\": 10, \"y\": 20}, \"Extra\": {}}],"
+        " \"Stack\": [], \"Trailer\": 1.5}");
+    ASSERT_NE(nullptr, config);
+    ASSERT_EQ(1u, config->getPlayfieldCards().size());
+    EXPECT_EQ(CFT_FIVE, config->getPlayfieldCards()[0].face);
+    EXPECT_EQ(CST_DIAMONDS, config->getPlayfieldCards()[0].suit);
+    EXPECT_EQ(10.0f, config->getPlayfieldCards()[0].position.x);
+    EXPECT_EQ(20.0f, config->getPlayfieldCards()[0].position.y);
+    EXPECT_TRUE(config->getStackCards().empty());
+    delete config;
+}
+
+TEST(LevelConfigLoaderTest, DuplicateMembersUseFirst)
+{
+    LevelConfig* config = LevelConfigLoader::loadFromString(
+        "{\"Playfield\": [{\"CardFace\": 1, \"CardFace\": 7, \"CardSuit\": 0,"
+        "                  \"Position\": {\"x\": 1, \"x\": 9, \"y\": 2}}],"
+        " \"Playfield\": [{\"CardFace\": 3}, {\"CardFace\": 4}]}");
+    ASSERT_NE(nullptr, config);
+    ASSERT_EQ(1u, config->getPlayfieldCards().size());
+    EXPECT_EQ(CFT_TWO, config->getPlayfieldCards()[0].face);
+    EXPECT_EQ(1.0f, config->getPlayfieldCards()[0].position.x);
+    delete config;
+}
+
+TEST(LevelConfigLoaderTest, NonArrayCardListsIgnored)
+{
+    LevelConfig* config = LevelConfigLoader::loadFromString(
+        "{\"Playfield\": {\"CardFace\": 1}, \"Stack\": 3}");
+    ASSERT_NE(nullptr, config);
+    EXPECT_TRUE(config->getPlayfieldCards().empty());
+    EXPECT_TRUE(config->getStackCards().empty());
+    delete config;
+}
+
+TEST(LevelConfigLoaderTest, WrongNestingRejected)
+{
+    // 根不是对象
+    EXPECT_TRUE(rejects("[{\"Playfield\": []}]"));
+    EXPECT_TRUE(rejects("42"));
+    // 卡牌不是对象
+    EXPECT_TRUE(rejects("{\"Playfield\": [1]}"));
+    EXPECT_TRUE(rejects("{\"Playfield\": [[{\"CardFace\": 1}]]}"));
+    // 牌面、花色不是整数
+    EXPECT_TRUE(rejects("{\"Playfield\": [{\"CardFace\": \"1\"}]}"));
+    EXPECT_TRUE(rejects("{\"Playfield\": [{\"CardSuit\": 1.5}]}"));
+    EXPECT_TRUE(rejects("{\"Playfield\": [{\"CardFace\": {\"value\": 1}}]}"));
+    // Position不是对象、缺少坐标或坐标不是数值
+    EXPECT_TRUE(rejects("{\"Playfield\": [{\"Position\": [1, 2]}]}"));
+    EXPECT_TRUE(rejects("{\"Playfield\": [{\"Position\": 5}]}"));
+    EXPECT_TRUE(rejects("{\"Playfield\": [{\"Position\": {\"x\": 1}}]}"));
+    EXPECT_TRUE(rejects("{\"Playfield\": [{\"Position\": {\"x\": 1, \"y\": \"2\"}}]}"));
+    EXPECT_TRUE(rejects("{\"Playfield\": [{\"Position\": {\"x\": {\"v\": 1}, \"y\": 2}}]}"));
+}
+
+TEST(LevelConfigLoaderTest, TruncatedJsonRejected)
+{
+    std::string json = kValidLevel;
+    // 每个截断位置都必须解析失败（去掉末尾空白后的完整文档除外）
+    size_t end = json.find_last_not_of(" \n") + 1;
+    for (size_t length = 0; length < end; length++) {
+        EXPECT_TRUE(rejects(json.substr(0, length))) << "length " << length;
+    }
+    
+    EXPECT_TRUE(rejects("{\"Playfield\": ["));
+    EXPECT_TRUE(rejects("{\"Playfield\": [{\"CardFace\": 1, \"CardSuit\": 0},"));
+    EXPECT_TRUE(rejects("{\"Playfield\": [], \"Stack\": [{\"CardFace\": 2}"));
+    EXPECT_TRUE(rejects("{\"Playfield\": [{\"Position\": {\"x\": 1, \"y\": 2"));
+}
+
+TEST(LevelConfigLoaderTest, TrailingGarbageRejected)
+{
+    EXPECT_TRUE(rejects(std::string(kValidLevel) + "{}"));
+    EXPECT_TRUE(rejects("{\"Playfield\": []}]"));
+}
@@ -0,0 +1,228 @@
+#include "managers/LevelPrefetchManager.h"
+#include "services/LevelBuildService.h"
+#include "utils/CoreLog.h"
+#if POKER_CORE_JSON
+#include "configs/loaders/LevelConfigLoader.h"
+#endif
+#include <gtest/gtest.h>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 预加载线程的输入只能由调用prefetchLevels的线程准备，工作线程只解析和生成；
+// 本测试只链接PokerCore，输入和生成都不依赖引擎
+
+namespace {
+
+const uint64_t kTestSeedBase = 0x7E57000000000000ULL;
+
+std::mutex s_recordMutex;
+std::vector<std::thread::id> s_sinkThreads;     // 日志输出函数被调用时所在的线程
+std::vector<std::string> s_sinkMessages;
+std::vector<std::thread::id> s_readerThreads;   // 文件读取函数被调用时所在的线程
+
+void recordSink(const char* message)
+{
+    std::lock_guard<std::mutex> lock(s_recordMutex);
+    s_sinkThreads.push_back(std::this_thread::get_id());
+    s_sinkMessages.push_back(message);
+}
+
+void clearRecords()
+{
+    std::lock_guard<std::mutex> lock(s_recordMutex);
+    s_sinkThreads.clear();
+    s_sinkMessages.clear();
+    s_readerThreads.clear();
+}
+
+#if POKER_CORE_JSON
+std::string recordReader(const std::string& filePath)
+{
+    std::lock_guard<std::mutex> lock(s_recordMutex);
+    s_readerThreads.push_back(std::this_thread::get_id());
+    return filePath == "level/level_2.json" ? std::string("{\"Playfield\":[") : std::string();
+}
+#endif
+
+// 等待工作线程生成关卡（最多5秒）
+bool waitReady(const LevelPrefetchManager& manager, int levelId)
+{
+    for (int i = 0; i < 500; i++) {
+        if (manager.isReady(levelId)) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+// 比较两个模型的牌局（卡牌ID按线程分配，不参与比较）
+void expectSameDeal(const GameModel* expected, const GameModel* actual)
+{
+    ASSERT_EQ(expected->getPlayfieldCardIds().size(), actual->getPlayfieldCardIds().size());
+    ASSERT_EQ(expected->getStackCardIds().size(), actual->getStackCardIds().size());
+    for (size_t i = 0; i < expected->getPlayfieldCardIds().size(); i++) {
+        const CardModel* expectedCard = expected->getCardById(expected->getPlayfieldCardIds()[i]);
+        const CardModel* actualCard = actual->getCardById(actual->getPlayfieldCardIds()[i]);
+        EXPECT_EQ(expectedCard->getFace(), actualCard->getFace());
+        EXPECT_EQ(expectedCard->getSuit(), actualCard->getSuit());
+    }
+}
+
+class LevelPrefetchManagerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(_layout.initPeaks(3, 3, 16));
+        clearRecords();
+        CoreLog::setSink(&recordSink);
+    }
+    
+    void TearDown() override
+    {
+        CoreLog::setSink(nullptr);
+#if POKER_CORE_JSON
+        LevelConfigLoader::setFileReader(nullptr);
+#endif
+    }
+    
+    // 与GameController相同的准备方式：先读JSON，再填写按种子生成的参数
+    bool prepareInput(int levelId, LevelLoadInput* input)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_providerMutex);
+            _providerThreads.push_back(std::this_thread::get_id());
+        }
+#if POKER_CORE_JSON
+        input->json = LevelConfigLoader::readLevelFile(levelId);
+#endif
+        input->layout = &_layout;
+        input->seed = kTestSeedBase + static_cast<uint64_t>(levelId);
+        input->difficulty = 0.5f;
+        return true;
+    }
+    
+    LevelLayoutTemplate _layout;
+    std::mutex _providerMutex;
+    std::vector<std::thread::id> _providerThreads;
+};
+
+} // namespace
+
+TEST_F(LevelPrefetchManagerTest, InputPreparedOnCallingThread)
+{
+#if POKER_CORE_JSON
+    LevelConfigLoader::setFileReader(&recordReader);
+#endif
+    LevelPrefetchManager manager;
+    ASSERT_TRUE(manager.init([this](int levelId, LevelLoadInput* input) {
+        return prepareInput(levelId, input);
+    }));
+    manager.prefetchLevels(1, 2);
+    
+    ASSERT_TRUE(waitReady(manager, 1));
+    ASSERT_TRUE(waitReady(manager, 2));
+    
+    std::thread::id mainThread = std::this_thread::get_id();
+    ASSERT_EQ(2u, _providerThreads.size());
+    for (std::thread::id threadId : _providerThreads) {
+        EXPECT_EQ(mainThread, threadId);
+    }
+    for (std::thread::id threadId : s_readerThreads) {
+        EXPECT_EQ(mainThread, threadId);
+    }
+    
+    for (int levelId = 1; levelId <= 2; levelId++) {
+        GameModel* prefetched = manager.takeGameModel(levelId);
+        ASSERT_NE(nullptr, prefetched);
+        
+        LevelLoadInput input;
+        input.levelId = levelId;
+        prepareInput(levelId, &input);
+        GameModel* direct = LevelBuildService::buildGameModel(input);
+        ASSERT_NE(nullptr, direct);
+        expectSameDeal(direct, prefetched);
+        delete direct;
+        delete prefetched;
+    }
+}
+
+TEST_F(LevelPrefetchManagerTest, FailedInputIsNotCached)
+{
+    LevelPrefetchManager manager;
+    ASSERT_TRUE(manager.init([this](int levelId, LevelLoadInput* input) {
+        // 关卡3准备输入失败（不发出请求）；关卡4的输入没有任何来源（工作线程生成失败）；关卡5正常
+        if (levelId == 5) {
+            return prepareInput(levelId, input);
+        }
+        return levelId != 3;
+    }));
+    manager.prefetchLevels(3, 3);
+    
+    // 工作线程按顺序处理请求，关卡5生成完成时关卡4一定已经处理过
+    ASSERT_TRUE(waitReady(manager, 5));
+    EXPECT_EQ(1, manager.getCachedCount());
+    EXPECT_FALSE(manager.isReady(3));
+    EXPECT_FALSE(manager.isReady(4));
+    EXPECT_EQ(nullptr, manager.takeGameModel(3));
+    EXPECT_EQ(nullptr, manager.takeGameModel(4));
+    delete manager.takeGameModel(5);
+}
+
+TEST_F(LevelPrefetchManagerTest, WorkerLogsDeferredUntilFlush)
+{
+    std::thread worker([]() {
+        CORE_LOG("from worker %d", 1);
+    });
+    worker.join();
+    
+    {
+        std::lock_guard<std::mutex> lock(s_recordMutex);
+        EXPECT_TRUE(s_sinkMessages.empty());
+    }
+    
+    // 其他线程调用flush不输出
+    std::thread otherFlush([]() {
+        CoreLog::flush();
+    });
+    otherFlush.join();
+    EXPECT_TRUE(s_sinkMessages.empty());
+    
+    CoreLog::flush();
+    ASSERT_EQ(1u, s_sinkMessages.size());
+    EXPECT_EQ("from worker 1", s_sinkMessages[0]);
+    EXPECT_EQ(std::this_thread::get_id(), s_sinkThreads[0]);
+    
+    CORE_LOG("from main");
+    ASSERT_EQ(2u, s_sinkMessages.size());
+    EXPECT_EQ("from main", s_sinkMessages[1]);
+}
+
+#if POKER_CORE_JSON
+TEST_F(LevelPrefetchManagerTest, InvalidJsonLoggedOnSinkThread)
+{
+    LevelConfigLoader::setFileReader(&recordReader);
+    LevelPrefetchManager manager;
+    ASSERT_TRUE(manager.init([this](int levelId, LevelLoadInput* input) {
+        return prepareInput(levelId, input);
+    }));
+    
+    // 关卡2的JSON被截断，工作线程回退到按种子生成，解析错误的日志暂存到flush
+    manager.prefetchLevels(2, 1);
+    ASSERT_TRUE(waitReady(manager, 2));
+    
+    for (std::thread::id threadId : s_sinkThreads) {
+        EXPECT_EQ(std::this_thread::get_id(), threadId);
+    }
+    CoreLog::flush();
+    ASSERT_FALSE(s_sinkMessages.empty());
+    for (std::thread::id threadId : s_sinkThreads) {
+        EXPECT_EQ(std::this_thread::get_id(), threadId);
+    }
+    delete manager.takeGameModel(2);
+}
+#endif
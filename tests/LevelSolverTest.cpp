@@ -0,0 +1,204 @@
+#include "services/LevelSolver.h"
+#include "managers/UndoManager.h"
+#include "configs/models/LevelConfig.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "services/GameRulesService.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+// 求解结果与在GameModel上用规则服务穷举所有走法（走完撤销）的结果一致：
+// 是否可胜、最少翻牌次数、最少操作数和获胜路线数量；另外覆盖开局即胜、必败和超出上限的牌局
+
+namespace {
+
+const CardPosition kTrayPosition(540.0f, 300.0f);
+
+struct BruteForceResult
+{
+    unsigned long long winningLines;    // 获胜路线数量
+    int minStackDraws;                  // 最少翻牌次数，不可胜时为-1
+};
+
+/**
+ * 随机小牌局：主牌区按4列排开，相邻卡牌互相重叠（后放的压住先放的）；
+ * 牌面集中在几个相邻数值，保证有足够多的可胜牌局
+ */
+LevelConfig* createRandomLevel(unsigned int seed, int playfieldCount, int stackCount)
+{
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> faceDist(CFT_FIVE, CFT_NINE);
+    std::uniform_int_distribution<int> suitDist(CST_CLUBS, CST_SPADES);
+    
+    LevelConfig* levelConfig = new LevelConfig();
+    for (int i = 0; i < playfieldCount; i++) {
+        CardPosition position(200.0f + (i % 4) * 90.0f, 1200.0f - (i / 4) * 120.0f);
+        levelConfig->addPlayfieldCard(CardConfig(static_cast<CardFaceType>(faceDist(random)),
+                                                 static_cast<CardSuitType>(suitDist(random)), position));
+    }
+    for (int i = 0; i < stackCount; i++) {
+        levelConfig->addStackCard(CardConfig(static_cast<CardFaceType>(faceDist(random)),
+                                             static_cast<CardSuitType>(suitDist(random)), CardPosition()));
+    }
+    return levelConfig;
+}
+
+GameModel* createRandomGame(unsigned int seed, int playfieldCount, int stackCount)
+{
+    LevelConfig* levelConfig = createRandomLevel(seed, playfieldCount, stackCount);
+    GameModel* gameModel = GameModelFromLevelGenerator::generateGameModel(levelConfig);
+    delete levelConfig;
+    return gameModel;
+}
+
+/**
+ * 在GameModel上穷举：每一步尝试所有可匹配的主牌区卡牌和翻牌，走完立即撤销
+ */
+BruteForceResult bruteForce(GameModel* gameModel, UndoManager* undoManager)
+{
+    BruteForceResult result = { 0, -1 };
+    if (gameModel->getPlayfieldCardIds().empty()) {
+        result.winningLines = 1;
+        result.minStackDraws = 0;
+        return result;
+    }
+    
+    std::vector<int> candidates;
+    for (int cardId : gameModel->getPlayfieldCardIds()) {
+        if (GameRulesService::canMatchWithTray(gameModel, cardId)) {
+            candidates.push_back(cardId);
+        }
+    }
+    
+    for (int cardId : candidates) {
+        UndoAction action;
+        EXPECT_TRUE(GameRulesService::replaceTrayFromPlayfield(gameModel, cardId, kTrayPosition, &action));
+        undoManager->recordAction(action);
+        BruteForceResult child = bruteForce(gameModel, undoManager);
+        EXPECT_TRUE(undoManager->performUndo(gameModel));
+        result.winningLines += child.winningLines;
+        if (child.minStackDraws >= 0 && (result.minStackDraws < 0 || child.minStackDraws < result.minStackDraws)) {
+            result.minStackDraws = child.minStackDraws;
+        }
+    }
+    
+    UndoAction action;
+    if (GameRulesService::replaceTrayFromStack(gameModel, kTrayPosition, &action)) {
+        undoManager->recordAction(action);
+        BruteForceResult child = bruteForce(gameModel, undoManager);
+        EXPECT_TRUE(undoManager->performUndo(gameModel));
+        result.winningLines += child.winningLines;
+        if (child.minStackDraws >= 0 && (result.minStackDraws < 0 || child.minStackDraws + 1 < result.minStackDraws)) {
+            result.minStackDraws = child.minStackDraws + 1;
+        }
+    }
+    return result;
+}
+
+void expectSolverMatchesBruteForce(GameModel* gameModel)
+{
+    LevelSolveResult solved = LevelSolver::solve(gameModel);
+    
+    UndoModel undoModel;
+    UndoManager undoManager;
+    undoManager.init(&undoModel);
+    std::vector<int> playfieldBefore = gameModel->getPlayfieldCardIds();
+    BruteForceResult expected = bruteForce(gameModel, &undoManager);
+    ASSERT_EQ(playfieldBefore, gameModel->getPlayfieldCardIds());
+    
+    ASSERT_TRUE(solved.supported);
+    EXPECT_EQ(expected.winningLines > 0, solved.winnable);
+    EXPECT_EQ(expected.winningLines, solved.winningLineCount);
+    EXPECT_EQ(expected.minStackDraws, solved.minStackDraws);
+    if (solved.winnable) {
+        EXPECT_EQ(static_cast<int>(gameModel->getPlayfieldCardIds().size()) + expected.minStackDraws,
+                  solved.minMoveCount);
+    } else {
+        EXPECT_EQ(-1, solved.minMoveCount);
+    }
+}
+
+} // namespace
+
+TEST(LevelSolverTest, MatchesBruteForceOnRandomDeals)
+{
+    int winnableCount = 0;
+    for (unsigned int seed = 1; seed <= 60; seed++) {
+        SCOPED_TRACE(seed);
+        GameModel* gameModel = createRandomGame(seed, 8, 6);
+        ASSERT_NE(nullptr, gameModel);
+        expectSolverMatchesBruteForce(gameModel);
+        winnableCount += LevelSolver::solve(gameModel).winnable ? 1 : 0;
+        delete gameModel;
+    }
+    
+    // 样本中既要有可胜也要有必败的牌局，否则比较没有意义
+    EXPECT_GT(winnableCount, 0);
+    EXPECT_LT(winnableCount, 60);
+}
+
+TEST(LevelSolverTest, MatchesBruteForceMidGame)
+{
+    // 先走几步再求解：求解从当前状态出发，不受已走步数影响
+    for (unsigned int seed = 100; seed < 120; seed++) {
+        SCOPED_TRACE(seed);
+        GameModel* gameModel = createRandomGame(seed, 10, 6);
+        ASSERT_NE(nullptr, gameModel);
+        for (int step = 0; step < 3; step++) {
+            std::vector<int> matchable;
+            gameModel->getMatchableCardIds(&matchable);
+            bool moved = !matchable.empty()
+                && GameRulesService::replaceTrayFromPlayfield(gameModel, matchable[0], kTrayPosition, nullptr);
+            if (!moved) {
+                GameRulesService::replaceTrayFromStack(gameModel, kTrayPosition, nullptr);
+            }
+        }
+        expectSolverMatchesBruteForce(gameModel);
+        delete gameModel;
+    }
+}
+
+TEST(LevelSolverTest, EmptyPlayfieldIsWon)
+{
+    GameModel* gameModel = createRandomGame(7, 0, 3);
+    ASSERT_NE(nullptr, gameModel);
+    LevelSolveResult solved = LevelSolver::solve(gameModel);
+    EXPECT_TRUE(solved.supported);
+    EXPECT_TRUE(solved.winnable);
+    EXPECT_EQ(0, solved.minStackDraws);
+    EXPECT_EQ(0, solved.minMoveCount);
+    EXPECT_EQ(1ULL, solved.winningLineCount);
+    delete gameModel;
+}
+
+TEST(LevelSolverTest, NoMatchingFaceIsLost)
+{
+    // 底牌和备用牌都是A，主牌区只有K：无论怎么翻都无法匹配
+    LevelConfig levelConfig;
+    levelConfig.addPlayfieldCard(CardConfig(CFT_KING, CST_CLUBS, CardPosition(200.0f, 1200.0f)));
+    levelConfig.addPlayfieldCard(CardConfig(CFT_KING, CST_HEARTS, CardPosition(600.0f, 1200.0f)));
+    for (int i = 0; i < 3; i++) {
+        levelConfig.addStackCard(CardConfig(CFT_ACE, CST_SPADES, CardPosition()));
+    }
+    GameModel* gameModel = GameModelFromLevelGenerator::generateGameModel(&levelConfig);
+    ASSERT_NE(nullptr, gameModel);
+    
+    LevelSolveResult solved = LevelSolver::solve(gameModel);
+    EXPECT_TRUE(solved.supported);
+    EXPECT_FALSE(solved.winnable);
+    EXPECT_EQ(-1, solved.minStackDraws);
+    EXPECT_EQ(-1, solved.minMoveCount);
+    EXPECT_EQ(0ULL, solved.winningLineCount);
+    expectSolverMatchesBruteForce(gameModel);
+    delete gameModel;
+}
+
+TEST(LevelSolverTest, TooManyPlayfieldCardsIsUnsupported)
+{
+    GameModel* gameModel = createRandomGame(9, LevelSolver::kMaxPlayfieldCards + 1, 2);
+    ASSERT_NE(nullptr, gameModel);
+    LevelSolveResult solved = LevelSolver::solve(gameModel);
+    EXPECT_FALSE(solved.supported);
+    EXPECT_FALSE(solved.winnable);
+    delete gameModel;
+}
@@ -0,0 +1,208 @@
+#include "models/PackedGameState.h"
+#include "managers/UndoManager.h"
+#include "configs/models/LevelLayoutTemplate.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "services/GameRulesService.h"
+#include "services/ProceduralLevelGenerator.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+// 紧凑状态与GameModel同步走随机对局：每一步增量更新的状态（含Zobrist哈希）与从模型重新打包的结果相同，
+// 撤销回到之前打包过的状态；由状态还原的模型与原模型逐项一致；对局中途建立的布局保留卡牌的发牌位置
+
+namespace {
+
+const CardPosition kTrayPosition(540.0f, 300.0f);
+
+GameModel* createGame(int seed)
+{
+    LevelLayoutTemplate layout;
+    if (!layout.initPeaks(3, 3, 16)) {
+        return nullptr;
+    }
+    LevelConfig* levelConfig = ProceduralLevelGenerator::generateLevelConfig(layout, seed, 0.5f);
+    if (!levelConfig) {
+        return nullptr;
+    }
+    GameModel* gameModel = GameModelFromLevelGenerator::generateGameModel(levelConfig);
+    delete levelConfig;
+    return gameModel;
+}
+
+void expectSameModel(const GameModel* expected, const GameModel* actual)
+{
+    EXPECT_EQ(expected->getPlayfieldCardIds(), actual->getPlayfieldCardIds());
+    EXPECT_EQ(expected->getStackCardIds(), actual->getStackCardIds());
+    EXPECT_EQ(expected->getTrayCardId(), actual->getTrayCardId());
+    ASSERT_EQ(expected->getAllCards().size(), actual->getAllCards().size());
+    for (const CardModel* card : expected->getAllCards()) {
+        const CardModel* other = actual->getCardById(card->getCardId());
+        ASSERT_NE(nullptr, other);
+        EXPECT_EQ(card->getFace(), other->getFace());
+        EXPECT_EQ(card->getSuit(), other->getSuit());
+        EXPECT_EQ(card->getLocation(), other->getLocation());
+        EXPECT_EQ(card->getPosition(), other->getPosition());
+        EXPECT_EQ(card->getHomePosition(), other->getHomePosition());
+        EXPECT_EQ(card->isFlipped(), other->isFlipped());
+        EXPECT_EQ(expected->isCardCovered(card->getCardId()), actual->isCardCovered(card->getCardId()));
+        if (card->getLocation() == CL_PLAYFIELD) {
+            EXPECT_EQ(card->isClickable(), other->isClickable());
+        }
+    }
+}
+
+void expectPacksTo(const PackedGameLayout* layout, const GameModel* gameModel, const PackedGameState& expected)
+{
+    PackedGameState packed;
+    ASSERT_TRUE(layout->packState(gameModel, &packed));
+    EXPECT_TRUE(packed == expected);
+    EXPECT_EQ(packed.hash, expected.hash);
+}
+
+} // namespace
+
+TEST(PackedGameStateTest, StaysInLockStepWithGameModel)
+{
+    for (int seed = 1; seed <= 20; seed++) {
+        SCOPED_TRACE(seed);
+        GameModel* gameModel = createGame(seed);
+        ASSERT_NE(nullptr, gameModel);
+        PackedGameLayout* layout = PackedGameLayout::createFromGameModel(gameModel);
+        ASSERT_NE(nullptr, layout);
+        
+        UndoModel undoModel;
+        UndoManager undoManager;
+        undoManager.init(&undoModel);
+        std::mt19937 random(seed);
+        PackedGameState state = layout->getInitialState();
+        std::vector<PackedGameState> history(1, state);
+        expectPacksTo(layout, gameModel, state);
+        
+        for (int step = 0; step < 60 && !state.isGameWon(); step++) {
+            // 偶尔撤销，其余时候随机选一张可匹配的牌，没有时翻牌
+            if (history.size() > 1 && random() % 5 == 0) {
+                ASSERT_TRUE(undoManager.performUndo(gameModel));
+                history.pop_back();
+                state = history.back();
+            } else {
+                std::vector<int> matchable;
+                gameModel->getMatchableCardIds(&matchable);
+                UndoAction action;
+                if (!matchable.empty()) {
+                    int cardId = matchable[random() % matchable.size()];
+                    int slot = layout->getCardIndex(cardId);
+                    ASSERT_TRUE(state.canMatchWithTray(slot));
+                    ASSERT_TRUE(GameRulesService::replaceTrayFromPlayfield(gameModel, cardId, kTrayPosition, &action));
+                    ASSERT_TRUE(state.replaceTrayFromPlayfield(slot));
+                } else if (GameRulesService::replaceTrayFromStack(gameModel, kTrayPosition, &action)) {
+                    ASSERT_TRUE(state.replaceTrayFromStack());
+                } else {
+                    EXPECT_FALSE(state.replaceTrayFromStack());
+                    break;
+                }
+                undoManager.recordAction(action);
+                history.push_back(state);
+            }
+            
+            expectPacksTo(layout, gameModel, state);
+            for (int cardId : gameModel->getPlayfieldCardIds()) {
+                EXPECT_EQ(GameRulesService::canMatchWithTray(gameModel, cardId),
+                          state.canMatchWithTray(layout->getCardIndex(cardId)));
+            }
+            
+            GameModel* restored = layout->createGameModel(state, kTrayPosition);
+            ASSERT_NE(nullptr, restored);
+            expectSameModel(gameModel, restored);
+            delete restored;
+        }
+        
+        delete layout;
+        delete gameModel;
+    }
+}
+
+TEST(PackedGameStateTest, HashDependsOnlyOnState)
+{
+    // 增量更新的哈希与直接打包同一模型状态得到的哈希相同，不同状态的哈希不同
+    GameModel* gameModel = createGame(42);
+    ASSERT_NE(nullptr, gameModel);
+    PackedGameLayout* layout = PackedGameLayout::createFromGameModel(gameModel);
+    ASSERT_NE(nullptr, layout);
+    
+    PackedGameState initial = layout->getInitialState();
+    PackedGameState drawn = initial;
+    ASSERT_TRUE(drawn.replaceTrayFromStack());
+    EXPECT_NE(initial.hash, drawn.hash);
+    
+    ASSERT_TRUE(GameRulesService::replaceTrayFromStack(gameModel, kTrayPosition, nullptr));
+    expectPacksTo(layout, gameModel, drawn);
+    
+    PackedGameState drawnTwice = drawn;
+    ASSERT_TRUE(drawnTwice.replaceTrayFromStack());
+    EXPECT_NE(drawn.hash, drawnTwice.hash);
+    EXPECT_NE(initial.hash, drawnTwice.hash);
+    
+    delete layout;
+    delete gameModel;
+}
+
+TEST(PackedGameStateTest, MidGameLayoutKeepsHomePositions)
+{
+    GameModel* gameModel = createGame(7);
+    ASSERT_NE(nullptr, gameModel);
+    UndoModel undoModel;
+    UndoManager undoManager;
+    undoManager.init(&undoModel);
+    
+    // 走到最后一步是从主牌区匹配为止
+    int movedCardId = -1;
+    for (int step = 0; step < 40 && (movedCardId < 0 || undoModel.getActionCount() < 3); step++) {
+        std::vector<int> matchable;
+        gameModel->getMatchableCardIds(&matchable);
+        UndoAction action;
+        if (!matchable.empty()) {
+            ASSERT_TRUE(GameRulesService::replaceTrayFromPlayfield(gameModel, matchable[0], kTrayPosition, &action));
+            movedCardId = matchable[0];
+        } else {
+            ASSERT_TRUE(GameRulesService::replaceTrayFromStack(gameModel, kTrayPosition, &action));
+            movedCardId = -1;
+        }
+        undoManager.recordAction(action);
+    }
+    ASSERT_GE(movedCardId, 0);
+    
+    PackedGameLayout* layout = PackedGameLayout::createFromGameModel(gameModel);
+    ASSERT_NE(nullptr, layout);
+    int movedIndex = layout->getCardIndex(movedCardId);
+    ASSERT_GE(movedIndex, 0);
+    EXPECT_EQ(kTrayPosition, layout->getInitialPosition(movedIndex));
+    EXPECT_EQ(gameModel->getCardById(movedCardId)->getHomePosition(), layout->getHomePosition(movedIndex));
+    
+    GameModel* restored = layout->createGameModel(layout->getInitialState(), kTrayPosition);
+    ASSERT_NE(nullptr, restored);
+    for (const CardModel* card : gameModel->getAllCards()) {
+        EXPECT_EQ(card->getHomePosition(), restored->getCardById(card->getCardId())->getHomePosition());
+        EXPECT_EQ(card->getPosition(), restored->getCardById(card->getCardId())->getPosition());
+    }
+    
+    // 在还原的模型上撤销最后一步：卡牌回到发牌位置，而不是留在底牌位置
+    UndoModel restoredUndo;
+    UndoManager restoredManager;
+    restoredManager.init(&restoredUndo);
+    for (int i = 0; i < undoModel.getActionCount(); i++) {
+        restoredManager.recordAction(undoModel.getAction(i));
+    }
+    ASSERT_TRUE(undoManager.performUndo(gameModel));
+    ASSERT_TRUE(restoredManager.performUndo(restored));
+    const CardModel* movedCard = restored->getCardById(movedCardId);
+    EXPECT_EQ(CL_PLAYFIELD, movedCard->getLocation());
+    EXPECT_EQ(gameModel->getCardById(movedCardId)->getPosition(), movedCard->getPosition());
+    EXPECT_EQ(movedCard->getHomePosition(), movedCard->getPosition());
+    EXPECT_NE(kTrayPosition, movedCard->getPosition());
+    EXPECT_EQ(gameModel->getTrayCardId(), restored->getTrayCardId());
+    
+    delete restored;
+    delete layout;
+    delete gameModel;
+}
@@ -0,0 +1,307 @@
+#include "managers/SaveJournalManager.h"
+#include "managers/UndoManager.h"
+#include "configs/models/LevelLayoutTemplate.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "services/GameRulesService.h"
+#include "services/ProceduralLevelGenerator.h"
+#include "services/ReplayPlayerService.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// 自动存档日志的撤销/重做往返：恢复后撤销游标与可重做记录和恢复前一致，
+// 重做记为单独的记录，不会像普通操作一样清除之后的可重做记录；
+// 尾部记录写了一半、CRC错误或序号不连续时恢复到最后一条完好的记录；记录达到压缩间隔时重写为新的基础快照
+
+namespace {
+
+const CardPosition kTrayPosition(540.0f, 300.0f);
+
+class SaveJournalManagerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _filePath = ::testing::TempDir() + "save_journal_test.journal";
+        remove(_filePath.c_str());
+        
+        LevelLayoutTemplate layout;
+        ASSERT_TRUE(layout.initPeaks(3, 3, 16));
+        LevelConfig* levelConfig = ProceduralLevelGenerator::generateLevelConfig(layout, 42, 0.5f);
+        ASSERT_NE(nullptr, levelConfig);
+        _gameModel = GameModelFromLevelGenerator::generateGameModel(levelConfig);
+        delete levelConfig;
+        ASSERT_NE(nullptr, _gameModel);
+        
+        _undoManager.init(&_undoModel);
+        _journal.init(_filePath);
+        ASSERT_TRUE(_journal.startJournal(7, _gameModel, &_undoModel));
+        _stateHashes.push_back(stateHash());
+    }
+    
+    void TearDown() override
+    {
+        _journal.discard();
+        delete _gameModel;
+    }
+    
+    // 与GameController相同：修改模型、记录撤销、追加日志
+    void drawFromStack()
+    {
+        UndoAction action;
+        ASSERT_TRUE(GameRulesService::replaceTrayFromStack(_gameModel, kTrayPosition, &action));
+        _undoManager.recordAction(action);
+        ASSERT_TRUE(_journal.appendMove(action, kTrayPosition, _gameModel, &_undoModel));
+        _stateHashes.push_back(stateHash());
+    }
+    
+    void undo()
+    {
+        ASSERT_TRUE(_undoManager.performUndo(_gameModel));
+        ASSERT_TRUE(_journal.appendUndo(_gameModel, &_undoModel));
+        _stateHashes.push_back(stateHash());
+    }
+    
+    void redo()
+    {
+        UndoAction action;
+        ASSERT_TRUE(_undoManager.performRedo(_gameModel, kTrayPosition, &action));
+        ASSERT_TRUE(_journal.appendRedo(action, kTrayPosition, _gameModel, &_undoModel));
+        _stateHashes.push_back(stateHash());
+    }
+    
+    uint64_t stateHash() const
+    {
+        return ReplayPlayerService::computeStateHash(_gameModel, &_undoModel);
+    }
+    
+    // 读取关闭后的日志文件
+    std::vector<char> readFile() const
+    {
+        std::vector<char> bytes;
+        FILE* file = fopen(_filePath.c_str(), "rb");
+        if (file) {
+            char chunk[4096];
+            size_t size = 0;
+            while ((size = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+                bytes.insert(bytes.end(), chunk, chunk + size);
+            }
+            fclose(file);
+        }
+        return bytes;
+    }
+    
+    void writeFile(const std::vector<char>& bytes) const
+    {
+        FILE* file = fopen(_filePath.c_str(), "wb");
+        ASSERT_NE(nullptr, file);
+        ASSERT_EQ(bytes.size(), fwrite(bytes.data(), 1, bytes.size(), file));
+        fclose(file);
+    }
+    
+    // 第index条记录在文件中的偏移（文件头之后是基础快照）
+    static size_t recordOffset(const std::vector<char>& bytes, int index)
+    {
+        SaveJournalHeader header;
+        memcpy(&header, bytes.data(), sizeof(header));
+        return sizeof(SaveJournalHeader) + header.snapshotSize + index * sizeof(SaveJournalRecord);
+    }
+    
+    // 用新的管理器恢复被改动的日志，恢复后的状态应等于前goodCount条记录重放后的状态
+    void expectRestoreStopsAt(int goodCount)
+    {
+        ASSERT_LT(goodCount, static_cast<int>(_stateHashes.size()));
+        ASSERT_NE(_stateHashes[0], _stateHashes[goodCount]);
+        SaveJournalManager journal;
+        journal.init(_filePath);
+        GameModel restoredModel;
+        UndoModel restoredUndo;
+        int levelId = 0;
+        ASSERT_TRUE(journal.restoreJournal(&restoredModel, &restoredUndo, &levelId));
+        EXPECT_EQ(7, levelId);
+        uint64_t restoredHash = ReplayPlayerService::computeStateHash(&restoredModel, &restoredUndo);
+        EXPECT_EQ(_stateHashes[goodCount], restoredHash);
+        if (goodCount + 1 < static_cast<int>(_stateHashes.size())) {
+            EXPECT_NE(_stateHashes.back(), restoredHash);
+        }
+    }
+    
+    // 关闭日志后用新的管理器恢复（模拟应用被结束后重新启动），并与当前状态比较
+    void expectRestoreMatches(GameModel* restoredModel, UndoModel* restoredUndo)
+    {
+        _journal.close();
+        SaveJournalManager journal;
+        journal.init(_filePath);
+        int levelId = 0;
+        ASSERT_TRUE(journal.restoreJournal(restoredModel, restoredUndo, &levelId));
+        EXPECT_EQ(7, levelId);
+        EXPECT_EQ(_undoModel.getActionCount(), restoredUndo->getActionCount());
+        ASSERT_EQ(_undoModel.getRedoCount(), restoredUndo->getRedoCount());
+        for (int i = 0; i < _undoModel.getRedoCount(); i++) {
+            EXPECT_EQ(_undoModel.getRedoAction(i).fromCardId, restoredUndo->getRedoAction(i).fromCardId);
+            EXPECT_EQ(_undoModel.getRedoAction(i).toCardId, restoredUndo->getRedoAction(i).toCardId);
+        }
+        EXPECT_EQ(ReplayPlayerService::computeStateHash(_gameModel, &_undoModel),
+                  ReplayPlayerService::computeStateHash(restoredModel, restoredUndo));
+    }
+    
+    std::string _filePath;
+    GameModel* _gameModel = nullptr;
+    UndoModel _undoModel;
+    UndoManager _undoManager;
+    SaveJournalManager _journal;
+    std::vector<uint64_t> _stateHashes;     // 第i项为追加前i条记录后的状态
+};
+
+} // namespace
+
+TEST_F(SaveJournalManagerTest, RedoAvailableAfterRestore)
+{
+    drawFromStack();
+    drawFromStack();
+    drawFromStack();
+    undo();
+    undo();
+    ASSERT_EQ(2, _undoModel.getRedoCount());
+    
+    GameModel restoredModel;
+    UndoModel restoredUndo;
+    expectRestoreMatches(&restoredModel, &restoredUndo);
+    
+    // 恢复后的重做与恢复前的重做得到相同的状态
+    UndoManager restoredManager;
+    restoredManager.init(&restoredUndo);
+    ASSERT_TRUE(restoredManager.canRedo());
+    UndoAction restoredAction;
+    ASSERT_TRUE(restoredManager.performRedo(&restoredModel, kTrayPosition, &restoredAction));
+    UndoAction action;
+    ASSERT_TRUE(_undoManager.performRedo(_gameModel, kTrayPosition, &action));
+    EXPECT_EQ(action.fromCardId, restoredAction.fromCardId);
+    EXPECT_EQ(ReplayPlayerService::computeStateHash(_gameModel, &_undoModel),
+              ReplayPlayerService::computeStateHash(&restoredModel, &restoredUndo));
+}
+
+TEST_F(SaveJournalManagerTest, RedoRecordKeepsLaterRedo)
+{
+    drawFromStack();
+    drawFromStack();
+    drawFromStack();
+    undo();
+    undo();
+    redo();
+    ASSERT_EQ(1, _undoModel.getRedoCount());
+    
+    GameModel restoredModel;
+    UndoModel restoredUndo;
+    expectRestoreMatches(&restoredModel, &restoredUndo);
+}
+
+TEST_F(SaveJournalManagerTest, RedoSurvivesCompaction)
+{
+    drawFromStack();
+    drawFromStack();
+    drawFromStack();
+    undo();
+    undo();
+    
+    // 第一次恢复把状态压缩为新的基础快照，第二次恢复只读取快照
+    {
+        GameModel restoredModel;
+        UndoModel restoredUndo;
+        expectRestoreMatches(&restoredModel, &restoredUndo);
+    }
+    GameModel restoredModel;
+    UndoModel restoredUndo;
+    expectRestoreMatches(&restoredModel, &restoredUndo);
+    EXPECT_EQ(2, restoredUndo.getRedoCount());
+}
+
+TEST_F(SaveJournalManagerTest, NewMoveClearsRedo)
+{
+    drawFromStack();
+    drawFromStack();
+    undo();
+    drawFromStack();
+    ASSERT_EQ(0, _undoModel.getRedoCount());
+    
+    GameModel restoredModel;
+    UndoModel restoredUndo;
+    expectRestoreMatches(&restoredModel, &restoredUndo);
+}
+
+TEST_F(SaveJournalManagerTest, TornTailStopsAtLastGoodRecord)
+{
+    drawFromStack();
+    drawFromStack();
+    undo();
+    drawFromStack();
+    _journal.close();
+    
+    // 最后一条记录只写了一半
+    std::vector<char> bytes = readFile();
+    ASSERT_EQ(recordOffset(bytes, 4), bytes.size());
+    bytes.resize(recordOffset(bytes, 3) + sizeof(SaveJournalRecord) / 2);
+    writeFile(bytes);
+    expectRestoreStopsAt(3);
+}
+
+TEST_F(SaveJournalManagerTest, CrcMismatchStopsAtLastGoodRecord)
+{
+    drawFromStack();
+    drawFromStack();
+    drawFromStack();
+    undo();
+    _journal.close();
+    
+    // 第3条记录的CRC被改动，之后的记录即使完好也不再重放
+    std::vector<char> bytes = readFile();
+    bytes[recordOffset(bytes, 2) + offsetof(SaveJournalRecord, crc)] ^= 0x5A;
+    writeFile(bytes);
+    expectRestoreStopsAt(2);
+}
+
+TEST_F(SaveJournalManagerTest, SequenceGapStopsAtLastGoodRecord)
+{
+    drawFromStack();
+    drawFromStack();
+    drawFromStack();
+    drawFromStack();
+    _journal.close();
+    
+    // 交换第2、3条记录：两条记录各自的CRC都正确，但序号不连续
+    std::vector<char> bytes = readFile();
+    std::vector<char> record(bytes.begin() + recordOffset(bytes, 1), bytes.begin() + recordOffset(bytes, 2));
+    std::copy(bytes.begin() + recordOffset(bytes, 2), bytes.begin() + recordOffset(bytes, 3),
+              bytes.begin() + recordOffset(bytes, 1));
+    std::copy(record.begin(), record.end(), bytes.begin() + recordOffset(bytes, 2));
+    writeFile(bytes);
+    expectRestoreStopsAt(1);
+}
+
+TEST_F(SaveJournalManagerTest, CompactsAfterInterval)
+{
+    // 翻牌与撤销交替，记录数超过压缩间隔而不会耗尽备用牌堆
+    const int recordCount = SaveJournalManager::kCompactInterval + 3;
+    for (int i = 0; i < recordCount; i++) {
+        if (i % 2 == 0) {
+            drawFromStack();
+        } else {
+            undo();
+        }
+    }
+    EXPECT_EQ(recordCount - SaveJournalManager::kCompactInterval, _journal.getRecordCount());
+    _journal.close();
+    
+    // 压缩时重写了基础快照：文件中只有压缩之后追加的记录
+    std::vector<char> bytes = readFile();
+    ASSERT_EQ(recordOffset(bytes, recordCount - SaveJournalManager::kCompactInterval), bytes.size());
+    
+    // 截掉压缩后的记录，剩下的基础快照就是压缩时的状态
+    bytes.resize(recordOffset(bytes, 0));
+    writeFile(bytes);
+    expectRestoreStopsAt(SaveJournalManager::kCompactInterval);
+}
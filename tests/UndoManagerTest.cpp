@@ -0,0 +1,271 @@
+#include "managers/UndoManager.h"
+#include "configs/models/LevelLayoutTemplate.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "services/GameRulesService.h"
+#include "services/ProceduralLevelGenerator.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <vector>
+
+// 重做恢复撤销前的完整状态，新操作清空重做记录；带操作树时相同前缀复用子节点，
+// 可以沿被放弃的分支重做，随机走牌、撤销、重做和切换分支后每个节点始终对应同一个局面
+
+namespace {
+
+const CardPosition kTrayPosition(540.0f, 300.0f);
+
+/**
+ * 对局局面：各区域和每张卡牌的状态
+ */
+struct GameState
+{
+    std::vector<int> playfieldIds;
+    std::vector<int> stackIds;
+    int trayCardId;
+    std::vector<int> locations;
+    std::vector<CardPosition> positions;
+    std::vector<bool> clickable;
+    std::vector<bool> flipped;
+    
+    bool operator==(const GameState& other) const
+    {
+        return playfieldIds == other.playfieldIds && stackIds == other.stackIds && trayCardId == other.trayCardId
+            && locations == other.locations && positions == other.positions && clickable == other.clickable
+            && flipped == other.flipped;
+    }
+};
+
+GameState captureState(const GameModel* gameModel)
+{
+    GameState state;
+    state.playfieldIds = gameModel->getPlayfieldCardIds();
+    state.stackIds = gameModel->getStackCardIds();
+    state.trayCardId = gameModel->getTrayCardId();
+    for (const CardModel* card : gameModel->getAllCards()) {
+        state.locations.push_back(card->getLocation());
+        state.positions.push_back(card->getPosition());
+        // 底牌和备用牌的可点击标记不参与规则判断，只比较主牌区卡牌
+        state.clickable.push_back(card->getLocation() == CL_PLAYFIELD && card->isClickable());
+        state.flipped.push_back(card->isFlipped());
+    }
+    return state;
+}
+
+bool sameAction(const UndoAction& a, const UndoAction& b)
+{
+    return a.type == b.type && a.fromCardId == b.fromCardId && a.toCardId == b.toCardId;
+}
+
+class UndoManagerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        LevelLayoutTemplate layout;
+        ASSERT_TRUE(layout.initPeaks(3, 3, 16));
+        LevelConfig* levelConfig = ProceduralLevelGenerator::generateLevelConfig(layout, 2024, 0.5f);
+        ASSERT_NE(nullptr, levelConfig);
+        _gameModel = GameModelFromLevelGenerator::generateGameModel(levelConfig);
+        delete levelConfig;
+        ASSERT_NE(nullptr, _gameModel);
+        _undoManager.init(&_undoModel);
+    }
+    
+    void TearDown() override
+    {
+        delete _gameModel;
+    }
+    
+    // 走一步（第choice个可匹配的卡牌，没有时翻牌）并记录
+    bool playMove(size_t choice, UndoAction* outAction)
+    {
+        std::vector<int> matchable;
+        _gameModel->getMatchableCardIds(&matchable);
+        UndoAction action;
+        bool moved = !matchable.empty()
+            && GameRulesService::replaceTrayFromPlayfield(_gameModel, matchable[choice % matchable.size()],
+                                                          kTrayPosition, &action);
+        if (!moved) {
+            moved = GameRulesService::replaceTrayFromStack(_gameModel, kTrayPosition, &action);
+        }
+        if (moved) {
+            _undoManager.recordAction(action);
+            if (outAction) {
+                *outAction = action;
+            }
+        }
+        return moved;
+    }
+    
+    GameModel* _gameModel = nullptr;
+    UndoModel _undoModel;
+    UndoManager _undoManager;
+};
+
+} // namespace
+
+TEST_F(UndoManagerTest, RedoRestoresStateBeforeUndo)
+{
+    std::vector<GameState> states(1, captureState(_gameModel));
+    std::vector<UndoAction> actions;
+    for (int step = 0; step < 12; step++) {
+        UndoAction action;
+        ASSERT_TRUE(playMove(0, &action));
+        actions.push_back(action);
+        states.push_back(captureState(_gameModel));
+    }
+    
+    // 全部撤销，每一步回到之前的局面
+    for (int step = 11; step >= 0; step--) {
+        ASSERT_TRUE(_undoManager.performUndo(_gameModel));
+        EXPECT_TRUE(states[step] == captureState(_gameModel));
+    }
+    EXPECT_FALSE(_undoManager.canUndo());
+    ASSERT_EQ(12, _undoModel.getRedoCount());
+    
+    // 全部重做，按原顺序得到同样的操作和局面
+    for (int step = 0; step < 12; step++) {
+        UndoAction action;
+        ASSERT_TRUE(_undoManager.performRedo(_gameModel, kTrayPosition, &action));
+        EXPECT_TRUE(sameAction(actions[step], action));
+        EXPECT_TRUE(states[step + 1] == captureState(_gameModel));
+    }
+    EXPECT_FALSE(_undoManager.canRedo());
+    EXPECT_EQ(12, _undoModel.getActionCount());
+}
+
+TEST_F(UndoManagerTest, NewActionClearsRedo)
+{
+    for (int step = 0; step < 5; step++) {
+        ASSERT_TRUE(playMove(0, nullptr));
+    }
+    ASSERT_TRUE(_undoManager.performUndo(_gameModel));
+    ASSERT_TRUE(_undoManager.performUndo(_gameModel));
+    ASSERT_TRUE(_undoManager.canRedo());
+    
+    ASSERT_TRUE(playMove(1, nullptr));
+    EXPECT_FALSE(_undoManager.canRedo());
+    
+    // 没有重做记录时重做失败，局面不变
+    GameState before = captureState(_gameModel);
+    UndoAction action;
+    EXPECT_FALSE(_undoManager.performRedo(_gameModel, kTrayPosition, &action));
+    EXPECT_TRUE(before == captureState(_gameModel));
+    EXPECT_EQ(4, _undoModel.getActionCount());
+}
+
+TEST_F(UndoManagerTest, MoveTreeReusesSharedPrefix)
+{
+    MoveTree moveTree;
+    _undoManager.setMoveTree(&moveTree);
+    
+    UndoAction first;
+    ASSERT_TRUE(playMove(0, &first));
+    const MoveTreeNode* firstNode = moveTree.getCurrent();
+    int nodeCount = moveTree.getNodeCount();
+    
+    // 撤销后走同样的一步：复用原节点，不新建节点
+    ASSERT_TRUE(_undoManager.performUndo(_gameModel));
+    EXPECT_EQ(moveTree.getRoot(), moveTree.getCurrent());
+    UndoAction again;
+    ASSERT_TRUE(playMove(0, &again));
+    ASSERT_TRUE(sameAction(first, again));
+    EXPECT_EQ(firstNode, moveTree.getCurrent());
+    EXPECT_EQ(nodeCount, moveTree.getNodeCount());
+    EXPECT_EQ(firstNode, moveTree.getRoot()->firstChild);
+    EXPECT_EQ(nullptr, firstNode->nextSibling);
+}
+
+TEST_F(UndoManagerTest, RedoBranchFollowsAbandonedLine)
+{
+    MoveTree moveTree;
+    _undoManager.setMoveTree(&moveTree);
+    
+    // 走到有可匹配卡牌的局面，在这里先匹配（之后放弃），再改为翻牌
+    while (!_gameModel->hasMatchableCard()) {
+        ASSERT_TRUE(playMove(0, nullptr));
+    }
+    const MoveTreeNode* forkNode = moveTree.getCurrent();
+    GameState forkState = captureState(_gameModel);
+    int forkDepth = _undoModel.getActionCount();
+    UndoAction abandoned;
+    ASSERT_TRUE(playMove(0, &abandoned));
+    ASSERT_EQ(UAT_REPLACE_TRAY_FROM_PLAYFIELD, abandoned.type);
+    const MoveTreeNode* abandonedNode = moveTree.getCurrent();
+    GameState abandonedState = captureState(_gameModel);
+    
+    ASSERT_TRUE(_undoManager.performUndo(_gameModel));
+    UndoAction latest;
+    ASSERT_TRUE(GameRulesService::replaceTrayFromStack(_gameModel, kTrayPosition, &latest));
+    _undoManager.recordAction(latest);
+    const MoveTreeNode* latestNode = moveTree.getCurrent();
+    GameState latestState = captureState(_gameModel);
+    ASSERT_TRUE(_undoManager.performUndo(_gameModel));
+    EXPECT_TRUE(forkState == captureState(_gameModel));
+    EXPECT_EQ(forkNode, moveTree.getCurrent());
+    
+    // 默认重做最近走过的分支
+    EXPECT_EQ(latestNode, moveTree.getRedoChild());
+    UndoAction action;
+    ASSERT_TRUE(_undoManager.performRedo(_gameModel, kTrayPosition, &action));
+    EXPECT_TRUE(sameAction(latest, action));
+    EXPECT_TRUE(latestState == captureState(_gameModel));
+    ASSERT_TRUE(_undoManager.performUndo(_gameModel));
+    
+    // 沿被放弃的分支重做：局面与当初走这一步时相同，撤销记录按新操作追加
+    ASSERT_TRUE(_undoManager.performRedoBranch(_gameModel, kTrayPosition, abandonedNode, &action));
+    EXPECT_TRUE(sameAction(abandoned, action));
+    EXPECT_TRUE(abandonedState == captureState(_gameModel));
+    EXPECT_EQ(abandonedNode, moveTree.getCurrent());
+    ASSERT_EQ(forkDepth + 1, _undoModel.getActionCount());
+    EXPECT_TRUE(sameAction(abandoned, _undoModel.getAction(forkDepth)));
+    
+    // 不是当前节点子节点的分支被拒绝
+    EXPECT_FALSE(_undoManager.performRedoBranch(_gameModel, kTrayPosition, latestNode, &action));
+    EXPECT_TRUE(abandonedState == captureState(_gameModel));
+    
+    ASSERT_TRUE(_undoManager.performUndo(_gameModel));
+    EXPECT_TRUE(forkState == captureState(_gameModel));
+    EXPECT_EQ(abandonedNode, moveTree.getRedoChild());
+}
+
+TEST_F(UndoManagerTest, MoveTreeNodesKeepTheirState)
+{
+    MoveTree moveTree;
+    _undoManager.setMoveTree(&moveTree);
+    std::mt19937 random(99);
+    std::map<const MoveTreeNode*, GameState> nodeStates;
+    nodeStates[moveTree.getCurrent()] = captureState(_gameModel);
+    
+    for (int step = 0; step < 400; step++) {
+        int operation = random() % 10;
+        const MoveTreeNode* current = moveTree.getCurrent();
+        if (operation < 4) {
+            playMove(random(), nullptr);
+        } else if (operation < 7) {
+            _undoManager.performUndo(_gameModel);
+        } else if (operation < 9) {
+            _undoManager.performRedo(_gameModel, kTrayPosition, nullptr);
+        } else if (current->firstChild) {
+            // 随机选一个子分支重做
+            std::vector<const MoveTreeNode*> children;
+            for (const MoveTreeNode* child = current->firstChild; child; child = child->nextSibling) {
+                children.push_back(child);
+            }
+            const MoveTreeNode* branch = children[random() % children.size()];
+            ASSERT_TRUE(_undoManager.performRedoBranch(_gameModel, kTrayPosition, branch, nullptr));
+            EXPECT_EQ(branch, moveTree.getCurrent());
+        }
+        
+        current = moveTree.getCurrent();
+        EXPECT_EQ(current->firstChild != nullptr, _undoManager.canRedo());
+        auto it = nodeStates.find(current);
+        if (it == nodeStates.end()) {
+            nodeStates[current] = captureState(_gameModel);
+        } else {
+            EXPECT_TRUE(it->second == captureState(_gameModel)) << "step " << step;
+        }
+    }
+    EXPECT_GT(nodeStates.size(), 20u);
+}
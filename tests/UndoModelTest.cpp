@@ -0,0 +1,205 @@
+#include "models/UndoModel.h"
+#include <gtest/gtest.h>
+#include <deque>
+#include <random>
+
+// 环形缓冲区撤销记录：已满时丢弃最早的记录，弹出的记录成为重做记录直到添加新记录，
+// 修改容量保留最近的记录；随机操作与用std::deque实现的参考模型逐条比较
+
+namespace {
+
+UndoAction makeAction(int index)
+{
+    UndoAction action;
+    action.type = (index % 2) ? UAT_REPLACE_TRAY_FROM_STACK : UAT_REPLACE_TRAY_FROM_PLAYFIELD;
+    action.fromCardId = index;
+    action.toCardId = index + 1000;
+    return action;
+}
+
+/**
+ * 参考模型：撤销记录和重做记录分开保存（重做记录队首为下一次重做）
+ */
+struct ReferenceUndoModel
+{
+    std::deque<UndoAction> actions;
+    std::deque<UndoAction> redoActions;
+    size_t capacity;
+    
+    explicit ReferenceUndoModel(size_t capacity)
+        : capacity(capacity)
+    {
+    }
+    
+    void push(const UndoAction& action)
+    {
+        redoActions.clear();
+        if (capacity == 0) {
+            return;
+        }
+        if (actions.size() == capacity) {
+            actions.pop_front();
+        }
+        actions.push_back(action);
+    }
+    
+    UndoAction pop()
+    {
+        if (actions.empty()) {
+            return UndoAction();
+        }
+        UndoAction action = actions.back();
+        actions.pop_back();
+        redoActions.push_front(action);
+        return action;
+    }
+    
+    UndoAction redo()
+    {
+        if (redoActions.empty()) {
+            return UndoAction();
+        }
+        UndoAction action = redoActions.front();
+        redoActions.pop_front();
+        actions.push_back(action);
+        return action;
+    }
+    
+    void resize(size_t newCapacity)
+    {
+        capacity = newCapacity;
+        while (actions.size() > capacity) {
+            actions.pop_front();
+        }
+        redoActions.clear();
+    }
+};
+
+void expectSameAction(const UndoAction& expected, const UndoAction& actual)
+{
+    EXPECT_EQ(expected.type, actual.type);
+    EXPECT_EQ(expected.fromCardId, actual.fromCardId);
+    EXPECT_EQ(expected.toCardId, actual.toCardId);
+}
+
+void expectSameHistory(const ReferenceUndoModel& expected, const UndoModel& actual)
+{
+    ASSERT_EQ(static_cast<int>(expected.capacity), actual.getCapacity());
+    ASSERT_EQ(static_cast<int>(expected.actions.size()), actual.getActionCount());
+    ASSERT_EQ(static_cast<int>(expected.redoActions.size()), actual.getRedoCount());
+    EXPECT_EQ(!expected.actions.empty(), actual.canUndo());
+    EXPECT_EQ(!expected.redoActions.empty(), actual.canRedo());
+    for (size_t i = 0; i < expected.actions.size(); i++) {
+        expectSameAction(expected.actions[i], actual.getAction(static_cast<int>(i)));
+    }
+    for (size_t i = 0; i < expected.redoActions.size(); i++) {
+        expectSameAction(expected.redoActions[i], actual.getRedoAction(static_cast<int>(i)));
+    }
+    expectSameAction(expected.redoActions.empty() ? UndoAction() : expected.redoActions.front(),
+                     actual.peekRedoAction());
+}
+
+} // namespace
+
+TEST(UndoModelTest, FullBufferEvictsOldest)
+{
+    UndoModel undoModel(4);
+    for (int i = 0; i < 10; i++) {
+        undoModel.pushAction(makeAction(i));
+    }
+    ASSERT_EQ(4, undoModel.getActionCount());
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(6 + i, undoModel.getAction(i).fromCardId);
+    }
+    
+    // 弹出顺序从最新到最早，之后没有更多记录
+    for (int i = 9; i >= 6; i--) {
+        EXPECT_EQ(i, undoModel.popAction().fromCardId);
+    }
+    EXPECT_FALSE(undoModel.canUndo());
+    EXPECT_EQ(UAT_NONE, undoModel.popAction().type);
+    EXPECT_EQ(4, undoModel.getRedoCount());
+}
+
+TEST(UndoModelTest, PushClearsRedo)
+{
+    UndoModel undoModel(8);
+    for (int i = 0; i < 5; i++) {
+        undoModel.pushAction(makeAction(i));
+    }
+    undoModel.popAction();
+    undoModel.popAction();
+    ASSERT_EQ(2, undoModel.getRedoCount());
+    EXPECT_EQ(3, undoModel.peekRedoAction().fromCardId);
+    EXPECT_EQ(3, undoModel.redoAction().fromCardId);
+    EXPECT_EQ(4, undoModel.peekRedoAction().fromCardId);
+    
+    undoModel.pushAction(makeAction(20));
+    EXPECT_FALSE(undoModel.canRedo());
+    EXPECT_EQ(UAT_NONE, undoModel.redoAction().type);
+    ASSERT_EQ(5, undoModel.getActionCount());
+    EXPECT_EQ(20, undoModel.getAction(4).fromCardId);
+}
+
+TEST(UndoModelTest, SetCapacityKeepsNewest)
+{
+    UndoModel undoModel(6);
+    for (int i = 0; i < 9; i++) {
+        undoModel.pushAction(makeAction(i));
+    }
+    undoModel.popAction();
+    
+    undoModel.setCapacity(3);
+    EXPECT_EQ(3, undoModel.getCapacity());
+    ASSERT_EQ(3, undoModel.getActionCount());
+    EXPECT_FALSE(undoModel.canRedo());
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(5 + i, undoModel.getAction(i).fromCardId);
+    }
+    
+    // 扩容后保留原有记录，新记录追加在后面
+    undoModel.setCapacity(10);
+    undoModel.pushAction(makeAction(30));
+    ASSERT_EQ(4, undoModel.getActionCount());
+    EXPECT_EQ(5, undoModel.getAction(0).fromCardId);
+    EXPECT_EQ(30, undoModel.getAction(3).fromCardId);
+    
+    // 容量为0时不保存任何记录
+    undoModel.setCapacity(0);
+    undoModel.pushAction(makeAction(31));
+    EXPECT_FALSE(undoModel.canUndo());
+    EXPECT_EQ(UAT_NONE, undoModel.popAction().type);
+}
+
+TEST(UndoModelTest, MatchesReferenceUnderRandomOperations)
+{
+    std::mt19937 random(17);
+    UndoModel undoModel(5);
+    ReferenceUndoModel reference(5);
+    int nextIndex = 0;
+    
+    for (int step = 0; step < 5000; step++) {
+        int operation = random() % 10;
+        if (operation < 5) {
+            UndoAction action = makeAction(nextIndex++);
+            undoModel.pushAction(action);
+            reference.push(action);
+        } else if (operation < 7) {
+            expectSameAction(reference.pop(), undoModel.popAction());
+        } else if (operation < 9) {
+            expectSameAction(reference.redo(), undoModel.redoAction());
+        } else if (random() % 4 == 0) {
+            undoModel.clear();
+            reference.actions.clear();
+            reference.redoActions.clear();
+        } else {
+            int capacity = random() % 9;
+            undoModel.setCapacity(capacity);
+            reference.resize(capacity);
+        }
+        expectSameHistory(reference, undoModel);
+        if (HasFatalFailure()) {
+            return;
+        }
+    }
+}
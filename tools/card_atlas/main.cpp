@@ -0,0 +1,361 @@
+#include "configs/models/CardAtlasLayout.h"
+#include "configs/models/CardResConfig.h"
+#include "utils/CardGeometry.h"
+#include "utils/Crc32.h"
+#include <zlib.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * @file main.cpp
+ * @brief 卡牌图集生成工具
+ * @details 用法：CardAtlasTool <资源目录>
+ *          按CardAtlasLayout排布绘制52张正面和1张背面（与原先的占位样式相同：花色底色、白色边框、
+ *          居中的牌面文字，另在左上角标出花色），写出<资源目录>/images/cards.png和cards.plist
+ *          （多页时为cards_1等），帧名称为CardResConfig给出的纹理路径；资源目录下的images目录需已存在
+ *          有美术资源后可以用TexturePacker等工具生成同名帧的图集替换
+ */
+
+namespace {
+
+/**
+ * @brief 5x7点阵字形（每行低5位，最高位在左）
+ */
+struct Glyph
+{
+    char character;
+    unsigned char rows[7];
+};
+
+const Glyph kGlyphs[] = {
+    { 'A', { 0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 } },
+    { 'J', { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C } },
+    { 'Q', { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D } },
+    { 'K', { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 } },
+    { '0', { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E } },
+    { '1', { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+    { '2', { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F } },
+    { '3', { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E } },
+    { '4', { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 } },
+    { '5', { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E } },
+    { '6', { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E } },
+    { '7', { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 } },
+    { '8', { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E } },
+    { '9', { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C } },
+    { 'C', { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E } },
+    { 'D', { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C } },
+    { 'H', { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 } },
+    { 'S', { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E } },
+};
+
+const int kGlyphWidth = 5;
+const int kGlyphHeight = 7;
+const int kFaceTextScale = 6;       // 牌面文字的放大倍数
+const int kSuitTextScale = 3;       // 角落花色字母的放大倍数
+const int kBorderWidth = 2;         // 边框宽度
+
+/**
+ * @brief RGBA颜色
+ */
+struct Color
+{
+    unsigned char r, g, b, a;
+};
+
+const Color kWhite = { 255, 255, 255, 255 };
+const Color kBackColor = { 40, 52, 110, 255 };
+const Color kBackPatternColor = { 70, 86, 160, 255 };
+
+/**
+ * @brief 花色底色（与CardView原先的占位颜色相同）
+ */
+Color getSuitColor(CardSuitType suit)
+{
+    switch (suit) {
+        case CST_CLUBS:    return { 51, 204, 51, 255 };
+        case CST_DIAMONDS: return { 204, 51, 51, 255 };
+        case CST_HEARTS:   return { 204, 102, 153, 255 };
+        case CST_SPADES:   return { 51, 51, 204, 255 };
+        default:           return { 128, 128, 128, 255 };
+    }
+}
+
+/**
+ * @class Image
+ * @brief RGBA图像（第0行在上）
+ */
+class Image
+{
+public:
+    Image(int width, int height)
+        : _width(width)
+        , _height(height)
+        , _pixels(static_cast<size_t>(width) * height * 4, 0)
+    {
+    }
+    
+    int getWidth() const { return _width; }
+    int getHeight() const { return _height; }
+    const std::vector<unsigned char>& getPixels() const { return _pixels; }
+    
+    void setPixel(int x, int y, const Color& color)
+    {
+        if (x < 0 || y < 0 || x >= _width || y >= _height) {
+            return;
+        }
+        unsigned char* pixel = &_pixels[(static_cast<size_t>(y) * _width + x) * 4];
+        pixel[0] = color.r;
+        pixel[1] = color.g;
+        pixel[2] = color.b;
+        pixel[3] = color.a;
+    }
+    
+    Color getPixel(int x, int y) const
+    {
+        const unsigned char* pixel = &_pixels[(static_cast<size_t>(y) * _width + x) * 4];
+        Color color = { pixel[0], pixel[1], pixel[2], pixel[3] };
+        return color;
+    }
+    
+    void fillRect(int x, int y, int width, int height, const Color& color)
+    {
+        for (int row = y; row < y + height; row++) {
+            for (int column = x; column < x + width; column++) {
+                setPixel(column, row, color);
+            }
+        }
+    }
+    
+private:
+    int _width;
+    int _height;
+    std::vector<unsigned char> _pixels;
+};
+
+/**
+ * @brief 绘制一串点阵文字
+ * @param centerX 文字中心（像素）
+ * @param top 文字顶部（像素）
+ */
+void drawText(Image* image, const std::string& text, int centerX, int top, int scale, const Color& color)
+{
+    int advance = (kGlyphWidth + 1) * scale;
+    int left = centerX - (static_cast<int>(text.size()) * advance - scale) / 2;
+    for (size_t i = 0; i < text.size(); i++) {
+        const Glyph* glyph = nullptr;
+        for (const Glyph& candidate : kGlyphs) {
+            if (candidate.character == text[i]) {
+                glyph = &candidate;
+            }
+        }
+        if (!glyph) {
+            continue;
+        }
+        for (int row = 0; row < kGlyphHeight; row++) {
+            for (int column = 0; column < kGlyphWidth; column++) {
+                if (glyph->rows[row] & (0x10 >> column)) {
+                    image->fillRect(left + static_cast<int>(i) * advance + column * scale, top + row * scale,
+                                    scale, scale, color);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 绘制一帧
+ * @param frameIndex 帧序号（正面为花色*13+牌面，最后一帧为背面）
+ */
+void drawFrame(Image* image, const CardAtlasLayout& layout, int frameIndex)
+{
+    int x = 0;
+    int y = 0;
+    layout.getFrameOrigin(frameIndex, &x, &y);
+    int width = layout.getFrameWidth();
+    int height = layout.getFrameHeight();
+    
+    if (frameIndex == CardAtlasLayout::kBackFrameIndex) {
+        // 背面：深蓝底色加斜格纹
+        image->fillRect(x, y, width, height, kBackColor);
+        for (int row = 0; row < height; row++) {
+            for (int column = 0; column < width; column++) {
+                if ((column + row) % 12 == 0 || (column - row + height) % 12 == 0) {
+                    image->setPixel(x + column, y + row, kBackPatternColor);
+                }
+            }
+        }
+    } else {
+        CardSuitType suit = static_cast<CardSuitType>(frameIndex / CFT_NUM_CARD_FACE_TYPES);
+        CardFaceType face = static_cast<CardFaceType>(frameIndex % CFT_NUM_CARD_FACE_TYPES);
+        image->fillRect(x, y, width, height, getSuitColor(suit));
+        drawText(image, CardResConfig::getFaceName(face), x + width / 2,
+                 y + (height - kGlyphHeight * kFaceTextScale) / 2, kFaceTextScale, kWhite);
+        drawText(image, CardResConfig::getSuitSymbol(suit), x + kBorderWidth + 4 + kGlyphWidth * kSuitTextScale / 2,
+                 y + kBorderWidth + 4, kSuitTextScale, kWhite);
+    }
+    
+    // 白色边框
+    image->fillRect(x, y, width, kBorderWidth, kWhite);
+    image->fillRect(x, y + height - kBorderWidth, width, kBorderWidth, kWhite);
+    image->fillRect(x, y, kBorderWidth, height, kWhite);
+    image->fillRect(x + width - kBorderWidth, y, kBorderWidth, height, kWhite);
+    
+    // 边缘像素向外扩展到间隔区域
+    int padding = CardAtlasLayout::kFramePadding;
+    for (int row = -padding; row < height + padding; row++) {
+        int sourceRow = row < 0 ? 0 : (row >= height ? height - 1 : row);
+        for (int column = -padding; column < width + padding; column++) {
+            int sourceColumn = column < 0 ? 0 : (column >= width ? width - 1 : column);
+            if (sourceRow != row || sourceColumn != column) {
+                image->setPixel(x + column, y + row, image->getPixel(x + sourceColumn, y + sourceRow));
+            }
+        }
+    }
+}
+
+/**
+ * @brief 追加一个PNG数据块
+ */
+void appendChunk(std::vector<unsigned char>* png, const char* type, const unsigned char* data, size_t size)
+{
+    unsigned char header[8] = {
+        static_cast<unsigned char>(size >> 24), static_cast<unsigned char>(size >> 16),
+        static_cast<unsigned char>(size >> 8), static_cast<unsigned char>(size),
+        static_cast<unsigned char>(type[0]), static_cast<unsigned char>(type[1]),
+        static_cast<unsigned char>(type[2]), static_cast<unsigned char>(type[3])
+    };
+    png->insert(png->end(), header, header + sizeof(header));
+    png->insert(png->end(), data, data + size);
+    uint32_t crc = Crc32::compute(data, size, Crc32::compute(header + 4, 4));
+    unsigned char crcBytes[4] = {
+        static_cast<unsigned char>(crc >> 24), static_cast<unsigned char>(crc >> 16),
+        static_cast<unsigned char>(crc >> 8), static_cast<unsigned char>(crc)
+    };
+    png->insert(png->end(), crcBytes, crcBytes + sizeof(crcBytes));
+}
+
+/**
+ * @brief 把图像写成PNG（RGBA8，不使用行滤波）
+ */
+bool writePng(const std::string& path, const Image& image)
+{
+    int width = image.getWidth();
+    int height = image.getHeight();
+    size_t rowSize = static_cast<size_t>(width) * 4;
+    std::vector<unsigned char> raw;
+    raw.reserve((rowSize + 1) * height);
+    for (int row = 0; row < height; row++) {
+        raw.push_back(0);
+        raw.insert(raw.end(), image.getPixels().begin() + row * rowSize, image.getPixels().begin() + (row + 1) * rowSize);
+    }
+    uLongf compressedSize = compressBound(static_cast<uLong>(raw.size()));
+    std::vector<unsigned char> compressed(compressedSize);
+    if (compress2(compressed.data(), &compressedSize, raw.data(), static_cast<uLong>(raw.size()), 9) != Z_OK) {
+        return false;
+    }
+    
+    static const unsigned char kSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    unsigned char header[13] = {
+        static_cast<unsigned char>(width >> 24), static_cast<unsigned char>(width >> 16),
+        static_cast<unsigned char>(width >> 8), static_cast<unsigned char>(width),
+        static_cast<unsigned char>(height >> 24), static_cast<unsigned char>(height >> 16),
+        static_cast<unsigned char>(height >> 8), static_cast<unsigned char>(height),
+        8, 6, 0, 0, 0
+    };
+    std::vector<unsigned char> png(kSignature, kSignature + sizeof(kSignature));
+    appendChunk(&png, "IHDR", header, sizeof(header));
+    appendChunk(&png, "IDAT", compressed.data(), compressedSize);
+    appendChunk(&png, "IEND", nullptr, 0);
+    
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool written = fwrite(png.data(), 1, png.size(), file) == png.size();
+    return fclose(file) == 0 && written;
+}
+
+/**
+ * @brief 写出一页的plist（Cocos2d-x SpriteFrameCache格式2）
+ */
+bool writePlist(const std::string& path, const CardAtlasLayout& layout, int page, const std::string& textureName)
+{
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+    int width = layout.getFrameWidth();
+    int height = layout.getFrameHeight();
+    fprintf(file, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                  "<!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" "
+                  "\"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">\n"
+                  "<plist version=\"1.0\">\n<dict>\n    <key>frames</key>\n    <dict>\n");
+    for (int frameIndex = 0; frameIndex < CardAtlasLayout::kFrameCount; frameIndex++) {
+        if (layout.getPageIndex(frameIndex) != page) {
+            continue;
+        }
+        std::string name = frameIndex == CardAtlasLayout::kBackFrameIndex
+            ? CardResConfig::getCardBackTexture()
+            : CardResConfig::getCardFrontTexture(static_cast<CardFaceType>(frameIndex % CFT_NUM_CARD_FACE_TYPES),
+                                                 static_cast<CardSuitType>(frameIndex / CFT_NUM_CARD_FACE_TYPES));
+        int x = 0;
+        int y = 0;
+        layout.getFrameOrigin(frameIndex, &x, &y);
+        fprintf(file, "        <key>%s</key>\n        <dict>\n"
+                      "            <key>frame</key>\n            <string>{{%d,%d},{%d,%d}}</string>\n"
+                      "            <key>offset</key>\n            <string>{0,0}</string>\n"
+                      "            <key>rotated</key>\n            <false/>\n"
+                      "            <key>sourceColorRect</key>\n            <string>{{0,0},{%d,%d}}</string>\n"
+                      "            <key>sourceSize</key>\n            <string>{%d,%d}</string>\n"
+                      "        </dict>\n",
+                name.c_str(), x, y, width, height, width, height, width, height);
+    }
+    fprintf(file, "    </dict>\n    <key>metadata</key>\n    <dict>\n"
+                  "        <key>format</key>\n        <integer>2</integer>\n"
+                  "        <key>realTextureFileName</key>\n        <string>%s</string>\n"
+                  "        <key>size</key>\n        <string>{%d,%d}</string>\n"
+                  "        <key>textureFileName</key>\n        <string>%s</string>\n"
+                  "    </dict>\n</dict>\n</plist>\n",
+            textureName.c_str(), layout.getPageWidth(), layout.getPageHeight(), textureName.c_str());
+    return fclose(file) == 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <resources_dir>\n", argv[0]);
+        return 2;
+    }
+    std::string resourcesDir = argv[1];
+    
+    CardAtlasLayout layout(static_cast<int>(kCardWidth), static_cast<int>(kCardHeight));
+    if (!layout.isValid()) {
+        fprintf(stderr, "card frame does not fit in a %d px texture\n", CardAtlasLayout::kMaxTextureSize);
+        return 1;
+    }
+    
+    for (int page = 0; page < layout.getPageCount(); page++) {
+        Image image(layout.getPageWidth(), layout.getPageHeight());
+        for (int frameIndex = 0; frameIndex < CardAtlasLayout::kFrameCount; frameIndex++) {
+            if (layout.getPageIndex(frameIndex) == page) {
+                drawFrame(&image, layout, frameIndex);
+            }
+        }
+        
+        // plist中的纹理名相对于plist所在目录
+        std::string texturePath = CardResConfig::getCardAtlasTexture(page);
+        std::string textureName = texturePath.substr(texturePath.find_last_of('/') + 1);
+        std::string plistPath = resourcesDir + "/" + CardResConfig::getCardAtlasPlist(page);
+        if (!writePng(resourcesDir + "/" + texturePath, image)
+            || !writePlist(plistPath, layout, page, textureName)) {
+            fprintf(stderr, "%s: failed to write atlas page %d\n", resourcesDir.c_str(), page);
+            return 1;
+        }
+        printf("%s: %dx%d\n", plistPath.c_str(), layout.getPageWidth(), layout.getPageHeight());
+    }
+    return 0;
+}
@@ -0,0 +1,515 @@
+#include "configs/models/CardAtlasLayout.h"
+#include "managers/UndoManager.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "services/GameRulesService.h"
+#include "utils/CardGeometry.h"
+#include "utils/CardHitGrid.h"
+#include "utils/CardTweenSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if POKER_CORE_JSON
+#include "configs/loaders/LevelConfigLoader.h"
+#include <sstream>
+#endif
+
+/**
+ * @file main.cpp
+ * @brief 规则核心库热点路径的微基准
+ * @details 用法：CoreBench [--sizes 50,500,5000] [--min-time MS] [--seed S] [--max-draw-calls N]
+ *                [--output results.json]
+ *          对每个规模（主牌区卡牌数，另有一半数量的备用牌）生成层层叠放的合成关卡，测量：
+ *          - generate_game_model: GameModelFromLevelGenerator::generateGameModel
+ *          - get_card_by_id: GameModel::getCardById随机查找
+ *          - hit_test_card: CardHitGrid::findTopmostClickable在牌桌范围内随机点击（GameView的卡牌点击检测）
+ *          - tween_frame: CardTweenSystem同时移动全部卡牌，动画中途重定向一半卡牌，按60帧每秒推进到全部完成
+ *          - remove_from_playfield / insert_to_playfield: 按随机顺序移除全部主牌区卡牌再全部放回
+ *          - perform_undo / perform_redo: UndoManager在完整对局历史（全部翻牌和匹配）上逐条撤销/重做
+ *          - parse_json_dom、serialize、deserialize: LevelConfigLoader::loadFromStringDom（parseJsonDocument）
+ *            和GameModel的JSON序列化（仅启用rapidjson时；未启用时在标准错误中注明跳过，
+ *            CI用-DPOKER_REQUIRE_JSON=ON配置，保证这几项不会被静默跳过）
+ *          每项至少运行3次且总耗时不少于MS毫秒；结果以JSON输出（默认标准输出），摘要输出到标准错误
+ *          另外按GameView的绘制顺序和CardAtlasLayout统计初始牌桌上卡牌的绘制调用数，
+ *          指定--max-draw-calls时超过N则返回1
+ */
+
+namespace {
+
+const CardPosition kStackPosition(300.0f, 400.0f);
+const CardPosition kTrayPosition(700.0f, 400.0f);
+
+const char* kUsage = "usage: %s [--sizes 50,500,5000] [--min-time MS] [--seed S] [--max-draw-calls N] "
+                     "[--output results.json]\n";
+
+#if POKER_CORE_JSON
+const bool kJsonEnabled = true;
+#else
+const bool kJsonEnabled = false;
+#endif
+
+// 保存被测函数的结果，防止编译器把查找优化掉
+volatile long long s_sink = 0;
+
+/**
+ * @struct BenchResult
+ * @brief 一项基准的结果
+ */
+struct BenchResult
+{
+    std::string name;           // 基准名称
+    int cardCount;              // 主牌区卡牌数
+    int iterations;             // 运行次数
+    long long opsPerIteration;  // 每次运行的操作数
+    double totalMs;             // 全部运行的计时部分之和
+    double minMs;               // 单次运行的最短计时
+};
+
+/**
+ * @struct DrawCallResult
+ * @brief 一个规模的卡牌绘制调用数
+ */
+struct DrawCallResult
+{
+    int cardCount;              // 主牌区卡牌数
+    int drawCalls;              // 绘制全部卡牌的绘制调用数
+    int atlasPages;             // 卡牌图集页数
+};
+
+/**
+ * @brief 计时函数类型：执行一次运行，返回其中计时部分的毫秒数（准备工作不计时）
+ */
+using TimedRun = std::function<double()>;
+
+unsigned int nextRandom(unsigned int* state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point startTime)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+/**
+ * @brief 生成层层叠放的合成关卡（与SnapshotBench相同的布局）
+ */
+void makeLevelConfig(int playfieldCount, unsigned int* randomState, LevelConfig* outConfig)
+{
+    for (int i = 0; i < playfieldCount; i++) {
+        int column = i % 8;
+        int row = (i / 8) % 10;
+        int layer = i / 80;
+        CardPosition position(100.0f + column * 110.0f + layer * 15.0f, 700.0f + row * 80.0f + layer * 10.0f);
+        outConfig->addPlayfieldCard(CardConfig(static_cast<CardFaceType>(nextRandom(randomState) % 13),
+                                               static_cast<CardSuitType>(nextRandom(randomState) % 4), position));
+    }
+    for (int i = 0; i < playfieldCount / 2 + 1; i++) {
+        outConfig->addStackCard(CardConfig(static_cast<CardFaceType>(nextRandom(randomState) % 13),
+                                           static_cast<CardSuitType>(nextRandom(randomState) % 4), kStackPosition));
+    }
+}
+
+/**
+ * @brief 重复运行直到达到最短总耗时，汇总结果
+ */
+BenchResult runBench(const char* name, int cardCount, long long opsPerIteration, double minTimeMs, const TimedRun& run)
+{
+    BenchResult result = { name, cardCount, 0, opsPerIteration, 0.0, 0.0 };
+    while (result.iterations < 3 || result.totalMs < minTimeMs) {
+        double ms = run();
+        result.minMs = result.iterations == 0 ? ms : std::min(result.minMs, ms);
+        result.totalMs += ms;
+        result.iterations++;
+    }
+    return result;
+}
+
+/**
+ * @brief 把整局对局（匹配优先，无法匹配时翻牌）记入撤销历史
+ */
+void playFullGame(GameModel* gameModel, UndoManager* undoManager, unsigned int* randomState)
+{
+    std::vector<int> matchable;
+    UndoAction action;
+    while (true) {
+        matchable.clear();
+        gameModel->getMatchableCardIds(&matchable);
+        std::sort(matchable.begin(), matchable.end());
+        if (!matchable.empty()) {
+            int cardId = matchable[nextRandom(randomState) % matchable.size()];
+            if (GameRulesService::replaceTrayFromPlayfield(gameModel, cardId, kTrayPosition, &action)) {
+                undoManager->recordAction(action);
+                continue;
+            }
+        }
+        if (!GameRulesService::replaceTrayFromStack(gameModel, kTrayPosition, &action)) {
+            return;
+        }
+        undoManager->recordAction(action);
+    }
+}
+
+#if POKER_CORE_JSON
+/**
+ * @brief 把关卡配置写成关卡文件格式的JSON
+ */
+std::string toLevelJson(const LevelConfig& levelConfig)
+{
+    std::ostringstream json;
+    const std::vector<CardConfig>* lists[2] = { &levelConfig.getPlayfieldCards(), &levelConfig.getStackCards() };
+    const char* names[2] = { "Playfield", "Stack" };
+    json << "{";
+    for (int list = 0; list < 2; list++) {
+        json << (list == 0 ? "\n" : ",\n") << "    \"" << names[list] << "\": [";
+        for (size_t i = 0; i < lists[list]->size(); i++) {
+            const CardConfig& card = (*lists[list])[i];
+            json << (i == 0 ? "\n" : ",\n")
+                 << "        { \"CardFace\": " << card.face << ", \"CardSuit\": " << card.suit
+                 << ", \"Position\": { \"x\": " << card.position.x << ", \"y\": " << card.position.y << " } }";
+        }
+        json << "\n    ]";
+    }
+    json << "\n}\n";
+    return json.str();
+}
+#endif
+
+/**
+ * @brief 统计绘制全部卡牌的绘制调用数
+ * @details 与GameView相同的绘制顺序：主牌区、底牌堆、备用牌堆（各层按卡牌创建顺序），
+ *          翻开的卡牌用正面帧，其他用背面帧
+ */
+DrawCallResult countCardDrawCalls(const GameModel* gameModel, int cardCount)
+{
+    static const CardLocation kLayerOrder[] = { CL_PLAYFIELD, CL_TRAY, CL_STACK };
+    std::vector<int> frameIndices;
+    for (CardLocation location : kLayerOrder) {
+        for (const CardModel* card : gameModel->getAllCards()) {
+            if (card->getLocation() == location) {
+                frameIndices.push_back(CardAtlasLayout::getFrameIndex(card->getFace(), card->getSuit(),
+                                                                      card->isFlipped()));
+            }
+        }
+    }
+    CardAtlasLayout layout(static_cast<int>(kCardWidth), static_cast<int>(kCardHeight));
+    DrawCallResult result = { cardCount, layout.countDrawCalls(frameIndices), layout.getPageCount() };
+    return result;
+}
+
+/**
+ * @brief 运行一个规模的全部基准
+ * @return 校验失败时返回false
+ */
+bool runSize(int cardCount, unsigned int seed, double minTimeMs, std::vector<BenchResult>* outResults,
+             std::vector<DrawCallResult>* outDrawCalls)
+{
+    unsigned int randomState = seed;
+    LevelConfig levelConfig;
+    makeLevelConfig(cardCount, &randomState, &levelConfig);
+    int totalCards = static_cast<int>(levelConfig.getPlayfieldCards().size() + levelConfig.getStackCards().size());
+    
+    outResults->push_back(runBench("generate_game_model", cardCount, 1, minTimeMs, [&]() {
+        auto startTime = std::chrono::steady_clock::now();
+        GameModel* gameModel = GameModelFromLevelGenerator::generateGameModel(&levelConfig);
+        double ms = elapsedMs(startTime);
+        delete gameModel;
+        return ms;
+    }));
+    
+    GameModel* gameModel = GameModelFromLevelGenerator::generateGameModel(&levelConfig);
+    if (!gameModel) {
+        fprintf(stderr, "%d cards: failed to generate game model\n", cardCount);
+        return false;
+    }
+    outDrawCalls->push_back(countCardDrawCalls(gameModel, cardCount));
+    
+    // 随机查找（包括少量不存在的ID）
+    const int lookupCount = 100000;
+    std::vector<int> lookupIds(lookupCount);
+    for (int& cardId : lookupIds) {
+        cardId = static_cast<int>(nextRandom(&randomState) % (totalCards + totalCards / 16 + 1));
+    }
+    outResults->push_back(runBench("get_card_by_id", cardCount, lookupCount, minTimeMs, [&]() {
+        auto startTime = std::chrono::steady_clock::now();
+        long long sum = 0;
+        for (int cardId : lookupIds) {
+            const CardModel* card = gameModel->getCardById(cardId);
+            sum += card ? card->getFace() : -1;
+        }
+        double ms = elapsedMs(startTime);
+        s_sink = s_sink + sum;
+        return ms;
+    }));
+    
+    // 按GameView的绘制顺序登记卡牌，在主牌区及其周围随机点击
+    CardHitGrid hitGrid;
+    int drawOrder = 0;
+    for (const CardModel* card : gameModel->getAllCards()) {
+        hitGrid.setCard(card->getCardId(), card->getPosition(), drawOrder++, card->isClickable());
+    }
+    const int touchCount = 100000;
+    std::vector<CardPosition> touchPoints(touchCount);
+    for (CardPosition& point : touchPoints) {
+        point.x = static_cast<float>(nextRandom(&randomState) % 1080);
+        point.y = static_cast<float>(300 + nextRandom(&randomState) % 1500);
+    }
+    outResults->push_back(runBench("hit_test_card", cardCount, touchCount, minTimeMs, [&]() {
+        auto startTime = std::chrono::steady_clock::now();
+        long long sum = 0;
+        for (const CardPosition& point : touchPoints) {
+            sum += hitGrid.findTopmostClickable(point);
+        }
+        double ms = elapsedMs(startTime);
+        s_sink = s_sink + sum;
+        return ms;
+    }));
+    
+    // 全部卡牌同时移动0.3秒，第9帧时一半卡牌改为移向底牌堆（连续撤销时的重定向），直到全部完成
+    std::vector<int> tweenCardIds;
+    std::vector<CardPosition> tweenStartPositions;
+    for (const CardModel* card : gameModel->getAllCards()) {
+        tweenCardIds.push_back(card->getCardId());
+        tweenStartPositions.push_back(card->getPosition());
+    }
+    const int frameCount = 18 + 9;
+    CardTweenSystem tweenSystem;
+    tweenSystem.reserve(totalCards, totalCards);
+    std::vector<CardTweenSystem::CompleteCallback> tweenCallbacks;
+    outResults->push_back(runBench("tween_frame", cardCount, static_cast<long long>(totalCards) * frameCount,
+                                   minTimeMs, [&]() {
+        auto startTime = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < tweenCardIds.size(); i++) {
+            tweenSystem.moveTo(tweenCardIds[i], tweenStartPositions[i], kTrayPosition, 0.3f);
+        }
+        double sum = 0.0;
+        for (int frame = 0; frame < frameCount; frame++) {
+            if (frame == 9) {
+                for (size_t i = 0; i < tweenCardIds.size(); i += 2) {
+                    const CardTween* tween = tweenSystem.findTween(tweenCardIds[i]);
+                    tweenSystem.moveTo(tweenCardIds[i], tween->position, kStackPosition, 0.3f);
+                }
+            }
+            tweenSystem.update(1.0f / 60.0f);
+            for (const CardTween& tween : tweenSystem.getTweens()) {
+                sum += tween.position.x;
+            }
+            tweenSystem.removeFinished(&tweenCallbacks);
+        }
+        double ms = elapsedMs(startTime);
+        s_sink = s_sink + static_cast<long long>(sum) + tweenSystem.size();
+        return ms;
+    }));
+    if (tweenSystem.size() != 0) {
+        fprintf(stderr, "%d cards: %d tweens still running after %d frames\n", cardCount, tweenSystem.size(),
+                frameCount);
+        return false;
+    }
+    
+    // 按随机顺序移除全部主牌区卡牌，再全部放回（放回后与原状态一致，可重复运行）
+    const std::vector<int> initialPlayfield = gameModel->getPlayfieldCardIds();
+    std::vector<int> removeOrder = initialPlayfield;
+    for (size_t i = removeOrder.size(); i > 1; i--) {
+        std::swap(removeOrder[i - 1], removeOrder[nextRandom(&randomState) % i]);
+    }
+    long long playfieldCount = static_cast<long long>(removeOrder.size());
+    double insertMs = 0.0;
+    std::vector<double> insertRuns;
+    outResults->push_back(runBench("remove_from_playfield", cardCount, playfieldCount, minTimeMs, [&]() {
+        auto startTime = std::chrono::steady_clock::now();
+        for (int cardId : removeOrder) {
+            gameModel->removeFromPlayfield(cardId);
+        }
+        double ms = elapsedMs(startTime);
+        startTime = std::chrono::steady_clock::now();
+        for (int cardId : removeOrder) {
+            gameModel->insertToPlayfield(cardId);
+        }
+        insertRuns.push_back(elapsedMs(startTime));
+        return ms;
+    }));
+    for (double ms : insertRuns) {
+        insertMs += ms;
+    }
+    BenchResult insertResult = { "insert_to_playfield", cardCount, static_cast<int>(insertRuns.size()), playfieldCount,
+                                 insertMs, *std::min_element(insertRuns.begin(), insertRuns.end()) };
+    outResults->push_back(insertResult);
+    if (gameModel->getPlayfieldCardIds() != initialPlayfield) {
+        fprintf(stderr, "%d cards: playfield differs after remove/insert round trip\n", cardCount);
+        delete gameModel;
+        return false;
+    }
+    
+    // 完整对局历史上逐条撤销，再逐条重做恢复（撤销历史容量足够保存全部操作）
+    UndoModel undoModel(totalCards + 1);
+    UndoManager undoManager;
+    undoManager.init(&undoModel);
+    playFullGame(gameModel, &undoManager, &randomState);
+    long long historyLength = undoModel.getActionCount();
+    std::vector<double> redoRuns;
+    bool historyOk = true;
+    outResults->push_back(runBench("perform_undo", cardCount, historyLength, minTimeMs, [&]() {
+        auto startTime = std::chrono::steady_clock::now();
+        while (undoManager.canUndo()) {
+            historyOk = undoManager.performUndo(gameModel) && historyOk;
+        }
+        double ms = elapsedMs(startTime);
+        startTime = std::chrono::steady_clock::now();
+        UndoAction action;
+        while (undoManager.canRedo()) {
+            historyOk = undoManager.performRedo(gameModel, kTrayPosition, &action) && historyOk;
+        }
+        redoRuns.push_back(elapsedMs(startTime));
+        return ms;
+    }));
+    double redoMs = 0.0;
+    for (double ms : redoRuns) {
+        redoMs += ms;
+    }
+    BenchResult redoResult = { "perform_redo", cardCount, static_cast<int>(redoRuns.size()), historyLength,
+                               redoMs, *std::min_element(redoRuns.begin(), redoRuns.end()) };
+    outResults->push_back(redoResult);
+    if (!historyOk || undoModel.getActionCount() != historyLength) {
+        fprintf(stderr, "%d cards: undo/redo round trip failed\n", cardCount);
+        delete gameModel;
+        return false;
+    }
+
+#if POKER_CORE_JSON
+    // 解析计时包含DOM解析和parseJsonDocument（后者为私有接口，通过loadFromStringDom调用）
+    std::string levelJson = toLevelJson(levelConfig);
+    outResults->push_back(runBench("parse_json_dom", cardCount, 1, minTimeMs, [&]() {
+        auto startTime = std::chrono::steady_clock::now();
+        LevelConfig* parsedConfig = LevelConfigLoader::loadFromStringDom(levelJson);
+        double ms = elapsedMs(startTime);
+        delete parsedConfig;
+        return ms;
+    }));
+    
+    outResults->push_back(runBench("serialize", cardCount, 1, minTimeMs, [&]() {
+        auto startTime = std::chrono::steady_clock::now();
+        rapidjson::Document json = gameModel->serialize();
+        double ms = elapsedMs(startTime);
+        s_sink = s_sink + (json.IsObject() ? 1 : 0);
+        return ms;
+    }));
+    
+    rapidjson::Document serialized = gameModel->serialize();
+    outResults->push_back(runBench("deserialize", cardCount, 1, minTimeMs, [&]() {
+        GameModel restoredModel;
+        auto startTime = std::chrono::steady_clock::now();
+        restoredModel.deserialize(serialized);
+        return elapsedMs(startTime);
+    }));
+#endif
+
+    delete gameModel;
+    return true;
+}
+
+/**
+ * @brief 以JSON输出全部结果
+ */
+void writeJson(FILE* file, const std::vector<BenchResult>& results, const std::vector<DrawCallResult>& drawCalls,
+               double minTimeMs, unsigned int seed)
+{
+    fprintf(file, "{\n  \"benchmark\": \"CoreBench\",\n  \"schema_version\": 1,\n");
+    fprintf(file, "  \"json_enabled\": %s,\n  \"min_time_ms\": %.1f,\n  \"seed\": %u,\n  \"results\": [",
+            kJsonEnabled ? "true" : "false", minTimeMs, seed);
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& result = results[i];
+        double ops = static_cast<double>(result.opsPerIteration > 0 ? result.opsPerIteration : 1);
+        fprintf(file, "%s\n    { \"name\": \"%s\", \"cards\": %d, \"iterations\": %d, \"ops_per_iteration\": %lld, "
+                      "\"mean_ns_per_op\": %.2f, \"min_ns_per_op\": %.2f, \"total_ms\": %.3f }",
+                i == 0 ? "" : ",", result.name.c_str(), result.cardCount, result.iterations, result.opsPerIteration,
+                result.totalMs * 1e6 / (result.iterations * ops), result.minMs * 1e6 / ops, result.totalMs);
+    }
+    fprintf(file, "\n  ],\n  \"draw_calls\": [");
+    for (size_t i = 0; i < drawCalls.size(); i++) {
+        fprintf(file, "%s\n    { \"cards\": %d, \"card_draw_calls\": %d, \"atlas_pages\": %d }",
+                i == 0 ? "" : ",", drawCalls[i].cardCount, drawCalls[i].drawCalls, drawCalls[i].atlasPages);
+    }
+    fprintf(file, "\n  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::vector<int> sizes;
+    double minTimeMs = 200.0;
+    unsigned int seed = 12345;
+    const char* outputPath = nullptr;
+    int maxDrawCalls = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--sizes") == 0 && i + 1 < argc) {
+            for (const char* text = argv[++i]; *text; text++) {
+                sizes.push_back(atoi(text));
+                while (text[1] && *text != ',') {
+                    text++;
+                }
+            }
+        } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            minTimeMs = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--max-draw-calls") == 0 && i + 1 < argc) {
+            maxDrawCalls = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else {
+            fprintf(stderr, kUsage, argv[0]);
+            return 2;
+        }
+    }
+    if (sizes.empty()) {
+        sizes = { 50, 500, 5000 };
+    }
+    for (int size : sizes) {
+        if (size <= 0 || seed == 0) {
+            fprintf(stderr, kUsage, argv[0]);
+            return 2;
+        }
+    }
+    
+    if (!kJsonEnabled) {
+        fprintf(stderr, "parse_json_dom, serialize, deserialize: skipped (built without rapidjson)\n");
+    }
+    
+    std::vector<BenchResult> results;
+    std::vector<DrawCallResult> drawCalls;
+    bool ok = true;
+    for (int size : sizes) {
+        ok = runSize(size, seed, minTimeMs, &results, &drawCalls) && ok;
+    }
+    for (const BenchResult& result : results) {
+        fprintf(stderr, "%-22s %5d cards %10.2f ns/op (min %10.2f, %lld ops x %d)\n", result.name.c_str(),
+                result.cardCount, result.totalMs * 1e6 / (result.iterations * static_cast<double>(result.opsPerIteration)),
+                result.minMs * 1e6 / result.opsPerIteration, result.opsPerIteration, result.iterations);
+    }
+    for (const DrawCallResult& result : drawCalls) {
+        bool exceeded = maxDrawCalls > 0 && result.drawCalls > maxDrawCalls;
+        fprintf(stderr, "%-22s %5d cards %10d draw calls (%d atlas pages)%s\n", "card_draw_calls", result.cardCount,
+                result.drawCalls, result.atlasPages, exceeded ? " exceeds --max-draw-calls" : "");
+        ok = !exceeded && ok;
+    }
+    
+    FILE* output = outputPath ? fopen(outputPath, "w") : stdout;
+    if (!output) {
+        fprintf(stderr, "%s: failed to open output\n", outputPath);
+        return 1;
+    }
+    writeJson(output, results, drawCalls, minTimeMs, seed);
+    if (output != stdout) {
+        fclose(output);
+    }
+    return ok ? 0 : 1;
+}
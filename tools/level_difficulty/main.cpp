@@ -0,0 +1,178 @@
+#include "configs/loaders/LevelPackLoader.h"
+#include "configs/models/LevelLayoutTemplate.h"
+#include "managers/DifficultyEstimatorManager.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "services/ProceduralLevelGenerator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if POKER_CORE_JSON
+#include "configs/loaders/LevelConfigLoader.h"
+#endif
+
+/**
+ * @file main.cpp
+ * @brief 蒙特卡洛关卡难度评估工具
+ * @details 用法：LevelDifficulty [选项] <levels.pack | level.json ...>
+ *          LevelDifficulty [选项] --generate N [--difficulty D]
+ *          对每个关卡模拟大量随机/贪心对局，输出CSV报告：胜率（全部/随机/贪心）、卡住前平均操作数、
+ *          卡住时平均剩余卡牌数、翻牌次数分布的分位数和难度分数；吞吐量输出到标准错误
+ *          选项：--playouts N（每关对局数）、--threads T、--greedy R（贪心对局比例）、--seed S、--report out.csv
+ *          --generate用ProceduralLevelGenerator按种子1..N生成关卡（金字塔布局），不需要关卡文件
+ *          读取JSON关卡需要启用rapidjson
+ */
+
+namespace {
+
+const char* kUsage = "usage: %s [--playouts N] [--threads T] [--greedy R] [--seed S] [--report out.csv]"
+                     " <levels.pack | level.json ...>\n"
+                     "       %s [options] --generate N [--difficulty D]\n";
+
+bool hasSuffix(const std::string& text, const char* suffix)
+{
+    size_t length = strlen(suffix);
+    return text.size() > length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    DifficultyEstimateOptions options;
+    int threadCount = 0;
+    int generateCount = 0;
+    float generateDifficulty = 0.5f;
+    const char* reportPath = nullptr;
+    std::vector<std::string> inputPaths;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--playouts") == 0 && i + 1 < argc) {
+            options.playoutCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--greedy") == 0 && i + 1 < argc) {
+            options.greedyRatio = static_cast<float>(atof(argv[++i]));
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--report") == 0 && i + 1 < argc) {
+            reportPath = argv[++i];
+        } else if (strcmp(argv[i], "--generate") == 0 && i + 1 < argc) {
+            generateCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--difficulty") == 0 && i + 1 < argc) {
+            generateDifficulty = static_cast<float>(atof(argv[++i]));
+        } else if (argv[i][0] == '-') {
+            fprintf(stderr, kUsage, argv[0], argv[0]);
+            return 2;
+        } else {
+            inputPaths.push_back(argv[i]);
+        }
+    }
+    if (inputPaths.empty() == (generateCount <= 0)) {
+        fprintf(stderr, kUsage, argv[0], argv[0]);
+        return 2;
+    }
+    
+    // 收集关卡：关卡包中的每个关卡、每个JSON文件，或按种子生成的关卡
+    std::vector<LevelPack*> levelPacks;
+    std::vector<std::string> levelNames;
+    std::vector<LevelView> levelViews;
+    std::vector<std::string> jsonPaths;
+    for (const std::string& path : inputPaths) {
+        if (hasSuffix(path, ".pack")) {
+            LevelPack* levelPack = LevelPackLoader::loadFromFile(path);
+            if (!levelPack) {
+                fprintf(stderr, "%s: failed to open level pack\n", path.c_str());
+                return 1;
+            }
+            levelPacks.push_back(levelPack);
+            for (int i = 0; i < levelPack->getLevelCount(); i++) {
+                levelViews.push_back(levelPack->getLevel(i));
+                levelNames.push_back(path + "#" + std::to_string(levelViews.back().getLevelId()));
+            }
+        } else {
+#if POKER_CORE_JSON
+            jsonPaths.push_back(path);
+            levelNames.push_back(path);
+#else
+            fprintf(stderr, "%s: reading JSON levels requires rapidjson\n", path.c_str());
+            return 1;
+#endif
+        }
+    }
+    LevelLayoutTemplate layout;
+    layout.initPeaks(3, 3, 16);
+    for (int i = 0; i < generateCount; i++) {
+        levelNames.push_back("seed#" + std::to_string(i + 1));
+    }
+    
+    DifficultyEstimatorManager estimator;
+    estimator.init(threadCount);
+    int viewCount = static_cast<int>(levelViews.size());
+    int jsonCount = static_cast<int>(jsonPaths.size());
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<DifficultyEstimate> results = estimator.estimateBatch(static_cast<int>(levelNames.size()),
+        [&](int levelIndex) -> GameModel* {
+            if (levelIndex < viewCount) {
+                return GameModelFromLevelGenerator::generateGameModel(levelViews[levelIndex]);
+            }
+            LevelConfig* levelConfig = nullptr;
+#if POKER_CORE_JSON
+            if (levelIndex < viewCount + jsonCount) {
+                levelConfig = LevelConfigLoader::loadFromFile(jsonPaths[levelIndex - viewCount]);
+            }
+#endif
+            if (!levelConfig) {
+                levelConfig = ProceduralLevelGenerator::generateLevelConfig(
+                    layout, static_cast<uint64_t>(levelIndex - viewCount - jsonCount + 1), generateDifficulty);
+            }
+            GameModel* gameModel = levelConfig ? GameModelFromLevelGenerator::generateGameModel(levelConfig) : nullptr;
+            delete levelConfig;
+            return gameModel;
+        }, options);
+    double elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+    for (LevelPack* levelPack : levelPacks) {
+        delete levelPack;
+    }
+    
+    FILE* report = reportPath ? fopen(reportPath, "w") : stdout;
+    if (!report) {
+        fprintf(stderr, "%s: failed to open report\n", reportPath);
+        return 1;
+    }
+    
+    int failedCount = 0;
+    long long totalPlayouts = 0;
+    fprintf(report, "level,win_rate,random_win_rate,greedy_win_rate,mean_moves_to_stuck,mean_cards_left,"
+                    "draws_p10,draws_p50,draws_p90,win_draws_p50,difficulty_score\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const DifficultyEstimate& result = results[i];
+        if (!result.supported) {
+            fprintf(stderr, "%s: failed to load level or exceeds solver limits\n", levelNames[i].c_str());
+            failedCount++;
+            continue;
+        }
+        
+        totalPlayouts += result.playoutCount;
+        long long lostCount = result.playoutCount - result.winCount;
+        fprintf(report, "%s,%.4f,%.4f,%.4f,%.2f,%.2f,%d,%d,%d,%d,%.4f\n",
+                levelNames[i].c_str(), result.getWinRate(), result.getRandomWinRate(), result.getGreedyWinRate(),
+                result.getMeanMovesToStuck(), lostCount > 0 ? static_cast<double>(result.stuckCardSum) / lostCount : 0.0,
+                DifficultyEstimate::getQuantile(result.drawHistogram, 0.1),
+                DifficultyEstimate::getQuantile(result.drawHistogram, 0.5),
+                DifficultyEstimate::getQuantile(result.drawHistogram, 0.9),
+                DifficultyEstimate::getQuantile(result.winDrawHistogram, 0.5),
+                result.getDifficultyScore());
+    }
+    if (report != stdout) {
+        fclose(report);
+    }
+    
+    fprintf(stderr, "%lld playouts over %d levels with %d threads in %.3f ms (%.0f playouts/s)\n",
+            totalPlayouts, static_cast<int>(results.size()) - failedCount, estimator.getThreadCount(),
+            elapsedMs, totalPlayouts * 1000.0 / elapsedMs);
+    return failedCount == 0 ? 0 : 1;
+}
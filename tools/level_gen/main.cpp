@@ -0,0 +1,155 @@
+#include "configs/models/LevelLayoutTemplate.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "services/LevelSolver.h"
+#include "services/ProceduralLevelGenerator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * @file main.cpp
+ * @brief 按种子生成关卡的校验与性能基准
+ * @details 用法：LevelGen [--count N] [--seed S] [--difficulty D] [--peaks P] [--rows R] [--stack K] [--verify] [--print]
+ *          在P座R行的金字塔布局（K张备用牌）上，用种子S..S+N-1生成N个关卡并输出每秒生成数量
+ *          --verify：每个关卡再生成一次确认结果与种子一一对应，并用LevelSolver确认可胜
+ *          --print：输出第一个关卡的牌面
+ *          校验失败时返回1
+ */
+
+namespace {
+
+/**
+ * @brief 两个关卡配置是否完全相同
+ */
+bool isSameLevel(const LevelConfig& a, const LevelConfig& b)
+{
+    const std::vector<CardConfig>* listsA[2] = { &a.getPlayfieldCards(), &a.getStackCards() };
+    const std::vector<CardConfig>* listsB[2] = { &b.getPlayfieldCards(), &b.getStackCards() };
+    for (int list = 0; list < 2; list++) {
+        if (listsA[list]->size() != listsB[list]->size()) {
+            return false;
+        }
+        for (size_t i = 0; i < listsA[list]->size(); i++) {
+            const CardConfig& cardA = (*listsA[list])[i];
+            const CardConfig& cardB = (*listsB[list])[i];
+            if (cardA.face != cardB.face || cardA.suit != cardB.suit
+                || cardA.position.x != cardB.position.x || cardA.position.y != cardB.position.y) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void printLevel(const LevelConfig& levelConfig)
+{
+    static const char* kFaceNames = "A23456789TJQK";
+    static const char* kSuitNames = "CDHS";
+    printf("playfield:");
+    for (const CardConfig& card : levelConfig.getPlayfieldCards()) {
+        printf(" %c%c@(%.0f,%.0f)", kFaceNames[card.face], kSuitNames[card.suit], card.position.x, card.position.y);
+    }
+    printf("\nstack (bottom to top):");
+    for (const CardConfig& card : levelConfig.getStackCards()) {
+        printf(" %c%c", kFaceNames[card.face], kSuitNames[card.suit]);
+    }
+    printf("\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int levelCount = 10000;
+    unsigned long long seed = 1;
+    float difficulty = 0.5f;
+    int peakCount = 3;
+    int rowCount = 3;
+    int stackCount = 16;
+    bool verify = false;
+    bool print = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+            levelCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--difficulty") == 0 && i + 1 < argc) {
+            difficulty = static_cast<float>(atof(argv[++i]));
+        } else if (strcmp(argv[i], "--peaks") == 0 && i + 1 < argc) {
+            peakCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rows") == 0 && i + 1 < argc) {
+            rowCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--stack") == 0 && i + 1 < argc) {
+            stackCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--verify") == 0) {
+            verify = true;
+        } else if (strcmp(argv[i], "--print") == 0) {
+            print = true;
+        } else {
+            fprintf(stderr, "usage: %s [--count N] [--seed S] [--difficulty D] [--peaks P] [--rows R] [--stack K] [--verify] [--print]\n", argv[0]);
+            return 2;
+        }
+    }
+    
+    LevelLayoutTemplate layout;
+    if (levelCount < 1 || !layout.initPeaks(peakCount, rowCount, stackCount)) {
+        fprintf(stderr, "invalid layout or count\n");
+        return 2;
+    }
+    printf("layout: %d playfield cards, %d stack cards, %d required draws\n", layout.getPlayfieldCount(),
+           stackCount, ProceduralLevelGenerator::getRequiredStackDraws(stackCount, difficulty));
+    
+    // 生成性能：复用同一个LevelConfig，只计生成本身
+    LevelConfig levelConfig;
+    long faceSum = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < levelCount; i++) {
+        ProceduralLevelGenerator::generateLevel(layout, seed + i, difficulty, &levelConfig);
+        faceSum += levelConfig.getStackCards().back().face;
+    }
+    double elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+    printf("generate: %d levels in %.3f ms (%.0f levels/s, checksum %ld)\n",
+           levelCount, elapsedMs, levelCount * 1000.0 / elapsedMs, faceSum);
+    
+    if (print) {
+        ProceduralLevelGenerator::generateLevel(layout, seed, difficulty, &levelConfig);
+        printLevel(levelConfig);
+    }
+    if (!verify) {
+        return 0;
+    }
+    
+    if (layout.getPlayfieldCount() > LevelSolver::kMaxPlayfieldCards) {
+        fprintf(stderr, "playfield exceeds %d cards, cannot verify\n", LevelSolver::kMaxPlayfieldCards);
+        return 2;
+    }
+    
+    int failedCount = 0;
+    long drawSum = 0;
+    LevelConfig replayConfig;
+    for (int i = 0; i < levelCount; i++) {
+        ProceduralLevelGenerator::generateLevel(layout, seed + i, difficulty, &levelConfig);
+        ProceduralLevelGenerator::generateLevel(layout, seed + i, difficulty, &replayConfig);
+        if (!isSameLevel(levelConfig, replayConfig)) {
+            fprintf(stderr, "seed %llu: not deterministic\n", seed + i);
+            failedCount++;
+            continue;
+        }
+        
+        GameModel* gameModel = GameModelFromLevelGenerator::generateGameModel(&levelConfig);
+        LevelSolveResult result = LevelSolver::solve(gameModel);
+        delete gameModel;
+        if (!result.winnable) {
+            fprintf(stderr, "seed %llu: not winnable\n", seed + i);
+            failedCount++;
+            continue;
+        }
+        drawSum += result.minStackDraws;
+    }
+    printf("verify: %d/%d winnable and deterministic, mean min stack draws %.2f\n",
+           levelCount - failedCount, levelCount,
+           levelCount > failedCount ? static_cast<double>(drawSum) / (levelCount - failedCount) : 0.0);
+    return failedCount == 0 ? 0 : 1;
+}
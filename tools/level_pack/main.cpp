@@ -0,0 +1,106 @@
+#include "configs/loaders/LevelConfigLoader.h"
+#include "configs/loaders/LevelPackLoader.h"
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * @file main.cpp
+ * @brief 关卡包转换命令行工具
+ * @details 用法：LevelPackTool <out.pack> <level.json> [level.json ...]
+ *          把JSON关卡转换为二进制关卡包，关卡ID取文件名末尾的数字（level_12.json -> 12），
+ *          文件名中没有数字时按参数顺序从1编号
+ *
+ *          LevelPackTool --list <in.pack> 列出关卡包中的关卡
+ */
+
+namespace {
+
+/**
+ * @brief 从文件名（不含扩展名）末尾的数字解析关卡ID
+ * @return 没有数字时返回-1
+ */
+int parseLevelId(const std::string& filePath)
+{
+    size_t nameStart = filePath.find_last_of("/\\");
+    nameStart = nameStart == std::string::npos ? 0 : nameStart + 1;
+    size_t nameEnd = filePath.find_last_of('.');
+    if (nameEnd == std::string::npos || nameEnd < nameStart) {
+        nameEnd = filePath.size();
+    }
+    
+    size_t digitStart = nameEnd;
+    while (digitStart > nameStart && isdigit(static_cast<unsigned char>(filePath[digitStart - 1]))) {
+        digitStart--;
+    }
+    if (digitStart == nameEnd) {
+        return -1;
+    }
+    return atoi(filePath.substr(digitStart, nameEnd - digitStart).c_str());
+}
+
+int listPack(const char* packPath)
+{
+    LevelPack* pack = LevelPackLoader::loadFromFile(packPath);
+    if (!pack) {
+        fprintf(stderr, "%s: failed to open level pack\n", packPath);
+        return 1;
+    }
+    
+    for (int i = 0; i < pack->getLevelCount(); i++) {
+        LevelView level = pack->getLevel(i);
+        printf("level %d: playfield=%d stack=%d\n", level.getLevelId(), level.getPlayfieldCount(), level.getStackCount());
+    }
+    printf("%d levels\n", pack->getLevelCount());
+    delete pack;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc == 3 && strcmp(argv[1], "--list") == 0) {
+        return listPack(argv[2]);
+    }
+    
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <out.pack> <level.json> [level.json ...]\n", argv[0]);
+        fprintf(stderr, "       %s --list <in.pack>\n", argv[0]);
+        return 2;
+    }
+    
+    std::vector<LevelConfig*> levels;
+    int failedCount = 0;
+    for (int i = 2; i < argc; i++) {
+        LevelConfig* levelConfig = LevelConfigLoader::loadFromFile(argv[i]);
+        if (!levelConfig) {
+            fprintf(stderr, "%s: failed to load level\n", argv[i]);
+            failedCount++;
+            continue;
+        }
+        
+        int levelId = parseLevelId(argv[i]);
+        levelConfig->setLevelId(levelId >= 0 ? levelId : i - 1);
+        levels.push_back(levelConfig);
+    }
+    
+    bool saved = false;
+    if (failedCount == 0) {
+        std::vector<const LevelConfig*> packLevels(levels.begin(), levels.end());
+        saved = LevelPackLoader::saveToFile(argv[1], packLevels);
+        if (saved) {
+            printf("wrote %d levels to %s\n", static_cast<int>(levels.size()), argv[1]);
+        } else {
+            fprintf(stderr, "%s: failed to write level pack\n", argv[1]);
+        }
+    }
+    
+    for (size_t i = 0; i < levels.size(); i++) {
+        delete levels[i];
+    }
+    return saved ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+#include "configs/loaders/LevelConfigLoader.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @file main.cpp
+ * @brief 关卡JSON解析性能基准
+ * @details 用法：LevelParseBench [--cards N] [--iterations K] [level.json ...]
+ *          对比DOM解析（loadFromStringDom）与SAX原地解析（loadFromString）的耗时，
+ *          并校验两者得到的关卡配置完全一致
+ *          不指定文件时生成一个含N张主牌区卡牌（默认20000）和N/4张备用牌堆卡牌的关卡
+ */
+
+namespace {
+
+/**
+ * @brief 生成与关卡文件格式相同的大关卡
+ */
+std::string makeLargeLevel(int playfieldCount)
+{
+    std::ostringstream json;
+    unsigned int seed = 12345;
+    json << "{\n    \"Playfield\": [";
+    for (int i = 0; i < playfieldCount; i++) {
+        seed = seed * 1103515245u + 12345u;
+        json << (i == 0 ? "\n" : ",\n")
+             << "        {\n            \"CardFace\": " << (seed >> 16) % 13
+             << ",\n            \"CardSuit\": " << (seed >> 8) % 4
+             << ",\n            \"Position\": {\n                \"x\": " << (seed >> 4) % 1080
+             << ",\n                \"y\": " << (seed >> 12) % 1500 << ".5\n            }\n        }";
+    }
+    json << "\n    ],\n    \"Stack\": [";
+    for (int i = 0; i < playfieldCount / 4; i++) {
+        seed = seed * 1103515245u + 12345u;
+        json << (i == 0 ? "\n" : ",\n")
+             << "        {\n            \"CardFace\": " << (seed >> 16) % 13
+             << ",\n            \"CardSuit\": " << (seed >> 8) % 4
+             << ",\n            \"Position\": {\n                \"x\": 0,\n                \"y\": 0\n            }\n        }";
+    }
+    json << "\n    ]\n}\n";
+    return json.str();
+}
+
+bool sameCards(const std::vector<CardConfig>& a, const std::vector<CardConfig>& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].face != b[i].face || a[i].suit != b[i].suit || a[i].position != b[i].position) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 对一份JSON分别计时两种解析方式
+ * @return 两种方式结果不一致时返回false
+ */
+bool runBenchmark(const std::string& name, const std::string& json, int iterations)
+{
+    // 先各解析一次，校验结果一致
+    LevelConfig* domConfig = LevelConfigLoader::loadFromStringDom(json);
+    LevelConfig* saxConfig = LevelConfigLoader::loadFromString(json);
+    bool same = (!domConfig && !saxConfig)
+        || (domConfig && saxConfig && sameCards(domConfig->getPlayfieldCards(), saxConfig->getPlayfieldCards())
+            && sameCards(domConfig->getStackCards(), saxConfig->getStackCards()));
+    size_t cardCount = domConfig ? domConfig->getPlayfieldCards().size() + domConfig->getStackCards().size() : 0;
+    delete domConfig;
+    delete saxConfig;
+    if (!same) {
+        fprintf(stderr, "%s: DOM and SAX results differ\n", name.c_str());
+        return false;
+    }
+    
+    auto startTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        delete LevelConfigLoader::loadFromStringDom(json);
+    }
+    double domMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    
+    // SAX计时包含复制输入缓冲区（原地解析会修改缓冲区）
+    startTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        delete LevelConfigLoader::loadFromString(json);
+    }
+    double saxMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    
+    double megabytes = static_cast<double>(json.size()) * iterations / (1024.0 * 1024.0);
+    printf("%s: %zu bytes, %zu cards, %d iterations\n", name.c_str(), json.size(), cardCount, iterations);
+    printf("  DOM: %10.3f ms/parse %8.1f MB/s\n", domMs / iterations, megabytes / (domMs / 1000.0));
+    printf("  SAX: %10.3f ms/parse %8.1f MB/s\n", saxMs / iterations, megabytes / (saxMs / 1000.0));
+    printf("  speedup: %.2fx\n", saxMs > 0.0 ? domMs / saxMs : 0.0);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int cardCount = 20000;
+    int iterations = 20;
+    std::vector<std::string> filePaths;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--cards") == 0 && i + 1 < argc) {
+            cardCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = atoi(argv[++i]);
+        } else {
+            filePaths.push_back(argv[i]);
+        }
+    }
+    if (iterations <= 0) {
+        fprintf(stderr, "usage: %s [--cards N] [--iterations K] [level.json ...]\n", argv[0]);
+        return 2;
+    }
+    
+    bool ok = true;
+    if (filePaths.empty()) {
+        ok = runBenchmark("generated", makeLargeLevel(cardCount), iterations);
+    }
+    for (size_t i = 0; i < filePaths.size(); i++) {
+        std::ifstream file(filePaths[i].c_str(), std::ios::in | std::ios::binary);
+        if (!file) {
+            fprintf(stderr, "%s: failed to open file\n", filePaths[i].c_str());
+            ok = false;
+            continue;
+        }
+        std::ostringstream content;
+        content << file.rdbuf();
+        ok = runBenchmark(filePaths[i], content.str(), iterations) && ok;
+    }
+    return ok ? 0 : 1;
+}
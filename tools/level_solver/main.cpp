@@ -0,0 +1,209 @@
+#include "configs/loaders/LevelConfigLoader.h"
+#include "configs/loaders/LevelPackLoader.h"
+#include "managers/BatchSolverManager.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "services/LevelSolver.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
+
+/**
+ * @file main.cpp
+ * @brief 关卡求解命令行工具
+ * @details 用法：LevelSolver <level.json> [level.json ...]
+ *          对每个关卡输出是否可胜、最少翻牌次数、获胜路线数量和展开状态数
+ *
+ *          批量模式：LevelSolver --batch <dir|levels.pack> [--threads N] [--table-bits B] [--report out.csv]
+ *          多线程求解目录下所有.json关卡或关卡包中的所有关卡，输出CSV报告（默认输出到标准输出）
+ */
+
+namespace {
+
+/**
+ * @brief 列出目录下所有.json文件（按文件名排序）
+ */
+bool listJsonFiles(const std::string& dirPath, std::vector<std::string>* outPaths)
+{
+#ifdef _WIN32
+    WIN32_FIND_DATAA findData;
+    HANDLE handle = FindFirstFileA((dirPath + "\\*.json").c_str(), &findData);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return GetLastError() == ERROR_FILE_NOT_FOUND;
+    }
+    do {
+        if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+            outPaths->push_back(dirPath + "\\" + findData.cFileName);
+        }
+    } while (FindNextFileA(handle, &findData));
+    FindClose(handle);
+#else
+    DIR* dir = opendir(dirPath.c_str());
+    if (!dir) {
+        return false;
+    }
+    while (struct dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name.size() > 5 && name.compare(name.size() - 5, 5, ".json") == 0) {
+            outPaths->push_back(dirPath + "/" + name);
+        }
+    }
+    closedir(dir);
+#endif
+    
+    std::sort(outPaths->begin(), outPaths->end());
+    return true;
+}
+
+int runBatch(int argc, char* argv[])
+{
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s --batch <dir|levels.pack> [--threads N] [--table-bits B] [--report out.csv]\n", argv[0]);
+        return 2;
+    }
+    
+    std::string dirPath = argv[2];
+    int threadCount = 0;
+    int tableSizeBits = BatchSolverManager::kDefaultTableSizeBits;
+    const char* reportPath = nullptr;
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--table-bits") == 0 && i + 1 < argc) {
+            tableSizeBits = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--report") == 0 && i + 1 < argc) {
+            reportPath = argv[++i];
+        } else {
+            fprintf(stderr, "unknown option: %s\n", argv[i]);
+            return 2;
+        }
+    }
+    
+    // 关卡包直接从映射的内存生成牌局；目录则逐个解析JSON
+    std::vector<std::string> levelPaths;
+    LevelPack* levelPack = nullptr;
+    if (dirPath.size() > 5 && dirPath.compare(dirPath.size() - 5, 5, ".pack") == 0) {
+        levelPack = LevelPackLoader::loadFromFile(dirPath);
+        if (!levelPack) {
+            fprintf(stderr, "%s: failed to open level pack\n", dirPath.c_str());
+            return 1;
+        }
+        for (int i = 0; i < levelPack->getLevelCount(); i++) {
+            levelPaths.push_back(dirPath + "#" + std::to_string(levelPack->getLevel(i).getLevelId()));
+        }
+    } else if (!listJsonFiles(dirPath, &levelPaths)) {
+        fprintf(stderr, "%s: failed to open directory\n", dirPath.c_str());
+        return 1;
+    }
+    
+    BatchSolverManager batchSolver;
+    if (!batchSolver.init(threadCount, tableSizeBits)) {
+        fprintf(stderr, "invalid --table-bits %d\n", tableSizeBits);
+        return 2;
+    }
+    
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<BatchSolveEntry> entries = batchSolver.solveBatch(static_cast<int>(levelPaths.size()),
+        [&levelPaths, levelPack](int levelIndex) -> GameModel* {
+            if (levelPack) {
+                return GameModelFromLevelGenerator::generateGameModel(levelPack->getLevel(levelIndex));
+            }
+            LevelConfig* levelConfig = LevelConfigLoader::loadFromFile(levelPaths[levelIndex]);
+            if (!levelConfig) {
+                return nullptr;
+            }
+            GameModel* gameModel = GameModelFromLevelGenerator::generateGameModel(levelConfig);
+            delete levelConfig;
+            return gameModel;
+        });
+    double elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+    delete levelPack;
+    
+    FILE* report = reportPath ? fopen(reportPath, "w") : stdout;
+    if (!report) {
+        fprintf(stderr, "%s: failed to open report\n", reportPath);
+        return 1;
+    }
+    
+    int failedCount = 0;
+    int winnableCount = 0;
+    fprintf(report, "level,winnable,optimal_moves,min_stack_draws,winning_lines,nodes_expanded,wall_ms\n");
+    for (size_t i = 0; i < entries.size(); i++) {
+        const BatchSolveEntry& entry = entries[i];
+        if (!entry.loaded || !entry.result.supported) {
+            fprintf(stderr, "%s: %s\n", levelPaths[i].c_str(), entry.loaded ? "exceeds solver limits" : "failed to load level");
+            failedCount++;
+            continue;
+        }
+        
+        const LevelSolveResult& result = entry.result;
+        winnableCount += result.winnable ? 1 : 0;
+        fprintf(report, "%s,%d,%d,%d,%llu,%llu,%.3f\n",
+                levelPaths[i].c_str(), result.winnable ? 1 : 0, result.minMoveCount, result.minStackDraws,
+                result.winningLineCount, result.nodesExpanded, entry.wallTimeMs);
+    }
+    if (report != stdout) {
+        fclose(report);
+    }
+    
+    fprintf(stderr, "solved %d levels (%d winnable, %d failed) with %d threads in %.3f ms\n",
+            static_cast<int>(entries.size()) - failedCount, winnableCount, failedCount,
+            batchSolver.getThreadCount(), elapsedMs);
+    return failedCount == 0 ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc >= 2 && strcmp(argv[1], "--batch") == 0) {
+        return runBatch(argc, argv);
+    }
+    
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <level.json> [level.json ...]\n", argv[0]);
+        fprintf(stderr, "       %s --batch <dir|levels.pack> [--threads N] [--table-bits B] [--report out.csv]\n", argv[0]);
+        return 2;
+    }
+    
+    int failedCount = 0;
+    for (int i = 1; i < argc; i++) {
+        LevelConfig* levelConfig = LevelConfigLoader::loadFromFile(argv[i]);
+        if (!levelConfig) {
+            fprintf(stderr, "%s: failed to load level\n", argv[i]);
+            failedCount++;
+            continue;
+        }
+        
+        GameModel* gameModel = GameModelFromLevelGenerator::generateGameModel(levelConfig);
+        delete levelConfig;
+        
+        auto startTime = std::chrono::steady_clock::now();
+        LevelSolveResult result = LevelSolver::solve(gameModel);
+        double elapsedMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - startTime).count();
+        delete gameModel;
+        
+        if (!result.supported) {
+            fprintf(stderr, "%s: playfield exceeds %d cards, not supported\n", argv[i], LevelSolver::kMaxPlayfieldCards);
+            failedCount++;
+            continue;
+        }
+        
+        printf("%s: winnable=%d minStackDraws=%d winningLines=%llu nodes=%llu timeMs=%.3f\n",
+               argv[i], result.winnable ? 1 : 0, result.minStackDraws,
+               result.winningLineCount, result.nodesExpanded, elapsedMs);
+    }
+    
+    return failedCount == 0 ? 0 : 1;
+}
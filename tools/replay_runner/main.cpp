@@ -0,0 +1,199 @@
+#include "configs/models/LevelLayoutTemplate.h"
+#include "managers/ReplayRecorderManager.h"
+#include "managers/UndoManager.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "services/ProceduralLevelGenerator.h"
+#include "services/ReplayPlayerService.h"
+#include "utils/SeededRandom.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * @file main.cpp
+ * @brief 无头回放工具
+ * @details 用法：ReplayRunner [--iterations K] <replay.rpl ...>
+ *          ReplayRunner [--iterations K] --generate N [--inputs M] [--seed S]
+ *          在模型层以最快速度重新执行回放文件，校验每个检查点，输出每个文件的结果和每秒回放/输入数量
+ *          --generate：在按种子S..S+N-1生成的关卡上模拟M条随机输入（包括被拒绝的点击、撤销和重做，
+ *          录制开始前已有撤销和重做记录），在内存中录制后回放，确认检查点和最终状态一致
+ *          任何回放无效或不一致时返回1
+ */
+
+namespace {
+
+const char* kUsage = "usage: %s [--iterations K] <replay.rpl ...>\n"
+                     "       %s [--iterations K] --generate N [--inputs M] [--seed S]\n";
+
+/**
+ * @brief 读取整个文件（按uint32_t存放，保证4字节对齐）
+ */
+bool readFile(const std::string& path, std::vector<uint32_t>* outData, size_t* outSize)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    outData->assign((size + sizeof(uint32_t) - 1) / sizeof(uint32_t), 0);
+    bool read = size >= 0 && fread(outData->data(), 1, size, file) == static_cast<size_t>(size);
+    fclose(file);
+    *outSize = static_cast<size_t>(size);
+    return read;
+}
+
+/**
+ * @brief 模拟一条随机输入：点击随机卡牌（可能不合法）、翻牌、撤销或重做
+ */
+void applyRandomInput(GameModel* gameModel, UndoModel* undoModel, UndoManager* undoManager,
+                      const CardPosition& trayPosition, SeededRandom* random, ReplayRecorderManager* recorder)
+{
+    int roll = random->nextBelow(10);
+    ReplayInputType type = RIT_CARD_CLICK;
+    int cardId = -1;
+    if (roll < 6) {
+        cardId = random->nextBelow(static_cast<int>(gameModel->getAllCards().size()) + 1) - 1;
+    } else if (roll < 8) {
+        type = RIT_STACK_CLICK;
+    } else if (roll < 9) {
+        type = RIT_UNDO_CLICK;
+    } else {
+        type = RIT_REDO_CLICK;
+    }
+    if (recorder) {
+        recorder->recordInput(type, cardId, gameModel, undoModel);
+    }
+    ReplayPlayerService::applyInput(gameModel, undoManager, type, cardId, trayPosition);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int iterations = 1;
+    int generateCount = 0;
+    int inputCount = 200;
+    unsigned long long seed = 1;
+    std::vector<std::string> replayPaths;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--generate") == 0 && i + 1 < argc) {
+            generateCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--inputs") == 0 && i + 1 < argc) {
+            inputCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (argv[i][0] == '-') {
+            fprintf(stderr, kUsage, argv[0], argv[0]);
+            return 2;
+        } else {
+            replayPaths.push_back(argv[i]);
+        }
+    }
+    if (replayPaths.empty() == (generateCount <= 0) || iterations <= 0) {
+        fprintf(stderr, kUsage, argv[0], argv[0]);
+        return 2;
+    }
+    
+    // 收集回放：读取文件，或在生成的关卡上录制随机输入（同时记下录制结束时的状态哈希）
+    std::vector<std::string> names;
+    std::vector<std::vector<uint32_t> > replays;
+    std::vector<size_t> sizes;
+    std::vector<uint64_t> expectedHashes;
+    for (const std::string& path : replayPaths) {
+        std::vector<uint32_t> data;
+        size_t size = 0;
+        if (!readFile(path, &data, &size)) {
+            fprintf(stderr, "%s: failed to read replay\n", path.c_str());
+            return 1;
+        }
+        names.push_back(path);
+        replays.push_back(data);
+        sizes.push_back(size);
+        expectedHashes.push_back(0);
+    }
+    LevelLayoutTemplate layout;
+    layout.initPeaks(3, 3, 16);
+    CardPosition trayPosition(540.0f, 300.0f);
+    for (int i = 0; i < generateCount; i++) {
+        uint64_t levelSeed = seed + static_cast<uint64_t>(i);
+        LevelConfig* levelConfig = ProceduralLevelGenerator::generateLevelConfig(layout, levelSeed, 0.5f);
+        GameModel* gameModel = levelConfig ? GameModelFromLevelGenerator::generateGameModel(levelConfig) : nullptr;
+        delete levelConfig;
+        if (!gameModel) {
+            fprintf(stderr, "seed#%llu: failed to generate level\n", static_cast<unsigned long long>(levelSeed));
+            return 1;
+        }
+        
+        UndoModel undoModel;
+        UndoManager undoManager;
+        undoManager.init(&undoModel);
+        SeededRandom random(levelSeed);
+        for (int input = 0; input < inputCount / 4; input++) {
+            applyRandomInput(gameModel, &undoModel, &undoManager, trayPosition, &random, nullptr);
+        }
+        ReplayRecorderManager recorder;
+        recorder.startRecording(static_cast<int>(levelSeed), gameModel, &undoModel, trayPosition);
+        for (int input = 0; input < inputCount; input++) {
+            applyRandomInput(gameModel, &undoModel, &undoManager, trayPosition, &random, &recorder);
+        }
+        
+        std::vector<uint32_t> data;
+        recorder.getReplayData(gameModel, &undoModel, &data);
+        names.push_back("seed#" + std::to_string(levelSeed));
+        replays.push_back(data);
+        sizes.push_back(data.size() * sizeof(uint32_t));
+        expectedHashes.push_back(ReplayPlayerService::computeStateHash(gameModel, &undoModel));
+        delete gameModel;
+    }
+    
+    // 回放（工作模型在所有回放间复用）
+    GameModel gameModel;
+    UndoModel undoModel;
+    int failedCount = 0;
+    long long totalInputs = 0;
+    size_t totalBytes = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        for (size_t i = 0; i < replays.size(); i++) {
+            ReplayResult result = ReplayPlayerService::playReplay(replays[i].data(), sizes[i], &gameModel, &undoModel);
+            totalInputs += result.inputCount;
+            if (iteration > 0) {
+                continue;
+            }
+            
+            totalBytes += sizes[i];
+            bool failed = !result.loaded || !result.matched
+                || (expectedHashes[i] != 0 && result.finalHash != expectedHashes[i]);
+            if (!result.loaded) {
+                printf("%s: invalid replay\n", names[i].c_str());
+            } else if (!result.matched) {
+                printf("%s: level %d, checkpoint mismatch before input %d\n",
+                       names[i].c_str(), result.levelId, result.mismatchInputIndex);
+            } else if (!replayPaths.empty() || failed) {
+                printf("%s: level %d, %d inputs (%d accepted), %d checkpoints, %.1f s, %s, hash %016llx%s\n",
+                       names[i].c_str(), result.levelId, result.inputCount, result.acceptedCount,
+                       result.checkpointCount, result.durationMs / 1000.0, result.won ? "won" : "not won",
+                       static_cast<unsigned long long>(result.finalHash), failed ? " (final state mismatch)" : "");
+            }
+            failedCount += failed ? 1 : 0;
+        }
+    }
+    double elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+    
+    long long replayCount = static_cast<long long>(replays.size()) * iterations;
+    fprintf(stderr, "%lld replays (%zu bytes each on average), %lld inputs in %.3f ms (%.0f replays/s, %.0f inputs/s)\n",
+            replayCount, replays.empty() ? 0 : totalBytes / replays.size(), totalInputs, elapsedMs,
+            replayCount * 1000.0 / elapsedMs, totalInputs * 1000.0 / elapsedMs);
+    if (failedCount > 0) {
+        fprintf(stderr, "%d of %zu replays failed\n", failedCount, replays.size());
+    }
+    return failedCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,358 @@
+#include "managers/UndoManager.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "services/GameRulesService.h"
+#include "services/GameSnapshotService.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#if POKER_CORE_JSON
+#include "json/stringbuffer.h"
+#include "json/writer.h"
+#endif
+
+/**
+ * @file main.cpp
+ * @brief 存档快照往返校验与性能基准
+ * @details 用法：SnapshotBench [--cards N] [--moves M] [--iterations K] [--seed S]
+ *          生成一个N张主牌区卡牌的关卡，随机操作M步（含撤销）后：
+ *          1. 校验快照往返：读回的模型与原模型状态一致，之后执行相同操作（含全部撤销）的每一步仍一致
+ *          2. 测量二进制快照的写入/读取耗时和内存分配次数；启用rapidjson时另外输出JSON存档的耗时，
+ *             JSON不含撤销记录，保存的内容不同，只作参考，不计算两者的比值
+ *          校验失败时返回1
+ */
+
+namespace {
+
+std::atomic<long> s_allocationCount(0);
+
+} // namespace
+
+// 统计内存分配次数，用于确认读写快照不分配内存
+void* operator new(size_t size)
+{
+    s_allocationCount++;
+    void* memory = malloc(size > 0 ? size : 1);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+namespace {
+
+const CardPosition kStackPosition(300.0f, 400.0f);
+const CardPosition kTrayPosition(700.0f, 400.0f);
+
+unsigned int nextRandom(unsigned int* state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+/**
+ * @brief 生成层层叠放的大关卡（卡牌之间大量重叠）
+ */
+GameModel* makeLevel(int playfieldCount, unsigned int* randomState)
+{
+    LevelConfig levelConfig;
+    for (int i = 0; i < playfieldCount; i++) {
+        int column = i % 8;
+        int row = (i / 8) % 10;
+        int layer = i / 80;
+        CardPosition position(100.0f + column * 110.0f + layer * 15.0f, 700.0f + row * 80.0f + layer * 10.0f);
+        levelConfig.addPlayfieldCard(CardConfig(static_cast<CardFaceType>(nextRandom(randomState) % 13),
+                                                static_cast<CardSuitType>(nextRandom(randomState) % 4), position));
+    }
+    for (int i = 0; i < playfieldCount / 2 + 1; i++) {
+        levelConfig.addStackCard(CardConfig(static_cast<CardFaceType>(nextRandom(randomState) % 13),
+                                            static_cast<CardSuitType>(nextRandom(randomState) % 4), kStackPosition));
+    }
+    return GameModelFromLevelGenerator::generateGameModel(&levelConfig);
+}
+
+/**
+ * @brief 随机执行一步：匹配、翻牌或撤销
+ * @return 没有可执行的操作时返回false
+ */
+bool playRandomStep(GameModel* gameModel, UndoManager* undoManager, unsigned int* randomState)
+{
+    unsigned int choice = nextRandom(randomState) % 8;
+    if (choice == 0 && undoManager->canUndo()) {
+        return undoManager->performUndo(gameModel);
+    }
+    
+    std::vector<int> matchable;
+    gameModel->getMatchableCardIds(&matchable);
+    std::sort(matchable.begin(), matchable.end());
+    UndoAction action;
+    if (!matchable.empty() && (choice < 6 || gameModel->getStackCardIds().empty())) {
+        int cardId = matchable[nextRandom(randomState) % matchable.size()];
+        if (GameRulesService::replaceTrayFromPlayfield(gameModel, cardId, kTrayPosition, &action)) {
+            undoManager->recordAction(action);
+            return true;
+        }
+    }
+    if (GameRulesService::replaceTrayFromStack(gameModel, kTrayPosition, &action)) {
+        undoManager->recordAction(action);
+        return true;
+    }
+    return false;
+}
+
+bool sameCard(const CardModel* a, const CardModel* b)
+{
+    return a->getCardId() == b->getCardId() && a->getFace() == b->getFace() && a->getSuit() == b->getSuit()
+        && a->getLocation() == b->getLocation() && a->getPosition() == b->getPosition()
+        && a->getHomePosition() == b->getHomePosition()
+        && a->isFlipped() == b->isFlipped() && a->isClickable() == b->isClickable();
+}
+
+bool sameAction(const UndoAction& a, const UndoAction& b)
+{
+    return a.type == b.type && a.fromCardId == b.fromCardId && a.toCardId == b.toCardId;
+}
+
+/**
+ * @brief 比较两个模型的全部可见状态
+ */
+bool sameState(const GameModel* a, const UndoModel* undoA, const GameModel* b, const UndoModel* undoB)
+{
+    if (a->getAllCards().size() != b->getAllCards().size() || a->getTrayCardId() != b->getTrayCardId()
+        || a->getPlayfieldCardIds() != b->getPlayfieldCardIds() || a->getStackCardIds() != b->getStackCardIds()) {
+        return false;
+    }
+    for (const CardModel* card : a->getAllCards()) {
+        const CardModel* other = b->getCardById(card->getCardId());
+        if (!other || !sameCard(card, other) || a->isCardCovered(card->getCardId()) != b->isCardCovered(card->getCardId())) {
+            return false;
+        }
+    }
+    
+    std::vector<int> matchableA;
+    std::vector<int> matchableB;
+    a->getMatchableCardIds(&matchableA);
+    b->getMatchableCardIds(&matchableB);
+    std::sort(matchableA.begin(), matchableA.end());
+    std::sort(matchableB.begin(), matchableB.end());
+    if (matchableA != matchableB || undoA->getActionCount() != undoB->getActionCount()) {
+        return false;
+    }
+    for (int i = 0; i < undoA->getActionCount(); i++) {
+        if (!sameAction(undoA->getAction(i), undoB->getAction(i))) {
+            return false;
+        }
+    }
+    if (undoA->getRedoCount() != undoB->getRedoCount()) {
+        return false;
+    }
+    for (int i = 0; i < undoA->getRedoCount(); i++) {
+        if (!sameAction(undoA->getRedoAction(i), undoB->getRedoAction(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 校验快照往返
+ */
+bool verifyRoundTrip(const GameModel* gameModel, const UndoModel* undoModel, unsigned int seed)
+{
+    std::vector<uint32_t> buffer(GameSnapshotService::getSnapshotSize(gameModel, undoModel) / sizeof(uint32_t) + 1);
+    size_t size = GameSnapshotService::writeSnapshot(gameModel, undoModel, buffer.data(), buffer.size() * sizeof(uint32_t));
+    
+    GameModel restoredModel;
+    UndoModel restoredUndo;
+    if (size == 0 || !GameSnapshotService::readSnapshot(buffer.data(), size, &restoredModel, &restoredUndo)) {
+        fprintf(stderr, "round trip: failed to write or read snapshot\n");
+        return false;
+    }
+    if (!sameState(gameModel, undoModel, &restoredModel, &restoredUndo)) {
+        fprintf(stderr, "round trip: restored state differs\n");
+        return false;
+    }
+    
+    // 重新写入的快照应逐字节相同
+    std::vector<uint32_t> rewritten(buffer.size());
+    if (GameSnapshotService::writeSnapshot(&restoredModel, &restoredUndo, rewritten.data(), rewritten.size() * sizeof(uint32_t)) != size
+        || memcmp(buffer.data(), rewritten.data(), size) != 0) {
+        fprintf(stderr, "round trip: rewritten snapshot differs\n");
+        return false;
+    }
+    
+    // 截断和损坏的快照必须被拒绝
+    for (size_t cut = 0; cut < size; cut += std::max<size_t>(size / 64, 1)) {
+        GameModel truncatedModel;
+        if (GameSnapshotService::readSnapshot(buffer.data(), cut, &truncatedModel, nullptr)) {
+            fprintf(stderr, "round trip: truncated snapshot accepted (%zu bytes)\n", cut);
+            return false;
+        }
+    }
+    
+    // 在原模型的副本和读回的模型上执行相同的操作，之后全部撤销
+    GameModel originalCopy;
+    UndoModel originalUndo;
+    GameSnapshotService::readSnapshot(buffer.data(), size, &originalCopy, &originalUndo);
+    UndoManager managerA;
+    UndoManager managerB;
+    managerA.init(&originalUndo);
+    managerB.init(&restoredUndo);
+    unsigned int stateA = seed;
+    unsigned int stateB = seed;
+    for (int step = 0; step < 200; step++) {
+        bool playedA = playRandomStep(&originalCopy, &managerA, &stateA);
+        bool playedB = playRandomStep(&restoredModel, &managerB, &stateB);
+        if (playedA != playedB || !sameState(&originalCopy, &originalUndo, &restoredModel, &restoredUndo)) {
+            fprintf(stderr, "round trip: states diverge at step %d\n", step);
+            return false;
+        }
+    }
+    while (managerA.canUndo()) {
+        managerA.performUndo(&originalCopy);
+        managerB.performUndo(&restoredModel);
+        if (!sameState(&originalCopy, &originalUndo, &restoredModel, &restoredUndo)) {
+            fprintf(stderr, "round trip: states diverge while undoing\n");
+            return false;
+        }
+    }
+    return true;
+}
+
+void printResult(const char* name, double totalMs, int iterations, long allocations, size_t bytes)
+{
+    printf("  %-12s %10.2f us/op %8.1f allocs/op %10zu bytes\n", name, totalMs * 1000.0 / iterations,
+           static_cast<double>(allocations) / iterations, bytes);
+}
+
+/**
+ * @brief 测量二进制快照（启用rapidjson时另外测量JSON）的写入和读取耗时
+ */
+void runBenchmark(const GameModel* gameModel, const UndoModel* undoModel, int iterations)
+{
+    typedef std::chrono::steady_clock Clock;
+    
+    // 二进制快照：缓冲区预先分配，读取复用同一个模型
+    std::vector<uint32_t> buffer(GameSnapshotService::getSnapshotSize(gameModel, undoModel) / sizeof(uint32_t) + 1);
+    size_t size = 0;
+    long allocations = s_allocationCount;
+    Clock::time_point startTime = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        size = GameSnapshotService::writeSnapshot(gameModel, undoModel, buffer.data(), buffer.size() * sizeof(uint32_t));
+    }
+    double writeMs = std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+    long writeAllocations = s_allocationCount - allocations;
+    
+    GameModel restoredModel;
+    UndoModel restoredUndo;
+    GameSnapshotService::readSnapshot(buffer.data(), size, &restoredModel, &restoredUndo);
+    allocations = s_allocationCount;
+    startTime = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        GameSnapshotService::readSnapshot(buffer.data(), size, &restoredModel, &restoredUndo);
+    }
+    double readMs = std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+    long readAllocations = s_allocationCount - allocations;
+    
+    printResult("binary write", writeMs, iterations, writeAllocations, size);
+    printResult("binary read", readMs, iterations, readAllocations, size);
+
+#if POKER_CORE_JSON
+    // JSON：构建DOM并输出为字符串，读取时解析并反序列化
+    std::string json;
+    allocations = s_allocationCount;
+    startTime = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        rapidjson::Document document = gameModel->serialize();
+        rapidjson::StringBuffer stringBuffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(stringBuffer);
+        document.Accept(writer);
+        json.assign(stringBuffer.GetString(), stringBuffer.GetSize());
+    }
+    double jsonWriteMs = std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+    long jsonWriteAllocations = s_allocationCount - allocations;
+    
+    allocations = s_allocationCount;
+    startTime = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        rapidjson::Document document;
+        document.Parse(json.c_str());
+        restoredModel.deserialize(document);
+    }
+    double jsonReadMs = std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+    long jsonReadAllocations = s_allocationCount - allocations;
+    
+    // JSON不含撤销记录，只作为GameModel存档的对照
+    printResult("json write", jsonWriteMs, iterations, jsonWriteAllocations, json.size());
+    printResult("json read", jsonReadMs, iterations, jsonReadAllocations, json.size());
+#endif
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int cardCount = 200;
+    int moveCount = 120;
+    int iterations = 2000;
+    unsigned int seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--cards") == 0 && i + 1 < argc) {
+            cardCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--moves") == 0 && i + 1 < argc) {
+            moveCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        } else {
+            fprintf(stderr, "usage: %s [--cards N] [--moves M] [--iterations K] [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (cardCount <= 0 || moveCount < 0 || iterations <= 0 || seed == 0) {
+        fprintf(stderr, "invalid arguments\n");
+        return 2;
+    }
+    
+    unsigned int randomState = seed;
+    GameModel* gameModel = makeLevel(cardCount, &randomState);
+    UndoModel undoModel;
+    UndoManager undoManager;
+    undoManager.init(&undoModel);
+    int played = 0;
+    while (played < moveCount && playRandomStep(gameModel, &undoManager, &randomState)) {
+        played++;
+    }
+    
+    // 最后撤销几步，快照同时包含撤销和可重做记录
+    for (int i = 0; i < 3 && undoManager.canUndo(); i++) {
+        undoManager.performUndo(gameModel);
+    }
+    
+    printf("level: %d cards, %d moves, %d undo records, %d redo records, %d playfield cards left\n",
+           static_cast<int>(gameModel->getAllCards().size()), played, undoModel.getActionCount(),
+           undoModel.getRedoCount(), static_cast<int>(gameModel->getPlayfieldCardIds().size()));
+    
+    bool ok = verifyRoundTrip(gameModel, &undoModel, randomState);
+    printf("round trip: %s\n", ok ? "ok" : "FAILED");
+    if (ok) {
+        runBenchmark(gameModel, &undoModel, iterations);
+    }
+    
+    delete gameModel;
+    return ok ? 0 : 1;
+}